@@ -51,6 +51,8 @@ namespace builtin {
 
 extern const fastrtps::rtps::SampleIdentity INVALID_SAMPLE_IDENTITY;
 
+class TypeObjectCache;
+
 /**
  * Class TypeLookupManager that implements the TypeLookup Service described in the DDS-XTYPES 1.2 specification.
  * @ingroup XTYPES
@@ -168,6 +170,14 @@ public:
     fastrtps::rtps::SampleIdentity get_types(
             const fastrtps::types::TypeIdentifierSeq& in) const;
 
+    /**
+     * Check whether a type is on the persistent TypeObject cache of the participant.
+     * @param identifier TypeIdentifier of the type.
+     * @return true if the type was loaded from the cache file or stored on it.
+     */
+    bool is_type_cached(
+            const fastrtps::types::TypeIdentifier& identifier) const;
+
 private:
     /**
      * Create the endpoints used in the TypeLookupManager.
@@ -207,6 +217,11 @@ private:
 
     const fastrtps::rtps::GUID_t& get_builtin_request_writer_guid() const;
 
+    //! Keeps a received type on the persistent cache, if the participant has one.
+    void cache_type(
+            const fastrtps::types::TypeIdentifier& identifier,
+            const fastrtps::types::TypeObject& object);
+
     //!Pointer to the local RTPSParticipant.
     fastrtps::rtps::RTPSParticipantImpl* participant_;
 
@@ -243,6 +258,9 @@ private:
     //!Reply Listener object.
     TypeLookupReplyListener* reply_listener_;
 
+    //!Persistent cache of the received TypeObjects, only when configured.
+    TypeObjectCache* type_cache_;
+
     std::mutex temp_data_lock_;
     fastrtps::rtps::ReaderProxyData temp_reader_proxy_data_;
     fastrtps::rtps::WriterProxyData temp_writer_proxy_data_;
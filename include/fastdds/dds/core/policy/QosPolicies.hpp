@@ -1504,7 +1504,9 @@ typedef enum DataRepresentationId : int16_t
 {
     XCDR_DATA_REPRESENTATION = 0,   //!< Extended CDR Encoding version 1
     XML_DATA_REPRESENTATION = 1,    //!< XML Data Representation (Unsupported)
-    XCDR2_DATA_REPRESENTATION = 2    //!< Extended CDR Encoding version 2
+    XCDR2_DATA_REPRESENTATION = 2,  //!< Extended CDR Encoding version 2
+    //! Extended CDR Encoding compressed with a PayloadCompressor (Fast DDS extension)
+    COMPRESSED_XCDR_DATA_REPRESENTATION = 0x7F01
 } DataRepresentationId_t;
 
 /**
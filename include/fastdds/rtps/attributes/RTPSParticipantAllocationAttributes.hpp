@@ -86,6 +86,48 @@ struct SendBuffersAllocationAttributes
     bool dynamic = false;
 };
 
+/**
+ * @brief Holds limits for payloads shared between the readers of a participant.
+ */
+struct SharedPayloadsAllocationAttributes
+{
+    bool operator ==(
+            const SharedPayloadsAllocationAttributes& b) const
+    {
+        return (this->min_payload_size == b.min_payload_size) &&
+               (this->min_adopted_payload_size == b.min_adopted_payload_size) &&
+               (this->max_adopted_reception_buffers == b.max_adopted_reception_buffers);
+    }
+
+    /** Minimum size of a received DATA payload for it to be shared between readers.
+     *
+     * When a received DATA is going to be delivered to more than one reader of the participant,
+     * its payload is copied once into a reference counted buffer referenced by all of them, instead
+     * of being copied into the history of each reader. Smaller payloads are always copied, as the
+     * allocation of the shared buffer would be more expensive than the copies. A value of 0 disables
+     * payload sharing.
+     */
+    uint32_t min_payload_size = 8192u;
+
+    /** Minimum size of a received DATA payload for the reader to reference it on its reception buffer.
+     *
+     * Transports that receive on reference counted buffers (UDP and TCP) let the only reader of a large
+     * DATA keep its reception buffer instead of copying the payload, and receive the next messages on
+     * another buffer. Each kept sample holds a whole reception buffer while it is on the history, and a
+     * channel lends at most max_adopted_reception_buffers of them, copying the payloads while they are all kept.
+     * A value of 0 (the default) disables the adoption of reception buffers.
+     */
+    uint32_t min_adopted_payload_size = 0u;
+
+    /** Maximum number of reception buffers of each transport channel that readers may keep.
+     *
+     * Only used when min_adopted_payload_size is not 0. Each buffer has the maximum message size of the
+     * transport, so this bounds the memory held by the adopted payloads. A value of 0 disables the
+     * adoption of reception buffers.
+     */
+    uint32_t max_adopted_reception_buffers = 16u;
+};
+
 /**
  * @brief Holds limits for variable-length data.
  */
@@ -122,6 +164,8 @@ struct RTPSParticipantAllocationAttributes
     ResourceLimitedContainerConfig writers;
     //! Defines the allocation behaviour for the send buffer manager.
     SendBuffersAllocationAttributes send_buffers;
+    //! Defines the sharing of received payloads between the readers of the participant.
+    SharedPayloadsAllocationAttributes shared_payloads;
     //! Holds limits for variable-length data
     VariableLengthDataLimits data_limits;
 
@@ -145,6 +189,7 @@ struct RTPSParticipantAllocationAttributes
                (this->readers == b.readers) &&
                (this->writers == b.writers) &&
                (this->send_buffers == b.send_buffers) &&
+               (this->shared_payloads == b.shared_payloads) &&
                (this->data_limits == b.data_limits);
     }
 
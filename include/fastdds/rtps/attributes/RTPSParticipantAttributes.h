@@ -265,15 +265,21 @@ private:
 
 /**
  * TypeLookupService settings.
+ *
+ * The TypeLookup Service endpoints of a participant that is only a client are created on its first use,
+ * instead of when the participant is enabled. This is the only builtin service created on demand: the
+ * discovery, liveliness and security builtin endpoints are always created when the participant is enabled,
+ * as the authentication handshake needs the stateless security endpoints as soon as a remote participant
+ * is discovered.
  */
 class TypeLookupSettings
 {
 public:
 
-    //!Indicates to use the TypeLookup Service client endpoints
+    //!Indicates to use the TypeLookup Service client endpoints, which are created on their first use
     bool use_client = false;
 
-    //!Indicates to use the TypeLookup Service server endpoints
+    //!Indicates to use the TypeLookup Service server endpoints, which are created when the participant is enabled
     bool use_server = false;
 
 };
@@ -21,7 +21,9 @@
 #define _FASTDDS_RTPS_BUILTINPROTOCOLS_H_
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 
+#include <atomic>
 #include <list>
+#include <mutex>
 
 #include <fastdds/rtps/attributes/RTPSParticipantAttributes.h>
 #include <fastdds/rtps/network/NetworkFactory.h>
@@ -95,6 +97,13 @@ public:
     void transform_server_remote_locators(
             NetworkFactory & nf);
 
+    /**
+     * Get the TypeLookupManager. When the participant is only a TypeLookup client, the manager and its endpoints
+     * are created on the first call, and matched with the participants already discovered.
+     * @return Pointer to the TypeLookupManager, or nullptr if the TypeLookup service is disabled.
+     */
+    fastdds::dds::builtin::TypeLookupManager* typelookup_manager();
+
     //!BuiltinAttributes of the builtin protocols.
     BuiltinAttributes m_att;
     //!Pointer to the RTPSParticipantImpl.
@@ -103,8 +112,10 @@ public:
     PDP* mp_PDP;
     //!Pointer to the WLP
     WLP* mp_WLP;
-    //!Pointer to the TypeLookupManager
-    fastdds::dds::builtin::TypeLookupManager* tlm_;
+    //!Pointer to the TypeLookupManager. Null until created, which may be deferred to typelookup_manager().
+    std::atomic<fastdds::dds::builtin::TypeLookupManager*> tlm_;
+    //!Protects the deferred creation of the TypeLookupManager
+    std::mutex tlm_mutex_;
     //!Locator list for metatraffic
     LocatorList_t m_metatrafficMulticastLocatorList;
     //!Locator List for metatraffic unicast
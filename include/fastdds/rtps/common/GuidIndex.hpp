@@ -0,0 +1,190 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file GuidIndex.hpp
+ */
+
+#ifndef _FASTDDS_RTPS_COMMON_GUIDINDEX_HPP_
+#define _FASTDDS_RTPS_COMMON_GUIDINDEX_HPP_
+
+#include <fastdds/rtps/common/Guid.h>
+#include <fastrtps/utils/collections/ResourceLimitedVector.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Index of the remote entities matched with an endpoint, sorted by their GUID, so they can be found with a binary
+ * search when a message arrives from them.
+ *
+ * The GUIDs are kept on the index together with the pointers, so a search doesn't need to access the entities.
+ * Entries are held on a ResourceLimitedVector, with the same allocation configuration as the collection of matched
+ * entities of the endpoint.
+ *
+ * @tparam T Type of the indexed entities.
+ */
+template<typename T>
+class GuidIndex
+{
+public:
+
+    /**
+     * Construct a GuidIndex.
+     *
+     * @param entries_allocation Allocation configuration regarding the number of remote entities.
+     */
+    GuidIndex(
+            const ResourceLimitedContainerConfig& entries_allocation)
+        : entries_(entries_allocation)
+    {
+    }
+
+    /**
+     * Add an entity to the index.
+     *
+     * @param guid GUID of the entity.
+     * @param entity Pointer to the entity.
+     *
+     * @return false when the GUID was already on the index, or the resource limits were reached.
+     */
+    bool add(
+            const GUID_t& guid,
+            T* entity)
+    {
+        auto it = lower_bound(guid);
+        if (it != entries_.end() && equal(it->guid, guid))
+        {
+            return false;
+        }
+
+        size_t position = std::distance(entries_.begin(), it);
+        if (entries_.push_back({guid, entity}) == nullptr)
+        {
+            return false;
+        }
+
+        // Move the new entry to its sorted position
+        std::rotate(entries_.begin() + position, entries_.end() - 1, entries_.end());
+        return true;
+    }
+
+    /**
+     * Remove an entity from the index.
+     *
+     * @param guid GUID of the entity.
+     *
+     * @return true when the GUID was on the index.
+     */
+    bool remove(
+            const GUID_t& guid)
+    {
+        auto it = lower_bound(guid);
+        if (it != entries_.end() && equal(it->guid, guid))
+        {
+            entries_.erase(it);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Find an entity on the index.
+     *
+     * @param guid GUID of the entity.
+     *
+     * @return Pointer to the entity, nullptr when the GUID is not on the index.
+     */
+    T* find(
+            const GUID_t& guid) const
+    {
+        auto it = lower_bound(guid);
+        if (it != entries_.end() && equal(it->guid, guid))
+        {
+            return it->entity;
+        }
+        return nullptr;
+    }
+
+    /**
+     * Remove all the entities from the index.
+     */
+    void clear()
+    {
+        entries_.clear();
+    }
+
+    size_t size() const
+    {
+        return entries_.size();
+    }
+
+private:
+
+    struct Entry
+    {
+        GUID_t guid;
+        T* entity;
+    };
+
+    using EntryVector = ResourceLimitedVector<Entry, std::true_type>;
+
+    //! GUIDs are compared as 16 bytes, the order doesn't need to be the one of the GUID_t operators
+    static int compare(
+            const GUID_t& g1,
+            const GUID_t& g2)
+    {
+        return std::memcmp(&g1, &g2, sizeof(GUID_t));
+    }
+
+    static bool equal(
+            const GUID_t& g1,
+            const GUID_t& g2)
+    {
+        return compare(g1, g2) == 0;
+    }
+
+    typename EntryVector::const_iterator lower_bound(
+            const GUID_t& guid) const
+    {
+        return std::lower_bound(entries_.begin(), entries_.end(), guid,
+                       [](const Entry& entry, const GUID_t& value)
+                       {
+                           return compare(entry.guid, value) < 0;
+                       });
+    }
+
+    typename EntryVector::iterator lower_bound(
+            const GUID_t& guid)
+    {
+        return std::lower_bound(entries_.begin(), entries_.end(), guid,
+                       [](const Entry& entry, const GUID_t& value)
+                       {
+                           return compare(entry.guid, value) < 0;
+                       });
+    }
+
+    EntryVector entries_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // _FASTDDS_RTPS_COMMON_GUIDINDEX_HPP_
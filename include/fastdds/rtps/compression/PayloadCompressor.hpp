@@ -0,0 +1,126 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PayloadCompressor.hpp
+ */
+
+#ifndef _FASTDDS_RTPS_COMPRESSION_PAYLOADCOMPRESSOR_HPP_
+#define _FASTDDS_RTPS_COMPRESSION_PAYLOADCOMPRESSOR_HPP_
+
+#include <fastrtps/fastrtps_dll.h>
+#include <fastdds/rtps/common/Types.h>
+
+#include <memory>
+#include <string>
+
+namespace eprosima {
+namespace fastdds {
+namespace rtps {
+
+/**
+ * Interface against which to implement a codec for the serialized payloads of a topic.
+ *
+ * Writers using the COMPRESSED_XCDR_DATA_REPRESENTATION compress each serialized sample before fragmenting it,
+ * and readers decompress it before deserialization. The identifier of the codec travels on every compressed
+ * payload, so readers only need the codec to be registered.
+ * Implementations should be stateless, as the same instance is used concurrently by several entities.
+ * @ingroup RTPS_MODULE
+ */
+class PayloadCompressor
+{
+public:
+
+    RTPS_DllAPI virtual ~PayloadCompressor() = default;
+
+    /**
+     * Identifier of the codec, written on each payload compressed by it.
+     * Identifiers below 128 are reserved for the built-in codecs.
+     * @return Identifier of the codec.
+     */
+    RTPS_DllAPI virtual uint8_t id() const = 0;
+
+    /**
+     * Compress a buffer.
+     * @param input Buffer to compress.
+     * @param input_length Length of the buffer to compress.
+     * @param output Buffer where the compressed data will be written.
+     * @param output_max_length Size of the output buffer.
+     * @param output_length Length of the compressed data.
+     * @return false if the compressed data does not fit on the output buffer.
+     */
+    RTPS_DllAPI virtual bool compress(
+            const fastrtps::rtps::octet* input,
+            uint32_t input_length,
+            fastrtps::rtps::octet* output,
+            uint32_t output_max_length,
+            uint32_t& output_length) const = 0;
+
+    /**
+     * Decompress a buffer.
+     * @param input Buffer to decompress.
+     * @param input_length Length of the buffer to decompress.
+     * @param output Buffer where the decompressed data will be written.
+     * @param output_length Expected length of the decompressed data.
+     * @return false if the input is malformed or does not decompress to exactly output_length bytes.
+     */
+    RTPS_DllAPI virtual bool decompress(
+            const fastrtps::rtps::octet* input,
+            uint32_t input_length,
+            fastrtps::rtps::octet* output,
+            uint32_t output_length) const = 0;
+};
+
+/**
+ * Registry of the codecs available to compress payloads.
+ * The built-in "lz" codec (a fast LZ77 variant) is always available.
+ * @ingroup RTPS_MODULE
+ */
+class PayloadCompressorRegistry
+{
+public:
+
+    /**
+     * Register a codec.
+     * @param name Name used to select the codec, with the writer property "fastdds.compression.codec".
+     * @param compressor Codec to register.
+     * @return false if there is already a codec with the same name or identifier, or if its identifier is
+     * reserved for the built-in codecs.
+     */
+    RTPS_DllAPI static bool register_compressor(
+            const std::string& name,
+            std::shared_ptr<PayloadCompressor> compressor);
+
+    /**
+     * Find a codec by name.
+     * @param name Name of the codec.
+     * @return The codec, or nullptr if not registered.
+     */
+    RTPS_DllAPI static std::shared_ptr<PayloadCompressor> find(
+            const std::string& name);
+
+    /**
+     * Find a codec by identifier.
+     * @param id Identifier of the codec.
+     * @return The codec, or nullptr if not registered.
+     */
+    RTPS_DllAPI static std::shared_ptr<PayloadCompressor> find(
+            uint8_t id);
+};
+
+} // namespace rtps
+} // namespace fastdds
+} // namespace eprosima
+
+#endif // _FASTDDS_RTPS_COMPRESSION_PAYLOADCOMPRESSOR_HPP_
@@ -92,12 +92,29 @@ class WriterHistory : public History
 
     RTPS_DllAPI SequenceNumber_t next_sequence_number() const { return m_lastCacheChangeSeqNum + 1; }
 
+    /**
+     * Send a CacheChange_t to the matched readers without adding it to the WriterHistory.
+     * The change gets the next sequence number, as if it had been added and then removed.
+     * Only synchronous best-effort writers support it, as their readers never ask for a change again.
+     * @param a_change Pointer to the CacheChange_t to be sent. It needs not belong to the history.
+     * @param wparams Extra write parameters.
+     * @param max_blocking_time Maximum time the send may block.
+     * @return True if sent, false if the writer does not support it.
+     */
+    RTPS_DllAPI bool send_change_without_history(
+            CacheChange_t* a_change,
+            WriteParams& wparams,
+            std::chrono::time_point<std::chrono::steady_clock> max_blocking_time);
+
     protected:
 
     bool add_change_(CacheChange_t* a_change, WriteParams &wparams,
             std::chrono::time_point<std::chrono::steady_clock> max_blocking_time
                 = std::chrono::steady_clock::now() + std::chrono::hours(24));
 
+    //! Assign the next sequence number and the source timestamp to a change about to be sent
+    void set_next_sequence_number(CacheChange_t* a_change, WriteParams& wparams);
+
     //!Last CacheChange Sequence Number added to the History.
     SequenceNumber_t m_lastCacheChangeSeqNum;
     //!Pointer to the associated RTPSWriter;
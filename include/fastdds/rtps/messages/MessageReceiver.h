@@ -58,10 +58,12 @@ public:
      * Process a new CDR message.
      * @param[in] loc Locator indicating the sending address.
      * @param[in] msg Pointer to the message
+     * @param[in] pooled_buffer Whether the buffer of the message is reference counted, so readers can keep it.
      */
     void processCDRMsg(
             const Locator_t& loc,
-            CDRMessage_t* msg);
+            CDRMessage_t* msg,
+            bool pooled_buffer = false);
 
     // Functions to associate/remove associatedendpoints
     void associateEndpoint(
@@ -88,6 +90,8 @@ private:
     bool have_timestamp_;
     //!Timestamp associated with the message
     Time_t timestamp_;
+    //!Reference counted buffer of the message being processed, nullptr if it is not reference counted
+    octet* pooled_buffer_;
 
 #if HAVE_SECURITY
     CDRMessage_t crypto_msg_;
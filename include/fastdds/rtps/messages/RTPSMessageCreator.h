@@ -43,6 +43,22 @@ public:
     virtual bool writeQosToCDRMessage(CDRMessage_t* msg) = 0;
 };
 
+/**
+ * An INFO_TS submessage followed by the header of a DATA submessage without inline QoS, as sent by a writer.
+ * It is built once for the writer, so adding a sample only needs to patch the timestamp, the reader id, the
+ * submessage length and the sequence number.
+ */
+struct DataSubmessageTemplate
+{
+    //! Bytes of INFO_TS (12) and of the DATA header up to the serialized payload (24)
+    static constexpr uint32_t size = 36;
+
+    //! Bytes of the INFO_TS submessage, at the beginning of the template
+    static constexpr uint32_t info_ts_size = 12;
+
+    octet bytes[size];
+};
+
 /**
  * @brief Class RTPSMessageCreator, allows the generation of serialized CDR RTPS Messages.
  * @ingroup MANAGEMENT_MODULE
@@ -109,6 +125,24 @@ class RTPSMessageCreator
                 TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos, InlineQosWriter* inlineQos, 
                 bool* is_big_submessage);
 
+        /**
+         * Build the DATA submessage template of a writer.
+         * @param[out] data_template Template to build.
+         * @param[in] writerId Entity id of the writer.
+         */
+        static void initDataSubmessageTemplate(DataSubmessageTemplate* data_template, const EntityId_t& writerId);
+
+        /**
+         * Add an INFO_TS and a DATA submessage for a change, copying them from the template of its writer.
+         * The result is the same addSubmessageInfoTS and addSubmessageData would produce.
+         * @param addInfoTS Whether to add the INFO_TS. Otherwise only the DATA submessage is added.
+         * @return false, leaving the message untouched, when the DATA submessage needs inline QoS or a key, when
+         * it would not fit on 64KB, or when there is no room for it on the message.
+         */
+        static bool addSubmessagesFromDataTemplate(CDRMessage_t* msg, const DataSubmessageTemplate& data_template,
+                const CacheChange_t* change, TopicKind_t topicKind, const EntityId_t& readerId,
+                bool expectsInlineQos, bool addInfoTS);
+
         static bool addMessageDataFrag(CDRMessage_t* msg, GuidPrefix_t& guidprefix, const CacheChange_t* change, uint32_t fragment_number,
                 TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos, InlineQosWriter* inlineQos);
         static bool addSubmessageDataFrag(CDRMessage_t* msg, const CacheChange_t* change, uint32_t fragment_number,
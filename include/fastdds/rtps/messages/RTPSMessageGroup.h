@@ -39,6 +39,7 @@ namespace rtps {
 class RTPSParticipantImpl;
 class Endpoint;
 class RTPSMessageGroup_t;
+class ControlMessageAggregator;
 
 /**
  * RTPSMessageGroup Class used to construct a RTPS message.
@@ -181,6 +182,13 @@ public:
      */
     void flush_and_reset();
 
+    /**
+     * Let the participant aggregate the messages of this group with the control messages sent by other endpoints
+     * to the same destinations. Only to be used on groups with HEARTBEAT, ACKNACK, NACK_FRAG or GAP submessages.
+     * Has no effect when the participant does not aggregate control messages.
+     */
+    void aggregate_control_messages();
+
     //! Maximum fragment size minus the headers
     static inline constexpr uint32_t get_max_fragment_payload_size()
     {
@@ -224,6 +232,13 @@ private:
     bool add_info_ts_in_buffer(
             const Time_t& timestamp);
 
+    //! Whether the receivers already got this timestamp from a previous INFO_TS on the message
+    bool timestamp_is_current(
+            const Time_t& timestamp) const
+    {
+        return current_timestamp_ != c_RTPSTimeInvalid && current_timestamp_ == timestamp;
+    }
+
     bool create_gap_submessage(
             const SequenceNumber_t& gap_initial_sequence,
             const SequenceNumberSet_t& gap_bitmap,
@@ -241,6 +256,18 @@ private:
 
     GuidPrefix_t current_dst_;
 
+    //! Timestamp of the last INFO_TS on the message, invalid when there is none
+    Time_t current_timestamp_;
+
+    //! Timestamp of the INFO_TS on the submessage being added
+    Time_t submessage_timestamp_;
+
+    //! Whether the submessage being added has an INFO_TS
+    bool info_ts_added_;
+
+    //! Whether the submessage being added relies on the INFO_TS of the message instead of carrying its own
+    bool info_ts_omitted_;
+
     RTPSParticipantImpl* participant_;
 
 #if HAVE_SECURITY
@@ -252,6 +279,8 @@ private:
     std::chrono::steady_clock::time_point max_blocking_time_point_;
 
     std::unique_ptr<RTPSMessageGroup_t> send_buffer_;
+
+    ControlMessageAggregator* control_aggregator_;
 };
 
 } /* namespace rtps */
@@ -31,6 +31,8 @@ namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+class ControlMessageAggregator;
+
 /**
  * An interface used in \ref RTPSMessageGroup to handle destinations management
  * and message sending.
@@ -80,6 +82,23 @@ class RTPSMessageSenderInterface
         virtual bool send(
                 CDRMessage_t* message,
                 std::chrono::steady_clock::time_point& max_blocking_time_point) const = 0;
+
+        /**
+         * Queue a message with control submessages, to be sent together with the control messages of
+         * other endpoints to the same destinations.
+         *
+         * @param message Pointer to the buffer with the message already serialized.
+         * @param aggregator Aggregator where the message should be queued.
+         * @return true if the message has been queued, false if it should be sent with send().
+         */
+        virtual bool queue_control_message(
+                CDRMessage_t* message,
+                ControlMessageAggregator& aggregator) const
+        {
+            (void)message;
+            (void)aggregator;
+            return false;
+        }
 };
 
 } /* namespace rtps */
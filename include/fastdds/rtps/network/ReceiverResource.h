@@ -15,6 +15,7 @@
 #ifndef _FASTDDS_RTPS_RECEIVER_RESOURCE_H
 #define _FASTDDS_RTPS_RECEIVER_RESOURCE_H
 
+#include <atomic>
 #include <functional>
 #include <vector>
 #include <memory>
@@ -50,6 +51,17 @@ public:
     virtual void OnDataReceived(const octet* data, const uint32_t size,
         const Locator_t& localLocator, const Locator_t& remoteLocator) override;
 
+    /**
+    * Method called by the transport when receiving data on a reference counted reception buffer.
+    * Readers may keep references to it for the payloads of large DATA submessages.
+    * @param data Pointer to the reception buffer.
+    * @param size Number of bytes received.
+    * @param localLocator Locator identifying the local endpoint.
+    * @param remoteLocator Locator identifying the remote endpoint.
+    */
+    virtual void OnPooledDataReceived(const octet* data, const uint32_t size,
+        const Locator_t& localLocator, const Locator_t& remoteLocator) override;
+
     /**
      * Reports whether this resource supports the given local locator (i.e., said locator
      * maps to the transport channel managed by this resource).
@@ -78,6 +90,25 @@ public:
         return max_message_size_;
     }
 
+    /**
+     * Maximum number of reception buffers of the channel the registered receiver may keep.
+     * @return Maximum number of reception buffers, 0 when they are not lent.
+     */
+    uint32_t max_lent_buffers() const override
+    {
+        return max_lent_buffers_;
+    }
+
+    /**
+     * Set the maximum number of reception buffers of the channel the registered receiver may keep.
+     * @param max_buffers Maximum number of reception buffers, 0 to disable their lending.
+     */
+    void max_lent_buffers(
+            uint32_t max_buffers)
+    {
+        max_lent_buffers_ = max_buffers;
+    }
+
     /**
      * Resources can only be transfered through move semantics. Copy, assignment, and
      * construction outside of the factory are forbidden.
@@ -92,6 +123,10 @@ private:
     ReceiverResource& operator=(const ReceiverResource&) = delete;
 
     ReceiverResource(fastdds::rtps::TransportInterface&, const Locator_t&, uint32_t);
+
+    void process_data(const octet* data, const uint32_t size,
+        const Locator_t& localLocator, const Locator_t& remoteLocator, bool pooled_buffer);
+
     std::function<void()> Cleanup;
     std::function<bool(const Locator_t&)> LocatorMapsToManagedChannel;
     bool mValid; // Post-construction validity check for the NetworkFactory
@@ -99,6 +134,7 @@ private:
     std::mutex mtx;
     MessageReceiver* receiver;
     uint32_t max_message_size_;
+    std::atomic<uint32_t> max_lent_buffers_;
 };
 
 } // namespace rtps
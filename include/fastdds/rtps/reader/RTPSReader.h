@@ -26,6 +26,7 @@
 #include <fastdds/rtps/common/Time_t.h>
 #include <fastdds/rtps/builtin/data/WriterProxyData.h>
 #include <fastrtps/utils/TimedConditionVariable.hpp>
+#include <fastrtps/utils/collections/ResourceLimitedVector.hpp>
 #include "../history/ReaderHistory.h"
 
 namespace eprosima {
@@ -89,6 +90,14 @@ public:
     RTPS_DllAPI virtual bool matched_writer_is_matched(
             const GUID_t& writer_guid) = 0;
 
+    /**
+     * Tells us if a matched writer compresses the payloads of its samples.
+     * @param writer_guid GUID of the writer to check.
+     * @return True if the preferred data representation of the writer is COMPRESSED_XCDR.
+     */
+    RTPS_DllAPI bool matched_writer_compresses(
+            const GUID_t& writer_guid) const;
+
     /**
      * Processes a new DATA message. Previously the message must have been accepted by function acceptMsgDirectedTo.
      *
@@ -269,6 +278,20 @@ protected:
             const GUID_t& guid,
             const GUID_t& persistence_guid);
 
+    /*!
+     * @brief Keep whether a remote writer compresses its payloads
+     * @param wdata Attributes of the remote writer
+     */
+    void add_writer_representation(
+            const WriterProxyData& wdata);
+
+    /*!
+     * @brief Forget the data representation of a remote writer
+     * @param guid GUID of the remote writer
+     */
+    void remove_writer_representation(
+            const GUID_t& guid);
+
     /*!
      * @brief Get the last notified sequence for a RTPS guid
      * @param guid The RTPS guid to query
@@ -289,6 +312,23 @@ protected:
             const GUID_t& guid,
             const SequenceNumber_t& seq);
 
+    /*!
+     * @brief Add a change to the list of changes notified and not read yet.
+     * The list keeps the order of the history, so the first unread change is always at its front.
+     * @param change Change made available to the user.
+     */
+    void add_unread_change(
+            CacheChange_t* change);
+
+    /*!
+     * @brief Remove a change from the list of changes notified and not read yet.
+     * Should be called whenever an unread change is read or removed from the history.
+     * @param change Change to remove.
+     * @return true when the change was on the list.
+     */
+    bool remove_unread_change(
+            CacheChange_t* change);
+
     /*!
      * @brief Set the last notified sequence for a persistence guid
      * @param persistence_guid The persistence guid to update
@@ -333,7 +373,8 @@ protected:
     //!ReaderHistoryState
     ReaderHistoryState* history_state_;
 
-    uint64_t total_unread_ = 0;
+    //! Changes notified to the user and not read yet, in the order of the history. Limited as the history.
+    ResourceLimitedVector<CacheChange_t*> unread_changes_;
 
     TimedConditionVariable new_notification_cv_;
 
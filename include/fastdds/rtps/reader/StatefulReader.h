@@ -22,6 +22,7 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 
 #include <fastdds/rtps/reader/RTPSReader.h>
+#include <fastdds/rtps/common/GuidIndex.hpp>
 #include <fastrtps/utils/collections/ResourceLimitedVector.hpp>
 #include <fastdds/rtps/common/CDRMessage_t.h>
 #include <fastdds/rtps/messages/RTPSMessageGroup.h>
@@ -274,6 +275,8 @@ class StatefulReader : public RTPSReader
         ResourceLimitedVector<WriterProxy*> matched_writers_;
         //! Vector containing pointers to all the inactive, ready for reuse, WriterProxies.
         ResourceLimitedVector<WriterProxy*> matched_writers_pool_;
+        //! Active WriterProxies sorted by GUID, to find them when receiving messages.
+        GuidIndex<WriterProxy> matched_writers_index_;
         //!
         ResourceLimitedContainerConfig proxy_changes_config_;
         //! True to disable positive ACKs
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <map>
+#include <vector>
 #include <fastrtps/utils/Semaphore.h>
 #include <fastdds/dds/log/Log.hpp>
 #include <fastdds/rtps/common/CDRMessage_t.h>
@@ -60,12 +61,36 @@ public:
         return message_buffer_;
     }
 
+    /**
+     * Check whether the receiver may keep references to the reception buffer of the last message.
+     * It is allowed while the channel has another free reception buffer, or can still create one, so
+     * the number of buffers kept by receivers is bounded.
+     * @param max_buffers Maximum number of reception buffers the receiver may keep, as given by
+     * TransportReceiverInterface::max_lent_buffers(). 0 disables the lending of buffers.
+     * @return true when the message should be given to OnPooledDataReceived, false for OnDataReceived.
+     */
+    bool can_lend_message_buffer(
+            uint32_t max_buffers);
+
+    /**
+     * Prepare message_buffer() to receive the next message.
+     * When the receiver kept references to the reception buffer of the last message, the next one is
+     * received on a free buffer of the channel.
+     */
+    void renew_message_buffer();
+
 protected:
     //!Received message
     fastrtps::rtps::CDRMessage_t message_buffer_;
 
     std::atomic<bool> alive_;
     std::thread thread_;
+
+private:
+    //!Reference counted reception buffers kept for reuse, each one holding a reference
+    std::vector<fastrtps::rtps::octet*> receive_buffers_;
+    //!Size of the reception buffers. 0 when message_buffer_ is not reference counted.
+    uint32_t receive_buffer_size_;
 };
 
 } // namespace rtps
@@ -73,6 +73,12 @@ protected:
     std::mutex read_mutex_;
     std::recursive_mutex pending_logical_mutex_;
     std::atomic<eConnectionStatus> connection_status_;
+    std::atomic<TCPChecksumKind> checksum_kind_;
+    // Octets read from the socket and not consumed yet, between receive_begin_ and receive_end_.
+    // Only accessed by the listening thread.
+    std::vector<fastrtps::rtps::octet> receive_stream_;
+    size_t receive_begin_;
+    size_t receive_end_;
 
 public:
 
@@ -109,6 +115,12 @@ public:
         return locator_;
     }
 
+    //! Kind of checksum used on the TCP headers, agreed on the bind handshake.
+    inline TCPChecksumKind checksum_kind() const
+    {
+        return checksum_kind_;
+    }
+
     ResponseCode process_bind_request(
             const fastrtps::rtps::Locator_t& locator);
 
@@ -123,6 +135,33 @@ public:
             std::size_t size,
             asio::error_code& ec) = 0;
 
+    /**
+     * Read up to size octets, returning as soon as some are available.
+     * @return Number of octets read.
+     */
+    virtual uint32_t read_some(
+            fastrtps::rtps::octet* buffer,
+            std::size_t size,
+            asio::error_code& ec) = 0;
+
+    /**
+     * Read exactly size octets through the receive stream of the channel. The socket is read in chunks as
+     * big as the stream, so consecutive small messages are served from memory without further system calls.
+     * Reads longer than the stream go directly to the buffer. Must only be called by the listening thread.
+     * @return Number of octets read.
+     */
+    uint32_t read_buffered(
+            fastrtps::rtps::octet* buffer,
+            std::size_t size,
+            asio::error_code& ec);
+
+    //! Discard the octets on the receive stream. Called when a new connection starts.
+    inline void clear_receive_stream()
+    {
+        receive_begin_ = 0;
+        receive_end_ = 0;
+    }
+
     virtual size_t send(
             const fastrtps::rtps::octet* header,
             size_t header_size,
@@ -180,6 +219,12 @@ protected:
         return old;
     }
 
+    inline void checksum_kind(
+            TCPChecksumKind kind)
+    {
+        checksum_kind_ = kind;
+    }
+
     void add_logical_port_response(
             const TCPTransactionId& id,
             bool success,
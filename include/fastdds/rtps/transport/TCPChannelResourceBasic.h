@@ -53,6 +53,11 @@ public:
         std::size_t size,
         asio::error_code& ec) override;
 
+    uint32_t read_some(
+        fastrtps::rtps::octet* buffer,
+        std::size_t size,
+        asio::error_code& ec) override;
+
     size_t send(
         const fastrtps::rtps::octet* header,
         size_t header_size,
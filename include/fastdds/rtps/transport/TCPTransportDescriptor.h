@@ -163,6 +163,8 @@ typedef struct TCPTransportDescriptor : public SocketTransportDescriptor
     bool wait_for_tcp_negotiation;
     bool calculate_crc;
     bool check_crc;
+    //! Use CRC-32C instead of the octet sum on the connections whose remote end also enables it.
+    bool use_crc32c;
     bool apply_security;
 
     TLSConfig tls_config;
@@ -111,18 +111,21 @@ protected:
     bool check_crc(
         const TCPHeader &header,
         const fastrtps::rtps::octet *data,
-        uint32_t size) const;
+        uint32_t size,
+        TCPChecksumKind kind = TCP_CHECKSUM_SUM) const;
 
     void calculate_crc(
         TCPHeader &header,
         const fastrtps::rtps::octet *data,
-        uint32_t size) const;
+        uint32_t size,
+        TCPChecksumKind kind = TCP_CHECKSUM_SUM) const;
 
     void fill_rtcp_header(
         TCPHeader& header,
         const fastrtps::rtps::octet* send_buffer,
         uint32_t send_buffer_size,
-        uint16_t logical_port) const;
+        uint16_t logical_port,
+        TCPChecksumKind checksum_kind = TCP_CHECKSUM_SUM) const;
 
     //! Closes the given p_channel_resource and unbind it from every resource.
     void close_tcp_socket(std::shared_ptr<TCPChannelResource>& channel);
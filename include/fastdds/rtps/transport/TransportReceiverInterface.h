@@ -40,6 +40,32 @@ public:
      */
     virtual void OnDataReceived(const fastrtps::rtps::octet* data, const uint32_t size,
         const fastrtps::rtps::Locator_t& localLocator, const fastrtps::rtps::Locator_t& remote_locator) = 0;
+
+    /**
+     * Method to be called by the transport when receiving data on a reference counted reception buffer.
+     * The receiver may keep references to the buffer after returning, so the transport should check
+     * them before receiving on it again. By default, it behaves as OnDataReceived.
+     * @param data Pointer to the reception buffer, which starts with the received data.
+     * @param size Number of bytes received.
+     * @param localLocator Locator identifying the local endpoint.
+     * @param remote_locator Locator identifying the remote endpoint.
+     */
+    virtual void OnPooledDataReceived(const fastrtps::rtps::octet* data, const uint32_t size,
+        const fastrtps::rtps::Locator_t& localLocator, const fastrtps::rtps::Locator_t& remote_locator)
+    {
+        OnDataReceived(data, size, localLocator, remote_locator);
+    }
+
+    /**
+     * Maximum number of reception buffers of a channel the receiver may keep references to.
+     * Transports only call OnPooledDataReceived while this limit allows it. By default, it is 0 and the
+     * reception buffers are never lent.
+     * @return Maximum number of reception buffers per channel.
+     */
+    virtual uint32_t max_lent_buffers() const
+    {
+        return 0;
+    }
 };
 
 } // namespace rtps
@@ -197,6 +197,13 @@ enum TCPCPMKind : fastrtps::rtps::octet
     UNBIND_CONNECTION_REQUEST =         0xD6
 };
 
+//! Kinds of checksum stored on TCPHeader::crc. The kind used on each connection is agreed on the bind handshake.
+enum TCPChecksumKind : fastrtps::rtps::octet
+{
+    TCP_CHECKSUM_SUM =                  0x00, // Sum of all octets, adding back the carries
+    TCP_CHECKSUM_CRC32C =               0x01  // CRC-32C (Castagnoli)
+};
+
 class TCPControlMsgHeader
 {
     TCPCPMKind kind_; // 1 byte
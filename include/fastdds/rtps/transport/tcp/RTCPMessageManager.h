@@ -210,7 +210,8 @@ protected:
             const ResponseCode respCode = RETCODE_VOID);
 
     void fillHeaders(TCPCPMKind kind, const TCPTransactionId &transactionId, TCPControlMsgHeader &retCtrlHeader,
-        TCPHeader &header, const fastrtps::rtps::SerializedPayload_t *payload = nullptr, const ResponseCode *respCode = nullptr);
+        TCPHeader &header, TCPChecksumKind checksum, const fastrtps::rtps::SerializedPayload_t *payload = nullptr,
+        const ResponseCode *respCode = nullptr);
 
     bool isCompatibleProtocol(const fastrtps::rtps::ProtocolVersion_t &protocol) const;
 
@@ -24,6 +24,7 @@
 
 #include <fastdds/rtps/common/Locator.h>
 #include <fastdds/rtps/common/SerializedPayload.h>
+#include <fastdds/rtps/transport/tcp/RTCPHeader.h>
 
 #if defined(_WIN32)
 #if defined(EPROSIMA_USER_DLL_EXPORT)
@@ -196,6 +197,24 @@ public:
         return m_transportLocator;
     }
 
+    /*!
+     * @brief This function sets the kind of checksum preferred by the requester
+     * @param _checksumKind New value for member checksumKind
+     */
+    inline eProsima_user_DllExport void checksumKind(TCPChecksumKind _checksumKind)
+    {
+        m_checksumKind = _checksumKind;
+    }
+
+    /*!
+     * @brief This function returns the value of member checksumKind
+     * @return Value of member checksumKind
+     */
+    inline eProsima_user_DllExport TCPChecksumKind checksumKind() const
+    {
+        return m_checksumKind;
+    }
+
     /*!
      * @brief This function returns the maximum serialized size of an object
      * depending on the buffer alignment.
@@ -256,6 +275,8 @@ private:
     fastrtps::rtps::ProtocolVersion_t m_protocolVersion;
     fastrtps::rtps::VendorId_t m_vendorId;
     fastrtps::rtps::Locator_t m_transportLocator;
+    //! Not part of the first version of the protocol. Serialized at the end, when present.
+    TCPChecksumKind m_checksumKind;
 };
 /*!
  * @brief This class represents the structure OpenLogicalPortRequest_t defined by the user in the IDL file.
@@ -1245,6 +1266,24 @@ public:
         return m_locator;
     }
 
+    /*!
+     * @brief This function sets the kind of checksum chosen by the responder
+     * @param _checksumKind New value for member checksumKind
+     */
+    inline eProsima_user_DllExport void checksumKind(TCPChecksumKind _checksumKind)
+    {
+        m_checksumKind = _checksumKind;
+    }
+
+    /*!
+     * @brief This function returns the value of member checksumKind
+     * @return Value of member checksumKind
+     */
+    inline eProsima_user_DllExport TCPChecksumKind checksumKind() const
+    {
+        return m_checksumKind;
+    }
+
     /*!
      * @brief This function returns the maximum serialized size of an object
      * depending on the buffer alignment.
@@ -1303,6 +1342,8 @@ public:
 
 private:
     fastrtps::rtps::Locator_t m_locator;
+    //! Not part of the first version of the protocol. Serialized at the end, when present.
+    TCPChecksumKind m_checksumKind;
 };
 /*!
  * @brief This class represents the structure CheckLogicalPortsResponse_t defined by the user in the IDL file.
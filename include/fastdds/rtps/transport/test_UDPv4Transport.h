@@ -74,10 +74,17 @@ private:
     PercentageData drop_heartbeat_messages_percentage_;
     PercentageData drop_ack_nack_messages_percentage_;
     std::vector<fastrtps::rtps::SequenceNumber_t> sequence_number_data_messages_to_drop_;
+    std::function<bool(const fastrtps::rtps::Locator_t& destination, fastrtps::rtps::CDRMessage_t& msg)>
+    drop_data_messages_filter_;
+    std::function<void(const fastrtps::rtps::Locator_t& destination, const fastrtps::rtps::octet* buffer,
+            uint32_t size)> sent_messages_observer_;
     PercentageData percentage_of_messages_to_drop_;
 
     bool log_drop(const fastrtps::rtps::octet* buffer, uint32_t size);
-    bool packet_should_drop(const fastrtps::rtps::octet* send_buffer, uint32_t send_buffer_size);
+    bool packet_should_drop(
+            const fastrtps::rtps::octet* send_buffer,
+            uint32_t send_buffer_size,
+            const fastrtps::rtps::Locator_t& destination);
     bool random_chance_drop();
     bool should_be_dropped(PercentageData* percentage);
 
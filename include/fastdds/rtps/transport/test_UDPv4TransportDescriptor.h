@@ -16,8 +16,12 @@
 #define _FASTDDS_TEST_UDPV4_TRANSPORT_DESCRIPTOR_
 
 #include <fastdds/rtps/transport/SocketTransportDescriptor.h>
+#include <fastdds/rtps/common/CDRMessage_t.h>
+#include <fastdds/rtps/common/Locator.h>
 #include <fastdds/rtps/common/SequenceNumber.h>
 
+#include <functional>
+
 namespace eprosima{
 namespace fastdds{
 namespace rtps{
@@ -37,6 +41,14 @@ typedef struct test_UDPv4TransportDescriptor : public SocketTransportDescriptor{
    // General drop percentage (indescriminate)
    uint8_t percentageOfMessagesToDrop;
    std::vector<fastrtps::rtps::SequenceNumber_t> sequenceNumberDataMessagesToDrop;
+   // Called for every DATA submessage not belonging to discovery, with its destination and the message positioned
+   // at the beginning of the submessage. The datagram is dropped when it returns true.
+   std::function<bool(const fastrtps::rtps::Locator_t& destination, fastrtps::rtps::CDRMessage_t& msg)>
+   dropDataMessagesFilter;
+   // Called for every datagram sent to each destination, before deciding whether it is dropped. It is called from
+   // every thread sending through the transport, so it has to be thread safe.
+   std::function<void(const fastrtps::rtps::Locator_t& destination, const fastrtps::rtps::octet* buffer,
+           uint32_t size)> sentMessagesObserver;
 
    uint32_t dropLogLength; // logs dropped packets.
 
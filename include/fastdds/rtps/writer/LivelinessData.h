@@ -21,6 +21,7 @@
 #include <fastrtps/qos/QosPolicies.h>
 #include <fastdds/rtps/common/Time_t.h>
 
+#include <atomic>
 #include <chrono>
 
 namespace eprosima {
@@ -66,9 +67,33 @@ struct LivelinessData
         , status(WriterStatus::NOT_ASSERTED)
     {}
 
+    LivelinessData(
+            const LivelinessData& other)
+        : guid(other.guid)
+        , kind(other.kind)
+        , lease_duration(other.lease_duration)
+        , count(other.count)
+        , status(other.status)
+        , time(other.time)
+        , asserted_time(other.asserted_time.load())
+    {}
+
     ~LivelinessData()
     {}
 
+    LivelinessData& operator =(
+            const LivelinessData& other)
+    {
+        guid = other.guid;
+        kind = other.kind;
+        lease_duration = other.lease_duration;
+        count = other.count;
+        status = other.status;
+        time = other.time;
+        asserted_time = other.asserted_time.load();
+        return *this;
+    }
+
     /**
      * @brief Equality operator
      * @param other Liveliness data to compare to
@@ -110,6 +135,11 @@ struct LivelinessData
 
     //! The time when the writer will lose liveliness
     std::chrono::steady_clock::time_point time;
+
+    //! The time when the writer will lose liveliness according to its last assertion, in nanoseconds since the
+    //! epoch of the steady clock. Writers already alive store it without exclusive access to the LivelinessManager,
+    //! which moves it to time when it needs to.
+    std::atomic<int64_t> asserted_time{0};
 };
 
 } /* namespace rtps */
@@ -21,8 +21,12 @@
 #include <fastdds/rtps/writer/LivelinessData.h>
 #include <fastrtps/utils/collections/ResourceLimitedVector.hpp>
 #include <fastdds/rtps/resources/TimedEvent.h>
+#include <fastrtps/config.h>
 
 #include <mutex>
+#if HAVE_CXX14
+#include <shared_mutex>
+#endif // if HAVE_CXX14
 
 namespace eprosima {
 namespace fastrtps {
@@ -37,7 +41,9 @@ using LivelinessCallback = std::function<void(
 
 /**
  * @brief A class managing the liveliness of a set of writers. Writers are represented by their LivelinessData
- * @details Uses a shared timed event and informs outside classes on liveliness changes
+ * @details Uses a shared timed event and informs outside classes on liveliness changes.
+ * Asserting the liveliness of writers that are already alive only stores their new expiration time, sharing the
+ * mutex with other assertions. The timer takes those times into account when it expires.
  * @ingroup WRITER_MODULE
  */
 class LivelinessManager
@@ -118,18 +124,41 @@ public:
 
     /**
      * @brief A method to return liveliness data
-     * @details Should only be used for testing purposes
+     * @details Should only be used for testing purposes. The time of a writer asserted while it was alive may not
+     * include that assertion until the timer expires or another writer changes its status
      * @return Vector of liveliness data
      */
     const ResourceLimitedVector<LivelinessData> &get_liveliness_data() const;
 
 private:
 
+#if HAVE_CXX14
+    using LivelinessMutex = std::shared_timed_mutex;
+    using SharedLock = std::shared_lock<LivelinessMutex>;
+#else
+    using LivelinessMutex = std::mutex;
+    using SharedLock = std::unique_lock<LivelinessMutex>;
+#endif // if HAVE_CXX14
+
     //! @brief A method responsible for invoking the callback when liveliness is asserted
     //! @param writer The liveliness data of the writer asserting liveliness
     //!
     void assert_writer_liveliness(LivelinessData& writer);
 
+    //! @brief Asserts the liveliness of a writer, if it and the rest of writers asserted with it are already alive
+    //! @details Only needs shared access to the liveliness data
+    //! @param guid The guid of the writer
+    //! @param kind The liveliness kind
+    //! @param lease_duration The lease duration
+    //! @return True if liveliness was asserted, false if the writer was not found or something has to be notified
+    bool assert_alive_writers(
+            const GUID_t& guid,
+            const LivelinessQosPolicyKind& kind,
+            const Duration_t& lease_duration);
+
+    //! @brief Updates the time of the writers asserted through assert_alive_writers
+    void update_times();
+
     /**
      * @brief A method to calculate the time when the next writer is going to lose liveliness
      * @details This method is public for testing purposes but it should not be used from outside this class
@@ -163,8 +192,8 @@ private:
     //! A vector of liveliness data
     ResourceLimitedVector<LivelinessData> writers_;
 
-    //! A mutex to protect the liveliness data
-    std::mutex mutex_;
+    //! A mutex to protect the liveliness data. Assertions of alive writers only take it shared, when available
+    LivelinessMutex mutex_;
 
     //! The timer owner, i.e. the writer which is next due to lose its liveliness
     LivelinessData* timer_owner_;
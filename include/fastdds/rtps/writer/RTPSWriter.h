@@ -40,6 +40,8 @@ namespace rtps {
 class WriterListener;
 class WriterHistory;
 class FlowController;
+template<class T>
+class RTPSWriterCollector;
 struct CacheChange_t;
 
 /**
@@ -361,6 +363,17 @@ public:
             CDRMessage_t* message,
             std::chrono::steady_clock::time_point& max_blocking_time_point) const override;
 
+    /**
+     * Queue a message with control submessages on an aggregator.
+     *
+     * @param message Pointer to the buffer with the message already serialized.
+     * @param aggregator Aggregator where the message should be queued.
+     * @return true if the message has been queued.
+     */
+    bool queue_control_message(
+            CDRMessage_t* message,
+            ControlMessageAggregator& aggregator) const override;
+
 protected:
 
     //!Is the data sent directly or announced by HB and THEN send to the ones who ask for it?.
@@ -408,6 +421,16 @@ protected:
     virtual bool change_removed_by_history(
             CacheChange_t* a_change) = 0;
 
+    /**
+     * Send a change that is not on the history to the matched readers.
+     * Only called for synchronous best-effort writers, which don't need to reference the change after sending it.
+     * @param change Pointer to the change.
+     * @param max_blocking_time Maximum time the send may block.
+     */
+    virtual void send_change_without_history(
+            CacheChange_t* change,
+            const std::chrono::time_point<std::chrono::steady_clock>& max_blocking_time);
+
 #if HAVE_SECURITY
     SerializedPayload_t encrypt_payload_;
 
@@ -422,6 +445,9 @@ protected:
     //! The liveliness announcement period
     Duration_t liveliness_announcement_period_;
 
+    //! INFO_TS and DATA headers of this writer, built on creation and only read afterwards
+    DataSubmessageTemplate data_template_;
+
 private:
 
     RTPSWriter& operator =(
@@ -345,14 +345,23 @@ public:
             const FragmentNumberSet_t& fragments_state);
 
     /**
-     * Filter a CacheChange_t, in this version always returns true.
+     * Filter a CacheChange_t with the TIME_BASED_FILTER of the remote reader.
+     * A sample is irrelevant when its source timestamp is closer than the minimum separation to the last relevant
+     * sample of the same instance. Irrelevant samples are not sent, and reliable readers receive a GAP instead.
+     * Relevant samples update the filter, so this should be called once per change.
      * @param change
      * @return true if the change is relevant, false otherwise.
      */
-    inline bool rtps_is_relevant(
-            CacheChange_t* change)
+    bool rtps_is_relevant(
+            CacheChange_t* change);
+
+    /**
+     * Check if the remote reader has a TIME_BASED_FILTER.
+     * @return true if some changes may be irrelevant for this reader.
+     */
+    inline bool has_time_based_filter() const
     {
-        (void)change; return true;
+        return minimum_separation_ns_ > 0;
     }
 
     /**
@@ -401,6 +410,11 @@ private:
     bool is_reliable_;
     //!Taken from QoS
     bool disable_positive_acks_;
+    //!Taken from QoS. Minimum separation between samples of an instance, in nanoseconds.
+    int64_t minimum_separation_ns_;
+    //!Source timestamp, in nanoseconds, of the last relevant sample of each registered instance.
+    //!Limited as the writer history, whose size is derived from the maximum number of instances.
+    ResourceLimitedVector<std::pair<InstanceHandle_t, int64_t>> last_relevant_timestamps_;
     //!Pointer to the associated StatefulWriter.
     StatefulWriter* writer_;
     //!Set of the changes and its state.
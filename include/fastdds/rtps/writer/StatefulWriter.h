@@ -22,6 +22,7 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 
 #include <fastdds/rtps/writer/RTPSWriter.h>
+#include <fastdds/rtps/common/GuidIndex.hpp>
 #include <fastrtps/utils/collections/ResourceLimitedVector.hpp>
 #include <condition_variable>
 #include <mutex>
@@ -68,6 +69,25 @@ private:
     //! A timed event to mark samples as acknowledget (used only if disable positive ACKs QoS is enabled)
     TimedEvent* ack_event_;
 
+    //! A timed event to replay the history to late-joining readers (used only if historical replay is enabled)
+    TimedEvent* historical_replay_event_;
+
+    //! Historical changes pending to be replayed to a late-joining reader.
+    struct HistoricalReplay
+    {
+        //! GUID of the late-joining reader.
+        GUID_t reader_guid;
+        //! First sequence number pending to be replayed.
+        SequenceNumber_t next;
+        //! Sequence number following the last historical change.
+        SequenceNumber_t end;
+    };
+
+    //! Maximum number of historical changes replayed to each late-joining reader on each replay period.
+    uint32_t historical_replay_batch_;
+    //! Late-joining readers with historical changes pending to be replayed.
+    std::vector<HistoricalReplay> historical_replays_;
+
     //!Count of the sent heartbeats.
     Count_t m_heartbeatCount;
     //!WriterTimes
@@ -77,6 +97,8 @@ private:
     ResourceLimitedVector<ReaderProxy*> matched_readers_;
     //! Vector containing all the inactive, ready for reuse, ReaderProxies.
     ResourceLimitedVector<ReaderProxy*> matched_readers_pool_;
+    //! Active ReaderProxies sorted by GUID, to find them when receiving messages.
+    GuidIndex<ReaderProxy> matched_readers_index_;
 
     using ReaderProxyIterator = ResourceLimitedVector<ReaderProxy*>::iterator;
     using ReaderProxyConstIterator = ResourceLimitedVector<ReaderProxy*>::const_iterator;
@@ -320,6 +342,13 @@ private:
 
     void check_acked_status();
 
+    /**
+     * Report the feedback of a remote reader to the flow controllers of this writer.
+     * @param loss Whether the remote reader requested the retransmission of data or fragments.
+     */
+    void notify_flow_controllers_feedback(
+            bool loss);
+
     /**
      * @brief A method called when the ack timer expires
      * @details Only used if disable positive ACKs QoS is enabled
@@ -328,6 +357,13 @@ private:
 
     void send_heartbeat_to_all_readers();
 
+    /**
+     * Mark the next batch of historical changes of each late-joining reader as pending to be sent,
+     * as if the reader had requested them.
+     * @return true while there are historical changes pending to be replayed.
+     */
+    bool replay_historical_changes();
+
     void send_changes_separatedly(
             SequenceNumber_t max_sequence,
             bool& activateHeartbeatPeriod);
@@ -360,6 +396,9 @@ private:
 
     std::vector<std::unique_ptr<FlowController> > m_controllers;
 
+    //! Changes collected on each flow-controlled send, kept to avoid allocations
+    std::unique_ptr<RTPSWriterCollector<ReaderProxy*> > flow_controlled_changes_;
+
     bool there_are_remote_readers_ = false;
     bool there_are_local_readers_ = false;
 
@@ -70,6 +70,15 @@ public:
     bool change_removed_by_history(
             CacheChange_t* change) override;
 
+    /**
+     * Send a change that is not on the history to all ReaderLocators.
+     * @param change Pointer to the change.
+     * @param max_blocking_time
+     */
+    void send_change_without_history(
+            CacheChange_t* change,
+            const std::chrono::time_point<std::chrono::steady_clock>& max_blocking_time) override;
+
     /**
      * Add a matched reader.
      * @param data Pointer to the ReaderProxyData object added.
@@ -156,6 +165,18 @@ private:
             CacheChange_t* change,
             ReaderLocator& reader_locator);
 
+    //! Assert the liveliness of the writer and encrypt the payload of a change about to be sent
+    void prepare_change(
+            CacheChange_t* change);
+
+    /**
+     * Send a change to all ReaderLocators from the calling thread.
+     * @return false when the max blocking time was reached.
+     */
+    bool send_change(
+            CacheChange_t* change,
+            const std::chrono::time_point<std::chrono::steady_clock>& max_blocking_time);
+
     void send_all_unsent_changes();
 
     void send_unsent_changes_with_flow_control();
@@ -165,6 +186,8 @@ private:
     ResourceLimitedVector<ReaderLocator> matched_readers_;
     ResourceLimitedVector<ChangeForReader_t, std::true_type> unsent_changes_;
     std::vector<std::unique_ptr<FlowController> > flow_controllers_;
+    //! Changes collected on each flow-controlled send, kept to avoid allocations
+    std::unique_ptr<RTPSWriterCollector<ReaderLocator*> > flow_controlled_changes_;
     uint64_t last_intraprocess_sequence_number_;
     bool there_are_remote_readers_ = false;
 };
@@ -22,10 +22,27 @@
 
 #include <fastdds/rtps/common/CacheChange.h>
 #include <chrono>
+#include <vector>
 
 namespace eprosima{
 namespace fastrtps{
 
+/**
+ * @brief Full sample of an instance, used as reference by delta encoded samples
+ * @ingroup FASTRTPS_MODULE
+ */
+struct DeltaKeyframe
+{
+    //! Identifier of the full sample, chosen by the writer
+    uint32_t id = 0;
+    //! Number of samples written since the full sample (only used by writers)
+    uint32_t samples_since = 0;
+    //! Sequence number of the sample carrying the full sample (only used by readers)
+    rtps::SequenceNumber_t sequence_number;
+    //! The full serialized sample
+    std::vector<rtps::octet> data;
+};
+
 /**
  * @brief A struct storing a vector of cache changes and the next deadline in the group
  * @ingroup FASTRTPS_MODULE
@@ -28,6 +28,9 @@
 #include <fastrtps/common/KeyedChanges.h>
 #include <fastrtps/attributes/TopicAttributes.h>
 
+#include <map>
+#include <vector>
+
 namespace eprosima {
 namespace fastrtps {
 
@@ -108,6 +111,29 @@ public:
             rtps::InstanceHandle_t& handle,
             std::chrono::steady_clock::time_point& next_deadline_us);
 
+    /**
+     * @brief Enables delta encoding of the samples of each instance
+     * @param keyframe_period Number of samples of an instance between full samples. 0 disables delta encoding.
+     * @param durability Durability of the writer. Only VOLATILE writers delta encode, as late joiners could
+     * otherwise receive deltas of full samples already removed from the history.
+     */
+    void enable_delta_encoding(
+            uint32_t keyframe_period,
+            DurabilityQosPolicyKind durability);
+
+    /**
+     * @brief Delta encodes the serialized payload of a change, before it is added to the history
+     * @param change The change to encode
+     * @return True if the payload was replaced by a delta against the last full sample of the instance
+     */
+    bool encode_delta(
+            rtps::CacheChange_t* change);
+
+    /**
+     * @brief Forces the next sample of every instance to be sent in full, e.g. when a new reader is matched
+     */
+    void request_keyframes();
+
 private:
 
     typedef std::map<rtps::InstanceHandle_t, KeyedChanges> t_m_Inst_Caches;
@@ -122,6 +148,14 @@ private:
     ResourceLimitsQosPolicy resource_limited_qos_;
     //!Topic Attributes
     TopicAttributes topic_att_;
+    //!Number of samples between full samples of an instance (0 when delta encoding is disabled)
+    uint32_t keyframe_period_;
+    //!Last full sample sent of each instance, when delta encoding is used
+    std::map<rtps::InstanceHandle_t, DeltaKeyframe> keyframes_;
+    //!Highest identifier given to a keyframe
+    uint32_t last_keyframe_id_;
+    //!Scratch buffer used when delta encoding
+    std::vector<rtps::octet> delta_buffer_;
 
     /**
      * @brief Method that finds a key in m_keyedChanges or tries to add it if not found
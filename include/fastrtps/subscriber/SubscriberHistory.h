@@ -23,6 +23,7 @@
 
 #include <fastdds/dds/topic/TopicDataType.hpp>
 #include <fastdds/rtps/resources/ResourceManagement.h>
+#include <fastdds/rtps/compression/PayloadCompressor.hpp>
 #include <fastrtps/qos/ReaderQos.h>
 #include <fastdds/rtps/history/ReaderHistory.h>
 #include <fastrtps/qos/QosPolicies.h>
@@ -32,6 +33,10 @@
 
 #include <chrono>
 #include <functional>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace eprosima {
 namespace fastrtps {
@@ -209,6 +214,78 @@ private:
             uint32_t ownership_strength,
             void* data,
             SampleInfo_t* info);
+
+    /**
+     * Deserialize the payload of a change, decompressing and rebuilding it from its keyframe first if needed.
+     * @param change Change whose payload is deserialized.
+     * @param data Pointer to the object where the payload is deserialized.
+     * @return true if the payload has been deserialized.
+     */
+    bool deserialize_payload(
+            rtps::CacheChange_t* change,
+            void* data);
+
+    /**
+     * Get the payload of a change, decompressing it if needed.
+     * @param change Change whose payload is returned.
+     * @return Pointer to the uncompressed payload, or nullptr if it could not be decompressed.
+     */
+    rtps::SerializedPayload_t* plain_payload(
+            rtps::CacheChange_t* change);
+
+    /**
+     * Keep the full sample of a change on the history, if it is a keyframe of a delta encoding writer.
+     * @param change Change on the instance of a keyed topic. Keyframes of the instance are forgotten when it is
+     * not ALIVE.
+     */
+    void store_keyframe(
+            rtps::CacheChange_t* change);
+
+    /**
+     * Keep the full sample of an encoded keyframe.
+     * @param change Change carrying the keyframe.
+     * @param payload Uncompressed payload of the change.
+     * @return Pointer to the kept keyframe, or nullptr if the payload is not a keyframe.
+     */
+    DeltaKeyframe* keep_keyframe(
+            const rtps::CacheChange_t* change,
+            const rtps::SerializedPayload_t& payload);
+
+    /**
+     * Find the keyframe a delta encoded change refers to.
+     * Keyframes that were fragmented are looked for on the samples of the instance.
+     * @param change Delta encoded change.
+     * @param keyframe_id Identifier of the keyframe.
+     * @return Pointer to the keyframe, or nullptr if it has not been received.
+     */
+    DeltaKeyframe* find_keyframe(
+            rtps::CacheChange_t* change,
+            uint32_t keyframe_id);
+
+    /**
+     * Forget the keyframes of a writer no sample on the instance refers to.
+     * @param handle Instance of the keyframes.
+     * @param writer_guid Writer of the keyframes.
+     * @param keep_latest Whether the last keyframe should be kept for the next deltas.
+     */
+    void remove_unused_keyframes(
+            const rtps::InstanceHandle_t& handle,
+            const rtps::GUID_t& writer_guid,
+            bool keep_latest);
+
+    using t_m_Keyframes = std::map<std::pair<rtps::InstanceHandle_t, rtps::GUID_t>, std::vector<DeltaKeyframe>>;
+
+    //! Keyframes of each instance and writer, ordered by sequence number, when delta encoding is used
+    t_m_Keyframes keyframes_;
+
+    //! Buffer where compressed payloads are decompressed before deserialization
+    rtps::SerializedPayload_t decompressed_payload_;
+
+    //! Codec of the last compressed payload, kept to avoid looking it up on every sample
+    std::shared_ptr<fastdds::rtps::PayloadCompressor> decompressor_;
+
+    //! Buffer where delta encoded payloads are rebuilt before deserialization
+    rtps::SerializedPayload_t delta_payload_;
 };
 
 } // namespace fastrtps
@@ -31,6 +31,15 @@ using namespace eprosima::fastrtps::types;
 
 void register_builtin_annotations_types(TypeObjectFactory* factory);
 
+//! Number of builtin annotation types that can be registered one by one.
+size_t builtin_annotations_types_count();
+
+//! Index of the builtin annotation type with the given name, or builtin_annotations_types_count() if there is none.
+size_t find_builtin_annotation_type(const std::string& type_name);
+
+//! Registers both the minimal and the complete TypeObject of the builtin annotation type with the given index.
+void register_builtin_annotation_type(TypeObjectFactory* factory, size_t index);
+
 const TypeIdentifier* GetidIdentifier(bool complete = false);
 const TypeObject* GetidObject(bool complete = false);
 const TypeObject* GetMinimalidObject();
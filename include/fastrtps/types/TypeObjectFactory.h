@@ -19,7 +19,13 @@
 #include <fastrtps/types/DynamicTypeBuilder.h>
 #include <fastrtps/types/DynamicTypeBuilderPtr.h>
 #include <fastrtps/types/DynamicTypePtr.h>
+#include <fastrtps/config.h>
+#include <atomic>
 #include <mutex>
+#if HAVE_CXX14
+#include <shared_mutex>
+#endif // if HAVE_CXX14
+#include <unordered_map>
 
 namespace eprosima {
 namespace fastrtps {
@@ -31,6 +37,15 @@ private:
     mutable std::recursive_mutex m_MutexIdentifiers;
     mutable std::recursive_mutex m_MutexObjects;
     mutable std::recursive_mutex m_MutexInformations;
+    mutable std::recursive_mutex m_MutexBuiltinAnnotations;
+
+#if HAVE_CXX14
+    using IndexMutex = std::shared_timed_mutex;
+#else
+    using IndexMutex = std::mutex;
+#endif // if HAVE_CXX14
+    //! Taken for reading on the lookups by name, and for writing along with m_MutexIdentifiers when storing.
+    mutable IndexMutex m_MutexIndex;
 
 protected:
     TypeObjectFactory();
@@ -42,6 +57,11 @@ protected:
     mutable std::map<const TypeIdentifier*, TypeInformation*> informations_;
     mutable std::vector<TypeInformation*> informations_created_;
     std::map<std::string, std::string> aliases_; // Aliases
+    std::unordered_map<std::string, const TypeIdentifier*> identifiers_index_; // Name lookups on identifiers_
+    std::unordered_map<std::string, const TypeIdentifier*> complete_identifiers_index_; // Same on complete_identifiers_
+    std::vector<TypeIdentifier> primitive_identifiers_; // Basic TypeIdentifiers, never resized
+    mutable std::vector<uint8_t> builtin_annotations_state_; // Registration of each builtin annotation type
+    mutable std::atomic<bool> builtin_annotations_registered_;
 
     DynamicType_ptr build_dynamic_type(
             TypeDescriptor& descriptor,
@@ -60,7 +80,32 @@ protected:
     void nullify_all_entries(
             const TypeIdentifier* identifier);
 
-    void create_builtin_annotations();
+    /**
+     * @brief Registers the builtin annotation types that weren't registered yet.
+     * Called before any lookup by TypeIdentifier, as those may refer to any of them.
+     */
+    void create_builtin_annotations() const;
+
+    /**
+     * @brief Registers the builtin annotation type with the given name, if it is one and it wasn't registered yet.
+     * @param type_name
+     * @return true if the type was registered by this call or a concurrent one, so the lookup is worth repeating.
+     */
+    bool create_builtin_annotation(
+            const std::string& type_name) const;
+
+    const TypeIdentifier* find_type_identifier(
+            const std::string& type_name,
+            bool complete) const;
+
+    //! Must be called with m_MutexIdentifiers taken.
+    void store_type_identifier(
+            const std::string& type_name,
+            const TypeIdentifier* identifier,
+            bool complete);
+
+    const TypeObject* find_type_object(
+            const TypeIdentifier* identifier) const;
 
     void apply_type_annotations(
             DynamicTypeBuilder_ptr& type_builder,
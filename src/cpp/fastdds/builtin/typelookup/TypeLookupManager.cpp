@@ -32,6 +32,7 @@
 #include <fastdds/rtps/attributes/HistoryAttributes.h>
 #include <fastdds/rtps/attributes/WriterAttributes.h>
 #include <fastdds/rtps/attributes/ReaderAttributes.h>
+#include <fastdds/rtps/attributes/PropertyPolicy.h>
 #include <fastdds/dds/topic/TypeSupport.hpp>
 // TODO Uncomment if security is implemented.
 //#include <fastdds/rtps/common/Guid.h>
@@ -39,6 +40,7 @@
 
 #include <fastdds/dds/log/Log.hpp>
 
+#include <fastdds/builtin/typelookup/TypeObjectCache.hpp>
 #include <rtps/participant/RTPSParticipantImpl.h>
 
 #include <algorithm>
@@ -68,6 +70,7 @@ TypeLookupManager::TypeLookupManager(
     , builtin_reply_reader_history_(nullptr)
     , request_listener_(nullptr)
     , reply_listener_(nullptr)
+    , type_cache_(nullptr)
     , temp_reader_proxy_data_(
           prot->mp_participantImpl->getRTPSParticipantAttributes().allocation.locators.max_unicast_locators,
           prot->mp_participantImpl->getRTPSParticipantAttributes().allocation.locators.max_multicast_locators)
@@ -126,6 +129,7 @@ TypeLookupManager::~TypeLookupManager()
 
     delete reply_listener_;
     delete request_listener_;
+    delete type_cache_;
 }
 
 bool TypeLookupManager::init_typelookup_service(
@@ -133,6 +137,16 @@ bool TypeLookupManager::init_typelookup_service(
 {
     logInfo(TYPELOOKUP_SERVICE, "Initializing TypeLookup Service");
     participant_ = participant;
+
+    // Types already resolved on previous runs don't need a round trip
+    const std::string* cache_file = PropertyPolicyHelper::find_property(
+        participant_->getRTPSParticipantAttributes().properties, TYPE_OBJECT_CACHE_PROPERTY);
+    if (cache_file != nullptr && !cache_file->empty())
+    {
+        type_cache_ = new TypeObjectCache(*cache_file);
+        type_cache_->load(fastrtps::types::TypeObjectFactory::get_instance());
+    }
+
     bool retVal = create_endpoints();
 /*
 #if HAVE_SECURITY
@@ -696,6 +710,22 @@ const fastrtps::rtps::GUID_t& TypeLookupManager::get_builtin_request_writer_guid
     return c_Guid_Unknown;
 }
 
+bool TypeLookupManager::is_type_cached(
+        const fastrtps::types::TypeIdentifier& identifier) const
+{
+    return type_cache_ != nullptr && type_cache_->contains(identifier);
+}
+
+void TypeLookupManager::cache_type(
+        const fastrtps::types::TypeIdentifier& identifier,
+        const fastrtps::types::TypeObject& object)
+{
+    if (type_cache_ != nullptr)
+    {
+        type_cache_->store(identifier, object);
+    }
+}
+
 } // namespace builtin
 } // namespace dds
 } // namespace fastdds
@@ -85,6 +85,8 @@ void TypeLookupReplyListener::onNewCacheChangeAdded(
                 {
                     if (pair.type_object()._d() == EK_COMPLETE) // Just in case
                     {
+                        tlm_->cache_type(pair.type_identifier(), pair.type_object());
+
                         // If build_dynamic_type failed, just sent the nullptr already contained on it.
                         tlm_->participant_->getListener()->on_type_discovery(
                             tlm_->participant_->getUserRTPSParticipant(),
@@ -0,0 +1,476 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TypeObjectCache.cpp
+ */
+
+#include <fastdds/builtin/typelookup/TypeObjectCache.hpp>
+
+#include <fastdds/dds/log/Log.hpp>
+
+#include <fastcdr/Cdr.h>
+#include <fastcdr/FastBuffer.h>
+#include <fastcdr/exceptions/Exception.h>
+
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // ifdef _WIN32
+
+namespace eprosima {
+namespace fastdds {
+namespace dds {
+namespace builtin {
+
+using namespace fastrtps::types;
+
+/*
+ * File layout, all the integers in little endian:
+ *   header: "FDTC" uint32(version)
+ *   record: uint32(identifier size) uint32(object size) CDR(TypeIdentifier) CDR(TypeObject)
+ */
+static const char s_magic[4] = {'F', 'D', 'T', 'C'};
+static const uint32_t s_version = 1;
+static const size_t s_header_size = 8;
+static const size_t s_record_header_size = 8;
+
+static uint32_t read_uint32(
+        const char* data)
+{
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+           (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+static void write_uint32(
+        std::vector<char>& buffer,
+        uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+template<typename T>
+static bool serialize(
+        const T& value,
+        std::vector<char>& buffer)
+{
+    buffer.resize(T::getCdrSerializedSize(value));
+    fastcdr::FastBuffer fastbuffer(buffer.data(), buffer.size());
+    fastcdr::Cdr ser(fastbuffer, fastcdr::Cdr::LITTLE_ENDIANNESS, fastcdr::Cdr::DDS_CDR);
+    try
+    {
+        value.serialize(ser);
+    }
+    catch (fastcdr::exception::Exception&)
+    {
+        return false;
+    }
+
+    buffer.resize(ser.getSerializedDataLength());
+    return true;
+}
+
+template<typename T>
+static bool deserialize(
+        const char* data,
+        size_t size,
+        T& value)
+{
+    // Deserializing only reads the buffer, so the read-only mapping can be used
+    fastcdr::FastBuffer fastbuffer(const_cast<char*>(data), size);
+    fastcdr::Cdr deser(fastbuffer, fastcdr::Cdr::LITTLE_ENDIANNESS, fastcdr::Cdr::DDS_CDR);
+    try
+    {
+        value.deserialize(deser);
+    }
+    catch (fastcdr::exception::Exception&)
+    {
+        return false;
+    }
+    return deser.getSerializedDataLength() == size;
+}
+
+//! Name of a complete TypeObject, or an empty string for the anonymous ones (collections).
+static std::string type_name(
+        const TypeObject& object)
+{
+    const CompleteTypeObject& complete = object.complete();
+    switch (complete._d())
+    {
+        case TK_ALIAS:
+            return complete.alias_type().header().detail().type_name();
+        case TK_ANNOTATION:
+            return complete.annotation_type().header().annotation_name();
+        case TK_STRUCTURE:
+            return complete.struct_type().header().detail().type_name();
+        case TK_UNION:
+            return complete.union_type().header().detail().type_name();
+        case TK_BITSET:
+            return complete.bitset_type().header().detail().type_name();
+        case TK_ENUM:
+            return complete.enumerated_type().header().detail().type_name();
+        case TK_BITMASK:
+            return complete.bitmask_type().header().detail().type_name();
+        default:
+            return std::string();
+    }
+}
+
+//! Read-only mapping of a whole file. data() is nullptr if the file doesn't exist or is empty.
+class MappedFile
+{
+public:
+
+    explicit MappedFile(
+            const std::string& filename)
+    {
+#ifdef _WIN32
+        file_ = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE)
+        {
+            return;
+        }
+        // Shared with other readers, but not with an appender halfway through a record
+        OVERLAPPED whole_file = {};
+        locked_ = LockFileEx(file_, 0, 0, MAXDWORD, MAXDWORD, &whole_file) != 0;
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file_, &file_size) || file_size.QuadPart == 0)
+        {
+            return;
+        }
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_ != nullptr)
+        {
+            const void* view = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+            if (view != nullptr)
+            {
+                data_ = static_cast<const char*>(view);
+                size_ = static_cast<size_t>(file_size.QuadPart);
+            }
+        }
+#else
+        fd_ = open(filename.c_str(), O_RDONLY);
+        if (fd_ < 0)
+        {
+            return;
+        }
+        // Shared with other readers, but not with an appender halfway through a record
+        flock(fd_, LOCK_SH);
+        struct stat file_stat;
+        if (fstat(fd_, &file_stat) != 0 || file_stat.st_size == 0)
+        {
+            return;
+        }
+        void* view = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (view != MAP_FAILED)
+        {
+            data_ = static_cast<const char*>(view);
+            size_ = static_cast<size_t>(file_stat.st_size);
+        }
+#endif // ifdef _WIN32
+    }
+
+    ~MappedFile()
+    {
+#ifdef _WIN32
+        if (data_ != nullptr)
+        {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_ != nullptr)
+        {
+            CloseHandle(mapping_);
+        }
+        if (locked_)
+        {
+            OVERLAPPED whole_file = {};
+            UnlockFileEx(file_, 0, MAXDWORD, MAXDWORD, &whole_file);
+        }
+        if (file_ != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(file_);
+        }
+#else
+        if (data_ != nullptr)
+        {
+            munmap(const_cast<char*>(data_), size_);
+        }
+        if (fd_ >= 0)
+        {
+            // Closing the descriptor also releases the lock
+            close(fd_);
+        }
+#endif // ifdef _WIN32
+    }
+
+    const char* data() const
+    {
+        return data_;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+private:
+
+    MappedFile(
+            const MappedFile&) = delete;
+
+    MappedFile& operator =(
+            const MappedFile&) = delete;
+
+    const char* data_ = nullptr;
+
+    size_t size_ = 0;
+
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+    bool locked_ = false;
+#else
+    int fd_ = -1;
+#endif // ifdef _WIN32
+};
+
+/**
+ * Appends a buffer to a file while holding an exclusive lock on it, so records of several processes sharing the file
+ * never interleave and readers never see half of one.
+ * @param header Written before the buffer when the file is empty.
+ */
+static bool append_locked(
+        const std::string& filename,
+        const std::vector<char>& header,
+        const std::vector<char>& buffer)
+{
+    bool ret = false;
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                    OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    OVERLAPPED whole_file = {};
+    if (LockFileEx(file, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &whole_file))
+    {
+        LARGE_INTEGER file_size;
+        DWORD written = 0;
+        ret = GetFileSizeEx(file, &file_size) != 0;
+        if (ret && file_size.QuadPart == 0)
+        {
+            ret = WriteFile(file, header.data(), static_cast<DWORD>(header.size()), &written, nullptr) &&
+                    written == header.size();
+        }
+        if (ret)
+        {
+            ret = WriteFile(file, buffer.data(), static_cast<DWORD>(buffer.size()), &written, nullptr) &&
+                    written == buffer.size();
+        }
+        UnlockFileEx(file, 0, MAXDWORD, MAXDWORD, &whole_file);
+    }
+    CloseHandle(file);
+#else
+    int fd = open(filename.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if (flock(fd, LOCK_EX) == 0)
+    {
+        struct stat file_stat;
+        ret = fstat(fd, &file_stat) == 0;
+        if (ret && file_stat.st_size == 0)
+        {
+            ret = write(fd, header.data(), header.size()) == static_cast<ssize_t>(header.size());
+        }
+        if (ret)
+        {
+            ret = write(fd, buffer.data(), buffer.size()) == static_cast<ssize_t>(buffer.size());
+        }
+    }
+    // Closing the descriptor also releases the lock
+    close(fd);
+#endif // ifdef _WIN32
+    return ret;
+}
+
+TypeObjectCache::TypeObjectCache(
+        const std::string& filename)
+    : filename_(filename)
+    , writable_(true)
+{
+}
+
+std::string TypeObjectCache::key(
+        const TypeIdentifier& identifier)
+{
+    if (identifier._d() != EK_COMPLETE)
+    {
+        return std::string();
+    }
+
+    static const char hex[] = "0123456789abcdef";
+    std::string result;
+    const octet* hash = identifier.equivalence_hash();
+    for (size_t i = 0; i < 14; ++i)
+    {
+        result.push_back(hex[hash[i] >> 4]);
+        result.push_back(hex[hash[i] & 0x0F]);
+    }
+    return result;
+}
+
+size_t TypeObjectCache::load(
+        TypeObjectFactory* factory)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    size_t loaded = 0;
+
+    MappedFile file(filename_);
+    const char* data = file.data();
+    if (data == nullptr)
+    {
+        return 0;
+    }
+
+    size_t file_size = file.size();
+    if (file_size < s_header_size || memcmp(data, s_magic, sizeof(s_magic)) != 0 ||
+            read_uint32(data + sizeof(s_magic)) != s_version)
+    {
+        // Records appended to it could not be read back either
+        logWarning(TYPELOOKUP_CACHE, "Ignoring " << filename_ << ", it isn't a TypeObject cache of this version");
+        writable_ = false;
+        return 0;
+    }
+
+    size_t pos = s_header_size;
+    while (file_size - pos >= s_record_header_size)
+    {
+        size_t identifier_size = read_uint32(data + pos);
+        size_t object_size = read_uint32(data + pos + 4);
+        size_t available = file_size - pos - s_record_header_size;
+        if (identifier_size > available || object_size > available - identifier_size)
+        {
+            break;
+        }
+
+        const char* record = data + pos + s_record_header_size;
+        TypeIdentifier identifier;
+        TypeObject object;
+        if (!deserialize(record, identifier_size, identifier) ||
+                !deserialize(record + identifier_size, object_size, object))
+        {
+            break;
+        }
+
+        std::string type_key = key(identifier);
+        std::string name = object._d() == EK_COMPLETE ? type_name(object) : std::string();
+        if (type_key.empty() || name.empty())
+        {
+            break;
+        }
+
+        if (keys_.insert(type_key).second)
+        {
+            factory->add_type_object(name, &identifier, &object);
+            loaded_keys_.insert(type_key);
+            ++loaded;
+        }
+        pos += s_record_header_size + identifier_size + object_size;
+    }
+
+    if (pos < file_size)
+    {
+        // Records appended after the broken one would never be read, and the file may be shared with other
+        // processes, so it is neither repaired nor written anymore
+        logWarning(TYPELOOKUP_CACHE, "Ignoring " << (file_size - pos) << " bytes at the end of " << filename_
+                                                 << ", no more types will be stored on it");
+        writable_ = false;
+    }
+
+    logInfo(TYPELOOKUP_CACHE, "Loaded " << loaded << " types from " << filename_);
+    return loaded;
+}
+
+bool TypeObjectCache::store(
+        const TypeIdentifier& identifier,
+        const TypeObject& object)
+{
+    std::string type_key = key(identifier);
+    if (type_key.empty() || object._d() != EK_COMPLETE || type_name(object).empty())
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (!writable_ || keys_.find(type_key) != keys_.end())
+    {
+        return false;
+    }
+
+    std::vector<char> identifier_data;
+    std::vector<char> object_data;
+    if (!serialize(identifier, identifier_data) || !serialize(object, object_data))
+    {
+        logWarning(TYPELOOKUP_CACHE, "Cannot serialize type " << type_key);
+        return false;
+    }
+
+    std::vector<char> record;
+    write_uint32(record, static_cast<uint32_t>(identifier_data.size()));
+    write_uint32(record, static_cast<uint32_t>(object_data.size()));
+    record.insert(record.end(), identifier_data.begin(), identifier_data.end());
+    record.insert(record.end(), object_data.begin(), object_data.end());
+
+    std::vector<char> header(s_magic, s_magic + sizeof(s_magic));
+    write_uint32(header, s_version);
+    if (!append_locked(filename_, header, record))
+    {
+        logWarning(TYPELOOKUP_CACHE, "Cannot write on " << filename_);
+        return false;
+    }
+
+    keys_.insert(type_key);
+    return true;
+}
+
+bool TypeObjectCache::contains(
+        const TypeIdentifier& identifier) const
+{
+    std::string type_key = key(identifier);
+    std::lock_guard<std::mutex> guard(mutex_);
+    return !type_key.empty() && loaded_keys_.find(type_key) != loaded_keys_.end();
+}
+
+} // namespace builtin
+} // namespace dds
+} // namespace fastdds
+} // namespace eprosima
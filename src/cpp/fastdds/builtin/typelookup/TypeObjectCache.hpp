@@ -0,0 +1,114 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TypeObjectCache.hpp
+ */
+
+#ifndef _FASTDDS_TYPELOOKUP_TYPE_OBJECT_CACHE_HPP
+#define _FASTDDS_TYPELOOKUP_TYPE_OBJECT_CACHE_HPP
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <fastrtps/types/TypeObject.h>
+#include <fastrtps/types/TypeObjectFactory.h>
+
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace eprosima {
+namespace fastdds {
+namespace dds {
+namespace builtin {
+
+//! Participant property with the path of the file where the TypeObjects received by TypeLookup are kept.
+const char* const TYPE_OBJECT_CACHE_PROPERTY = "fastdds.typelookup.cache_file";
+
+/**
+ * Cache of the TypeObjects received through the TypeLookup Service, kept on a file so they survive the process.
+ *
+ * Entries are addressed by the equivalence hash of their TypeIdentifier, which already is a hash of the TypeObject,
+ * so an entry never becomes stale and several participants may share the same file. A type stored twice is only
+ * loaded once.
+ * Only complete TypeObjects of named types are kept, and they are registered under their own name.
+ * The file only grows by appending records under an exclusive file lock, and it is read through a memory mapping.
+ */
+class TypeObjectCache
+{
+public:
+
+    /**
+     * @param filename Path of the cache file. It is created on the first store().
+     */
+    explicit TypeObjectCache(
+            const std::string& filename);
+
+    /**
+     * Registers on the factory all the types found on the file, under their own name.
+     * A truncated or corrupted tail, as left by a process that died while writing, is ignored and the file is not
+     * written anymore.
+     * @param factory Factory where the types are added.
+     * @return Number of types added.
+     */
+    size_t load(
+            fastrtps::types::TypeObjectFactory* factory);
+
+    /**
+     * Appends a type to the file, unless it is already there.
+     * @param identifier TypeIdentifier of the type. Only EK_COMPLETE ones are kept.
+     * @param object Complete TypeObject of a named type.
+     * @return true if the type was appended.
+     */
+    bool store(
+            const fastrtps::types::TypeIdentifier& identifier,
+            const fastrtps::types::TypeObject& object);
+
+    /**
+     * @return Whether the type was loaded from the file, so it is known without asking the TypeLookup Service.
+     */
+    bool contains(
+            const fastrtps::types::TypeIdentifier& identifier) const;
+
+    const std::string& filename() const
+    {
+        return filename_;
+    }
+
+private:
+
+    //! Hexadecimal equivalence hash, or an empty string for the identifiers that cannot be cached.
+    static std::string key(
+            const fastrtps::types::TypeIdentifier& identifier);
+
+    std::string filename_;
+
+    //! False when the file exists but isn't a cache, so it is left untouched.
+    bool writable_;
+
+    mutable std::mutex mutex_;
+
+    //! Keys of the types on the file.
+    std::set<std::string> keys_;
+
+    //! Keys of the types registered by load().
+    std::set<std::string> loaded_keys_;
+};
+
+} // namespace builtin
+} // namespace dds
+} // namespace fastdds
+} // namespace eprosima
+
+#endif // ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+#endif // _FASTDDS_TYPELOOKUP_TYPE_OBJECT_CACHE_HPP
@@ -1009,7 +1009,17 @@ ReturnCode_t DomainParticipantImpl::register_remote_type(
         if (nullptr != dyn)
         {
             //callback(type_name, dyn); // If the type is already registered, don't call the callback.
-            return register_dynamic_type(dyn);
+            ReturnCode_t ret = register_dynamic_type(dyn);
+
+            // A type resolved on a previous run is only known because of the TypeObject cache, so the user still
+            // expects the callback that would have followed the TypeLookup replies.
+            builtin::TypeLookupManager* tlm = rtps_participant_->typelookup_manager();
+            if (ReturnCode_t::RETCODE_OK == ret && nullptr != tlm &&
+                    tlm->is_type_cached(type_information.complete().typeid_with_size().type_id()))
+            {
+                callback(type_name, dyn);
+            }
+            return ret;
         }
     }
     else if (rtps_participant_->typelookup_manager() != nullptr)
@@ -36,6 +36,8 @@
 #include <fastdds/rtps/resources/ResourceEvent.h>
 #include <fastdds/rtps/resources/TimedEvent.h>
 #include <fastdds/rtps/builtin/liveliness/WLP.h>
+#include <rtps/compression/PayloadCompression.hpp>
+#include <rtps/compression/PayloadDelta.hpp>
 
 #include <functional>
 #include <iostream>
@@ -144,6 +146,10 @@ DataWriterImpl::DataWriterImpl(
         w_att.keep_duration = qos.reliable_writer_qos().disable_positive_acks.duration;
     }
 
+    compressor_ = fastdds::rtps::PayloadCompression::writer_compressor(qos_.representation(), qos.properties());
+    history_.enable_delta_encoding(fastdds::rtps::PayloadDelta::keyframe_period(qos.properties()),
+            qos.durability().kind);
+
     RTPSWriter* writer = RTPSDomain::createRTPSWriter(
         publisher_->rtps_participant(),
         w_att,
@@ -300,6 +306,12 @@ bool DataWriterImpl::perform_create_new_change(
     std::unique_lock<RecursiveTimedMutex> lock(writer_->getMutex());
 #endif
     {
+        if (can_send_without_history(change_kind) &&
+                send_without_history(data, wparams, handle, max_blocking_time))
+        {
+            return true;
+        }
+
         CacheChange_t* ch = writer_->new_change(type_->getSerializedSizeProvider(data), change_kind, handle);
         if (ch != nullptr)
         {
@@ -314,42 +326,14 @@ bool DataWriterImpl::perform_create_new_change(
                 }
             }
 
-            //TODO(Ricardo) This logic in a class. Then a user of rtps layer can use it.
-            if (high_mark_for_frag_ == 0)
-            {
-                RTPSParticipant* part = publisher_->rtps_participant();
-                uint32_t max_data_size = writer_->getMaxDataSize();
-                uint32_t writer_throughput_controller_bytes =
-                        writer_->calculateMaxDataSize(qos_.throughput_controller().bytesPerPeriod);
-                uint32_t participant_throughput_controller_bytes =
-                        writer_->calculateMaxDataSize(
-                    part->getRTPSParticipantAttributes().throughputController.bytesPerPeriod);
-
-                high_mark_for_frag_ =
-                        max_data_size > writer_throughput_controller_bytes ?
-                        writer_throughput_controller_bytes :
-                        (max_data_size > participant_throughput_controller_bytes ?
-                        participant_throughput_controller_bytes :
-                        max_data_size);
-                high_mark_for_frag_ &= ~3;
-            }
-
-            uint32_t final_high_mark_for_frag = high_mark_for_frag_;
+            history_.encode_delta(ch);
 
-            // If needed inlineqos for related_sample_identity, then remove the inlinqos size from final fragment size.
-            if (wparams.related_sample_identity() != SampleIdentity::unknown())
+            if (compressor_ && change_kind == ALIVE)
             {
-                final_high_mark_for_frag -= 32;
+                fastdds::rtps::PayloadCompression::compress(*compressor_, ch->serializedPayload, compression_buffer_);
             }
 
-            // If it is big data, fragment it.
-            if (ch->serializedPayload.length > final_high_mark_for_frag)
-            {
-                // Fragment the data.
-                // Set the fragment size to the cachechange.
-                ch->setFragmentSize(static_cast<uint16_t>(
-                            (std::min)(final_high_mark_for_frag, RTPSMessageGroup::get_max_fragment_payload_size())));
-            }
+            set_fragment_size(ch, wparams);
 
             if (!this->history_.add_pub_change(ch, wparams, lock, max_blocking_time))
             {
@@ -393,6 +377,100 @@ bool DataWriterImpl::perform_create_new_change(
     return false;
 }
 
+bool DataWriterImpl::can_send_without_history(
+        ChangeKind_t change_kind) const
+{
+    // Only samples no reader will ask for again, and that no history bookkeeping (instances, deadline,
+    // lifespan) refers to, can skip the history. The RTPS writer is checked too, so a sample is never serialized
+    // for a writer that would refuse it.
+    return change_kind == ALIVE &&
+           !writer_->isAsync() &&
+           writer_->getAttributes().reliabilityKind == BEST_EFFORT &&
+           !type_->m_isGetKeyDefined &&
+           qos_.reliability().kind == BEST_EFFORT_RELIABILITY_QOS &&
+           qos_.durability().kind == VOLATILE_DURABILITY_QOS &&
+           qos_.history().kind == KEEP_LAST_HISTORY_QOS &&
+           qos_.history().depth == 1 &&
+           qos_.publish_mode().kind == SYNCHRONOUS_PUBLISH_MODE &&
+           qos_.deadline().period == c_TimeInfinite &&
+           qos_.lifespan().duration == c_TimeInfinite;
+}
+
+bool DataWriterImpl::send_without_history(
+        void* data,
+        WriteParams& wparams,
+        const InstanceHandle_t& handle,
+        const std::chrono::time_point<std::chrono::steady_clock>& max_blocking_time)
+{
+    CacheChange_t* ch = &volatile_change_;
+    ch->serializedPayload.reserve(type_->getSerializedSizeProvider(data)());
+    ch->kind = ALIVE;
+    ch->instanceHandle = handle;
+
+    if (!type_->serialize(data, &ch->serializedPayload))
+    {
+        logWarning(RTPS_WRITER, "RTPSWriter:Serialization returns false"; );
+        return false;
+    }
+
+    history_.encode_delta(ch);
+
+    if (compressor_)
+    {
+        fastdds::rtps::PayloadCompression::compress(*compressor_, ch->serializedPayload, compression_buffer_);
+    }
+
+    set_fragment_size(ch, wparams);
+
+    return history_.send_change_without_history(ch, wparams, max_blocking_time);
+}
+
+void DataWriterImpl::set_fragment_size(
+        CacheChange_t* ch,
+        const WriteParams& wparams)
+{
+    //TODO(Ricardo) This logic in a class. Then a user of rtps layer can use it.
+    if (high_mark_for_frag_ == 0)
+    {
+        RTPSParticipant* part = publisher_->rtps_participant();
+        uint32_t max_data_size = writer_->getMaxDataSize();
+        uint32_t writer_throughput_controller_bytes =
+                writer_->calculateMaxDataSize(qos_.throughput_controller().bytesPerPeriod);
+        uint32_t participant_throughput_controller_bytes =
+                writer_->calculateMaxDataSize(
+            part->getRTPSParticipantAttributes().throughputController.bytesPerPeriod);
+
+        high_mark_for_frag_ =
+                max_data_size > writer_throughput_controller_bytes ?
+                writer_throughput_controller_bytes :
+                (max_data_size > participant_throughput_controller_bytes ?
+                participant_throughput_controller_bytes :
+                max_data_size);
+        high_mark_for_frag_ &= ~3;
+    }
+
+    uint32_t final_high_mark_for_frag = high_mark_for_frag_;
+
+    // If needed inlineqos for related_sample_identity, then remove the inlinqos size from final fragment size.
+    if (wparams.related_sample_identity() != SampleIdentity::unknown())
+    {
+        final_high_mark_for_frag -= 32;
+    }
+
+    // If it is big data, fragment it.
+    if (ch->serializedPayload.length > final_high_mark_for_frag)
+    {
+        // Fragment the data.
+        // Set the fragment size to the cachechange.
+        ch->setFragmentSize(static_cast<uint16_t>(
+                    (std::min)(final_high_mark_for_frag, RTPSMessageGroup::get_max_fragment_payload_size())));
+    }
+    else
+    {
+        ch->setFragmentSize(0);
+    }
+}
+
 bool DataWriterImpl::create_new_change_with_params(
         ChangeKind_t changeKind,
         void* data,
@@ -548,6 +626,12 @@ void DataWriterImpl::InnerDataWriterListener::onWriterMatched(
         RTPSWriter* /*writer*/,
         const PublicationMatchedStatus& info)
 {
+    if (info.current_count_change > 0)
+    {
+        // New readers need a full sample of each instance before being able to decode deltas
+        data_writer_->history_.request_keyframes();
+    }
+
     if (data_writer_->listener_ != nullptr)
     {
         data_writer_->listener_->on_publication_matched(
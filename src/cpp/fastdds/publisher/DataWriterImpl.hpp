@@ -22,6 +22,7 @@
 #include <fastdds/rtps/common/Locator.h>
 #include <fastdds/rtps/common/Guid.h>
 #include <fastdds/rtps/common/WriteParams.h>
+#include <fastdds/rtps/compression/PayloadCompressor.hpp>
 
 #include <fastdds/dds/publisher/qos/DataWriterQos.hpp>
 
@@ -240,6 +241,15 @@ public:
 
     uint32_t high_mark_for_frag_;
 
+    //! Codec used to compress the payloads (only with the compressed data representation)
+    std::shared_ptr<fastdds::rtps::PayloadCompressor> compressor_;
+
+    //! Scratch buffer used when compressing payloads
+    std::vector<fastrtps::rtps::octet> compression_buffer_;
+
+    //! Change reused by every sample sent without history
+    fastrtps::rtps::CacheChange_t volatile_change_;
+
     //! A timer used to check for deadlines
     fastrtps::rtps::TimedEvent* deadline_timer_;
 
@@ -335,6 +345,29 @@ public:
             fastrtps::rtps::WriteParams& wparams,
             const fastrtps::rtps::InstanceHandle_t& handle);
 
+    /**
+     * Check whether a change of the given kind can be sent without keeping it on the history.
+     * Only ALIVE changes of synchronous, best-effort, volatile, KEEP_LAST(1) writers of unkeyed topics, with
+     * no deadline nor lifespan, are eligible.
+     */
+    bool can_send_without_history(
+            fastrtps::rtps::ChangeKind_t change_kind) const;
+
+    /**
+     * Serialize a sample on volatile_change_ and send it without adding it to the history.
+     * @return false when the sample could not be sent this way, so it should go through the history.
+     */
+    bool send_without_history(
+            void* data,
+            fastrtps::rtps::WriteParams& wparams,
+            const fastrtps::rtps::InstanceHandle_t& handle,
+            const std::chrono::time_point<std::chrono::steady_clock>& max_blocking_time);
+
+    //! Set the fragment size of a change, according to the maximum message size of the writer
+    void set_fragment_size(
+            fastrtps::rtps::CacheChange_t* ch,
+            const fastrtps::rtps::WriteParams& wparams);
+
     static fastrtps::TopicAttributes get_topic_attributes(
             const DataWriterQos& qos,
             const Topic& topic,
@@ -24,6 +24,7 @@
 #include <fastrtps_deprecated/publisher/PublisherImpl.h>
 
 #include <fastdds/rtps/writer/RTPSWriter.h>
+#include <rtps/compression/PayloadDelta.hpp>
 
 #include <fastdds/dds/log/Log.hpp>
 
@@ -53,6 +54,8 @@ PublisherHistory::PublisherHistory(
     , history_qos_(topic_att.historyQos)
     , resource_limited_qos_(topic_att.resourceLimitsQos)
     , topic_att_(topic_att)
+    , keyframe_period_(0)
+    , last_keyframe_id_(0)
 {
 }
 
@@ -183,6 +186,7 @@ bool PublisherHistory::find_key(
         {
             if (vit->second.cache_changes.size() == 0)
             {
+                keyframes_.erase(vit->first);
                 keyed_changes_.erase(vit);
                 *vit_out = keyed_changes_.insert(std::make_pair(a_change->instanceHandle, KeyedChanges())).first;
                 return true;
@@ -355,3 +359,79 @@ bool PublisherHistory::get_next_deadline(
 
     return false;
 }
+
+void PublisherHistory::enable_delta_encoding(
+        uint32_t keyframe_period,
+        DurabilityQosPolicyKind durability)
+{
+    if (keyframe_period > 0 && topic_att_.getTopicKind() == NO_KEY)
+    {
+        logWarning(PUBLISHER, "Delta encoding is only available on topics with key");
+        return;
+    }
+
+    if (keyframe_period > 0 && durability != VOLATILE_DURABILITY_QOS)
+    {
+        logWarning(PUBLISHER, "Delta encoding is only available on writers with VOLATILE durability");
+        return;
+    }
+
+    keyframe_period_ = keyframe_period;
+}
+
+bool PublisherHistory::encode_delta(
+        CacheChange_t* change)
+{
+    if (keyframe_period_ == 0 || mp_mutex == nullptr)
+    {
+        return false;
+    }
+
+    std::lock_guard<RecursiveTimedMutex> guard(*this->mp_mutex);
+
+    if (change->kind != ALIVE)
+    {
+        // Once the instance is unregistered or disposed readers forget its keyframe.
+        // The identifier is kept, so the next keyframe never reuses an old one.
+        auto kit = keyframes_.find(change->instanceHandle);
+        if (kit != keyframes_.end())
+        {
+            kit->second.data.clear();
+        }
+        return false;
+    }
+
+    t_m_Inst_Caches::iterator vit;
+    if (!find_key(change, &vit))
+    {
+        return false;
+    }
+
+    auto kit = keyframes_.find(change->instanceHandle);
+    if (kit == keyframes_.end())
+    {
+        // Readers may still keep keyframes of an instance removed from the history, so identifiers are not reused
+        kit = keyframes_.insert(std::make_pair(change->instanceHandle, DeltaKeyframe())).first;
+        kit->second.id = last_keyframe_id_;
+    }
+
+    // Keyframes have to fit on the payloads of the histories
+    bool is_delta = fastdds::rtps::PayloadDelta::encode(kit->second, keyframe_period_, m_att.payloadMaxSize,
+                    change->serializedPayload, delta_buffer_);
+    last_keyframe_id_ = std::max(last_keyframe_id_, kit->second.id);
+    return is_delta;
+}
+
+void PublisherHistory::request_keyframes()
+{
+    if (keyframe_period_ == 0 || mp_mutex == nullptr)
+    {
+        return;
+    }
+
+    std::lock_guard<RecursiveTimedMutex> guard(*this->mp_mutex);
+    for (auto& keyframe : keyframes_)
+    {
+        keyframe.second.data.clear();
+    }
+}
@@ -36,6 +36,8 @@
 #include <fastdds/rtps/resources/TimedEvent.h>
 #include <fastdds/rtps/builtin/BuiltinProtocols.h>
 #include <fastdds/rtps/builtin/liveliness/WLP.h>
+#include <rtps/compression/PayloadCompression.hpp>
+#include <rtps/compression/PayloadDelta.hpp>
 
 using namespace eprosima::fastrtps;
 using namespace ::rtps;
@@ -85,6 +87,10 @@ PublisherImpl::PublisherImpl(
                 return lifespan_expired();
             },
             m_att.qos.m_lifespan.duration.to_ns() * 1e-6);
+
+    compressor_ = fastdds::rtps::PayloadCompression::writer_compressor(m_att.qos.representation, m_att.properties);
+    m_history.enable_delta_encoding(fastdds::rtps::PayloadDelta::keyframe_period(m_att.properties),
+            m_att.qos.m_durability.kind);
 }
 
 PublisherImpl::~PublisherImpl()
@@ -167,6 +173,13 @@ bool PublisherImpl::create_new_change_with_params(
                 }
             }
 
+            m_history.encode_delta(ch);
+
+            if (compressor_ && changeKind == ALIVE)
+            {
+                fastdds::rtps::PayloadCompression::compress(*compressor_, ch->serializedPayload, compression_buffer_);
+            }
+
             //TODO(Ricardo) This logic in a class. Then a user of rtps layer can use it.
             if (high_mark_for_frag_ == 0)
             {
@@ -379,6 +392,12 @@ void PublisherImpl::PublisherWriterListener::onWriterMatched(
         RTPSWriter* /*writer*/,
         MatchingInfo& info)
 {
+    if (info.status == MATCHED_MATCHING)
+    {
+        // New readers need a full sample of each instance before being able to decode deltas
+        mp_publisherImpl->m_history.request_keyframes();
+    }
+
     if ( mp_publisherImpl->mp_listener != nullptr )
     {
         mp_publisherImpl->mp_listener->onPublicationMatched(mp_publisherImpl->mp_userPublisher, info);
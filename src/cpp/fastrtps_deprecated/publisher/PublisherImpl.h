@@ -24,6 +24,7 @@
 
 #include <fastdds/rtps/common/Locator.h>
 #include <fastdds/rtps/common/Guid.h>
+#include <fastdds/rtps/compression/PayloadCompressor.hpp>
 
 #include <fastrtps/attributes/PublisherAttributes.h>
 
@@ -185,6 +186,12 @@ class PublisherImpl
 
     uint32_t high_mark_for_frag_;
 
+    //! Codec used to compress the payloads (only with the compressed data representation)
+    std::shared_ptr<fastdds::rtps::PayloadCompressor> compressor_;
+
+    //! Scratch buffer used when compressing payloads
+    std::vector<rtps::octet> compression_buffer_;
+
     //! A timer used to check for deadlines
     rtps::TimedEvent* deadline_timer_;
     //! Deadline duration in microseconds
@@ -22,6 +22,8 @@
 
 #include <fastdds/rtps/reader/RTPSReader.h>
 #include <rtps/reader/WriterProxy.h>
+#include <rtps/compression/PayloadCompression.hpp>
+#include <rtps/compression/PayloadDelta.hpp>
 
 #include <fastdds/dds/topic/TopicDataType.hpp>
 #include <fastdds/dds/log/Log.hpp>
@@ -166,6 +168,8 @@ bool SubscriberHistory::received_change_keep_all_with_key(
     t_m_Inst_Caches::iterator vit;
     if (find_key_for_change(a_change, vit))
     {
+        store_keyframe(a_change);
+
         std::vector<CacheChange_t*>& instance_changes = vit->second.cache_changes;
         if (instance_changes.size() < static_cast<size_t>(resource_limited_qos_.max_samples_per_instance) )
         {
@@ -185,6 +189,8 @@ bool SubscriberHistory::received_change_keep_last_with_key(
     t_m_Inst_Caches::iterator vit;
     if (find_key_for_change(a_change, vit))
     {
+        store_keyframe(a_change);
+
         bool add = false;
         std::vector<CacheChange_t*>& instance_changes = vit->second.cache_changes;
         if (instance_changes.size() < static_cast<size_t>(history_qos_.depth) )
@@ -196,7 +202,13 @@ bool SubscriberHistory::received_change_keep_last_with_key(
             // Try to substitute the oldest sample.
 
             // As the instance should be ordered following the presentation QoS, we can always remove the first one.
-            add = remove_change_sub(instance_changes.at(0));
+            CacheChange_t* oldest = instance_changes.at(0);
+            if (oldest->getFragmentSize() != 0)
+            {
+                // Fragmented keyframes could not be kept when received
+                store_keyframe(oldest);
+            }
+            add = remove_change_sub(oldest);
         }
 
         if (add)
@@ -276,7 +288,7 @@ bool SubscriberHistory::find_key_for_change(
     if (!a_change->instanceHandle.isDefined() && type_ != nullptr)
     {
         logInfo(SUBSCRIBER, "Getting Key of change with no Key transmitted")
-        type_->deserialize(&a_change->serializedPayload, get_key_object_);
+        deserialize_payload(a_change, get_key_object_);
         bool is_key_protected = false;
 #if HAVE_SECURITY
         is_key_protected = mp_reader->getAttributes().security_attributes().is_key_protected;
@@ -304,7 +316,7 @@ bool SubscriberHistory::deserialize_change(
 {
     if (change->kind == ALIVE)
     {
-        if (!type_->deserialize(&change->serializedPayload, data))
+        if (!deserialize_payload(change, data))
         {
             logError(SUBSCRIBER, "Deserialization of data failed");
             return false;
@@ -330,6 +342,212 @@ bool SubscriberHistory::deserialize_change(
     return true;
 }
 
+bool SubscriberHistory::deserialize_payload(
+        CacheChange_t* change,
+        void* data)
+{
+    SerializedPayload_t* payload = plain_payload(change);
+    if (payload == nullptr)
+    {
+        return false;
+    }
+
+    bool is_keyframe = false;
+    uint32_t keyframe_id = 0;
+    if (fastdds::rtps::PayloadDelta::read_header(*payload, is_keyframe, keyframe_id))
+    {
+        DeltaKeyframe* keyframe = is_keyframe ? keep_keyframe(change, *payload) : find_keyframe(change, keyframe_id);
+        if (keyframe == nullptr || !fastdds::rtps::PayloadDelta::decode(*payload, *keyframe, delta_payload_))
+        {
+            logWarning(SUBSCRIBER, "Discarding delta encoded sample " << change->sequenceNumber << " from "
+                                                                     << change->writerGUID
+                                                                     << ": its keyframe has not been received");
+            return false;
+        }
+
+        payload = &delta_payload_;
+    }
+
+    return type_->deserialize(payload, data);
+}
+
+SerializedPayload_t* SubscriberHistory::plain_payload(
+        CacheChange_t* change)
+{
+    // Only writers advertising the compressed representation compress their payloads
+    if (fastdds::rtps::PayloadCompression::is_compressed(change->serializedPayload) &&
+            mp_reader->matched_writer_compresses(change->writerGUID))
+    {
+        if (!fastdds::rtps::PayloadCompression::decompress(change->serializedPayload, decompressed_payload_,
+                m_att.payloadMaxSize, decompressor_))
+        {
+            return nullptr;
+        }
+
+        return &decompressed_payload_;
+    }
+
+    return &change->serializedPayload;
+}
+
+void SubscriberHistory::store_keyframe(
+        CacheChange_t* change)
+{
+    if (change->kind != ALIVE)
+    {
+        // The writer starts again with a keyframe after unregistering or disposing the instance
+        remove_unused_keyframes(change->instanceHandle, change->writerGUID, false);
+        return;
+    }
+
+    // Fragmented keyframes are kept once reassembled
+    if (!change->is_fully_assembled())
+    {
+        return;
+    }
+
+    SerializedPayload_t* payload = plain_payload(change);
+    if (payload != nullptr && keep_keyframe(change, *payload) != nullptr)
+    {
+        remove_unused_keyframes(change->instanceHandle, change->writerGUID, true);
+    }
+}
+
+DeltaKeyframe* SubscriberHistory::keep_keyframe(
+        const CacheChange_t* change,
+        const SerializedPayload_t& payload)
+{
+    bool is_keyframe = false;
+    uint32_t keyframe_id = 0;
+    if (!fastdds::rtps::PayloadDelta::read_header(payload, is_keyframe, keyframe_id) || !is_keyframe)
+    {
+        return nullptr;
+    }
+
+    std::vector<DeltaKeyframe>& keyframes = keyframes_[std::make_pair(change->instanceHandle, change->writerGUID)];
+    auto it = keyframes.begin();
+    while (it != keyframes.end() && it->sequence_number < change->sequenceNumber)
+    {
+        ++it;
+    }
+
+    if (it == keyframes.end() || it->sequence_number != change->sequenceNumber)
+    {
+        it = keyframes.insert(it, DeltaKeyframe());
+        it->sequence_number = change->sequenceNumber;
+        fastdds::rtps::PayloadDelta::store_keyframe(payload, *it);
+        if (it->data.empty())
+        {
+            // Malformed keyframe
+            keyframes.erase(it);
+            if (keyframes.empty())
+            {
+                keyframes_.erase(std::make_pair(change->instanceHandle, change->writerGUID));
+            }
+            return nullptr;
+        }
+    }
+
+    return &(*it);
+}
+
+DeltaKeyframe* SubscriberHistory::find_keyframe(
+        CacheChange_t* change,
+        uint32_t keyframe_id)
+{
+    auto vit = keyed_changes_.find(change->instanceHandle);
+    if (vit == keyed_changes_.end())
+    {
+        return nullptr;
+    }
+
+    auto kit = keyframes_.find(std::make_pair(change->instanceHandle, change->writerGUID));
+    for (uint32_t attempt = 0; attempt < 2; ++attempt)
+    {
+        if (kit != keyframes_.end())
+        {
+            // The most recent keyframe with the identifier, as instances removed from a writer may reuse it
+            for (auto it = kit->second.rbegin(); it != kit->second.rend(); ++it)
+            {
+                if (it->id == keyframe_id && it->sequence_number < change->sequenceNumber)
+                {
+                    return &(*it);
+                }
+            }
+        }
+
+        if (attempt == 0)
+        {
+            // A fragmented keyframe may have been reassembled after it was received
+            for (CacheChange_t* instance_change : vit->second.cache_changes)
+            {
+                if (instance_change->writerGUID == change->writerGUID &&
+                        instance_change->sequenceNumber < change->sequenceNumber &&
+                        instance_change->getFragmentSize() != 0 && instance_change->kind == ALIVE &&
+                        instance_change->is_fully_assembled())
+                {
+                    SerializedPayload_t* payload = plain_payload(instance_change);
+                    if (payload != nullptr)
+                    {
+                        keep_keyframe(instance_change, *payload);
+                    }
+                }
+            }
+            kit = keyframes_.find(std::make_pair(change->instanceHandle, change->writerGUID));
+        }
+    }
+
+    return nullptr;
+}
+
+void SubscriberHistory::remove_unused_keyframes(
+        const InstanceHandle_t& handle,
+        const GUID_t& writer_guid,
+        bool keep_latest)
+{
+    auto kit = keyframes_.find(std::make_pair(handle, writer_guid));
+    if (kit == keyframes_.end())
+    {
+        return;
+    }
+
+    // Samples of the writer still on the instance may refer to the last keyframe before the oldest of them
+    SequenceNumber_t oldest = SequenceNumber_t::unknown();
+    auto vit = keyed_changes_.find(handle);
+    if (vit != keyed_changes_.end())
+    {
+        for (CacheChange_t* change : vit->second.cache_changes)
+        {
+            if (change->writerGUID == writer_guid &&
+                    (oldest == SequenceNumber_t::unknown() || change->sequenceNumber < oldest))
+            {
+                oldest = change->sequenceNumber;
+            }
+        }
+    }
+
+    std::vector<DeltaKeyframe>& keyframes = kit->second;
+    size_t first_used = keyframes.size();
+    if (oldest != SequenceNumber_t::unknown())
+    {
+        first_used = 0;
+        while (first_used + 1 < keyframes.size() && keyframes[first_used + 1].sequence_number <= oldest)
+        {
+            ++first_used;
+        }
+    }
+    else if (keep_latest && !keyframes.empty())
+    {
+        first_used = keyframes.size() - 1;
+    }
+
+    keyframes.erase(keyframes.begin(), keyframes.begin() + first_used);
+    if (keyframes.empty())
+    {
+        keyframes_.erase(kit);
+    }
+}
+
 bool SubscriberHistory::readNextData(
         void* data,
         SampleInfo_t* info,
@@ -430,6 +648,11 @@ bool SubscriberHistory::find_key(
         {
             if (vit->second.cache_changes.size() == 0)
             {
+                auto kit = keyframes_.lower_bound(std::make_pair(vit->first, GUID_t()));
+                while (kit != keyframes_.end() && kit->first.first == vit->first)
+                {
+                    kit = keyframes_.erase(kit);
+                }
                 keyed_changes_.erase(vit);
                 *vit_out = keyed_changes_.insert(std::make_pair(a_change->instanceHandle, KeyedChanges())).first;
                 return true;
@@ -465,6 +688,11 @@ bool SubscriberHistory::remove_change_sub(
                     break;
                 }
             }
+
+            if (found && !keyframes_.empty())
+            {
+                remove_unused_keyframes(change->instanceHandle, change->writerGUID, true);
+            }
         }
         if (!found)
         {
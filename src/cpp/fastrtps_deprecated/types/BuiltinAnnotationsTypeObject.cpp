@@ -36,104 +36,77 @@ namespace { char dummy; }
 
 using namespace eprosima::fastrtps::rtps;
 
-void register_builtin_annotations_types(TypeObjectFactory* factory)
+struct BuiltinAnnotationType
 {
-    factory->add_type_object("id", GetidIdentifier(true), GetidObject(true));
-    factory->add_type_object("id", GetidIdentifier(false), GetidObject(false));
-
-    factory->add_type_object("autoid", GetautoidIdentifier(true), GetautoidObject(true));
-    factory->add_type_object("autoid", GetautoidIdentifier(false), GetautoidObject(false));
-    {
-        using namespace autoid;
-
-        factory->add_type_object("AutoidKind", GetAutoidKindIdentifier(true), GetAutoidKindObject(true));
-        factory->add_type_object("AutoidKind", GetAutoidKindIdentifier(false), GetAutoidKindObject(false));
-
+    const char* name;
+    const TypeIdentifier* (*identifier)(bool complete);
+    const TypeObject* (*object)(bool complete);
+};
 
-    }
-    factory->add_type_object("optional", GetoptionalIdentifier(true), GetoptionalObject(true));
-    factory->add_type_object("optional", GetoptionalIdentifier(false), GetoptionalObject(false));
-
-    factory->add_type_object("position", GetpositionIdentifier(true), GetpositionObject(true));
-    factory->add_type_object("position", GetpositionIdentifier(false), GetpositionObject(false));
-
-    factory->add_type_object("value", GetvalueIdentifier(true), GetvalueObject(true));
-    factory->add_type_object("value", GetvalueIdentifier(false), GetvalueObject(false));
+// Constant-initialized, so the TypeObjects are only built when the factory asks for them.
+static const BuiltinAnnotationType s_builtin_annotations[] =
+{
+    { "id",                &GetidIdentifier, &GetidObject },
+    { "autoid",            &GetautoidIdentifier, &GetautoidObject },
+    { "AutoidKind",        &autoid::GetAutoidKindIdentifier, &autoid::GetAutoidKindObject },
+    { "optional",          &GetoptionalIdentifier, &GetoptionalObject },
+    { "position",          &GetpositionIdentifier, &GetpositionObject },
+    { "value",             &GetvalueIdentifier, &GetvalueObject },
+    { "extensibility",     &GetextensibilityIdentifier, &GetextensibilityObject },
+    { "ExtensibilityKind", &extensibility::GetExtensibilityKindIdentifier, &extensibility::GetExtensibilityKindObject },
+    { "final",             &GetfinalIdentifier, &GetfinalObject },
+    { "appendable",        &GetappendableIdentifier, &GetappendableObject },
+    { "mutable",           &GetmutableIdentifier, &GetmutableObject },
+    { "key",               &GetkeyIdentifier, &GetkeyObject },
+    { "must_understand",   &Getmust_understandIdentifier, &Getmust_understandObject },
+    { "default_literal",   &Getdefault_literalIdentifier, &Getdefault_literalObject },
+    { "default",           &GetdefaultIdentifier, &GetdefaultObject },
+    { "range",             &GetrangeIdentifier, &GetrangeObject },
+    { "min",               &GetminIdentifier, &GetminObject },
+    { "max",               &GetmaxIdentifier, &GetmaxObject },
+    { "unit",              &GetunitIdentifier, &GetunitObject },
+    { "bit_bound",         &Getbit_boundIdentifier, &Getbit_boundObject },
+    { "external",          &GetexternalIdentifier, &GetexternalObject },
+    { "nested",            &GetnestedIdentifier, &GetnestedObject },
+    { "verbatim",          &GetverbatimIdentifier, &GetverbatimObject },
+    { "PlacementKind",     &verbatim::GetPlacementKindIdentifier, &verbatim::GetPlacementKindObject },
+    { "service",           &GetserviceIdentifier, &GetserviceObject },
+    { "oneway",            &GetonewayIdentifier, &GetonewayObject },
+    { "ami",               &GetamiIdentifier, &GetamiObject },
+    { "non_serialized",    &Getnon_serializedIdentifier, &Getnon_serializedObject }
+};
+
+size_t builtin_annotations_types_count()
+{
+    return sizeof(s_builtin_annotations) / sizeof(s_builtin_annotations[0]);
+}
 
-    factory->add_type_object("extensibility", GetextensibilityIdentifier(true), GetextensibilityObject(true));
-    factory->add_type_object("extensibility", GetextensibilityIdentifier(false), GetextensibilityObject(false));
+size_t find_builtin_annotation_type(const std::string& type_name)
+{
+    size_t index = 0;
+    for (; index < builtin_annotations_types_count(); ++index)
     {
-        using namespace extensibility;
-
-        factory->add_type_object("ExtensibilityKind", GetExtensibilityKindIdentifier(true), GetExtensibilityKindObject(true));
-        factory->add_type_object("ExtensibilityKind", GetExtensibilityKindIdentifier(false), GetExtensibilityKindObject(false));
-
-
+        if (type_name == s_builtin_annotations[index].name)
+        {
+            break;
+        }
     }
-    factory->add_type_object("final", GetfinalIdentifier(true), GetfinalObject(true));
-    factory->add_type_object("final", GetfinalIdentifier(false), GetfinalObject(false));
-
-    factory->add_type_object("appendable", GetappendableIdentifier(true), GetappendableObject(true));
-    factory->add_type_object("appendable", GetappendableIdentifier(false), GetappendableObject(false));
-
-    factory->add_type_object("mutable", GetmutableIdentifier(true), GetmutableObject(true));
-    factory->add_type_object("mutable", GetmutableIdentifier(false), GetmutableObject(false));
-
-    factory->add_type_object("key", GetkeyIdentifier(true), GetkeyObject(true));
-    factory->add_type_object("key", GetkeyIdentifier(false), GetkeyObject(false));
-
-    factory->add_type_object("must_understand", Getmust_understandIdentifier(true), Getmust_understandObject(true));
-    factory->add_type_object("must_understand", Getmust_understandIdentifier(false), Getmust_understandObject(false));
-
-    factory->add_type_object("default_literal", Getdefault_literalIdentifier(true), Getdefault_literalObject(true));
-    factory->add_type_object("default_literal", Getdefault_literalIdentifier(false), Getdefault_literalObject(false));
-
-    factory->add_type_object("default", GetdefaultIdentifier(true), GetdefaultObject(true));
-    factory->add_type_object("default", GetdefaultIdentifier(false), GetdefaultObject(false));
-
-    factory->add_type_object("range", GetrangeIdentifier(true), GetrangeObject(true));
-    factory->add_type_object("range", GetrangeIdentifier(false), GetrangeObject(false));
-
-    factory->add_type_object("min", GetminIdentifier(true), GetminObject(true));
-    factory->add_type_object("min", GetminIdentifier(false), GetminObject(false));
-
-    factory->add_type_object("max", GetmaxIdentifier(true), GetmaxObject(true));
-    factory->add_type_object("max", GetmaxIdentifier(false), GetmaxObject(false));
-
-    factory->add_type_object("unit", GetunitIdentifier(true), GetunitObject(true));
-    factory->add_type_object("unit", GetunitIdentifier(false), GetunitObject(false));
-
-    factory->add_type_object("bit_bound", Getbit_boundIdentifier(true), Getbit_boundObject(true));
-    factory->add_type_object("bit_bound", Getbit_boundIdentifier(false), Getbit_boundObject(false));
-
-    factory->add_type_object("external", GetexternalIdentifier(true), GetexternalObject(true));
-    factory->add_type_object("external", GetexternalIdentifier(false), GetexternalObject(false));
+    return index;
+}
 
-    factory->add_type_object("nested", GetnestedIdentifier(true), GetnestedObject(true));
-    factory->add_type_object("nested", GetnestedIdentifier(false), GetnestedObject(false));
+void register_builtin_annotation_type(TypeObjectFactory* factory, size_t index)
+{
+    const BuiltinAnnotationType& type = s_builtin_annotations[index];
+    factory->add_type_object(type.name, type.identifier(true), type.object(true));
+    factory->add_type_object(type.name, type.identifier(false), type.object(false));
+}
 
-    factory->add_type_object("verbatim", GetverbatimIdentifier(true), GetverbatimObject(true));
-    factory->add_type_object("verbatim", GetverbatimIdentifier(false), GetverbatimObject(false));
+void register_builtin_annotations_types(TypeObjectFactory* factory)
+{
+    for (size_t index = 0; index < builtin_annotations_types_count(); ++index)
     {
-        using namespace verbatim;
-
-        factory->add_type_object("PlacementKind", GetPlacementKindIdentifier(true), GetPlacementKindObject(true));
-        factory->add_type_object("PlacementKind", GetPlacementKindIdentifier(false), GetPlacementKindObject(false));
-
-
+        register_builtin_annotation_type(factory, index);
     }
-    factory->add_type_object("service", GetserviceIdentifier(true), GetserviceObject(true));
-    factory->add_type_object("service", GetserviceIdentifier(false), GetserviceObject(false));
-
-    factory->add_type_object("oneway", GetonewayIdentifier(true), GetonewayObject(true));
-    factory->add_type_object("oneway", GetonewayIdentifier(false), GetonewayObject(false));
-
-    factory->add_type_object("ami", GetamiIdentifier(true), GetamiObject(true));
-    factory->add_type_object("ami", GetamiIdentifier(false), GetamiObject(false));
-
-    factory->add_type_object("non_serialized", Getnon_serializedIdentifier(true), Getnon_serializedObject(true));
-    factory->add_type_object("non_serialized", Getnon_serializedIdentifier(false), Getnon_serializedObject(false));
-
 }
 
 const TypeIdentifier* GetidIdentifier(bool complete)
@@ -31,6 +31,46 @@ namespace eprosima {
 namespace fastrtps {
 namespace types {
 
+#if HAVE_CXX14
+using IndexReadLock = std::shared_lock<std::shared_timed_mutex>;
+#else
+using IndexReadLock = std::unique_lock<std::mutex>;
+#endif // if HAVE_CXX14
+
+enum BuiltinAnnotationState : uint8_t
+{
+    BUILTIN_ANNOTATION_PENDING,
+    BUILTIN_ANNOTATION_REGISTERING,
+    BUILTIN_ANNOTATION_REGISTERED
+};
+
+struct PrimitiveTypeIdentifier
+{
+    const std::string* name;
+    octet kind;
+};
+
+// Constant-initialized, as it only holds addresses
+static const PrimitiveTypeIdentifier s_primitive_identifiers[] =
+{
+    { &TKNAME_BOOLEAN, TK_BOOLEAN },
+    { &TKNAME_BYTE, TK_BYTE },
+    { &TKNAME_UINT8, TK_BYTE },
+    { &TKNAME_INT8, TK_BYTE },
+    { &TKNAME_INT16, TK_INT16 },
+    { &TKNAME_INT32, TK_INT32 },
+    { &TKNAME_INT64, TK_INT64 },
+    { &TKNAME_UINT16, TK_UINT16 },
+    { &TKNAME_UINT32, TK_UINT32 },
+    { &TKNAME_UINT64, TK_UINT64 },
+    { &TKNAME_FLOAT32, TK_FLOAT32 },
+    { &TKNAME_FLOAT64, TK_FLOAT64 },
+    { &TKNAME_FLOAT128, TK_FLOAT128 },
+    { &TKNAME_CHAR8, TK_CHAR8 },
+    { &TKNAME_CHAR16, TK_CHAR16 },
+    { &TKNAME_CHAR16T, TK_CHAR16 }
+};
+
 class TypeObjectFactoryReleaser
 {
 public:
@@ -46,8 +86,8 @@ TypeObjectFactory* TypeObjectFactory::get_instance()
 {
     if (g_instance == nullptr)
     {
+        // Builtin annotations are registered when they are first looked up
         g_instance = new TypeObjectFactory();
-        g_instance->create_builtin_annotations();
     }
     return g_instance;
 }
@@ -64,90 +104,18 @@ ReturnCode_t TypeObjectFactory::delete_instance()
 }
 
 TypeObjectFactory::TypeObjectFactory()
+    : builtin_annotations_state_(builtin_annotations_types_count(), BUILTIN_ANNOTATION_PENDING)
+    , builtin_annotations_registered_(false)
 {
     std::unique_lock<std::recursive_mutex> scoped(m_MutexIdentifiers);
     // Generate basic TypeIdentifiers
-    TypeIdentifier* auxIdent;
-    // TK_BOOLEAN:
-    auxIdent = new TypeIdentifier();
-    identifiers_created_.push_back(auxIdent);
-    auxIdent->_d(TK_BOOLEAN);
-    identifiers_.insert(std::pair<std::string, TypeIdentifier*>(TKNAME_BOOLEAN, auxIdent));
-    // TK_BYTE:
-    auxIdent = new TypeIdentifier();
-    identifiers_created_.push_back(auxIdent);
-    auxIdent->_d(TK_BYTE);
-    identifiers_.insert(std::pair<std::string, TypeIdentifier*>(TKNAME_BYTE, auxIdent));
-    // TK_BYTE:
-    auxIdent = new TypeIdentifier();
-    identifiers_created_.push_back(auxIdent);
-    auxIdent->_d(TK_BYTE);
-    identifiers_.insert(std::pair<std::string, TypeIdentifier*>(TKNAME_UINT8, auxIdent));
-    // TK_BYTE:
-    auxIdent = new TypeIdentifier();
-    identifiers_created_.push_back(auxIdent);
-    auxIdent->_d(TK_BYTE);
-    identifiers_.insert(std::pair<std::string, TypeIdentifier*>(TKNAME_INT8, auxIdent));
-    // TK_INT16:
-    auxIdent = new TypeIdentifier();
-    identifiers_created_.push_back(auxIdent);
-    auxIdent->_d(TK_INT16);
-    identifiers_.insert(std::pair<std::string, TypeIdentifier*>(TKNAME_INT16, auxIdent));
-    // TK_INT32:
-    auxIdent = new TypeIdentifier();
-    identifiers_created_.push_back(auxIdent);
-    auxIdent->_d(TK_INT32);
-    identifiers_.insert(std::pair<std::string, TypeIdentifier*>(TKNAME_INT32, auxIdent));
-    // TK_INT64:
-    auxIdent = new TypeIdentifier();
-    identifiers_created_.push_back(auxIdent);
-    auxIdent->_d(TK_INT64);
-    identifiers_.insert(std::pair<std::string, TypeIdentifier*>(TKNAME_INT64, auxIdent));
-    // TK_UINT16:
-    auxIdent = new TypeIdentifier();
-    identifiers_created_.push_back(auxIdent);
-    auxIdent->_d(TK_UINT16);
-    identifiers_.insert(std::pair<std::string, TypeIdentifier*>(TKNAME_UINT16, auxIdent));
-    // TK_UINT32:
-    auxIdent = new TypeIdentifier();
-    identifiers_created_.push_back(auxIdent);
-    auxIdent->_d(TK_UINT32);
-    identifiers_.insert(std::pair<std::string, TypeIdentifier*>(TKNAME_UINT32, auxIdent));
-    // TK_UINT64:
-    auxIdent = new TypeIdentifier();
-    identifiers_created_.push_back(auxIdent);
-    auxIdent->_d(TK_UINT64);
-    identifiers_.insert(std::pair<std::string, TypeIdentifier*>(TKNAME_UINT64, auxIdent));
-    // TK_FLOAT32:
-    auxIdent = new TypeIdentifier();
-    identifiers_created_.push_back(auxIdent);
-    auxIdent->_d(TK_FLOAT32);
-    identifiers_.insert(std::pair<std::string, TypeIdentifier*>(TKNAME_FLOAT32, auxIdent));
-    // TK_FLOAT64:
-    auxIdent = new TypeIdentifier();
-    identifiers_created_.push_back(auxIdent);
-    auxIdent->_d(TK_FLOAT64);
-    identifiers_.insert(std::pair<std::string, TypeIdentifier*>(TKNAME_FLOAT64, auxIdent));
-    // TK_FLOAT128:
-    auxIdent = new TypeIdentifier();
-    identifiers_created_.push_back(auxIdent);
-    auxIdent->_d(TK_FLOAT128);
-    identifiers_.insert(std::pair<std::string, TypeIdentifier*>(TKNAME_FLOAT128, auxIdent));
-    // TK_CHAR8:
-    auxIdent = new TypeIdentifier();
-    identifiers_created_.push_back(auxIdent);
-    auxIdent->_d(TK_CHAR8);
-    identifiers_.insert(std::pair<std::string, TypeIdentifier*>(TKNAME_CHAR8, auxIdent));
-    // TK_CHAR16:
-    auxIdent = new TypeIdentifier();
-    identifiers_created_.push_back(auxIdent);
-    auxIdent->_d(TK_CHAR16);
-    identifiers_.insert(std::pair<std::string, TypeIdentifier*>(TKNAME_CHAR16, auxIdent));
-    // TK_CHAR16:
-    auxIdent = new TypeIdentifier();
-    identifiers_created_.push_back(auxIdent);
-    auxIdent->_d(TK_CHAR16);
-    identifiers_.insert(std::pair<std::string, TypeIdentifier*>(TKNAME_CHAR16T, auxIdent));
+    const size_t primitives = sizeof(s_primitive_identifiers) / sizeof(s_primitive_identifiers[0]);
+    primitive_identifiers_.resize(primitives);
+    for (size_t i = 0; i < primitives; ++i)
+    {
+        primitive_identifiers_[i]._d(s_primitive_identifiers[i].kind);
+        store_type_identifier(*s_primitive_identifiers[i].name, &primitive_identifiers_[i], false);
+    }
 }
 
 TypeObjectFactory::~TypeObjectFactory()
@@ -165,6 +133,8 @@ TypeObjectFactory::~TypeObjectFactory()
         std::unique_lock<std::recursive_mutex> scoped(m_MutexIdentifiers);
         identifiers_.clear();
         complete_identifiers_.clear();
+        identifiers_index_.clear();
+        complete_identifiers_index_.clear();
 
         for (TypeIdentifier* id : identifiers_created_)
         {
@@ -192,18 +162,99 @@ TypeObjectFactory::~TypeObjectFactory()
     }
 }
 
-void TypeObjectFactory::create_builtin_annotations()
+void TypeObjectFactory::create_builtin_annotations() const
+{
+    if (builtin_annotations_registered_.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    // Recursive, as registering an annotation type looks up the types it depends on
+    std::lock_guard<std::recursive_mutex> lock(m_MutexBuiltinAnnotations);
+    bool all_registered = true;
+    for (size_t index = 0; index < builtin_annotations_state_.size(); ++index)
+    {
+        if (builtin_annotations_state_[index] == BUILTIN_ANNOTATION_PENDING)
+        {
+            builtin_annotations_state_[index] = BUILTIN_ANNOTATION_REGISTERING;
+            register_builtin_annotation_type(const_cast<TypeObjectFactory*>(this), index);
+            builtin_annotations_state_[index] = BUILTIN_ANNOTATION_REGISTERED;
+        }
+        else if (builtin_annotations_state_[index] == BUILTIN_ANNOTATION_REGISTERING)
+        {
+            // Being registered by this same thread further up the stack
+            all_registered = false;
+        }
+    }
+
+    if (all_registered)
+    {
+        builtin_annotations_registered_.store(true, std::memory_order_release);
+    }
+}
+
+bool TypeObjectFactory::create_builtin_annotation(
+        const std::string& type_name) const
+{
+    if (builtin_annotations_registered_.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    size_t index = find_builtin_annotation_type(type_name);
+    if (index >= builtin_annotations_state_.size())
+    {
+        return false;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(m_MutexBuiltinAnnotations);
+    if (builtin_annotations_state_[index] == BUILTIN_ANNOTATION_PENDING)
+    {
+        // Marked first, as the registration looks the type up before adding it
+        builtin_annotations_state_[index] = BUILTIN_ANNOTATION_REGISTERING;
+        register_builtin_annotation_type(const_cast<TypeObjectFactory*>(this), index);
+        builtin_annotations_state_[index] = BUILTIN_ANNOTATION_REGISTERED;
+    }
+    return builtin_annotations_state_[index] == BUILTIN_ANNOTATION_REGISTERED;
+}
+
+const TypeIdentifier* TypeObjectFactory::find_type_identifier(
+        const std::string& type_name,
+        bool complete) const
 {
-    register_builtin_annotations_types(g_instance);
+    IndexReadLock lock(m_MutexIndex);
+    const auto& index = complete ? complete_identifiers_index_ : identifiers_index_;
+    auto it = index.find(type_name);
+    return it != index.end() ? it->second : nullptr;
+}
+
+void TypeObjectFactory::store_type_identifier(
+        const std::string& type_name,
+        const TypeIdentifier* identifier,
+        bool complete)
+{
+    std::lock_guard<IndexMutex> lock(m_MutexIndex);
+    if (complete)
+    {
+        complete_identifiers_[type_name] = identifier;
+        complete_identifiers_index_[type_name] = identifier;
+    }
+    else
+    {
+        identifiers_[type_name] = identifier;
+        identifiers_index_[type_name] = identifier;
+    }
 }
 
 void TypeObjectFactory::nullify_all_entries(const TypeIdentifier* identifier)
 {
+    std::lock_guard<IndexMutex> lock(m_MutexIndex);
     for (auto it = identifiers_.begin(); it != identifiers_.end(); ++it)
     {
         if (it->second == identifier)
         {
             it->second = nullptr;
+            identifiers_index_[it->first] = nullptr;
         }
     }
 
@@ -212,6 +263,7 @@ void TypeObjectFactory::nullify_all_entries(const TypeIdentifier* identifier)
         if (it->second == identifier)
         {
             it->second = nullptr;
+            complete_identifiers_index_[it->first] = nullptr;
         }
     }
 
@@ -500,6 +552,7 @@ void TypeObjectFactory::fill_minimal_information(
 TypeInformation* TypeObjectFactory::get_type_information(
         const TypeIdentifier* identifier) const
 {
+    create_builtin_annotations();
     const TypeIdentifier* ident = get_stored_type_identifier(identifier);
     {
         std::lock_guard<std::recursive_mutex> lock(m_MutexInformations);
@@ -862,10 +915,16 @@ const TypeObject* TypeObjectFactory::get_type_object(const std::string& type_nam
         return nullptr;
     }
 
-    return get_type_object(identifier);
+    return find_type_object(identifier);
 }
 
 const TypeObject* TypeObjectFactory::get_type_object(const TypeIdentifier* identifier) const
+{
+    create_builtin_annotations();
+    return find_type_object(identifier);
+}
+
+const TypeObject* TypeObjectFactory::find_type_object(const TypeIdentifier* identifier) const
 {
     std::unique_lock<std::recursive_mutex> scoped(m_MutexObjects);
     if (identifier == nullptr) return nullptr;
@@ -892,7 +951,7 @@ const TypeObject* TypeObjectFactory::get_type_object(const TypeIdentifier* ident
         {
             return nullptr; // Type without object
         }
-        return get_type_object(internalId);
+        return find_type_object(internalId);
     }
 
     return nullptr;
@@ -1051,48 +1110,43 @@ const TypeIdentifier* TypeObjectFactory::TryCreateTypeIdentifier(const std::stri
 
 const TypeIdentifier* TypeObjectFactory::get_type_identifier(const std::string& type_name, bool complete) const
 {
-    std::unique_lock<std::recursive_mutex> scoped(m_MutexIdentifiers);
-
-    if (complete)
+    const TypeIdentifier* identifier = find_type_identifier(type_name, complete);
+    if (identifier == nullptr && create_builtin_annotation(type_name))
     {
-        if (complete_identifiers_.find(type_name) != complete_identifiers_.end())
-        {
-            return complete_identifiers_.at(type_name);
-        }
-        /*else // Try it with minimal
-        {
-            return get_type_identifier(type_name, false);
-        }*/
+        identifier = find_type_identifier(type_name, complete);
     }
-    else
+    if (identifier != nullptr)
     {
-        if (identifiers_.find(type_name) != identifiers_.end())
-        {
-            return identifiers_.at(type_name);
-        }
+        return identifier;
     }
 
     // Try with aliases
-    if (aliases_.find(type_name) != aliases_.end())
+    std::string target_type;
     {
-        return get_type_identifier(aliases_.at(type_name), complete);
+        std::unique_lock<std::recursive_mutex> scoped(m_MutexIdentifiers);
+        auto alias = aliases_.find(type_name);
+        if (alias == aliases_.end())
+        {
+            return nullptr;
+        }
+        target_type = alias->second;
     }
-
-    return nullptr;
+    return get_type_identifier(target_type, complete);
 }
 
 const TypeIdentifier* TypeObjectFactory::get_type_identifier_trying_complete(const std::string& type_name) const
 {
-    std::unique_lock<std::recursive_mutex> scoped(m_MutexIdentifiers);
-
-    if (complete_identifiers_.find(type_name) != complete_identifiers_.end())
+    const TypeIdentifier* identifier = find_type_identifier(type_name, true);
+    if (identifier == nullptr && create_builtin_annotation(type_name))
     {
-        return complete_identifiers_.at(type_name);
+        identifier = find_type_identifier(type_name, true);
     }
-    else // Try it with minimal
+    if (identifier != nullptr)
     {
-        return get_type_identifier(type_name, false);
+        return identifier;
     }
+    // Try it with minimal
+    return get_type_identifier(type_name, false);
 }
 
 const TypeIdentifier* TypeObjectFactory::get_stored_type_identifier(const TypeIdentifier* identifier) const
@@ -1123,6 +1177,7 @@ const TypeIdentifier* TypeObjectFactory::get_stored_type_identifier(const TypeId
 
 std::string TypeObjectFactory::get_type_name(const TypeIdentifier* identifier) const
 {
+    create_builtin_annotations();
     std::unique_lock<std::recursive_mutex> scoped(m_MutexIdentifiers);
     if (identifier == nullptr) return "<NULLPTR>";
     if (identifier->_d() == EK_COMPLETE)
@@ -1255,7 +1310,6 @@ const TypeIdentifier* TypeObjectFactory::try_get_complete(const TypeIdentifier*
         return identifier;
     }
 
-    std::unique_lock<std::recursive_mutex> scoped(m_MutexIdentifiers);
     std::string name = get_type_name(identifier);
     return get_type_identifier_trying_complete(name);
 }
@@ -1297,22 +1351,15 @@ bool TypeObjectFactory::is_type_identifier_complete(
 
 void TypeObjectFactory::add_type_identifier(const std::string& type_name, const TypeIdentifier* identifier)
 {
+    std::unique_lock<std::recursive_mutex> scoped(m_MutexIdentifiers);
     const TypeIdentifier* alreadyExists = get_stored_type_identifier(identifier);
     if (alreadyExists != nullptr && alreadyExists != identifier)
     {
         // Don't copy
-        if (is_type_identifier_complete(alreadyExists))
-        {
-            complete_identifiers_[type_name] = alreadyExists;
-        }
-        else
-        {
-            identifiers_[type_name] = alreadyExists;
-        }
+        store_type_identifier(type_name, alreadyExists, is_type_identifier_complete(alreadyExists));
         return;
     }
 
-    std::unique_lock<std::recursive_mutex> scoped(m_MutexIdentifiers);
     //identifiers_.insert(std::pair<const std::string, const TypeIdentifier*>(type_name, identifier));
     if (is_type_identifier_complete(identifier))
     {
@@ -1321,7 +1368,7 @@ void TypeObjectFactory::add_type_identifier(const std::string& type_name, const
             TypeIdentifier* id = new TypeIdentifier();
             identifiers_created_.push_back(id);
             *id = *identifier;
-            complete_identifiers_[type_name] = id;
+            store_type_identifier(type_name, id, true);
         }
     }
     else
@@ -1331,7 +1378,7 @@ void TypeObjectFactory::add_type_identifier(const std::string& type_name, const
             TypeIdentifier* id = new TypeIdentifier();
             identifiers_created_.push_back(id);
             *id = *identifier;
-            identifiers_[type_name] = id;
+            store_type_identifier(type_name, id, false);
         }
     }
 }
@@ -1349,7 +1396,7 @@ void TypeObjectFactory::add_type_object(const std::string& type_name, const Type
         {
             if (object->_d() == EK_MINIMAL)
             {
-                const TypeIdentifier* typeId = identifiers_[type_name];
+                const TypeIdentifier* typeId = find_type_identifier(type_name, false);
                 if (objects_.find(typeId) == objects_.end())
                 {
                     TypeObject* obj = new TypeObject();
@@ -1359,7 +1406,7 @@ void TypeObjectFactory::add_type_object(const std::string& type_name, const Type
             }
             else if (object->_d() == EK_COMPLETE)
             {
-                const TypeIdentifier* typeId = complete_identifiers_[type_name];
+                const TypeIdentifier* typeId = find_type_identifier(type_name, true);
                 if (complete_objects_.find(typeId) == complete_objects_.end())
                 {
                     TypeObject* obj = new TypeObject();
@@ -1370,7 +1417,7 @@ void TypeObjectFactory::add_type_object(const std::string& type_name, const Type
         }
         else
         {
-            const TypeIdentifier* typeId = identifiers_[type_name];
+            const TypeIdentifier* typeId = find_type_identifier(type_name, false);
             if (object->_d() == EK_MINIMAL)
             {
                 if (objects_.find(typeId) == objects_.end())
@@ -1664,6 +1711,7 @@ static TypeKind GetTypeKindFromIdentifier(const TypeIdentifier* identifier)
 DynamicType_ptr TypeObjectFactory::build_dynamic_type(const std::string& name, const TypeIdentifier* identifier,
     const TypeObject* object) const
 {
+    create_builtin_annotations();
     TypeKind kind = GetTypeKindFromIdentifier(identifier);
     TypeDescriptor descriptor(name, kind);
     switch (kind)
@@ -2136,6 +2184,7 @@ TypeIdentifierWithSizeSeq TypeObjectFactory::typelookup_get_type_dependencies(
         OctetSeq& out_continuation_point,
         size_t max_size) const
 {
+    create_builtin_annotations();
     TypeIdentifierWithSizeSeq result;
     size_t continuation_point = to_size_t(in_continuation_point);
     size_t start_index = max_size * continuation_point;
@@ -2219,6 +2268,7 @@ const TypeIdentifier* TypeObjectFactory::typelookup_get_type(
         const TypeIdentifier& identifier,
         TypeObject& object) const
 {
+    create_builtin_annotations();
     const TypeIdentifier* local_id = get_stored_type_identifier(&identifier);
 
     if (local_id != nullptr)
@@ -2236,12 +2286,14 @@ const TypeIdentifier* TypeObjectFactory::typelookup_get_type(
 bool TypeObjectFactory::typelookup_check_type_identifier(
         const TypeIdentifier& identifier) const
 {
+    create_builtin_annotations();
     return get_stored_type_identifier(&identifier) != nullptr;
 }
 
 const TypeObject* TypeObjectFactory::typelookup_get_type_object_from_information(
         const TypeInformation& information) const
 {
+    create_builtin_annotations();
     if (information.complete().typeid_with_size().type_id()._d() != 0)
     {
         const TypeIdentifier* local_id =
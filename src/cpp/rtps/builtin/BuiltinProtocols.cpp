@@ -31,6 +31,9 @@
 #include <fastdds/rtps/builtin/liveliness/WLP.h>
 
 #include <fastdds/dds/builtin/typelookup/TypeLookupManager.hpp>
+#include <fastdds/builtin/typelookup/TypeObjectCache.hpp>
+
+#include <fastdds/rtps/attributes/PropertyPolicy.h>
 
 #include <rtps/participant/RTPSParticipantImpl.h>
 
@@ -66,7 +69,7 @@ BuiltinProtocols::~BuiltinProtocols()
 
     // TODO Auto-generated destructor stub
     delete mp_WLP;
-    delete tlm_;
+    delete tlm_.load();
     delete mp_PDP;
 
 }
@@ -131,11 +134,17 @@ bool BuiltinProtocols::initBuiltinProtocols(
         mp_WLP->initWL(mp_participantImpl);
     }
 
-    // TypeLookupManager
-    if (m_att.typelookup_config.use_client || m_att.typelookup_config.use_server)
+    // TypeLookupManager. A server has to answer the requests of others from the beginning, but a client only needs
+    // its endpoints once the user asks for a type, which many participants never do. A client with a TypeObject
+    // cache is created now, so the cached types are known before the first type is discovered.
+    bool typelookup_cache = m_att.typelookup_config.use_client && nullptr != PropertyPolicyHelper::find_property(
+        mp_participantImpl->getRTPSParticipantAttributes().properties,
+        fastdds::dds::builtin::TYPE_OBJECT_CACHE_PROPERTY);
+    if (m_att.typelookup_config.use_server || typelookup_cache)
     {
-        tlm_ = new fastdds::dds::builtin::TypeLookupManager(this);
-        tlm_->init_typelookup_service(mp_participantImpl);
+        fastdds::dds::builtin::TypeLookupManager* tlm = new fastdds::dds::builtin::TypeLookupManager(this);
+        tlm->init_typelookup_service(mp_participantImpl);
+        tlm_ = tlm;
     }
 
     if (m_att.discovery_config.discoveryProtocol == DiscoveryProtocol_t::SIMPLE ||
@@ -150,6 +159,40 @@ bool BuiltinProtocols::initBuiltinProtocols(
     return true;
 }
 
+fastdds::dds::builtin::TypeLookupManager* BuiltinProtocols::typelookup_manager()
+{
+    fastdds::dds::builtin::TypeLookupManager* tlm = tlm_;
+    if (tlm != nullptr || !m_att.typelookup_config.use_client || mp_PDP == nullptr)
+    {
+        return tlm;
+    }
+
+    std::lock_guard<std::mutex> guard(tlm_mutex_);
+    tlm = tlm_;
+    if (tlm == nullptr)
+    {
+        tlm = new fastdds::dds::builtin::TypeLookupManager(this);
+        tlm->init_typelookup_service(mp_participantImpl);
+        tlm_ = tlm;
+
+        // Participants discovered from now on are matched by the PDP. The ones discovered before are matched here,
+        // which may match again one being discovered right now, and that is harmless.
+        if (m_att.discovery_config.discoveryProtocol == DiscoveryProtocol_t::SIMPLE)
+        {
+            std::lock_guard<std::recursive_mutex> pdp_guard(*mp_PDP->getMutex());
+            for (auto it = mp_PDP->ParticipantProxiesBegin(); it != mp_PDP->ParticipantProxiesEnd(); ++it)
+            {
+                if ((*it)->m_guid.guidPrefix != mp_participantImpl->getGuid().guidPrefix)
+                {
+                    tlm->assign_remote_endpoints(**it);
+                }
+            }
+        }
+    }
+
+    return tlm;
+}
+
 bool BuiltinProtocols::updateMetatrafficLocators(LocatorList_t& loclist)
 {
     m_metatrafficUnicastLocatorList = loclist;
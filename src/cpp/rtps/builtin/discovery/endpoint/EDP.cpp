@@ -685,6 +685,7 @@ bool EDP::validMatching(
  * XCDR     XCDR2   true
  * XCDR2    XCDR    false
  * XCDR2    XCDR2   true
+ * Writers with the COMPRESSED_XCDR extension only match readers accepting it.
  * @param wdata
  * @param rdata
  * @return
@@ -716,6 +717,13 @@ bool EDP::checkDataRepresentationQos(
                         std::find(rr.begin(), rr.end(),
                                 fastdds::dds::XCDR_DATA_REPRESENTATION) != rr.end() || rr.empty();
             }
+            else if (writerRepresentation == fastdds::dds::COMPRESSED_XCDR_DATA_REPRESENTATION)
+            {
+                // Only readers able to decompress the payloads
+                compatible |=
+                        std::find(rr.begin(), rr.end(),
+                                fastdds::dds::COMPRESSED_XCDR_DATA_REPRESENTATION) != rr.end();
+            }
             else // XML_DATA_REPRESENTATION
             {
                 logInfo(EDP, "DataRepresentationQosPolicy XML_DATA_REPRESENTATION isn't supported.");
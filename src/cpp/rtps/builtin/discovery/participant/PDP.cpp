@@ -918,9 +918,10 @@ bool PDP::remove_remote_participant(
             this->mp_builtin->mp_WLP->removeRemoteEndpoints(pdata);
         }
 
-        if (mp_builtin->tlm_ != nullptr)
+        fastdds::dds::builtin::TypeLookupManager* tlm = mp_builtin->tlm_;
+        if (tlm != nullptr)
         {
-            mp_builtin->tlm_->remove_remote_endpoints(pdata);
+            tlm->remove_remote_endpoints(pdata);
         }
 
         this->mp_EDP->removeRemoteEndpoints(pdata);
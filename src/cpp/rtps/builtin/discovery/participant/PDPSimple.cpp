@@ -442,9 +442,10 @@ void PDPSimple::notifyAboveRemoteEndpoints(
         mp_builtin->mp_WLP->assignRemoteEndpoints(pdata);
     }
 
-    if (mp_builtin->tlm_ != nullptr)
+    fastdds::dds::builtin::TypeLookupManager* tlm = mp_builtin->tlm_;
+    if (tlm != nullptr)
     {
-        mp_builtin->tlm_->assign_remote_endpoints(pdata);
+        tlm->assign_remote_endpoints(pdata);
     }
 }
 
@@ -0,0 +1,307 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SharedBuffer.hpp
+ */
+
+#ifndef RTPS_COMMON_SHAREDBUFFER_HPP
+#define RTPS_COMMON_SHAREDBUFFER_HPP
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <fastdds/rtps/common/Types.h>
+
+#include <atomic>   // std::atomic
+#include <cstdlib>  // malloc, free
+#include <mutex>    // std::mutex
+#include <new>      // placement new
+#include <vector>   // std::vector
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Reference counted heap buffers.
+ *
+ * Buffers are identified by the pointer to their first byte, and their reference count is kept on a
+ * header placed just before it. A buffer is freed when its last reference is released, by whoever
+ * holds it, so its lifetime does not depend on the one of the entity that allocated it.
+ * Buffers taken from a FreeList are given back to it instead, to be reused.
+ * @ingroup COMMON_MODULE
+ */
+class SharedBuffer
+{
+    struct Header;
+
+public:
+
+    /**
+     * Released buffers kept for reuse, on size classes of powers of two.
+     *
+     * The free list is referenced by its creator and by every buffer taken from it, and it is deleted
+     * when all of them have released it. Buffers released after its creator are freed.
+     */
+    class FreeList
+    {
+    public:
+
+        /**
+         * Create a free list, holding the reference of its creator.
+         * @param max_buffers_per_class Maximum number of released buffers kept on each size class.
+         * @return Pointer to the free list.
+         */
+        static FreeList* create(
+                uint32_t max_buffers_per_class)
+        {
+            return new FreeList(max_buffers_per_class);
+        }
+
+        /**
+         * Release the reference of the creator, freeing the buffers kept for reuse.
+         */
+        void release()
+        {
+            {
+                std::lock_guard<std::mutex> guard(mutex_);
+                closed_ = true;
+                for (std::vector<Header*>& size_class : size_classes_)
+                {
+                    for (Header* header : size_class)
+                    {
+                        SharedBuffer::free_header(header);
+                    }
+                    size_class.clear();
+                }
+            }
+
+            release_reference();
+        }
+
+        /**
+         * Take a buffer, reusing a released one of the same size class when possible.
+         * @param size Minimum size of the buffer.
+         * @return Pointer to the buffer, holding one reference. nullptr if it could not be allocated.
+         */
+        octet* allocate(
+                uint32_t size)
+        {
+            uint32_t size_class = class_of(size);
+            if (size_class >= num_size_classes)
+            {
+                return SharedBuffer::allocate(size);
+            }
+
+            Header* header = nullptr;
+            {
+                std::lock_guard<std::mutex> guard(mutex_);
+                std::vector<Header*>& free_buffers = size_classes_[size_class];
+                if (!free_buffers.empty())
+                {
+                    header = free_buffers.back();
+                    free_buffers.pop_back();
+                }
+            }
+
+            if (header == nullptr)
+            {
+                header = SharedBuffer::allocate_header(1u << size_class);
+                if (header == nullptr)
+                {
+                    return nullptr;
+                }
+                header->size_class = size_class;
+            }
+
+            references_.fetch_add(1, std::memory_order_relaxed);
+            header->free_list = this;
+            header->ref_count.store(1, std::memory_order_relaxed);
+            return header->data();
+        }
+
+    private:
+
+        friend class SharedBuffer;
+
+        //! Classes are limited to 2 GiB buffers
+        static constexpr uint32_t num_size_classes = 32;
+
+        explicit FreeList(
+                uint32_t max_buffers_per_class)
+            : references_(1)
+            , max_buffers_per_class_(max_buffers_per_class)
+        {
+        }
+
+        static uint32_t class_of(
+                uint32_t size)
+        {
+            uint32_t size_class = 0;
+            while (size_class < num_size_classes && (1u << size_class) < size)
+            {
+                ++size_class;
+            }
+            return size_class;
+        }
+
+        //! Called when the last reference to a buffer taken from this list is released
+        void recycle(
+                Header* header)
+        {
+            {
+                std::lock_guard<std::mutex> guard(mutex_);
+                std::vector<Header*>& free_buffers = size_classes_[header->size_class];
+                if (!closed_ && free_buffers.size() < max_buffers_per_class_)
+                {
+                    if (free_buffers.capacity() == 0)
+                    {
+                        free_buffers.reserve(max_buffers_per_class_);
+                    }
+                    free_buffers.push_back(header);
+                    header = nullptr;
+                }
+            }
+
+            if (header != nullptr)
+            {
+                SharedBuffer::free_header(header);
+            }
+
+            release_reference();
+        }
+
+        void release_reference()
+        {
+            if (1 == references_.fetch_sub(1, std::memory_order_acq_rel))
+            {
+                delete this;
+            }
+        }
+
+        std::mutex mutex_;
+        std::atomic<uint32_t> references_;
+        uint32_t max_buffers_per_class_;
+        bool closed_ = false;
+        std::vector<Header*> size_classes_[num_size_classes];
+    };
+
+    /**
+     * Allocate a buffer.
+     * @param size Size of the buffer.
+     * @return Pointer to the buffer, holding one reference. nullptr if it could not be allocated.
+     */
+    static octet* allocate(
+            uint32_t size)
+    {
+        Header* header = allocate_header(size);
+        return header != nullptr ? header->data() : nullptr;
+    }
+
+    /**
+     * Add a reference to a buffer. The caller should already hold a reference to it.
+     * @param buffer Pointer to the buffer.
+     */
+    static void add_reference(
+            octet* buffer)
+    {
+        Header::from_data(buffer)->ref_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Release a reference to a buffer, freeing it when this was the last one.
+     * @param buffer Pointer to the buffer.
+     */
+    static void release(
+            octet* buffer)
+    {
+        Header* header = Header::from_data(buffer);
+        if (1 == header->ref_count.fetch_sub(1, std::memory_order_acq_rel))
+        {
+            if (header->free_list != nullptr)
+            {
+                header->free_list->recycle(header);
+            }
+            else
+            {
+                free_header(header);
+            }
+        }
+    }
+
+    /**
+     * Get the number of references to a buffer.
+     * When it is 1, the caller holds the only reference, and every access made through released
+     * references happens before the return of this method.
+     * @param buffer Pointer to the buffer.
+     * @return Number of references.
+     */
+    static uint32_t references(
+            const octet* buffer)
+    {
+        return Header::from_data(const_cast<octet*>(buffer))->ref_count.load(std::memory_order_acquire);
+    }
+
+private:
+
+    // Keeps the buffer 8-byte aligned, as required by CDR deserialization.
+    struct alignas(8) Header
+    {
+        std::atomic<uint32_t> ref_count;
+        uint32_t size_class;
+        FreeList* free_list;
+
+        octet* data()
+        {
+            return reinterpret_cast<octet*>(this + 1);
+        }
+
+        static Header* from_data(
+                octet* data)
+        {
+            return reinterpret_cast<Header*>(data) - 1;
+        }
+
+    };
+
+    static Header* allocate_header(
+            uint32_t size)
+    {
+        void* raw = malloc(sizeof(Header) + size);
+        if (raw == nullptr)
+        {
+            return nullptr;
+        }
+
+        Header* header = new (raw) Header();
+        header->ref_count.store(1, std::memory_order_relaxed);
+        header->size_class = 0;
+        header->free_list = nullptr;
+        return header;
+    }
+
+    static void free_header(
+            Header* header)
+    {
+        header->~Header();
+        free(header);
+    }
+
+};
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
+
+#endif
+#endif  // RTPS_COMMON_SHAREDBUFFER_HPP
@@ -0,0 +1,265 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file LZPayloadCompressor.cpp
+ */
+
+#include <rtps/compression/LZPayloadCompressor.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace eprosima {
+namespace fastdds {
+namespace rtps {
+
+using fastrtps::rtps::octet;
+
+constexpr uint8_t LZPayloadCompressor::identifier;
+
+static constexpr uint32_t min_match = 4;
+static constexpr uint32_t max_offset = 65535;
+static constexpr uint32_t hash_bits = 12;
+
+static inline uint32_t read32(
+        const octet* p)
+{
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint32_t hash(
+        uint32_t sequence)
+{
+    return (sequence * 2654435761u) >> (32 - hash_bits);
+}
+
+static inline bool write_length(
+        uint32_t length,
+        octet* output,
+        uint32_t output_max_length,
+        uint32_t& op)
+{
+    while (length >= 255)
+    {
+        if (op >= output_max_length)
+        {
+            return false;
+        }
+        output[op++] = 255;
+        length -= 255;
+    }
+
+    if (op >= output_max_length)
+    {
+        return false;
+    }
+    output[op++] = static_cast<octet>(length);
+    return true;
+}
+
+static inline bool read_length(
+        const octet* input,
+        uint32_t input_length,
+        uint32_t& ip,
+        uint32_t& length)
+{
+    octet extra;
+    do
+    {
+        if (ip >= input_length)
+        {
+            return false;
+        }
+        extra = input[ip++];
+        length += extra;
+    } while (extra == 255);
+
+    return true;
+}
+
+static bool write_sequence(
+        const octet* literals,
+        uint32_t literals_length,
+        uint32_t offset,
+        uint32_t match_length,
+        octet* output,
+        uint32_t output_max_length,
+        uint32_t& op)
+{
+    if (op >= output_max_length)
+    {
+        return false;
+    }
+
+    uint32_t token_pos = op++;
+    uint32_t literals_nibble = literals_length < 15 ? literals_length : 15;
+    if (literals_nibble == 15 && !write_length(literals_length - 15, output, output_max_length, op))
+    {
+        return false;
+    }
+
+    if (literals_length > output_max_length - op)
+    {
+        return false;
+    }
+    memcpy(&output[op], literals, literals_length);
+    op += literals_length;
+
+    uint32_t match_nibble = 0;
+    if (match_length > 0)
+    {
+        if (output_max_length - op < 2)
+        {
+            return false;
+        }
+        output[op++] = static_cast<octet>(offset & 0xFF);
+        output[op++] = static_cast<octet>(offset >> 8);
+
+        uint32_t extra = match_length - min_match;
+        match_nibble = extra < 15 ? extra : 15;
+        if (match_nibble == 15 && !write_length(extra - 15, output, output_max_length, op))
+        {
+            return false;
+        }
+    }
+
+    output[token_pos] = static_cast<octet>((literals_nibble << 4) | match_nibble);
+    return true;
+}
+
+bool LZPayloadCompressor::compress(
+        const octet* input,
+        uint32_t input_length,
+        octet* output,
+        uint32_t output_max_length,
+        uint32_t& output_length) const
+{
+    uint32_t table[1u << hash_bits];
+    std::fill(std::begin(table), std::end(table), UINT32_MAX);
+
+    uint32_t op = 0;
+    uint32_t anchor = 0;
+    uint32_t ip = 0;
+
+    while (input_length >= min_match && ip <= input_length - min_match)
+    {
+        uint32_t sequence = read32(&input[ip]);
+        uint32_t& entry = table[hash(sequence)];
+        uint32_t ref = entry;
+        entry = ip;
+
+        if (ref != UINT32_MAX && ip - ref <= max_offset && read32(&input[ref]) == sequence)
+        {
+            uint32_t match_length = min_match;
+            while (ip + match_length < input_length && input[ref + match_length] == input[ip + match_length])
+            {
+                ++match_length;
+            }
+
+            if (!write_sequence(&input[anchor], ip - anchor, ip - ref, match_length, output, output_max_length, op))
+            {
+                return false;
+            }
+
+            ip += match_length;
+            anchor = ip;
+        }
+        else
+        {
+            ++ip;
+        }
+    }
+
+    if (!write_sequence(&input[anchor], input_length - anchor, 0, 0, output, output_max_length, op))
+    {
+        return false;
+    }
+
+    output_length = op;
+    return true;
+}
+
+bool LZPayloadCompressor::decompress(
+        const octet* input,
+        uint32_t input_length,
+        octet* output,
+        uint32_t output_length) const
+{
+    uint32_t ip = 0;
+    uint32_t op = 0;
+
+    while (ip < input_length)
+    {
+        octet token = input[ip++];
+
+        uint32_t literals_length = token >> 4;
+        if (literals_length == 15 && !read_length(input, input_length, ip, literals_length))
+        {
+            return false;
+        }
+        if (literals_length > input_length - ip || literals_length > output_length - op)
+        {
+            return false;
+        }
+        memcpy(&output[op], &input[ip], literals_length);
+        ip += literals_length;
+        op += literals_length;
+
+        // The last sequence only has literals
+        if (ip == input_length)
+        {
+            break;
+        }
+
+        if (input_length - ip < 2)
+        {
+            return false;
+        }
+        uint32_t offset = input[ip] | (static_cast<uint32_t>(input[ip + 1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > op)
+        {
+            return false;
+        }
+
+        uint32_t match_length = token & 0x0F;
+        if (match_length == 15 && !read_length(input, input_length, ip, match_length))
+        {
+            return false;
+        }
+        match_length += min_match;
+        if (match_length > output_length - op)
+        {
+            return false;
+        }
+
+        // Source and destination may overlap, so copy byte by byte
+        const octet* match = &output[op - offset];
+        for (uint32_t n = 0; n < match_length; ++n)
+        {
+            output[op + n] = match[n];
+        }
+        op += match_length;
+    }
+
+    return op == output_length;
+}
+
+} // namespace rtps
+} // namespace fastdds
+} // namespace eprosima
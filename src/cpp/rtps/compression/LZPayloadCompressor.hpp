@@ -0,0 +1,67 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file LZPayloadCompressor.hpp
+ */
+
+#ifndef RTPS_COMPRESSION_LZPAYLOADCOMPRESSOR_HPP
+#define RTPS_COMPRESSION_LZPAYLOADCOMPRESSOR_HPP
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <fastdds/rtps/compression/PayloadCompressor.hpp>
+
+namespace eprosima {
+namespace fastdds {
+namespace rtps {
+
+/**
+ * Built-in fast codec, a byte oriented LZ77 variant.
+ *
+ * Compressed data is a list of sequences, each one made of a token, a run of literal bytes, and a match
+ * (a 16-bit offset into the already decompressed data and a length). The high nibble of the token is the
+ * number of literals, and the low nibble the length of the match minus 4. Nibbles equal to 15 are followed
+ * by extra length bytes, added until one of them is not 255. The last sequence only has literals.
+ */
+class LZPayloadCompressor : public PayloadCompressor
+{
+public:
+
+    static constexpr uint8_t identifier = 1;
+
+    uint8_t id() const override
+    {
+        return identifier;
+    }
+
+    bool compress(
+            const fastrtps::rtps::octet* input,
+            uint32_t input_length,
+            fastrtps::rtps::octet* output,
+            uint32_t output_max_length,
+            uint32_t& output_length) const override;
+
+    bool decompress(
+            const fastrtps::rtps::octet* input,
+            uint32_t input_length,
+            fastrtps::rtps::octet* output,
+            uint32_t output_length) const override;
+};
+
+} // namespace rtps
+} // namespace fastdds
+} // namespace eprosima
+
+#endif
+#endif  // RTPS_COMPRESSION_LZPAYLOADCOMPRESSOR_HPP
@@ -0,0 +1,235 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PayloadCompression.cpp
+ */
+
+#include <rtps/compression/PayloadCompression.hpp>
+#include <rtps/compression/LZPayloadCompressor.hpp>
+
+#include <fastdds/dds/log/Log.hpp>
+
+#include <cassert>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+namespace eprosima {
+namespace fastdds {
+namespace rtps {
+
+using fastrtps::rtps::octet;
+using fastrtps::rtps::SerializedPayload_t;
+
+constexpr uint32_t PayloadCompression::header_size;
+
+//! Marker placed instead of the encapsulation identifier on compressed payloads.
+static constexpr octet COMPRESSED_ENCAPSULATION[2] = { 0xC0, 0x01 };
+
+//! Identifiers below this one are reserved for the built-in codecs.
+static constexpr uint8_t first_custom_codec_id = 128;
+
+class PayloadCompressorTable
+{
+public:
+
+    static PayloadCompressorTable& instance()
+    {
+        static PayloadCompressorTable table;
+        return table;
+    }
+
+    std::mutex mutex;
+
+    std::map<std::string, std::shared_ptr<PayloadCompressor> > by_name;
+
+    std::map<uint8_t, std::shared_ptr<PayloadCompressor> > by_id;
+
+private:
+
+    PayloadCompressorTable()
+    {
+        std::shared_ptr<PayloadCompressor> lz = std::make_shared<LZPayloadCompressor>();
+        by_name["lz"] = lz;
+        by_id[lz->id()] = lz;
+    }
+
+};
+
+bool PayloadCompressorRegistry::register_compressor(
+        const std::string& name,
+        std::shared_ptr<PayloadCompressor> compressor)
+{
+    PayloadCompressorTable& table = PayloadCompressorTable::instance();
+    std::lock_guard<std::mutex> guard(table.mutex);
+
+    if (!compressor || table.by_name.count(name) > 0 || table.by_id.count(compressor->id()) > 0)
+    {
+        return false;
+    }
+
+    if (compressor->id() < first_custom_codec_id)
+    {
+        logError(RTPS_COMPRESSION, "Codec " << name << " uses identifier " << int(compressor->id())
+                                            << ", reserved for the built-in codecs");
+        return false;
+    }
+
+    table.by_name[name] = compressor;
+    table.by_id[compressor->id()] = compressor;
+    return true;
+}
+
+std::shared_ptr<PayloadCompressor> PayloadCompressorRegistry::find(
+        const std::string& name)
+{
+    PayloadCompressorTable& table = PayloadCompressorTable::instance();
+    std::lock_guard<std::mutex> guard(table.mutex);
+
+    auto it = table.by_name.find(name);
+    return it == table.by_name.end() ? nullptr : it->second;
+}
+
+std::shared_ptr<PayloadCompressor> PayloadCompressorRegistry::find(
+        uint8_t id)
+{
+    PayloadCompressorTable& table = PayloadCompressorTable::instance();
+    std::lock_guard<std::mutex> guard(table.mutex);
+
+    auto it = table.by_id.find(id);
+    return it == table.by_id.end() ? nullptr : it->second;
+}
+
+std::shared_ptr<PayloadCompressor> PayloadCompression::writer_compressor(
+        const fastdds::dds::DataRepresentationQosPolicy& representation,
+        const fastrtps::rtps::PropertyPolicy& properties)
+{
+    if (representation.m_value.empty() ||
+            representation.m_value.front() != fastdds::dds::COMPRESSED_XCDR_DATA_REPRESENTATION)
+    {
+        return nullptr;
+    }
+
+    std::string codec = "lz";
+    const std::string* codec_property =
+            fastrtps::rtps::PropertyPolicyHelper::find_property(properties, "fastdds.compression.codec");
+    if (codec_property != nullptr)
+    {
+        codec = *codec_property;
+    }
+
+    std::shared_ptr<PayloadCompressor> compressor = PayloadCompressorRegistry::find(codec);
+    if (!compressor)
+    {
+        logError(RTPS_COMPRESSION, "Unknown compression codec " << codec << ". Payloads will not be compressed");
+    }
+    return compressor;
+}
+
+bool PayloadCompression::compress(
+        const PayloadCompressor& compressor,
+        SerializedPayload_t& payload,
+        std::vector<octet>& buffer)
+{
+    if (payload.length <= header_size)
+    {
+        return false;
+    }
+
+    // Only worth it when the result is smaller than the original payload
+    uint32_t max_length = payload.length - header_size;
+    if (buffer.size() < max_length)
+    {
+        buffer.resize(max_length);
+    }
+
+    uint32_t compressed_length = 0;
+    if (!compressor.compress(payload.data, payload.length, buffer.data(), max_length, compressed_length))
+    {
+        return false;
+    }
+
+    octet* header = payload.data;
+    header[0] = COMPRESSED_ENCAPSULATION[0];
+    header[1] = COMPRESSED_ENCAPSULATION[1];
+    header[2] = compressor.id();
+    header[3] = 0;
+    header[4] = static_cast<octet>(payload.length);
+    header[5] = static_cast<octet>(payload.length >> 8);
+    header[6] = static_cast<octet>(payload.length >> 16);
+    header[7] = static_cast<octet>(payload.length >> 24);
+    memcpy(&payload.data[header_size], buffer.data(), compressed_length);
+    payload.length = header_size + compressed_length;
+    return true;
+}
+
+bool PayloadCompression::is_compressed(
+        const SerializedPayload_t& payload)
+{
+    return payload.length > header_size &&
+           payload.data[0] == COMPRESSED_ENCAPSULATION[0] &&
+           payload.data[1] == COMPRESSED_ENCAPSULATION[1];
+}
+
+bool PayloadCompression::decompress(
+        const SerializedPayload_t& payload,
+        SerializedPayload_t& decompressed,
+        uint32_t max_length,
+        std::shared_ptr<PayloadCompressor>& compressor)
+{
+    assert(is_compressed(payload));
+
+    // Writers keep their codec, so the registry is only looked up for the first payload of each one
+    if (!compressor || compressor->id() != payload.data[2])
+    {
+        compressor = PayloadCompressorRegistry::find(payload.data[2]);
+        if (!compressor)
+        {
+            logError(RTPS_COMPRESSION, "Received payload compressed with unknown codec " << int(payload.data[2]));
+            return false;
+        }
+    }
+
+    uint32_t length = static_cast<uint32_t>(payload.data[4]) |
+            (static_cast<uint32_t>(payload.data[5]) << 8) |
+            (static_cast<uint32_t>(payload.data[6]) << 16) |
+            (static_cast<uint32_t>(payload.data[7]) << 24);
+    if (length > max_length)
+    {
+        logWarning(RTPS_COMPRESSION, "Discarding compressed payload of " << length << " bytes, above the maximum of "
+                                                                        << max_length);
+        return false;
+    }
+
+    if (decompressed.max_size < length)
+    {
+        decompressed.reserve(length);
+    }
+
+    if (!compressor->decompress(&payload.data[header_size], payload.length - header_size, decompressed.data, length))
+    {
+        logError(RTPS_COMPRESSION, "Malformed compressed payload");
+        return false;
+    }
+
+    decompressed.length = length;
+    decompressed.pos = 0;
+    decompressed.encapsulation = payload.encapsulation;
+    return true;
+}
+
+} // namespace rtps
+} // namespace fastdds
+} // namespace eprosima
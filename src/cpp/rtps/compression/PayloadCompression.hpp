@@ -0,0 +1,103 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PayloadCompression.hpp
+ */
+
+#ifndef RTPS_COMPRESSION_PAYLOADCOMPRESSION_HPP
+#define RTPS_COMPRESSION_PAYLOADCOMPRESSION_HPP
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <fastdds/rtps/compression/PayloadCompressor.hpp>
+#include <fastdds/rtps/common/SerializedPayload.h>
+#include <fastdds/rtps/attributes/PropertyPolicy.h>
+#include <fastdds/dds/core/policy/QosPolicies.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace eprosima {
+namespace fastdds {
+namespace rtps {
+
+/**
+ * Compression and decompression of serialized payloads.
+ *
+ * A compressed payload starts with a header in place of the encapsulation of the serialized data:
+ * two bytes with the COMPRESSED_ENCAPSULATION marker, one byte with the identifier of the codec,
+ * one reserved byte, and the length of the uncompressed payload as a little-endian 32-bit integer.
+ * Payloads that would not shrink are kept uncompressed, so readers check the marker on every sample.
+ */
+class PayloadCompression
+{
+public:
+
+    //! Size of the header of a compressed payload.
+    static constexpr uint32_t header_size = 8;
+
+    /**
+     * Get the codec a writer should use.
+     * Writers whose preferred data representation is COMPRESSED_XCDR_DATA_REPRESENTATION use the codec named on
+     * property "fastdds.compression.codec", or the built-in "lz" codec when the property is not present.
+     * @param representation Data representation QoS of the writer.
+     * @param properties Properties of the writer.
+     * @return The codec to use, or nullptr if payloads should not be compressed.
+     */
+    static std::shared_ptr<PayloadCompressor> writer_compressor(
+            const fastdds::dds::DataRepresentationQosPolicy& representation,
+            const fastrtps::rtps::PropertyPolicy& properties);
+
+    /**
+     * Compress a payload in place, if that makes it smaller.
+     * @param compressor Codec to use.
+     * @param payload Serialized payload to compress.
+     * @param buffer Scratch buffer, kept by the caller to avoid allocations.
+     * @return true if the payload has been compressed.
+     */
+    static bool compress(
+            const PayloadCompressor& compressor,
+            fastrtps::rtps::SerializedPayload_t& payload,
+            std::vector<fastrtps::rtps::octet>& buffer);
+
+    /**
+     * Check whether a payload has been compressed.
+     * @param payload Payload to check.
+     * @return true if the payload starts with the header of a compressed payload.
+     */
+    static bool is_compressed(
+            const fastrtps::rtps::SerializedPayload_t& payload);
+
+    /**
+     * Decompress a payload.
+     * @param payload Compressed payload.
+     * @param decompressed Payload where the decompressed data is written. It is resized when needed.
+     * @param max_length Maximum length of the decompressed data, i.e. the payload size of the reader history.
+     * @param [in,out] compressor Codec of the previous payload decompressed by the caller. The registry is only
+     * looked up when the payload uses another codec, and then this is updated with the codec found.
+     * @return false if the codec is not registered, the payload is malformed or it would exceed max_length.
+     */
+    static bool decompress(
+            const fastrtps::rtps::SerializedPayload_t& payload,
+            fastrtps::rtps::SerializedPayload_t& decompressed,
+            uint32_t max_length,
+            std::shared_ptr<PayloadCompressor>& compressor);
+};
+
+} // namespace rtps
+} // namespace fastdds
+} // namespace eprosima
+
+#endif
+#endif  // RTPS_COMPRESSION_PAYLOADCOMPRESSION_HPP
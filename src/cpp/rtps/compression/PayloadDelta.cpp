@@ -0,0 +1,367 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PayloadDelta.cpp
+ */
+
+#include <rtps/compression/PayloadDelta.hpp>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace eprosima {
+namespace fastdds {
+namespace rtps {
+
+using fastrtps::DeltaKeyframe;
+using fastrtps::rtps::octet;
+using fastrtps::rtps::SerializedPayload_t;
+
+constexpr uint32_t PayloadDelta::header_size;
+
+//! Marker placed instead of the encapsulation identifier on delta encoded payloads.
+static constexpr octet DELTA_ENCAPSULATION[2] = { 0xC0, 0x02 };
+
+static constexpr octet KIND_KEYFRAME = 0;
+static constexpr octet KIND_DELTA = 1;
+
+//! Unchanged runs shorter than this are cheaper to resend than to skip.
+static constexpr uint32_t min_skip = 4;
+
+static inline void write32(
+        octet* p,
+        uint32_t value)
+{
+    p[0] = static_cast<octet>(value);
+    p[1] = static_cast<octet>(value >> 8);
+    p[2] = static_cast<octet>(value >> 16);
+    p[3] = static_cast<octet>(value >> 24);
+}
+
+static inline uint32_t read32(
+        const octet* p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static inline void write_header(
+        octet* p,
+        octet kind,
+        uint32_t id,
+        uint32_t length)
+{
+    p[0] = DELTA_ENCAPSULATION[0];
+    p[1] = DELTA_ENCAPSULATION[1];
+    p[2] = kind;
+    p[3] = 0;
+    write32(&p[4], id);
+    write32(&p[8], length);
+}
+
+static inline bool write_varint(
+        uint32_t value,
+        octet* output,
+        uint32_t output_max_length,
+        uint32_t& op)
+{
+    do
+    {
+        if (op >= output_max_length)
+        {
+            return false;
+        }
+        octet byte = static_cast<octet>(value & 0x7F);
+        value >>= 7;
+        output[op++] = value != 0 ? static_cast<octet>(byte | 0x80) : byte;
+    } while (value != 0);
+
+    return true;
+}
+
+static inline bool read_varint(
+        const octet* input,
+        uint32_t input_length,
+        uint32_t& ip,
+        uint32_t& value)
+{
+    value = 0;
+    for (uint32_t shift = 0; shift < 32; shift += 7)
+    {
+        if (ip >= input_length)
+        {
+            return false;
+        }
+        octet byte = input[ip++];
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Write the runs of bytes of sample that differ from reference, both with the same length.
+ * @return false if the runs do not fit on output_max_length bytes.
+ */
+static bool write_runs(
+        const octet* reference,
+        const octet* sample,
+        uint32_t length,
+        octet* output,
+        uint32_t output_max_length,
+        uint32_t& op)
+{
+    uint32_t pos = 0;
+    uint32_t last = 0;
+    while (pos < length)
+    {
+        // Skip unchanged bytes
+        while (pos < length && reference[pos] == sample[pos])
+        {
+            ++pos;
+        }
+        if (pos == length)
+        {
+            break;
+        }
+
+        // Extend the run until enough unchanged bytes are found
+        uint32_t run_end = pos;
+        uint32_t unchanged = 0;
+        for (uint32_t n = pos; n < length && unchanged < min_skip; ++n)
+        {
+            if (reference[n] == sample[n])
+            {
+                ++unchanged;
+            }
+            else
+            {
+                unchanged = 0;
+                run_end = n + 1;
+            }
+        }
+
+        uint32_t run_length = run_end - pos;
+        if (!write_varint(pos - last, output, output_max_length, op) ||
+                !write_varint(run_length, output, output_max_length, op) ||
+                run_length > output_max_length - op)
+        {
+            return false;
+        }
+        memcpy(&output[op], &sample[pos], run_length);
+        op += run_length;
+
+        pos = run_end;
+        last = run_end;
+    }
+
+    return true;
+}
+
+static void encode_keyframe(
+        DeltaKeyframe& keyframe,
+        uint32_t max_length,
+        SerializedPayload_t& payload)
+{
+    uint32_t length = payload.length;
+    if (length > max_length || max_length - length < PayloadDelta::header_size)
+    {
+        // Sent as is, so readers would not have a keyframe for the next deltas
+        keyframe.data.clear();
+        return;
+    }
+
+    keyframe.id++;
+    keyframe.samples_since = 0;
+    keyframe.data.assign(payload.data, payload.data + length);
+
+    if (payload.max_size < length + PayloadDelta::header_size)
+    {
+        payload.reserve(length + PayloadDelta::header_size);
+    }
+    memmove(&payload.data[PayloadDelta::header_size], payload.data, length);
+    write_header(payload.data, KIND_KEYFRAME, keyframe.id, length);
+    payload.length = length + PayloadDelta::header_size;
+}
+
+uint32_t PayloadDelta::keyframe_period(
+        const fastrtps::rtps::PropertyPolicy& properties)
+{
+    const std::string* property =
+            fastrtps::rtps::PropertyPolicyHelper::find_property(properties, "fastdds.delta_encoding.keyframe_period");
+    if (property == nullptr)
+    {
+        return 0;
+    }
+
+    return static_cast<uint32_t>(std::strtoul(property->c_str(), nullptr, 10));
+}
+
+bool PayloadDelta::encode(
+        DeltaKeyframe& keyframe,
+        uint32_t keyframe_period,
+        uint32_t max_length,
+        SerializedPayload_t& payload,
+        std::vector<octet>& buffer)
+{
+    if (keyframe.data.empty() || keyframe.samples_since + 1 >= keyframe_period ||
+            keyframe.data.size() != payload.length || payload.length <= header_size)
+    {
+        encode_keyframe(keyframe, max_length, payload);
+        return false;
+    }
+
+    // Only worth it when the delta is smaller than the sample
+    uint32_t max_delta_length = payload.length - header_size;
+    if (buffer.size() < max_delta_length)
+    {
+        buffer.resize(max_delta_length);
+    }
+
+    uint32_t delta_length = 0;
+    if (!write_runs(keyframe.data.data(), payload.data, payload.length, buffer.data(), max_delta_length,
+            delta_length))
+    {
+        encode_keyframe(keyframe, max_length, payload);
+        return false;
+    }
+
+    keyframe.samples_since++;
+    write_header(payload.data, KIND_DELTA, keyframe.id, payload.length);
+    memcpy(&payload.data[header_size], buffer.data(), delta_length);
+    payload.length = header_size + delta_length;
+    return true;
+}
+
+bool PayloadDelta::is_encoded(
+        const SerializedPayload_t& payload)
+{
+    return payload.length >= header_size &&
+           payload.data[0] == DELTA_ENCAPSULATION[0] &&
+           payload.data[1] == DELTA_ENCAPSULATION[1];
+}
+
+bool PayloadDelta::read_header(
+        const SerializedPayload_t& payload,
+        bool& is_keyframe,
+        uint32_t& keyframe_id)
+{
+    if (!is_encoded(payload) || (payload.data[2] != KIND_KEYFRAME && payload.data[2] != KIND_DELTA))
+    {
+        return false;
+    }
+
+    is_keyframe = payload.data[2] == KIND_KEYFRAME;
+    keyframe_id = read32(&payload.data[4]);
+    return true;
+}
+
+void PayloadDelta::store_keyframe(
+        const SerializedPayload_t& payload,
+        DeltaKeyframe& keyframe)
+{
+    if (!is_encoded(payload) || payload.data[2] != KIND_KEYFRAME)
+    {
+        return;
+    }
+
+    uint32_t id = read32(&payload.data[4]);
+    uint32_t length = read32(&payload.data[8]);
+    if (length != payload.length - header_size || (id == keyframe.id && !keyframe.data.empty()))
+    {
+        return;
+    }
+
+    keyframe.id = id;
+    keyframe.data.assign(&payload.data[header_size], &payload.data[header_size] + length);
+}
+
+bool PayloadDelta::decode(
+        const SerializedPayload_t& payload,
+        DeltaKeyframe& keyframe,
+        SerializedPayload_t& decoded)
+{
+    if (!is_encoded(payload))
+    {
+        return false;
+    }
+
+    uint32_t id = read32(&payload.data[4]);
+    uint32_t length = read32(&payload.data[8]);
+    if (payload.data[2] == KIND_KEYFRAME)
+    {
+        if (length != payload.length - header_size)
+        {
+            return false;
+        }
+
+        store_keyframe(payload, keyframe);
+        if (decoded.max_size < length)
+        {
+            decoded.reserve(length);
+        }
+        memcpy(decoded.data, &payload.data[header_size], length);
+    }
+    else if (payload.data[2] == KIND_DELTA)
+    {
+        if (keyframe.data.empty() || keyframe.id != id || keyframe.data.size() != length)
+        {
+            return false;
+        }
+
+        if (decoded.max_size < length)
+        {
+            decoded.reserve(length);
+        }
+        memcpy(decoded.data, keyframe.data.data(), length);
+
+        const octet* input = &payload.data[header_size];
+        uint32_t input_length = payload.length - header_size;
+        uint32_t ip = 0;
+        uint32_t pos = 0;
+        while (ip < input_length)
+        {
+            uint32_t skip = 0;
+            uint32_t run_length = 0;
+            if (!read_varint(input, input_length, ip, skip) || !read_varint(input, input_length, ip, run_length) ||
+                    skip > length - pos || run_length > length - pos - skip || run_length > input_length - ip)
+            {
+                return false;
+            }
+
+            pos += skip;
+            memcpy(&decoded.data[pos], &input[ip], run_length);
+            pos += run_length;
+            ip += run_length;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    decoded.length = length;
+    decoded.pos = 0;
+    decoded.encapsulation = payload.encapsulation;
+    return true;
+}
+
+} // namespace rtps
+} // namespace fastdds
+} // namespace eprosima
@@ -0,0 +1,132 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PayloadDelta.hpp
+ */
+
+#ifndef RTPS_COMPRESSION_PAYLOADDELTA_HPP
+#define RTPS_COMPRESSION_PAYLOADDELTA_HPP
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <fastdds/rtps/common/SerializedPayload.h>
+#include <fastdds/rtps/attributes/PropertyPolicy.h>
+#include <fastrtps/common/KeyedChanges.h>
+
+#include <vector>
+
+namespace eprosima {
+namespace fastdds {
+namespace rtps {
+
+/**
+ * Per-instance delta encoding of serialized payloads.
+ *
+ * The writer keeps the last full sample (keyframe) of each instance. Following samples with the same length are
+ * sent as the list of byte runs that differ from the keyframe, until a new keyframe is sent every
+ * keyframe period samples. Deltas always refer to a keyframe, never to a previous delta, so a lost delta only
+ * affects itself, and a reader recovers from a lost keyframe on the next one.
+ * Readers keep every keyframe still referenced by a sample on their history. Writers only delta encode when
+ * their samples are not kept for late joiners, which could otherwise get deltas of a keyframe no longer sent.
+ *
+ * Encoded payloads start with a header in place of the encapsulation of the serialized data: two bytes with the
+ * DELTA_ENCAPSULATION marker, one byte with the kind (keyframe or delta), one reserved byte, the identifier of
+ * the keyframe, and the length of the full sample, both as little-endian 32-bit integers.
+ * A keyframe is the header followed by the full sample. A delta is the header followed by a list of runs, each
+ * one made of the number of unchanged bytes to skip, the number of bytes replaced (both as LEB128 integers),
+ * and the replacing bytes.
+ */
+class PayloadDelta
+{
+public:
+
+    //! Size of the header of an encoded payload.
+    static constexpr uint32_t header_size = 12;
+
+    /**
+     * Get the keyframe period a writer should use.
+     * Delta encoding is enabled with the property "fastdds.delta_encoding.keyframe_period", which holds the
+     * number of samples of an instance sent between two keyframes.
+     * @param properties Properties of the writer.
+     * @return Number of samples between keyframes, or 0 if delta encoding is disabled.
+     */
+    static uint32_t keyframe_period(
+            const fastrtps::rtps::PropertyPolicy& properties);
+
+    /**
+     * Encode a serialized sample in place, either as a keyframe or as a delta against the last keyframe.
+     * A sample that would not fit on max_length bytes as a keyframe is left unencoded, and the next sample
+     * is sent as a keyframe.
+     * @param keyframe Last keyframe of the instance. It is updated when a new keyframe is sent.
+     * @param keyframe_period Number of samples between keyframes.
+     * @param max_length Maximum length of the encoded payload, i.e. the payload size of the histories.
+     * @param payload Serialized sample to encode.
+     * @param buffer Scratch buffer, kept by the caller to avoid allocations.
+     * @return true if the payload has been encoded as a delta, false otherwise.
+     */
+    static bool encode(
+            fastrtps::DeltaKeyframe& keyframe,
+            uint32_t keyframe_period,
+            uint32_t max_length,
+            fastrtps::rtps::SerializedPayload_t& payload,
+            std::vector<fastrtps::rtps::octet>& buffer);
+
+    /**
+     * Check whether a payload has been delta encoded.
+     * @param payload Payload to check.
+     * @return true if the payload starts with the header of an encoded payload.
+     */
+    static bool is_encoded(
+            const fastrtps::rtps::SerializedPayload_t& payload);
+
+    /**
+     * Read the header of an encoded payload.
+     * @param payload Payload to read.
+     * @param is_keyframe Set to true when the payload is a keyframe, false when it is a delta.
+     * @param keyframe_id Set to the identifier of the keyframe carried or referenced by the payload.
+     * @return false if the payload is not encoded.
+     */
+    static bool read_header(
+            const fastrtps::rtps::SerializedPayload_t& payload,
+            bool& is_keyframe,
+            uint32_t& keyframe_id);
+
+    /**
+     * Keep the full sample of an encoded payload if it is a keyframe.
+     * @param payload Encoded payload.
+     * @param keyframe Last keyframe of the instance, updated if the payload is a newer keyframe.
+     */
+    static void store_keyframe(
+            const fastrtps::rtps::SerializedPayload_t& payload,
+            fastrtps::DeltaKeyframe& keyframe);
+
+    /**
+     * Rebuild the full sample of an encoded payload.
+     * @param payload Encoded payload.
+     * @param keyframe Last keyframe of the instance. It is updated if the payload is a newer keyframe.
+     * @param decoded Payload where the full sample is written. It is resized when needed.
+     * @return false if the payload is malformed or refers to a keyframe that has not been received.
+     */
+    static bool decode(
+            const fastrtps::rtps::SerializedPayload_t& payload,
+            fastrtps::DeltaKeyframe& keyframe,
+            fastrtps::rtps::SerializedPayload_t& decoded);
+};
+
+} // namespace rtps
+} // namespace fastdds
+} // namespace eprosima
+
+#endif
+#endif  // RTPS_COMPRESSION_PAYLOADDELTA_HPP
@@ -0,0 +1,101 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/flowcontrol/CongestionController.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+static void read_property(
+        const PropertyPolicy& properties,
+        const std::string& name,
+        uint32_t& value)
+{
+    const std::string* property = PropertyPolicyHelper::find_property(properties, name);
+    if (property != nullptr)
+    {
+        uint32_t read_value = static_cast<uint32_t>(std::strtoul(property->c_str(), nullptr, 10));
+        if (read_value > 0)
+        {
+            value = read_value;
+        }
+    }
+}
+
+bool CongestionControllerDescriptor::from_properties(
+        const PropertyPolicy& properties,
+        const ThroughputControllerDescriptor& throughput,
+        CongestionControllerDescriptor& descriptor)
+{
+    const std::string* kind = PropertyPolicyHelper::find_property(properties, "fastdds.congestion_control");
+    if (kind == nullptr || *kind != "AIMD")
+    {
+        return false;
+    }
+
+    if (throughput.bytesPerPeriod != UINT32_MAX && throughput.periodMillisecs != 0)
+    {
+        descriptor.periodMillisecs = throughput.periodMillisecs;
+        descriptor.maxBytesPerPeriod = throughput.bytesPerPeriod;
+    }
+
+    read_property(properties, "fastdds.congestion_control.period_ms", descriptor.periodMillisecs);
+    read_property(properties, "fastdds.congestion_control.initial_bytes", descriptor.initialBytesPerPeriod);
+    read_property(properties, "fastdds.congestion_control.min_bytes", descriptor.minBytesPerPeriod);
+    read_property(properties, "fastdds.congestion_control.additive_increase", descriptor.additiveIncrease);
+
+    descriptor.minBytesPerPeriod = (std::min)(descriptor.minBytesPerPeriod, descriptor.maxBytesPerPeriod);
+    descriptor.initialBytesPerPeriod = (std::max)(descriptor.minBytesPerPeriod,
+                    (std::min)(descriptor.initialBytesPerPeriod, descriptor.maxBytesPerPeriod));
+    return true;
+}
+
+CongestionController::CongestionController(
+        const CongestionControllerDescriptor& descriptor,
+        RTPSWriter* associatedWriter)
+    : ThroughputController(
+        ThroughputControllerDescriptor(descriptor.initialBytesPerPeriod, descriptor.periodMillisecs),
+        associatedWriter)
+    , mDescriptor(descriptor)
+    , mLastDecrease(std::chrono::steady_clock::now() - std::chrono::milliseconds(descriptor.periodMillisecs))
+{
+}
+
+void CongestionController::NotifyAcknowledgement()
+{
+    uint32_t window = bytes_per_period();
+    uint32_t room = mDescriptor.maxBytesPerPeriod - window;
+    bytes_per_period(window + (std::min)(room, mDescriptor.additiveIncrease));
+}
+
+void CongestionController::NotifyLoss()
+{
+    // Several readers usually report the same loss, so the window is only decreased once per period
+    auto now = std::chrono::steady_clock::now();
+    if (now - mLastDecrease < std::chrono::milliseconds(mDescriptor.periodMillisecs))
+    {
+        return;
+    }
+
+    mLastDecrease = now;
+    bytes_per_period((std::max)(mDescriptor.minBytesPerPeriod, bytes_per_period() / 2));
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
@@ -0,0 +1,95 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CONGESTION_CONTROLLER_H
+#define CONGESTION_CONTROLLER_H
+
+#include <rtps/flowcontrol/ThroughputController.h>
+#include <fastdds/rtps/attributes/PropertyPolicy.h>
+
+#include <chrono>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Configuration of a CongestionController.
+ */
+struct CongestionControllerDescriptor
+{
+    //! Window of time in which no more than the congestion window is allowed.
+    uint32_t periodMillisecs = 100;
+    //! Initial size in bytes of the congestion window.
+    uint32_t initialBytesPerPeriod = 256 * 1024;
+    //! Minimum size in bytes of the congestion window. Should be greater than the size of a fragment.
+    uint32_t minBytesPerPeriod = 64 * 1024;
+    //! Maximum size in bytes of the congestion window.
+    uint32_t maxBytesPerPeriod = UINT32_MAX;
+    //! Bytes added to the congestion window on each acknowledgement without losses.
+    uint32_t additiveIncrease = 64 * 1024;
+
+    /**
+     * Fill a descriptor from the properties of a writer.
+     * Congestion control is enabled with property "fastdds.congestion_control" set to "AIMD".
+     * When the writer has a throughput controller, its values are used as the period and the maximum window.
+     * @param properties Properties of the writer.
+     * @param throughput Throughput controller descriptor of the writer.
+     * @param descriptor Descriptor to fill.
+     * @return true if congestion control is enabled on the properties.
+     */
+    static bool from_properties(
+            const PropertyPolicy& properties,
+            const ThroughputControllerDescriptor& throughput,
+            CongestionControllerDescriptor& descriptor);
+};
+
+/**
+ * Throughput controller whose allowed bytes per period adapt to the feedback of the remote readers.
+ *
+ * The window grows additively on each acknowledgement without losses, and is halved when a
+ * remote reader requests retransmissions (ACKNACK with missing samples, or NACK_FRAG), at most once per period.
+ * This paces big fragmented samples to the rate the network is able to deliver, instead of sending
+ * all the fragments back to back.
+ */
+class CongestionController : public ThroughputController
+{
+public:
+
+    CongestionController(
+            const CongestionControllerDescriptor& descriptor,
+            RTPSWriter* associatedWriter);
+
+    virtual void NotifyAcknowledgement() override;
+
+    virtual void NotifyLoss() override;
+
+    //! @return Current size in bytes of the congestion window.
+    uint32_t window()
+    {
+        return bytes_per_period();
+    }
+
+private:
+
+    CongestionControllerDescriptor mDescriptor;
+
+    std::chrono::steady_clock::time_point mLastDecrease;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif
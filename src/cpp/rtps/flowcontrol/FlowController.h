@@ -50,6 +50,12 @@ class FlowController
 
         virtual void disable() = 0;
 
+        //! Called when a remote reader acknowledges data without requesting any retransmission.
+        virtual void NotifyAcknowledgement(){}
+
+        //! Called when a remote reader requests the retransmission of data or fragments.
+        virtual void NotifyLoss(){}
+
         virtual ~FlowController();
         FlowController();
 
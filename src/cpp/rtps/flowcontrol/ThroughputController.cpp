@@ -69,19 +69,32 @@ void ThroughputController::disable()
     mAssociatedParticipant = nullptr;
 }
 
+uint32_t ThroughputController::bytes_per_period()
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mThroughputControllerMutex);
+    return mBytesPerPeriod;
+}
+
+void ThroughputController::bytes_per_period(
+        uint32_t bytes)
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mThroughputControllerMutex);
+    mBytesPerPeriod = bytes;
+}
+
 template<typename Collector>
 void ThroughputController::process_nts(Collector& changesToSend)
 {
     uint32_t size_to_restore = 0;
-    auto it = changesToSend.items().begin();
+    auto it = changesToSend.begin();
     while (
-        it != changesToSend.items().end() &&
+        it != changesToSend.end() &&
         process_change_nts_(it->cacheChange, it->sequenceNumber, it->fragmentNumber, &size_to_restore))
     {
         ++it;
     }
 
-    changesToSend.items().erase(it, changesToSend.items().end());
+    changesToSend.erase_from(it);
 
     if (size_to_restore > 0)
     {
@@ -51,6 +51,15 @@ public:
 
     virtual void disable() override;
 
+protected:
+
+    //! @return Number of bytes currently allowed on each period.
+    uint32_t bytes_per_period();
+
+    //! Change the number of bytes allowed on each period.
+    void bytes_per_period(
+            uint32_t bytes);
+
 private:
 
     template<typename Collector>
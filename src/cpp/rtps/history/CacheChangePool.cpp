@@ -21,6 +21,8 @@
 #include <fastdds/rtps/common/CacheChange.h>
 #include <fastdds/dds/log/Log.hpp>
 
+#include "SharedPayloadPool.hpp"
+
 #include <mutex>
 #include <cstring>
 #include <cassert>
@@ -37,7 +39,8 @@ CacheChangePool::~CacheChangePool()
     //Deletion process does not depend on the memory management policy
     for(std::vector<CacheChange_t*>::iterator it = m_allCaches.begin();it!=m_allCaches.end();++it)
     {
-        delete(*it);
+        SharedPayloadPool::release_payload(**it);
+        delete(static_cast<PooledCacheChange*>(*it));
     }
 }
 
@@ -132,7 +135,7 @@ bool CacheChangePool::reserve_Cache(CacheChange_t** chan, uint32_t dataSize)
             catch(std::bad_alloc& ex)
             {
                 logError(RTPS_HISTORY, "Failed to allocate memory for the serializedPayload, exception caught: " << ex.what());
-                delete(*chan);
+                delete(static_cast<PooledCacheChange*>(*chan));
                 *chan = nullptr;
                 return false;
             }
@@ -165,7 +168,7 @@ bool CacheChangePool::reserve_Cache(CacheChange_t** chan, uint32_t dataSize)
                 catch(std::bad_alloc& ex)
                 {
                     logError(RTPS_HISTORY, "Failed to allocate memory for the serializedPayload, exception caught: " << ex.what());
-                    delete(*chan);
+                    delete(static_cast<PooledCacheChange*>(*chan));
                     *chan = nullptr;
                     return false;
                 }
@@ -178,6 +181,9 @@ bool CacheChangePool::reserve_Cache(CacheChange_t** chan, uint32_t dataSize)
 
 void CacheChangePool::release_Cache(CacheChange_t* ch)
 {
+    // Shared payloads are not owned by the change, so its own buffer should be restored before reusing it
+    SharedPayloadPool::release_payload(*ch);
+
     switch(memoryMode)
     {
         case PREALLOCATED_MEMORY_MODE:
@@ -200,7 +206,7 @@ void CacheChangePool::release_Cache(CacheChange_t* ch)
                 logInfo(RTPS_UTILS,"Tried to release a CacheChange that is not logged in the Pool");
                 break;
             }
-            delete(ch);
+            delete(static_cast<PooledCacheChange*>(ch));
             --m_pool_size;
             break;
 
@@ -247,7 +253,7 @@ bool CacheChangePool::allocateGroup(uint32_t group_size)
     }
     for(uint32_t i = 0; i < reserved; ++i)
     {
-        CacheChange_t* ch = new CacheChange_t(m_payload_size);
+        CacheChange_t* ch = new PooledCacheChange(m_payload_size);
         m_allCaches.push_back(ch);
         m_freeCaches.push_back(ch);
         ++m_pool_size;
@@ -281,7 +287,7 @@ CacheChange_t* CacheChangePool::allocateSingle(uint32_t dataSize)
 
     if((m_max_pool_size == 0) | (m_pool_size < m_max_pool_size)) { //If no limit or current changes < max changes
         ++m_pool_size;
-        ch = new CacheChange_t(dataSize);
+        ch = new PooledCacheChange(dataSize);
         m_allCaches.push_back(ch);
         added = true;
     }
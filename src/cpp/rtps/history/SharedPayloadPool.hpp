@@ -0,0 +1,270 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SharedPayloadPool.hpp
+ */
+
+#ifndef RTPS_HISTORY_SHAREDPAYLOADPOOL_HPP
+#define RTPS_HISTORY_SHAREDPAYLOADPOOL_HPP
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <fastdds/rtps/common/CacheChange.h>
+
+#include <rtps/common/SharedBuffer.hpp>
+
+#include <cassert>  // assert
+#include <cstring>  // memcpy
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * CacheChange_t given by a CacheChangePool, which can reference a payload shared with other changes.
+ * The own buffer of the change is kept aside while it references a shared one.
+ */
+struct PooledCacheChange : public CacheChange_t
+{
+    using CacheChange_t::CacheChange_t;
+
+    //!Reference counted buffer holding serializedPayload, while it is shared
+    octet* shared_buffer = nullptr;
+    //!Own buffer of serializedPayload, kept aside while it references a shared buffer
+    octet* own_payload_data = nullptr;
+    //!Maximum size of own_payload_data
+    uint32_t own_payload_max_size = 0;
+};
+
+/**
+ * Participant-wide provider of reference counted payload buffers.
+ *
+ * When a received DATA is delivered to several readers of the same participant, its payload is copied
+ * once into a shared buffer, and the CacheChange_t of every reader points to that same immutable buffer.
+ * The own buffer of each reader change is kept aside while it references a shared one, and restored
+ * when the reference is released.
+ *
+ * Large payloads received on a reference counted reception buffer are not copied at all: the readers
+ * reference the reception buffer itself, and the transport receives the next messages on another one.
+ *
+ * Shared buffers are reused once released, and freed when their free list is full or the pool is gone,
+ * so they do not depend on the lifetime of the pool that created them.
+ * @ingroup COMMON_MODULE
+ */
+class SharedPayloadPool
+{
+public:
+
+    //! Released buffers kept for reuse on each size class
+    static constexpr uint32_t max_pooled_buffers = 16;
+
+    /**
+     * Construct a SharedPayloadPool.
+     * @param min_payload_size Minimum size of the payloads to share. 0 disables payload sharing.
+     * @param min_adopted_payload_size Minimum size of the payloads referenced on their reception buffer.
+     * 0 disables the adoption of reception buffers.
+     */
+    SharedPayloadPool(
+            uint32_t min_payload_size,
+            uint32_t min_adopted_payload_size)
+        : min_payload_size_(min_payload_size)
+        , min_adopted_payload_size_(min_adopted_payload_size)
+        , free_list_(min_payload_size > 0 ? SharedBuffer::FreeList::create(max_pooled_buffers) : nullptr)
+    {
+    }
+
+    ~SharedPayloadPool()
+    {
+        if (free_list_ != nullptr)
+        {
+            free_list_->release();
+        }
+    }
+
+    SharedPayloadPool(
+            const SharedPayloadPool&) = delete;
+    SharedPayloadPool& operator =(
+            const SharedPayloadPool&) = delete;
+
+    /**
+     * Check whether a payload delivered to a number of readers should be shared.
+     * @param payload_size Size of the payload.
+     * @param num_readers Number of readers the payload will be delivered to.
+     * @return true when the payload should be shared.
+     */
+    bool should_share(
+            uint32_t payload_size,
+            size_t num_readers) const
+    {
+        return (min_payload_size_ > 0) && (num_readers > 1) && (payload_size >= min_payload_size_);
+    }
+
+    /**
+     * Check whether a payload received on a reference counted reception buffer should be referenced there.
+     * @param payload_size Size of the payload.
+     * @return true when the reception buffer should be adopted.
+     */
+    bool should_adopt(
+            uint32_t payload_size) const
+    {
+        return (min_adopted_payload_size_ > 0) && (payload_size >= min_adopted_payload_size_);
+    }
+
+    /**
+     * Copy a payload into a shared buffer, and make it the payload of a change being received.
+     * @param change Change being received. Its serializedPayload is moved to the shared buffer.
+     * @return Shared buffer, holding one reference. nullptr if it could not be allocated.
+     */
+    octet* get_payload(
+            CacheChange_t& change)
+    {
+        assert(free_list_ != nullptr);
+
+        octet* buffer = free_list_->allocate(change.serializedPayload.length);
+        if (buffer != nullptr)
+        {
+            memcpy(buffer, change.serializedPayload.data, change.serializedPayload.length);
+            change.serializedPayload.data = buffer;
+        }
+        return buffer;
+    }
+
+    /**
+     * Keep a reference to the reference counted buffer a change is being received on.
+     * @param buffer Reception buffer, allocated with SharedBuffer. serializedPayload should point into it.
+     * @param change Change being received.
+     * @return The reception buffer, with a new reference to it.
+     */
+    static octet* adopt_payload(
+            octet* buffer,
+            const CacheChange_t& change)
+    {
+        static_cast<void>(change);
+        assert(change.serializedPayload.data >= buffer);
+
+        SharedBuffer::add_reference(buffer);
+        return buffer;
+    }
+
+    /**
+     * Set the change whose payload the calling thread is delivering from a shared buffer.
+     * Readers sharing the payload take their reference through incoming_buffer().
+     * @param change Change being delivered, nullptr when the delivery has finished.
+     * @param buffer Shared buffer holding the payload of the change.
+     */
+    static void set_incoming(
+            const CacheChange_t* change,
+            octet* buffer)
+    {
+        Incoming& incoming = incoming_payload();
+        incoming.change = change;
+        incoming.buffer = buffer;
+    }
+
+    /**
+     * Get the shared buffer holding the payload of a change being delivered by the calling thread.
+     * @param change Change received by a reader.
+     * @return Shared buffer holding its payload, or nullptr when the payload is not shared.
+     */
+    static octet* incoming_buffer(
+            const CacheChange_t& change)
+    {
+        const Incoming& incoming = incoming_payload();
+        return (incoming.change == &change) ? incoming.buffer : nullptr;
+    }
+
+    /**
+     * Make a change reference a shared payload.
+     * @param buffer Shared buffer holding the payload of the source change.
+     * @param source Change whose payload is shared.
+     * @param target Change given by a CacheChangePool. Its own buffer is kept aside.
+     */
+    static void share_payload(
+            octet* buffer,
+            const CacheChange_t& source,
+            CacheChange_t& target)
+    {
+        PooledCacheChange& change = static_cast<PooledCacheChange&>(target);
+        assert(change.shared_buffer == nullptr);
+
+        SharedBuffer::add_reference(buffer);
+        change.shared_buffer = buffer;
+        change.own_payload_data = change.serializedPayload.data;
+        change.own_payload_max_size = change.serializedPayload.max_size;
+        change.serializedPayload.data = source.serializedPayload.data;
+        change.serializedPayload.length = source.serializedPayload.length;
+        change.serializedPayload.max_size = source.serializedPayload.length;
+        change.serializedPayload.encapsulation = source.serializedPayload.encapsulation;
+    }
+
+    /**
+     * Drop the reference of a change to its shared payload, if any, restoring the own buffer of the change.
+     * The shared buffer is reused or freed when this was the last reference to it.
+     * @param target Change given by a CacheChangePool.
+     */
+    static void release_payload(
+            CacheChange_t& target)
+    {
+        PooledCacheChange& change = static_cast<PooledCacheChange&>(target);
+        if (change.shared_buffer == nullptr)
+        {
+            return;
+        }
+
+        SharedBuffer::release(change.shared_buffer);
+
+        change.serializedPayload.data = change.own_payload_data;
+        change.serializedPayload.max_size = change.own_payload_max_size;
+        change.serializedPayload.length = 0;
+        change.own_payload_data = nullptr;
+        change.own_payload_max_size = 0;
+        change.shared_buffer = nullptr;
+    }
+
+    /**
+     * Check whether a change references a shared payload.
+     * @param target Change given by a CacheChangePool.
+     * @return true when its payload is shared.
+     */
+    static bool is_shared(
+            const CacheChange_t& target)
+    {
+        return static_cast<const PooledCacheChange&>(target).shared_buffer != nullptr;
+    }
+
+private:
+
+    struct Incoming
+    {
+        const CacheChange_t* change;
+        octet* buffer;
+    };
+
+    static Incoming& incoming_payload()
+    {
+        static thread_local Incoming incoming{nullptr, nullptr};
+        return incoming;
+    }
+
+    uint32_t min_payload_size_;
+    uint32_t min_adopted_payload_size_;
+    SharedBuffer::FreeList* free_list_;
+};
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
+
+#endif
+#endif  // RTPS_HISTORY_SHAREDPAYLOADPOOL_HPP
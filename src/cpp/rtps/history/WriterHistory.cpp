@@ -83,15 +83,7 @@ bool WriterHistory::add_change_(CacheChange_t* a_change, WriteParams &wparams,
         return false;
     }
 
-    ++m_lastCacheChangeSeqNum;
-    a_change->sequenceNumber = m_lastCacheChangeSeqNum;
-    a_change->sourceTimestamp = Time_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
-                                           std::chrono::system_clock::now().time_since_epoch()).count() * 1e-9);
-
-    a_change->write_params = wparams;
-    // Updated sample identity
-    wparams.sample_identity().writer_guid(a_change->writerGUID);
-    wparams.sample_identity().sequence_number(a_change->sequenceNumber);
+    set_next_sequence_number(a_change, wparams);
 
     m_changes.push_back(a_change);
 
@@ -108,6 +100,46 @@ bool WriterHistory::add_change_(CacheChange_t* a_change, WriteParams &wparams,
     return true;
 }
 
+bool WriterHistory::send_change_without_history(CacheChange_t* a_change, WriteParams& wparams,
+        std::chrono::time_point<std::chrono::steady_clock> max_blocking_time)
+{
+    if(mp_writer == nullptr || mp_mutex == nullptr)
+    {
+        logError(RTPS_HISTORY,"You need to create a Writer with this History before sending any changes");
+        return false;
+    }
+
+    std::lock_guard<RecursiveTimedMutex> guard(*mp_mutex);
+
+    // Changes sent by asynchronous or reliable writers are referenced until they are sent or acknowledged
+    if(mp_writer->isAsync() || mp_writer->getAttributes().reliabilityKind != BEST_EFFORT)
+    {
+        return false;
+    }
+
+    a_change->writerGUID = mp_writer->getGuid();
+    set_next_sequence_number(a_change, wparams);
+
+    logInfo(RTPS_HISTORY,"Change "<< a_change->sequenceNumber << " sent without history with "<<a_change->serializedPayload.length<< " bytes");
+
+    mp_writer->send_change_without_history(a_change, max_blocking_time);
+
+    return true;
+}
+
+void WriterHistory::set_next_sequence_number(CacheChange_t* a_change, WriteParams& wparams)
+{
+    ++m_lastCacheChangeSeqNum;
+    a_change->sequenceNumber = m_lastCacheChangeSeqNum;
+    a_change->sourceTimestamp = Time_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                           std::chrono::system_clock::now().time_since_epoch()).count() * 1e-9);
+
+    a_change->write_params = wparams;
+    // Updated sample identity
+    wparams.sample_identity().writer_guid(a_change->writerGUID);
+    wparams.sample_identity().sequence_number(a_change->sequenceNumber);
+}
+
 bool WriterHistory::remove_change(CacheChange_t* a_change)
 {
     if(mp_writer == nullptr || mp_mutex == nullptr)
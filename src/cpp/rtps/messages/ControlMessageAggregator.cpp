@@ -0,0 +1,182 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ControlMessageAggregator.cpp
+ */
+
+#include "ControlMessageAggregator.hpp"
+
+#include <fastdds/rtps/messages/CDRMessage.h>
+#include <fastdds/rtps/messages/RTPSMessageCreator.h>
+#include <fastdds/rtps/messages/RTPS_messages.h>
+#include <fastdds/rtps/resources/TimedEvent.h>
+#include <rtps/participant/RTPSParticipantImpl.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+ControlMessageAggregator::ControlMessageAggregator(
+        RTPSParticipantImpl* participant,
+        const GuidPrefix_t& guid_prefix,
+        uint32_t max_message_size,
+        uint32_t period_us)
+    : participant_(participant)
+    , guid_prefix_(guid_prefix)
+    , max_message_size_(max_message_size)
+    , flush_event_(nullptr)
+{
+    flush_event_ = new TimedEvent(participant->getEventResource(), [this]() -> bool
+            {
+                flush();
+                return false;
+            },
+            period_us / 1000.0);
+}
+
+ControlMessageAggregator::~ControlMessageAggregator()
+{
+    // Once the event is destroyed, flush cannot be called from the event thread
+    delete flush_event_;
+    flush();
+}
+
+bool ControlMessageAggregator::add_nts(
+        const CDRMessage_t& message,
+        std::unique_ptr<PendingMessage>& full)
+{
+    if (destination_.empty() || message.length <= RTPSMESSAGE_HEADER_SIZE)
+    {
+        return false;
+    }
+
+    const octet* submessages = &message.buffer[RTPSMESSAGE_HEADER_SIZE];
+    uint32_t submessages_length = message.length - RTPSMESSAGE_HEADER_SIZE;
+    if (RTPSMESSAGE_HEADER_SIZE + submessages_length > max_message_size_)
+    {
+        return false;
+    }
+
+    // Messages not starting with an INFO_DST need one when appended to other messages
+    uint32_t info_dst_length = (submessages[0] == INFO_DST) ? 0u :
+            RTPSMESSAGE_SUBMESSAGEHEADER_SIZE + GuidPrefix_t::size;
+
+    auto it = std::find_if(pending_.begin(), pending_.end(),
+                    [this](const std::unique_ptr<PendingMessage>& pending)
+                    {
+                        return pending->locators == destination_;
+                    });
+
+    PendingMessage* pending = nullptr;
+    if (it != pending_.end())
+    {
+        pending = it->get();
+        if (pending->message.length + info_dst_length + submessages_length > pending->message.max_size)
+        {
+            // No room for this message: the caller sends what is pending, and this one starts a new message
+            full = std::move(*it);
+            *it = take_free_nts();
+            pending = it->get();
+            pending->locators = destination_;
+        }
+    }
+    else
+    {
+        if (pending_.empty())
+        {
+            flush_event_->restart_timer();
+        }
+
+        pending_.push_back(take_free_nts());
+        pending = pending_.back().get();
+        pending->locators = destination_;
+    }
+
+    // Destination of the previous messages should not apply to the submessages of this one
+    if (info_dst_length > 0 && pending->message.length > RTPSMESSAGE_HEADER_SIZE)
+    {
+        RTPSMessageCreator::addSubmessageInfoDST(&pending->message, c_GuidPrefix_Unknown);
+    }
+
+    return CDRMessage::addData(&pending->message, submessages, submessages_length);
+}
+
+std::unique_ptr<ControlMessageAggregator::PendingMessage> ControlMessageAggregator::take_free_nts()
+{
+    if (free_.empty())
+    {
+        std::unique_ptr<PendingMessage> new_pending(new PendingMessage(max_message_size_));
+        CDRMessage::initCDRMsg(&new_pending->message);
+        RTPSMessageCreator::addHeader(&new_pending->message, guid_prefix_);
+        return new_pending;
+    }
+
+    std::unique_ptr<PendingMessage> ret_val = std::move(free_.back());
+    free_.pop_back();
+    return ret_val;
+}
+
+void ControlMessageAggregator::send_and_release(
+        std::unique_ptr<PendingMessage>& pending)
+{
+    send(*pending);
+    pending->message.length = RTPSMESSAGE_HEADER_SIZE;
+    pending->message.pos = RTPSMESSAGE_HEADER_SIZE;
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    free_.push_back(std::move(pending));
+}
+
+void ControlMessageAggregator::flush()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        sending_.swap(pending_);
+    }
+
+    for (std::unique_ptr<PendingMessage>& pending : sending_)
+    {
+        send(*pending);
+        pending->message.length = RTPSMESSAGE_HEADER_SIZE;
+        pending->message.pos = RTPSMESSAGE_HEADER_SIZE;
+    }
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (std::unique_ptr<PendingMessage>& pending : sending_)
+    {
+        free_.push_back(std::move(pending));
+    }
+    sending_.clear();
+}
+
+void ControlMessageAggregator::send(
+        PendingMessage& pending)
+{
+    if (pending.message.length > RTPSMESSAGE_HEADER_SIZE)
+    {
+        std::chrono::steady_clock::time_point max_blocking_time_point =
+                std::chrono::steady_clock::now() + std::chrono::hours(24);
+        participant_->sendSync(&pending.message,
+                Locators(pending.locators.begin()), Locators(pending.locators.end()),
+                max_blocking_time_point);
+    }
+}
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
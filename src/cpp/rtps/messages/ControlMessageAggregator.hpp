@@ -0,0 +1,177 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ControlMessageAggregator.hpp
+ */
+
+#ifndef RTPS_MESSAGES_CONTROLMESSAGEAGGREGATOR_HPP
+#define RTPS_MESSAGES_CONTROLMESSAGEAGGREGATOR_HPP
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <fastdds/rtps/common/CDRMessage_t.h>
+#include <fastdds/rtps/common/Guid.h>
+#include <fastdds/rtps/common/Locator.h>
+
+#include <memory>   // std::unique_ptr
+#include <mutex>    // std::mutex
+#include <vector>   // std::vector
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class RTPSParticipantImpl;
+class TimedEvent;
+
+/**
+ * Participant-wide aggregator of control messages (HEARTBEAT, ACKNACK, NACK_FRAG, GAP).
+ *
+ * Control messages sent by the endpoints of a participant are not sent right away, but appended to a
+ * pending message for the same set of destination locators. Pending messages are sent when the
+ * aggregation period expires, or when they are full, so the control traffic of many endpoints talking
+ * to the same remote participant travels on a single datagram.
+ * @ingroup WRITER_MODULE
+ */
+class ControlMessageAggregator
+{
+public:
+
+    /**
+     * Construct a ControlMessageAggregator.
+     * @param participant Participant whose send resources will be used.
+     * @param guid_prefix GUID prefix of the participant, used on the header of the aggregated messages.
+     * @param max_message_size Maximum size of an aggregated message.
+     * @param period_us Time (in microseconds) control messages are kept waiting for other ones.
+     */
+    ControlMessageAggregator(
+            RTPSParticipantImpl* participant,
+            const GuidPrefix_t& guid_prefix,
+            uint32_t max_message_size,
+            uint32_t period_us);
+
+    /**
+     * Destructor.
+     * Pending messages are sent before destruction.
+     */
+    ~ControlMessageAggregator();
+
+    /**
+     * Queue a message to be sent with other control messages to the same destinations.
+     * @param message RTPS message, with its header, to be queued.
+     * @param destination_locators_begin Iterator to the first destination locator.
+     * @param destination_locators_end Iterator to the end of the destination locators.
+     * @return false when the message could not be queued, and should be sent directly.
+     */
+    template<class LocatorIteratorT>
+    bool add(
+            const CDRMessage_t& message,
+            const LocatorIteratorT& destination_locators_begin,
+            const LocatorIteratorT& destination_locators_end)
+    {
+        std::unique_ptr<PendingMessage> full;
+        bool ret_val = false;
+
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+
+            destination_.clear();
+            LocatorIteratorT it = destination_locators_begin;
+            while (it != destination_locators_end)
+            {
+                destination_.push_back(*it);
+                ++it;
+            }
+
+            ret_val = add_nts(message, full);
+        }
+
+        // Sent without the mutex, so other endpoints can keep queueing meanwhile
+        if (full)
+        {
+            send_and_release(full);
+        }
+
+        return ret_val;
+    }
+
+private:
+
+    struct PendingMessage
+    {
+        explicit PendingMessage(
+                uint32_t max_message_size)
+            : message(max_message_size)
+        {
+        }
+
+        //! Locators the message will be sent to.
+        std::vector<Locator_t> locators;
+        //! Aggregated message.
+        CDRMessage_t message;
+    };
+
+    /**
+     * Append a message to the pending one for destination_.
+     * @param message RTPS message, with its header, to be appended.
+     * @param [out] full Pending message taken out because it had no room for this one. It should be sent
+     * without holding the mutex.
+     * @return false when the message could not be queued, and should be sent directly.
+     */
+    bool add_nts(
+            const CDRMessage_t& message,
+            std::unique_ptr<PendingMessage>& full);
+
+    //! Take an empty message from the free list, or create a new one.
+    std::unique_ptr<PendingMessage> take_free_nts();
+
+    //! Send a message taken out of pending_, and return it to the free list.
+    void send_and_release(
+            std::unique_ptr<PendingMessage>& pending);
+
+    //! Send all the pending messages. Only called from the event thread, or on destruction.
+    void flush();
+
+    void send(
+            PendingMessage& pending);
+
+    RTPSParticipantImpl* participant_;
+
+    GuidPrefix_t guid_prefix_;
+
+    uint32_t max_message_size_;
+
+    std::mutex mutex_;
+
+    //! Destination locators of the message being added.
+    std::vector<Locator_t> destination_;
+
+    //! Messages waiting for the aggregation period to expire.
+    std::vector<std::unique_ptr<PendingMessage> > pending_;
+
+    //! Messages already sent, kept to be reused.
+    std::vector<std::unique_ptr<PendingMessage> > free_;
+
+    //! Messages being sent by flush().
+    std::vector<std::unique_ptr<PendingMessage> > sending_;
+
+    TimedEvent* flush_event_;
+};
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
+
+#endif
+#endif  // RTPS_MESSAGES_CONTROLMESSAGEAGGREGATOR_HPP
@@ -49,6 +49,7 @@ MessageReceiver::MessageReceiver(
     , dest_guid_prefix_(c_GuidPrefix_Unknown)
     , have_timestamp_(false)
     , timestamp_(c_TimeInvalid)
+    , pooled_buffer_(nullptr)
 #if HAVE_SECURITY
     , crypto_msg_(participant->is_secure() ? rec_buffer_size : 0)
 #endif
@@ -159,10 +160,13 @@ void MessageReceiver::reset()
 
 void MessageReceiver::processCDRMsg(
         const Locator_t& loc,
-        CDRMessage_t* msg)
+        CDRMessage_t* msg,
+        bool pooled_buffer)
 {
     (void)loc;
 
+    pooled_buffer_ = pooled_buffer ? msg->buffer : nullptr;
+
     if (msg->length < RTPSMESSAGE_HEADER_SIZE)
     {
         logWarning(RTPS_MSG_IN, IDSTRING "Received message too short, ignoring");
@@ -659,13 +663,47 @@ bool MessageReceiver::proc_Submsg_Data(
     logInfo(RTPS_MSG_IN, IDSTRING "from Writer " << ch.writerGUID << "; possible RTPSReader entities: " <<
         associated_readers_.size());
 
-    //Look for the correct reader to add the change
-    findAllReaders(readerID, 
-        [&ch] (RTPSReader* reader)
+    // Each reader is given the change once the next one is found, so the payload can be copied once into a buffer
+    // all of them reference as soon as it is known to have several destinations
+    SharedPayloadPool& payload_pool = participant_->shared_payload_pool();
+    octet* shared_buffer = nullptr;
+    bool several_readers = false;
+    RTPSReader* pending_reader = nullptr;
+    findAllReaders(readerID,
+        [&] (RTPSReader* reader)
         {
-            reader->processDataMsg(&ch);
+            if (pending_reader != nullptr)
+            {
+                if (dataFlag && !several_readers && payload_pool.should_share(ch.serializedPayload.length, 2u))
+                {
+                    shared_buffer = payload_pool.get_payload(ch);
+                    SharedPayloadPool::set_incoming(&ch, shared_buffer);
+                }
+                several_readers = true;
+                pending_reader->processDataMsg(&ch);
+            }
+            pending_reader = reader;
         });
 
+    if (pending_reader != nullptr)
+    {
+        // The only reader of a large payload references it where it was received, the transport will use another
+        // buffer
+        if (dataFlag && !several_readers && msg->buffer == pooled_buffer_ &&
+                payload_pool.should_adopt(ch.serializedPayload.length))
+        {
+            shared_buffer = SharedPayloadPool::adopt_payload(pooled_buffer_, ch);
+            SharedPayloadPool::set_incoming(&ch, shared_buffer);
+        }
+        pending_reader->processDataMsg(&ch);
+    }
+
+    if (shared_buffer != nullptr)
+    {
+        SharedPayloadPool::set_incoming(nullptr, nullptr);
+        SharedBuffer::release(shared_buffer);
+    }
+
     //TODO(Ricardo) If a exception is thrown (ex, by fastcdr), this line is not executed -> segmentation fault
     ch.serializedPayload.data = nullptr;
 
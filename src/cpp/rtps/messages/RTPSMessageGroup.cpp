@@ -24,6 +24,7 @@
 #include <rtps/flowcontrol/FlowController.h>
 #include "RTPSGapBuilder.hpp"
 #include "RTPSMessageGroup_t.hpp"
+#include "ControlMessageAggregator.hpp"
 
 #include <fastdds/dds/log/Log.hpp>
 
@@ -125,12 +126,17 @@ RTPSMessageGroup::RTPSMessageGroup(
     , full_msg_(nullptr)
     , submessage_msg_(nullptr)
     , currentBytesSent_(0)
+    , current_timestamp_(c_RTPSTimeInvalid)
+    , submessage_timestamp_(c_RTPSTimeInvalid)
+    , info_ts_added_(false)
+    , info_ts_omitted_(false)
     , participant_(participant)
 #if HAVE_SECURITY
     , encrypt_msg_(nullptr)
 #endif
     , max_blocking_time_point_(max_blocking_time_point)
     , send_buffer_(participant->get_send_buffer())
+    , control_aggregator_(nullptr)
 {
     // Avoid warning when neither SECURITY nor DEBUG is used
     (void)participant;
@@ -175,6 +181,7 @@ void RTPSMessageGroup::reset_to_header()
     CDRMessage::initCDRMsg(full_msg_);
     full_msg_->pos = RTPSMESSAGE_HEADER_SIZE;
     full_msg_->length = RTPSMESSAGE_HEADER_SIZE;
+    current_timestamp_ = c_RTPSTimeInvalid;
 }
 
 void RTPSMessageGroup::flush()
@@ -211,6 +218,12 @@ void RTPSMessageGroup::send()
         }
 #endif
 
+        if (control_aggregator_ != nullptr && sender_.queue_control_message(msgToSend, *control_aggregator_))
+        {
+            currentBytesSent_ += msgToSend->length;
+            return;
+        }
+
         if (!sender_.send(msgToSend, max_blocking_time_point_))
         {
             throw timeout();
@@ -227,10 +240,25 @@ void RTPSMessageGroup::flush_and_reset()
     current_dst_ = c_GuidPrefix_Unknown;
 }
 
+void RTPSMessageGroup::aggregate_control_messages()
+{
+#if HAVE_SECURITY
+    // Protected messages are encoded for their own destinations, so they are never aggregated
+    if (participant_->security_attributes().is_rtps_protected && endpoint_->supports_rtps_protection())
+    {
+        return;
+    }
+#endif
+
+    control_aggregator_ = participant_->control_message_aggregator();
+}
+
 void RTPSMessageGroup::check_and_maybe_flush(
         const GuidPrefix_t& destination_guid_prefix)
 {
     CDRMessage::initCDRMsg(submessage_msg_);
+    info_ts_added_ = false;
+    info_ts_omitted_ = false;
 
     if (sender_.destinations_have_changed())
     {
@@ -247,6 +275,7 @@ bool RTPSMessageGroup::insert_submessage(
     if (!CDRMessage::appendMsg(full_msg_, submessage_msg_))
     {
         // Retry
+        Time_t timestamp = current_timestamp_;
         flush();
 
         current_dst_ = c_GuidPrefix_Unknown;
@@ -257,6 +286,17 @@ bool RTPSMessageGroup::insert_submessage(
             return false;
         }
 
+        // The timestamp the submessage relied on was on the message just sent
+        if (info_ts_omitted_)
+        {
+            if (!RTPSMessageCreator::addSubmessageInfoTS(full_msg_, timestamp, false))
+            {
+                logError(RTPS_WRITER,"Cannot add INFO_TS submessage to the CDRMessage. Buffer too small");
+                return false;
+            }
+            current_timestamp_ = timestamp;
+        }
+
         if (!CDRMessage::appendMsg(full_msg_, submessage_msg_))
         {
             logError(RTPS_WRITER,"Cannot add RTPS submesage to the CDRMessage. Buffer too small");
@@ -264,6 +304,11 @@ bool RTPSMessageGroup::insert_submessage(
         }
     }
 
+    if (info_ts_added_)
+    {
+        current_timestamp_ = submessage_timestamp_;
+    }
+
     // Messages with a submessage bigger than 64KB cannot have more submessages and should be flushed
     if (is_big_submessage)
     {
@@ -299,6 +344,19 @@ bool RTPSMessageGroup::add_info_dst_in_buffer(
 bool RTPSMessageGroup::add_info_ts_in_buffer(
         const Time_t& timestamp)
 {
+#if HAVE_SECURITY
+    // Protected submessages are encoded one by one
+    if (!endpoint_->getAttributes().security_attributes().is_submessage_protected)
+#endif
+    {
+        // Receivers keep the timestamp until the end of the message
+        if (timestamp_is_current(timestamp))
+        {
+            info_ts_omitted_ = true;
+            return true;
+        }
+    }
+
     logInfo(RTPS_WRITER, "Sending INFO_TS message");
 
 #if HAVE_SECURITY
@@ -337,6 +395,8 @@ bool RTPSMessageGroup::add_info_ts_in_buffer(
     }
 #endif
 
+    info_ts_added_ = true;
+    submessage_timestamp_ = timestamp;
     return true;
 }
 
@@ -348,6 +408,30 @@ bool RTPSMessageGroup::add_data(
 
     // Check preconditions. If fail flush and reset.
     check_and_maybe_flush();
+
+    const EntityId_t& readerId = get_entity_id(sender_.remote_guids());
+
+    // Only writers have a DATA template
+    bool use_template = WRITER == endpoint_->getAttributes().endpointKind;
+#if HAVE_SECURITY
+    // Protected submessages are encoded one by one
+    use_template = use_template && !endpoint_->getAttributes().security_attributes().is_submessage_protected;
+#endif
+
+    if (use_template)
+    {
+        const RTPSWriter* writer = static_cast<const RTPSWriter*>(endpoint_);
+        bool add_info_ts = !timestamp_is_current(change.sourceTimestamp);
+        if (RTPSMessageCreator::addSubmessagesFromDataTemplate(submessage_msg_, writer->data_template_, &change,
+                endpoint_->getAttributes().topicKind, readerId, expectsInlineQos, add_info_ts))
+        {
+            info_ts_added_ = add_info_ts;
+            info_ts_omitted_ = !add_info_ts;
+            submessage_timestamp_ = change.sourceTimestamp;
+            return insert_submessage(false);
+        }
+    }
+
     add_info_ts_in_buffer(change.sourceTimestamp);
 
     InlineQosWriter* inlineQos = nullptr;
@@ -360,7 +444,6 @@ bool RTPSMessageGroup::add_data(
 #if HAVE_SECURITY
     uint32_t from_buffer_position = submessage_msg_->pos;
 #endif
-    const EntityId_t& readerId = get_entity_id(sender_.remote_guids());
 
     // TODO (Ricardo). Check to create special wrapper.
     bool is_big_submessage;
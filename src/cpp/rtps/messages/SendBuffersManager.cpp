@@ -19,16 +19,50 @@
 #include "SendBuffersManager.hpp"
 #include "../participant/RTPSParticipantImpl.h"
 
+#include <algorithm>
+#include <thread>
+
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+/**
+ * @return Index of the first slot the calling thread looks at. Consecutive threads get consecutive slots.
+ */
+static size_t thread_slot()
+{
+    static std::atomic<size_t> next_thread_slot(0u);
+    thread_local size_t slot = next_thread_slot.fetch_add(1u, std::memory_order_relaxed);
+    return slot;
+}
+
 SendBuffersManager::SendBuffersManager(
         size_t reserved_size,
         bool allow_growing)
-    : allow_growing_(allow_growing)
+    : reserved_size_(reserved_size)
+    , allow_growing_(allow_growing)
 {
-    pool_.reserve(reserved_size);
+    // Room for the reserved buffers, and for one more per core so threads sending concurrently don't need to
+    // share their slots when the pool grows.
+    n_slots_ = reserved_size + std::max(std::thread::hardware_concurrency(), 1u);
+    slots_.reset(new Slot[n_slots_]);
+}
+
+SendBuffersManager::~SendBuffersManager()
+{
+    size_t n_buffers = pool_.size();
+    for (size_t i = 0; i < n_slots_; ++i)
+    {
+        RTPSMessageGroup_t* buffer = slots_[i].buffer.exchange(nullptr);
+        if (buffer != nullptr)
+        {
+            delete buffer;
+            ++n_buffers;
+        }
+    }
+
+    assert(n_buffers == n_created_);
+    (void)n_buffers;
 }
 
 void SendBuffersManager::init(
@@ -36,7 +70,7 @@ void SendBuffersManager::init(
 {
     std::lock_guard<std::mutex> guard(mutex_);
 
-    if (n_created_ < pool_.capacity())
+    if (n_created_ < reserved_size_)
     {
         const GuidPrefix_t& guid_prefix = participant->getGuid().guidPrefix;
 
@@ -54,13 +88,14 @@ void SendBuffersManager::init(
 #else
         advance *= 2;
 #endif
-        size_t data_size = advance * (pool_.capacity() - n_created_);
+        size_t data_size = advance * (reserved_size_ - n_created_);
         common_buffer_.assign(data_size, 0);
 
         octet* raw_buffer = common_buffer_.data();
-        while(n_created_ < pool_.capacity())
+        while(n_created_ < reserved_size_)
         {
-            pool_.emplace_back(new RTPSMessageGroup_t(
+            // Slots cannot be full here, as there are more slots than reserved buffers
+            put_on_slots(new RTPSMessageGroup_t(
                 raw_buffer,
 #if HAVE_SECURITY
                 secure,
@@ -76,35 +111,98 @@ void SendBuffersManager::init(
 std::unique_ptr<RTPSMessageGroup_t> SendBuffersManager::get_buffer(
         const RTPSParticipantImpl* participant)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    RTPSMessageGroup_t* ret_val = take_from_slots();
 
-    std::unique_ptr<RTPSMessageGroup_t> ret_val;
-
-    while (pool_.empty())
+    if (ret_val == nullptr)
     {
-        if (allow_growing_ || n_created_ < pool_.capacity())
-        {
-            add_one_buffer(participant);
-        }
-        else
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        while (ret_val == nullptr)
         {
-            logInfo(RTPS_PARTICIPANT, "Waiting for send buffer");
-            available_cv_.wait(lock);
+            if (!pool_.empty())
+            {
+                ret_val = pool_.back().release();
+                pool_.pop_back();
+            }
+            else if (allow_growing_ || n_created_ < reserved_size_)
+            {
+                add_one_buffer(participant);
+            }
+            else
+            {
+                // A buffer may have been returned to the slots while the mutex was being taken.
+                // Announcing the wait before looking again ensures return_buffer notifies otherwise.
+                ++n_waiting_;
+                ret_val = take_from_slots();
+                if (ret_val == nullptr)
+                {
+                    logInfo(RTPS_PARTICIPANT, "Waiting for send buffer");
+                    available_cv_.wait(lock);
+                }
+                --n_waiting_;
+            }
         }
     }
 
-    ret_val = std::move(pool_.back());
-    pool_.pop_back();
-
-    return ret_val;
+    return std::unique_ptr<RTPSMessageGroup_t>(ret_val);
 }
 
 void SendBuffersManager::return_buffer(
         std::unique_ptr <RTPSMessageGroup_t>&& buffer)
 {
-    std::lock_guard<std::mutex> guard(mutex_);
-    pool_.push_back(std::move(buffer));
-    available_cv_.notify_one();
+    RTPSMessageGroup_t* raw_buffer = buffer.release();
+
+    if (!put_on_slots(raw_buffer))
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        pool_.emplace_back(raw_buffer);
+        available_cv_.notify_one();
+    }
+    else if (n_waiting_ > 0u)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        available_cv_.notify_one();
+    }
+}
+
+RTPSMessageGroup_t* SendBuffersManager::take_from_slots()
+{
+    size_t index = thread_slot() % n_slots_;
+    for (size_t n = 0; n < n_slots_; ++n)
+    {
+        Slot& slot = slots_[index];
+        if (slot.buffer.load() != nullptr)
+        {
+            RTPSMessageGroup_t* buffer = slot.buffer.exchange(nullptr);
+            if (buffer != nullptr)
+            {
+                return buffer;
+            }
+        }
+
+        index = (index + 1 == n_slots_) ? 0 : index + 1;
+    }
+
+    return nullptr;
+}
+
+bool SendBuffersManager::put_on_slots(
+        RTPSMessageGroup_t* buffer)
+{
+    size_t index = thread_slot() % n_slots_;
+    for (size_t n = 0; n < n_slots_; ++n)
+    {
+        Slot& slot = slots_[index];
+        RTPSMessageGroup_t* expected = nullptr;
+        if (slot.buffer.load() == nullptr && slot.buffer.compare_exchange_strong(expected, buffer))
+        {
+            return true;
+        }
+
+        index = (index + 1 == n_slots_) ? 0 : index + 1;
+    }
+
+    return false;
 }
 
 void SendBuffersManager::add_one_buffer(
@@ -23,6 +23,7 @@
 #include "RTPSMessageGroup_t.hpp"
 #include <fastdds/rtps/common/GuidPrefix_t.hpp>
 
+#include <atomic>              // std::atomic
 #include <vector>              // std::vector
 #include <memory>              // std::unique_ptr
 #include <mutex>               // std::mutex
@@ -37,6 +38,11 @@ class RTPSParticipantImpl;
 
 /**
  * Manages a pool of send buffers.
+ *
+ * Buffers are kept on an array of slots that threads access without locking. Each thread starts looking for a
+ * buffer, and returning it, on a slot of its own, so a thread usually gets back the buffer it used last time and
+ * threads sending at the same time don't contend. The mutex is only taken to create new buffers, to keep the
+ * buffers that don't fit on the slots, and to wait for a buffer when the pool cannot grow.
  * @ingroup WRITER_MODULE
  */
 class SendBuffersManager
@@ -52,10 +58,7 @@ public:
             size_t reserved_size,
             bool allow_growing);
 
-    ~SendBuffersManager()
-    {
-        assert(pool_.size() == n_created_);
-    }
+    ~SendBuffersManager();
 
     /**
      * Initialization of pool.
@@ -82,19 +85,39 @@ public:
 
 private:
 
+    //!A slot of the lock-free part of the pool, padded so threads using contiguous slots don't share a cache line.
+    struct Slot
+    {
+        std::atomic<RTPSMessageGroup_t*> buffer{nullptr};
+        char padding[64 - sizeof(std::atomic<RTPSMessageGroup_t*>)];
+    };
+
+    RTPSMessageGroup_t* take_from_slots();
+
+    bool put_on_slots(
+            RTPSMessageGroup_t* buffer);
+
     void add_one_buffer(
             const RTPSParticipantImpl* participant);
 
-    //!Protects all data
+    //!Lock-free part of the pool
+    std::unique_ptr<Slot[]> slots_;
+    //!Number of slots
+    size_t n_slots_ = 0;
+    //!Protects the data below
     std::mutex mutex_;
-    //!Send buffers pool
+    //!Buffers that didn't fit on the slots
     std::vector<std::unique_ptr<RTPSMessageGroup_t>> pool_;
+    //!Number of buffers created inside init()
+    size_t reserved_size_ = 0;
     //!Raw buffer shared by the buffers created inside init()
     std::vector<octet> common_buffer_;
     //!Creation counter
     std::size_t n_created_ = 0;
-    //!Whether we allow n_created_ to grow beyond the pool_ capacity.
+    //!Whether we allow n_created_ to grow beyond reserved_size_.
     bool allow_growing_ = true;
+    //!Number of threads waiting on available_cv_.
+    std::atomic<uint32_t> n_waiting_{0u};
     //!To wait for a buffer to be returned to the pool.
     std::condition_variable available_cv_;
 };
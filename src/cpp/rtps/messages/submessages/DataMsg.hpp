@@ -243,6 +243,96 @@ bool RTPSMessageCreator::addSubmessageData(
     return added_no_error;
 }
 
+void RTPSMessageCreator::initDataSubmessageTemplate(
+        DataSubmessageTemplate* data_template,
+        const EntityId_t& writerId)
+{
+    CDRMessage_t msg(DataSubmessageTemplate::size);
+    SequenceNumber_t sequence_number;
+
+    // Timestamp, reader id, submessage length and sequence number are patched for each sample
+    RTPSMessageCreator::addSubmessageInfoTS(&msg, c_TimeZero, false);
+
+    octet flags = BIT(2);
+#if !__BIG_ENDIAN__
+    flags = flags | BIT(0);
+#endif
+    CDRMessage::addOctet(&msg, DATA);
+    CDRMessage::addOctet(&msg, flags);
+    CDRMessage::addUInt16(&msg, 0);
+    //extra flags. not in this version.
+    CDRMessage::addUInt16(&msg, 0);
+    CDRMessage::addUInt16(&msg, RTPSMESSAGE_OCTETSTOINLINEQOS_DATASUBMSG);
+    CDRMessage::addEntityId(&msg, &c_EntityId_Unknown);
+    CDRMessage::addEntityId(&msg, &writerId);
+    CDRMessage::addSequenceNumber(&msg, &sequence_number);
+
+    memcpy(data_template->bytes, msg.buffer, DataSubmessageTemplate::size);
+}
+
+bool RTPSMessageCreator::addSubmessagesFromDataTemplate(
+        CDRMessage_t* msg,
+        const DataSubmessageTemplate& data_template,
+        const CacheChange_t* change,
+        TopicKind_t topicKind,
+        const EntityId_t& readerId,
+        bool expectsInlineQos,
+        bool addInfoTS)
+{
+    // Same conditions under which addSubmessageData adds neither inline QoS nor a key
+    if (change->kind != ALIVE || change->serializedPayload.length == 0 || change->serializedPayload.data == nullptr ||
+            (expectsInlineQos && topicKind == WITH_KEY) ||
+            change->write_params.related_sample_identity() != SampleIdentity::unknown())
+    {
+        return false;
+    }
+
+    const uint32_t header_size = DataSubmessageTemplate::size - DataSubmessageTemplate::info_ts_size;
+    uint32_t copied_size = header_size;
+    if (addInfoTS)
+    {
+        copied_size += DataSubmessageTemplate::info_ts_size;
+    }
+    uint32_t payload_length = change->serializedPayload.length;
+    uint32_t end = msg->pos + copied_size + payload_length;
+    // Align submessage to rtps alignment (4).
+    uint32_t align = (4 - end % 4) & 3;
+    // The DATA length counts from the end of its submessage header
+    uint32_t size32 = header_size - 4 + payload_length + align;
+    if (size32 > std::numeric_limits<uint16_t>::max() || end + align > msg->max_size)
+    {
+        return false;
+    }
+
+    octet* submessage = &msg->buffer[msg->pos];
+
+    // The template was built with the native endianness
+    if (addInfoTS)
+    {
+        int32_t seconds = change->sourceTimestamp.seconds();
+        uint32_t fraction = change->sourceTimestamp.fraction();
+        memcpy(submessage, data_template.bytes, DataSubmessageTemplate::info_ts_size);
+        memcpy(submessage + 4, &seconds, sizeof(seconds));
+        memcpy(submessage + 8, &fraction, sizeof(fraction));
+        submessage += DataSubmessageTemplate::info_ts_size;
+    }
+
+    uint16_t submessage_size = static_cast<uint16_t>(size32);
+    memcpy(submessage, data_template.bytes + DataSubmessageTemplate::info_ts_size, header_size);
+    memcpy(submessage + 2, &submessage_size, sizeof(submessage_size));
+    memcpy(submessage + 8, readerId.value, readerId.size);
+    memcpy(submessage + 16, &change->sequenceNumber.high, sizeof(change->sequenceNumber.high));
+    memcpy(submessage + 20, &change->sequenceNumber.low, sizeof(change->sequenceNumber.low));
+
+    memcpy(submessage + header_size, change->serializedPayload.data, payload_length);
+    memset(submessage + header_size + payload_length, 0, align);
+
+    msg->pos = end + align;
+    msg->length += copied_size + payload_length + align;
+
+    return true;
+}
+
 bool RTPSMessageCreator::addMessageDataFrag(
         CDRMessage_t* msg,
         GuidPrefix_t& guidprefix,
@@ -36,6 +36,7 @@ ReceiverResource::ReceiverResource(
         , mtx()
         , receiver(nullptr)
         , max_message_size_(max_recv_buffer_size)
+        , max_lent_buffers_(0)
 {
     // Internal channel is opened and assigned to this resource.
     mValid = transport.OpenInputChannel(locator, this, max_message_size_);
@@ -59,6 +60,7 @@ ReceiverResource::ReceiverResource(ReceiverResource&& rValueResource)
     mValid = rValueResource.mValid;
     rValueResource.mValid = false;
     max_message_size_ = rValueResource.max_message_size_;
+    max_lent_buffers_ = rValueResource.max_lent_buffers_.load();
 }
 
 bool ReceiverResource::SupportsLocator(const Locator_t& localLocator)
@@ -86,6 +88,18 @@ void ReceiverResource::UnregisterReceiver(MessageReceiver* rcv)
 
 void ReceiverResource::OnDataReceived(const octet * data, const uint32_t size,
     const Locator_t & localLocator, const Locator_t & remoteLocator)
+{
+    process_data(data, size, localLocator, remoteLocator, false);
+}
+
+void ReceiverResource::OnPooledDataReceived(const octet * data, const uint32_t size,
+    const Locator_t & localLocator, const Locator_t & remoteLocator)
+{
+    process_data(data, size, localLocator, remoteLocator, true);
+}
+
+void ReceiverResource::process_data(const octet * data, const uint32_t size,
+    const Locator_t & localLocator, const Locator_t & remoteLocator, bool pooled_buffer)
 {
     (void)localLocator;
 
@@ -102,7 +116,7 @@ void ReceiverResource::OnDataReceived(const octet * data, const uint32_t size,
         msg.reserved_size = size;
 
         // TODO: Should we unlock in case UnregisterReceiver is called from callback ?
-        rcv->processCDRMsg(remoteLocator, &msg);
+        rcv->processCDRMsg(remoteLocator, &msg, pooled_buffer);
     }
 
 }
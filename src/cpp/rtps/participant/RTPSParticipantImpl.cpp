@@ -20,6 +20,7 @@
 #include <rtps/participant/RTPSParticipantImpl.h>
 
 #include <rtps/flowcontrol/ThroughputController.h>
+#include <rtps/flowcontrol/CongestionController.h>
 #include <rtps/persistence/PersistenceService.h>
 
 #include <fastdds/rtps/messages/MessageReceiver.h>
@@ -55,6 +56,8 @@
 #include <mutex>
 #include <functional>
 #include <algorithm>
+#include <array>
+#include <future>
 
 #include <fastdds/dds/log/Log.hpp>
 #include <fastrtps/xmlparser/XMLProfileManager.h>
@@ -96,6 +99,30 @@ Locator_t& RTPSParticipantImpl::applyLocatorAdaptRule(
     return loc;
 }
 
+/**
+ * Whether a locator appears on more than one of the lists. The receiver resources of such lists cannot be created
+ * concurrently, as both would try to open the same input channel.
+ */
+template<size_t N>
+static bool lists_share_locators(
+        const std::array<LocatorList_t*, N>& lists)
+{
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t j = i + 1; j < N; ++j)
+        {
+            for (const Locator_t& locator : *lists[i])
+            {
+                if (lists[j]->contains(locator))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
 RTPSParticipantImpl::RTPSParticipantImpl(
         uint32_t domain_id,
         const RTPSParticipantAttributes& PParam,
@@ -111,6 +138,8 @@ RTPSParticipantImpl::RTPSParticipantImpl(
     , mp_ResourceSemaphore(new Semaphore(0))
     , IdCounter(0)
     , type_check_fn_(nullptr)
+    , shared_payload_pool_(PParam.allocation.shared_payloads.min_payload_size,
+            PParam.allocation.shared_payloads.min_adopted_payload_size)
 #if HAVE_SECURITY
     , m_security_manager(this)
 #endif
@@ -210,6 +239,19 @@ RTPSParticipantImpl::RTPSParticipantImpl(
         m_controllers.push_back(std::move(controller));
     }
 
+    // Aggregation of control messages, if a period has been configured
+    const std::string* aggregation_period = PropertyPolicyHelper::find_property(m_att.properties,
+                    "fastdds.control_messages.aggregation_period_us");
+    if (aggregation_period != nullptr)
+    {
+        uint32_t period_us = static_cast<uint32_t>(std::strtoul(aggregation_period->c_str(), nullptr, 10));
+        if (period_us > 0)
+        {
+            control_message_aggregator_.reset(new ControlMessageAggregator(this, m_guid.guidPrefix,
+                    getMaxMessageSize(), period_us));
+        }
+    }
+
     /* If metatrafficMulticastLocatorList is empty, add mandatory default Locators
        Else -> Take them */
 
@@ -319,10 +361,43 @@ RTPSParticipantImpl::RTPSParticipantImpl(
         m_att.defaultMulticastLocatorList.clear();
     }
 
-    createReceiverResources(m_att.builtin.metatrafficMulticastLocatorList, true, false);
-    createReceiverResources(m_att.builtin.metatrafficUnicastLocatorList, true, false);
-    createReceiverResources(m_att.defaultUnicastLocatorList, true, false);
-    createReceiverResources(m_att.defaultMulticastLocatorList, true, false);
+    std::array<LocatorList_t*, 4> receiver_lists = {
+        &m_att.builtin.metatrafficMulticastLocatorList,
+        &m_att.builtin.metatrafficUnicastLocatorList,
+        &m_att.defaultUnicastLocatorList,
+        &m_att.defaultMulticastLocatorList
+    };
+
+    // Opening the sockets and starting the reception threads of each list can be done concurrently.
+    // The port mutations of the unicast lists never collide, as metatraffic and user ports have different parity.
+    const std::string* parallel_receiver_setup = PropertyPolicyHelper::find_property(m_att.properties,
+                    "fastdds.participant.parallel_receiver_setup");
+    if (parallel_receiver_setup != nullptr && *parallel_receiver_setup == "true" &&
+            !lists_share_locators(receiver_lists))
+    {
+        std::vector<std::future<void> > setups;
+        for (LocatorList_t* list : receiver_lists)
+        {
+            if (!list->empty())
+            {
+                setups.push_back(std::async(std::launch::async, [this, list]()
+                        {
+                            createReceiverResources(*list, true, false);
+                        }));
+            }
+        }
+        for (auto& setup : setups)
+        {
+            setup.get();
+        }
+    }
+    else
+    {
+        for (LocatorList_t* list : receiver_lists)
+        {
+            createReceiverResources(*list, true, false);
+        }
+    }
 
     bool allow_growing_buffers = m_att.allocation.send_buffers.dynamic;
     size_t num_send_buffers = m_att.allocation.send_buffers.preallocated_number;
@@ -434,6 +509,9 @@ RTPSParticipantImpl::~RTPSParticipantImpl()
 
     delete mp_ResourceSemaphore;
     delete mp_userParticipant;
+
+    // Pending control messages are sent before the send resources are destroyed
+    control_message_aggregator_.reset();
     send_resource_list_.clear();
 
     delete mp_mutex;
@@ -600,8 +678,18 @@ bool RTPSParticipantImpl::createWriter(
     }
     *WriterOut = SWriter;
 
+    // Reliable writers may adapt their throughput to the feedback of the readers
+    CongestionControllerDescriptor congestion_descriptor;
+    if (param.endpoint.reliabilityKind == RELIABLE &&
+            CongestionControllerDescriptor::from_properties(param.endpoint.properties, param.throughputController,
+            congestion_descriptor))
+    {
+        std::unique_ptr<FlowController> controller(new CongestionController(congestion_descriptor, SWriter));
+        SWriter->add_flow_controller(std::move(controller));
+    }
     // If the terminal throughput controller has proper user defined values, instantiate it
-    if (param.throughputController.bytesPerPeriod != UINT32_MAX && param.throughputController.periodMillisecs != 0)
+    else if (param.throughputController.bytesPerPeriod != UINT32_MAX &&
+            param.throughputController.periodMillisecs != 0)
     {
         std::unique_ptr<FlowController> controller(new ThroughputController(param.throughputController, SWriter));
         SWriter->add_flow_controller(std::move(controller));
@@ -1009,6 +1097,11 @@ void RTPSParticipantImpl::createReceiverResources(
     uint32_t max_receiver_buffer_size = std::numeric_limits<uint32_t>::max();
 #endif
 
+    // Readers only keep reception buffers when adoption is enabled
+    const SharedPayloadsAllocationAttributes& shared_payloads = m_att.allocation.shared_payloads;
+    uint32_t max_lent_buffers =
+            shared_payloads.min_adopted_payload_size > 0 ? shared_payloads.max_adopted_reception_buffers : 0u;
+
     for (auto it_loc = Locator_list.begin(); it_loc != Locator_list.end(); ++it_loc)
     {
         bool ret = m_network_Factory.BuildReceiverResources(*it_loc, newItemsBuffer, max_receiver_buffer_size);
@@ -1027,6 +1120,7 @@ void RTPSParticipantImpl::createReceiverResources(
         {
             std::lock_guard<std::mutex> lock(m_receiverResourcelistMutex);
             //Push the new items into the ReceiverResource buffer
+            (*it_buffer)->max_lent_buffers(max_lent_buffers);
             m_receiverResourcelist.emplace_back(*it_buffer);
             //Create and init the MessageReceiver
             auto mr = new MessageReceiver(this, (*it_buffer)->max_message_size());
@@ -1357,7 +1451,7 @@ WLP* RTPSParticipantImpl::wlp()
 
 fastdds::dds::builtin::TypeLookupManager* RTPSParticipantImpl::typelookup_manager() const
 {
-    return mp_builtinProtocols->tlm_;
+    return mp_builtinProtocols->typelookup_manager();
 }
 
 IPersistenceService* RTPSParticipantImpl::get_persistence_service(
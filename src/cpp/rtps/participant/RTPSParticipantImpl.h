@@ -49,6 +49,8 @@
 
 #include "../messages/RTPSMessageGroup_t.hpp"
 #include "../messages/SendBuffersManager.hpp"
+#include "../history/SharedPayloadPool.hpp"
+#include "../messages/ControlMessageAggregator.hpp"
 
 #if HAVE_SECURITY
 #include <fastdds/rtps/Endpoint.h>
@@ -440,6 +442,21 @@ public:
 
     uint32_t get_domain_id() const;
 
+    //! Pool of payloads shared between the readers of this participant
+    SharedPayloadPool& shared_payload_pool()
+    {
+        return shared_payload_pool_;
+    }
+
+    /**
+     * Get the aggregator of control messages of this participant.
+     * @return nullptr when control messages should not be aggregated.
+     */
+    ControlMessageAggregator* control_message_aggregator()
+    {
+        return control_message_aggregator_.get();
+    }
+
     //!Compare metatraffic locators list searching for mutations
     bool did_mutation_took_place_on_meta(
         const LocatorList_t& MulticastLocatorList,
@@ -482,6 +499,10 @@ private:
     std::function<bool(const std::string&)> type_check_fn_;
     //!Pool of send buffers
     std::unique_ptr<SendBuffersManager> send_buffers_;
+    //!Pool of payloads shared between readers
+    SharedPayloadPool shared_payload_pool_;
+    //!Aggregator of control messages sent by the endpoints
+    std::unique_ptr<ControlMessageAggregator> control_message_aggregator_;
 
 #if HAVE_SECURITY
     // Security manager
@@ -31,11 +31,26 @@
 #include <typeinfo>
 #include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <limits>
 
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+static ResourceLimitedContainerConfig unread_changes_configuration(
+        const HistoryAttributes& att)
+{
+    // There cannot be more unread changes than changes on the history
+    size_t initial = static_cast<size_t>(std::abs(att.initialReservedCaches));
+    ResourceLimitedContainerConfig config(initial, std::numeric_limits<size_t>::max(), initial > 0 ? initial : 1u);
+    if (att.maximumReservedCaches > 0)
+    {
+        config.maximum = static_cast<size_t>(att.maximumReservedCaches);
+    }
+    return config;
+}
+
 RTPSReader::RTPSReader(
         RTPSParticipantImpl* pimpl,
         const GUID_t& guid,
@@ -49,6 +64,7 @@ RTPSReader::RTPSReader(
     , m_acceptMessagesFromUnkownWriters(false)
     , m_expectsInlineQos(att.expectsInlineQos)
     , history_state_(new ReaderHistoryState(att.matched_writers_allocation.initial))
+    , unread_changes_(unread_changes_configuration(hist->m_att))
     , liveliness_kind_(att.liveliness_kind_)
     , liveliness_lease_duration_(att.liveliness_lease_duration)
 {
@@ -135,6 +151,38 @@ void RTPSReader::remove_persistence_guid(
     }
 }
 
+bool RTPSReader::matched_writer_compresses(
+        const GUID_t& writer_guid) const
+{
+    std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
+    const std::vector<GUID_t>& writers = history_state_->compressing_writers;
+    return std::find(writers.begin(), writers.end(), writer_guid) != writers.end();
+}
+
+void RTPSReader::add_writer_representation(
+        const WriterProxyData& wdata)
+{
+    const std::vector<fastdds::dds::DataRepresentationId_t>& representations = wdata.m_qos.representation.m_value;
+    if (!representations.empty() &&
+            representations.front() == fastdds::dds::COMPRESSED_XCDR_DATA_REPRESENTATION)
+    {
+        std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
+        std::vector<GUID_t>& writers = history_state_->compressing_writers;
+        if (std::find(writers.begin(), writers.end(), wdata.guid()) == writers.end())
+        {
+            writers.push_back(wdata.guid());
+        }
+    }
+}
+
+void RTPSReader::remove_writer_representation(
+        const GUID_t& guid)
+{
+    std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
+    std::vector<GUID_t>& writers = history_state_->compressing_writers;
+    writers.erase(std::remove(writers.begin(), writers.end(), guid), writers.end());
+}
+
 SequenceNumber_t RTPSReader::update_last_notified(
         const GUID_t& guid,
         const SequenceNumber_t& seq)
@@ -203,7 +251,7 @@ bool RTPSReader::wait_for_unread_cache(
     {
         if (new_notification_cv_.wait_until(lock, time_out, [&]()
                     {
-                        return total_unread_ > 0;
+                        return !unread_changes_.empty();
                     }))
         {
             return true;
@@ -216,7 +264,45 @@ bool RTPSReader::wait_for_unread_cache(
 uint64_t RTPSReader::get_unread_count() const
 {
     std::unique_lock<RecursiveTimedMutex> lock(mp_mutex);
-    return total_unread_;
+    return unread_changes_.size();
+}
+
+void RTPSReader::add_unread_change(
+        CacheChange_t* change)
+{
+    // Same order as the history, which only inserts before its last change when the timestamp is older
+    bool in_order = unread_changes_.empty() ||
+            !(change->sourceTimestamp < unread_changes_.back()->sourceTimestamp);
+
+    if (nullptr == unread_changes_.push_back(change))
+    {
+        logError(RTPS_READER, "More unread changes than the history can keep on " << m_guid);
+        return;
+    }
+
+    if (!in_order)
+    {
+        auto it = std::upper_bound(unread_changes_.begin(), unread_changes_.end() - 1, change,
+                        [](const CacheChange_t* c1, const CacheChange_t* c2) -> bool
+                    {
+                        return c1->sourceTimestamp < c2->sourceTimestamp;
+                    });
+        std::rotate(it, unread_changes_.end() - 1, unread_changes_.end());
+    }
+}
+
+bool RTPSReader::remove_unread_change(
+        CacheChange_t* change)
+{
+    // Changes are usually read and removed in order, so they are looked for from the front
+    auto it = std::find(unread_changes_.begin(), unread_changes_.end(), change);
+    if (it == unread_changes_.end())
+    {
+        return false;
+    }
+
+    unread_changes_.erase(it);
+    return true;
 }
 
 } /* namespace rtps */
@@ -28,6 +28,7 @@
 #include <fastrtps/utils/collections/foonathan_memory_helpers.hpp>
 
 #include <map>
+#include <vector>
 
 namespace eprosima {
 namespace fastrtps {
@@ -63,6 +64,7 @@ struct ReaderHistoryState
         , persistence_guid_count(persistence_guid_count_allocator)
         , history_record(history_record_allocator)
     {
+        compressing_writers.reserve(initial_writers_allocation);
     }
 
     pool_allocator_t persistence_guid_map_allocator;
@@ -75,6 +77,8 @@ struct ReaderHistoryState
     foonathan::memory::map<GUID_t, uint16_t, pool_allocator_t> persistence_guid_count;
     //!Information about max notified change
     foonathan::memory::map<GUID_t, SequenceNumber_t, pool_allocator_t> history_record;
+    //!Matched writers compressing their payloads
+    std::vector<GUID_t> compressing_writers;
 };
 
 } /* namespace rtps */
@@ -26,6 +26,7 @@
 #include <rtps/reader/WriterProxy.h>
 #include <fastrtps/utils/TimeConversion.h>
 #include <rtps/history/HistoryAttributesExtension.hpp>
+#include <rtps/history/SharedPayloadPool.hpp>
 
 #include <fastdds/rtps/builtin/BuiltinProtocols.h>
 #include <fastdds/rtps/builtin/liveliness/WLP.h>
@@ -76,6 +77,7 @@ StatefulReader::StatefulReader(
     , times_(att.times)
     , matched_writers_(att.matched_writers_allocation)
     , matched_writers_pool_(att.matched_writers_allocation)
+    , matched_writers_index_(att.matched_writers_allocation)
     , proxy_changes_config_(resource_limits_from_history(hist->m_att, 0))
     , disable_positive_acks_(att.disable_positive_acks)
     , is_alive_(true)
@@ -101,21 +103,19 @@ bool StatefulReader::matched_writer_add(
 
     bool is_same_process = RTPSDomainImpl::should_intraprocess_between(m_guid, wdata.guid());
 
-    for (WriterProxy* it : matched_writers_)
+    WriterProxy* existing = matched_writers_index_.find(wdata.guid());
+    if (existing != nullptr)
     {
-        if (it->guid() == wdata.guid())
+        logInfo(RTPS_READER, "Attempting to add existing writer, updating information");
+        existing->update(wdata);
+        if (!is_same_process)
         {
-            logInfo(RTPS_READER, "Attempting to add existing writer, updating information");
-            it->update(wdata);
-            if (!is_same_process)
+            for (const Locator_t& locator : existing->remote_locators_shrinked())
             {
-                for (const Locator_t& locator : it->remote_locators_shrinked())
-                {
-                    getRTPSParticipant()->createSenderResources(locator);
-                }
+                getRTPSParticipant()->createSenderResources(locator);
             }
-            return false;
         }
+        return false;
     }
 
     // Get a writer proxy from the inactive pool (or create a new one if necessary and allowed)
@@ -151,11 +151,13 @@ bool StatefulReader::matched_writer_add(
 
     SequenceNumber_t initial_sequence;
     add_persistence_guid(wdata.guid(), wdata.persistence_guid());
+    add_writer_representation(wdata);
     initial_sequence = get_last_notified(wdata.guid());
 
     wp->start(wdata, initial_sequence);
 
     matched_writers_.push_back(wp);
+    matched_writers_index_.add(wp->guid(), wp);
 
     if (liveliness_lease_duration_ < c_TimeInfinite)
     {
@@ -214,7 +216,9 @@ bool StatefulReader::matched_writer_remove(
 
                 wproxy = *it;
                 matched_writers_.erase(it);
+                matched_writers_index_.remove(writer_guid);
                 remove_persistence_guid(wproxy->guid(), wproxy->persistence_guid());
+                remove_writer_representation(writer_guid);
                 break;
             }
         }
@@ -237,13 +241,8 @@ bool StatefulReader::matched_writer_is_matched(
     std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
     if (is_alive_)
     {
-        for (WriterProxy* it : matched_writers_)
-        {
-            if (it->guid() == writer_guid && it->is_alive())
-            {
-                return true;
-            }
-        }
+        WriterProxy* wp = matched_writers_index_.find(writer_guid);
+        return wp != nullptr && wp->is_alive();
     }
     return false;
 }
@@ -282,13 +281,11 @@ bool StatefulReader::findWriterProxy(
 {
     assert(WP);
 
-    for (WriterProxy* it : matched_writers_)
+    WriterProxy* wp = matched_writers_index_.find(writerGUID);
+    if (wp != nullptr && wp->is_alive())
     {
-        if (it->guid() == writerGUID && it->is_alive())
-        {
-            *WP = it;
-            return true;
-        }
+        *WP = wp;
+        return true;
     }
     return false;
 }
@@ -336,10 +333,23 @@ bool StatefulReader::processDataMsg(
 
             CacheChange_t* change_to_add;
 
-            if (reserveCache(&change_to_add, change->serializedPayload.length)) //Reserve a new cache from the corresponding cache pool
+            // Shared payloads are referenced instead of copied, so no buffer is needed for them
+            octet* shared_buffer = SharedPayloadPool::incoming_buffer(*change);
+            bool share_payload = shared_buffer != nullptr;
+#if HAVE_SECURITY
+            share_payload &= !getAttributes().security_attributes().is_payload_protected;
+#endif
+            uint32_t payload_size = share_payload ? 0 : change->serializedPayload.length;
+
+            if (reserveCache(&change_to_add, payload_size)) //Reserve a new cache from the corresponding cache pool
             {
+                if (share_payload)
+                {
+                    change_to_add->copy_not_memcpy(change);
+                    SharedPayloadPool::share_payload(shared_buffer, *change, *change_to_add);
+                }
 #if HAVE_SECURITY
-                if (getAttributes().security_attributes().is_payload_protected)
+                else if (getAttributes().security_attributes().is_payload_protected)
                 {
                     change_to_add->copy_not_memcpy(change);
                     if (!getRTPSParticipant()->security_manager().decode_serialized_payload(change->serializedPayload,
@@ -350,10 +360,8 @@ bool StatefulReader::processDataMsg(
                         return false;
                     }
                 }
-                else
-                {
 #endif
-                if (!change_to_add->copy(change))
+                else if (!change_to_add->copy(change))
                 {
                     logWarning(RTPS_MSG_IN, IDSTRING "Problem copying CacheChange, received data is: " << change->serializedPayload.length
                                                                                                        << " bytes and max size in reader " << getGuid().entityId << " is " <<
@@ -361,9 +369,6 @@ bool StatefulReader::processDataMsg(
                     releaseCache(change_to_add);
                     return false;
                 }
-#if HAVE_SECURITY
-            }
-#endif
             }
             else
             {
@@ -635,13 +640,9 @@ bool StatefulReader::acceptMsgFrom(
 {
     assert(wp != nullptr);
 
-    for (WriterProxy* it : matched_writers_)
+    if (findWriterProxy(writerId, wp))
     {
-        if (it->guid() == writerId && it->is_alive())
-        {
-            *wp = it;
-            return true;
-        }
+        return true;
     }
 
     // Check if it's a framework's one. In this case, m_acceptMessagesFromUnkownWriters
@@ -662,21 +663,17 @@ bool StatefulReader::change_removed_by_history(
 {
     std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
 
+    if (!a_change->isRead)
+    {
+        remove_unread_change(a_change);
+    }
+
     if (is_alive_)
     {
         if (wp != nullptr || matched_writer_lookup(a_change->writerGUID, &wp))
         {
             if (a_change->is_fully_assembled())
             {
-                if (!a_change->isRead && wp->available_changes_max() >= a_change->sequenceNumber)
-                {
-                    if (0 < total_unread_)
-                    {
-                        --total_unread_;
-                    }
-                }
-
-
                 wp->change_removed_from_history(a_change->sequenceNumber);
             }
             return true;
@@ -777,7 +774,7 @@ void StatefulReader::NotifyChanges(
         {
             if (!ch_to_give->isRead)
             {
-                ++total_unread_;
+                add_unread_change(ch_to_give);
 
                 if (getListener() != nullptr)
                 {
@@ -808,54 +805,49 @@ bool StatefulReader::nextUntakenCache(
         return false;
     }
 
-    std::vector<CacheChange_t*> toremove;
-    bool takeok = false;
-    for (std::vector<CacheChange_t*>::iterator it = mp_history->changesBegin();
-            it != mp_history->changesEnd(); ++it)
+    // Changes available to the user are the read ones and the ones on the list of unread changes, which keeps the
+    // order of the history, so only changes not available yet are skipped before its front.
+    History::iterator it = mp_history->changesBegin();
+    while (it != mp_history->changesEnd())
     {
-        WriterProxy* wp;
-        if (this->matched_writer_lookup((*it)->writerGUID, &wp))
+        CacheChange_t* candidate = *it;
+        if (!candidate->isRead && (unread_changes_.empty() || candidate != unread_changes_.front()))
         {
-            // TODO Revisar la comprobacion
-            SequenceNumber_t seq = wp->available_changes_max();
-            if (seq >= (*it)->sequenceNumber)
-            {
-                *change = *it;
+            ++it;
+            continue;
+        }
 
-                if (!(*change)->isRead)
-                {
-                    if (0 < total_unread_)
-                    {
-                        --total_unread_;
-                    }
-                }
+        WriterProxy* wp;
+        if (!this->matched_writer_lookup(candidate->writerGUID, &wp))
+        {
+            logWarning(RTPS_READER,
+                    "Removing change " << candidate->sequenceNumber << " from " << candidate->writerGUID <<
+                    " because is no longer paired");
+
+            // The history keeps its changes on a vector, so the next one takes the place of the removed one
+            auto position = it - mp_history->changesBegin();
+            mp_history->remove_change(candidate);
+            it = mp_history->changesBegin() + position;
+            continue;
+        }
 
-                (*change)->isRead = true;
+        if (!candidate->isRead)
+        {
+            unread_changes_.erase(unread_changes_.begin());
+        }
 
-                if (wpout != nullptr)
-                {
-                    *wpout = wp;
-                }
+        candidate->isRead = true;
+        *change = candidate;
 
-                takeok = true;
-                break;
-            }
-        }
-        else
+        if (wpout != nullptr)
         {
-            toremove.push_back((*it));
+            *wpout = wp;
         }
-    }
 
-    for (std::vector<CacheChange_t*>::iterator it = toremove.begin();
-            it != toremove.end(); ++it)
-    {
-        logWarning(RTPS_READER,
-                "Removing change " << (*it)->sequenceNumber << " from " << (*it)->writerGUID <<
-                " because is no longer paired");
-        mp_history->remove_change(*it);
+        return true;
     }
-    return takeok;
+
+    return false;
 }
 
 // TODO Porque elimina aqui y no cuando hay unpairing
@@ -869,57 +861,33 @@ bool StatefulReader::nextUnreadCache(
         return false;
     }
 
-    std::vector<CacheChange_t*> toremove;
-    bool readok = false;
-    for (std::vector<CacheChange_t*>::iterator it = mp_history->changesBegin();
-            it != mp_history->changesEnd(); ++it)
+    // Only changes already available are on the list of unread changes
+    while (!unread_changes_.empty())
     {
-        if ((*it)->isRead)
-        {
-            continue;
-        }
+        CacheChange_t* unread = unread_changes_.front();
+        unread_changes_.erase(unread_changes_.begin());
 
         WriterProxy* wp;
-        if (this->matched_writer_lookup((*it)->writerGUID, &wp))
+        if (this->matched_writer_lookup(unread->writerGUID, &wp))
         {
-            SequenceNumber_t seq;
-            seq = wp->available_changes_max();
-            if (seq >= (*it)->sequenceNumber)
-            {
-                *change = *it;
-
-                if (0 < total_unread_)
-                {
-                    --total_unread_;
-                }
-
-                (*change)->isRead = true;
-
-                if (wpout != nullptr)
-                {
-                    *wpout = wp;
-                }
+            *change = unread;
+            (*change)->isRead = true;
 
-                readok = true;
-                break;
+            if (wpout != nullptr)
+            {
+                *wpout = wp;
             }
+
+            return true;
         }
-        else
-        {
-            toremove.push_back((*it));
-        }
-    }
 
-    for (std::vector<CacheChange_t*>::iterator it = toremove.begin();
-            it != toremove.end(); ++it)
-    {
         logWarning(RTPS_READER,
-                "Removing change " << (*it)->sequenceNumber << " from " << (*it)->writerGUID <<
+                "Removing change " << unread->sequenceNumber << " from " << unread->writerGUID <<
                 " because is no longer paired");
-        mp_history->remove_change(*it);
+        mp_history->remove_change(unread);
     }
 
-    return readok;
+    return false;
 }
 
 bool StatefulReader::updateTimes(
@@ -982,6 +950,7 @@ void StatefulReader::send_acknack(
     if (!writer->is_on_same_process())
     {
         RTPSMessageGroup group(getRTPSParticipant(), this, sender);
+        group.aggregate_control_messages();
         group.add_acknack(sns, acknack_count_, is_final);
     }
     else
@@ -1018,6 +987,7 @@ void StatefulReader::send_acknack(
     try
     {
         RTPSMessageGroup group(getRTPSParticipant(), this, sender);
+        group.aggregate_control_messages();
         if (!missing_changes.empty() || !heartbeat_was_final)
         {
             GUID_t guid = sender.remote_guids().at(0);
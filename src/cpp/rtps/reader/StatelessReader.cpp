@@ -26,6 +26,7 @@
 #include <fastdds/rtps/builtin/liveliness/WLP.h>
 #include <fastdds/rtps/writer/LivelinessManager.h>
 #include <rtps/participant/RTPSParticipantImpl.h>
+#include <rtps/history/SharedPayloadPool.hpp>
 
 #include <mutex>
 #include <thread>
@@ -73,6 +74,7 @@ bool StatelessReader::matched_writer_add(
     if (att != nullptr)
     {
         add_persistence_guid(info.guid, info.persistence_guid);
+        add_writer_representation(wdata);
 
         m_acceptMessagesFromUnkownWriters = false;
         logInfo(RTPS_READER, "Writer " << info.guid << " added to reader " << m_guid);
@@ -130,6 +132,7 @@ bool StatelessReader::matched_writer_remove(
             }
 
             remove_persistence_guid(it->guid, it->persistence_guid);
+            remove_writer_representation(writer_guid);
             matched_writers_.erase(it);
 
             return true;
@@ -162,7 +165,7 @@ bool StatelessReader::change_received(
         {
             Time_t::now(change->receptionTimestamp);
             update_last_notified(change->writerGUID, change->sequenceNumber);
-            ++total_unread_;
+            add_unread_change(change);
 
             if (getListener() != nullptr)
             {
@@ -188,10 +191,7 @@ bool StatelessReader::nextUntakenCache(
     {
         if (!(*change)->isRead)
         {
-            if (0 < total_unread_)
-            {
-                --total_unread_;
-            }
+            remove_unread_change(*change);
         }
 
         (*change)->isRead = true;
@@ -206,26 +206,11 @@ bool StatelessReader::nextUnreadCache(
         WriterProxy** /*wpout*/)
 {
     std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
-    bool found = false;
-    std::vector<CacheChange_t*>::iterator it;
 
-    for (it = mp_history->changesBegin();
-            it!=mp_history->changesEnd(); ++it)
+    if (!unread_changes_.empty())
     {
-        if (!(*it)->isRead)
-        {
-            found = true;
-            break;
-        }
-    }
-
-    if (found)
-    {
-        *change = *it;
-        if (0 < total_unread_)
-        {
-            --total_unread_;
-        }
+        *change = unread_changes_.front();
+        unread_changes_.erase(unread_changes_.begin());
         (*change)->isRead = true;
 
         return true;
@@ -242,10 +227,7 @@ bool StatelessReader::change_removed_by_history(
 {
     if (!ch->isRead)
     {
-        if (0 < total_unread_)
-        {
-            --total_unread_;
-        }
+        remove_unread_change(ch);
     }
 
     return true;
@@ -266,11 +248,24 @@ bool StatelessReader::processDataMsg(
 
         CacheChange_t* change_to_add;
 
+        // Shared payloads are referenced instead of copied, so no buffer is needed for them
+        octet* shared_buffer = SharedPayloadPool::incoming_buffer(*change);
+        bool share_payload = shared_buffer != nullptr;
+#if HAVE_SECURITY
+        share_payload &= !getAttributes().security_attributes().is_payload_protected;
+#endif
+        uint32_t payload_size = share_payload ? 0 : change->serializedPayload.length;
+
         //Reserve a new cache from the corresponding cache pool
-        if (reserveCache(&change_to_add, change->serializedPayload.length))
+        if (reserveCache(&change_to_add, payload_size))
         {
+            if (share_payload)
+            {
+                change_to_add->copy_not_memcpy(change);
+                SharedPayloadPool::share_payload(shared_buffer, *change, *change_to_add);
+            }
 #if HAVE_SECURITY
-            if (getAttributes().security_attributes().is_payload_protected)
+            else if (getAttributes().security_attributes().is_payload_protected)
             {
                 change_to_add->copy_not_memcpy(change);
                 if (!getRTPSParticipant()->security_manager().decode_serialized_payload(
@@ -282,10 +277,8 @@ bool StatelessReader::processDataMsg(
                     return false;
                 }
             }
-            else
-            {
 #endif
-            if (!change_to_add->copy(change))
+            else if (!change_to_add->copy(change))
             {
                 logWarning(RTPS_MSG_IN, IDSTRING "Problem copying CacheChange, received data is: "
                         << change->serializedPayload.length << " bytes and max size in reader "
@@ -293,9 +286,6 @@ bool StatelessReader::processDataMsg(
                 releaseCache(change_to_add);
                 return false;
             }
-#if HAVE_SECURITY
-        }
-#endif
         }
         else
         {
@@ -29,6 +29,7 @@
 #include <fastdds/rtps/resources/TimedEvent.h>
 #include <fastdds/rtps/messages/RTPSMessageCreator.h>
 #include <rtps/participant/RTPSParticipantImpl.h>
+#include <rtps/messages/ControlMessageAggregator.hpp>
 
 #include "rtps/RTPSDomainImpl.hpp"
 
@@ -572,6 +573,20 @@ bool WriterProxy::send(
                    max_blocking_time_point);
 }
 
+bool WriterProxy::queue_control_message(
+        CDRMessage_t* message,
+        ControlMessageAggregator& aggregator) const
+{
+    if (is_on_same_process_)
+    {
+        return true;
+    }
+
+    ResourceLimitedVector<Locator_t> remote_locators = remote_locators_shrinked();
+
+    return aggregator.add(*message, Locators(remote_locators.begin()), Locators(remote_locators.end()));
+}
+
 #if !defined(NDEBUG) && defined(FASTRTPS_SOURCE) && defined(__linux__)
 int WriterProxy::get_mutex_owner() const
 {
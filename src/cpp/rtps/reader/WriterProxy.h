@@ -316,6 +316,17 @@ public:
             CDRMessage_t* message,
             std::chrono::steady_clock::time_point& max_blocking_time_point) const override;
 
+    /**
+     * Queue a message with control submessages on an aggregator.
+     *
+     * @param message Pointer to the buffer with the message already serialized.
+     * @param aggregator Aggregator where the message should be queued.
+     * @return true if the message has been queued.
+     */
+    virtual bool queue_control_message(
+            CDRMessage_t* message,
+            ControlMessageAggregator& aggregator) const override;
+
     bool is_on_same_process() const
     {
         return is_on_same_process_;
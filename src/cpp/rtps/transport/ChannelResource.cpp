@@ -15,15 +15,22 @@
 #include <asio.hpp>
 #include <fastdds/rtps/transport/ChannelResource.h>
 
+#include <rtps/common/SharedBuffer.hpp>
+
+#include <algorithm>
+
 namespace eprosima {
 namespace fastdds {
 namespace rtps {
 
 using Log = fastdds::dds::Log;
+using octet = fastrtps::rtps::octet;
+using SharedBuffer = fastrtps::rtps::SharedBuffer;
 
 ChannelResource::ChannelResource()
     : message_buffer_(RTPSMESSAGE_DEFAULT_SIZE)
     , alive_(true)
+    , receive_buffer_size_(0)
 {
     logInfo(RTPS_MSG_IN, "Created with CDRMessage of size: " << message_buffer_.max_size);
 }
@@ -31,6 +38,8 @@ ChannelResource::ChannelResource()
 ChannelResource::ChannelResource(ChannelResource&& channelResource)
     : message_buffer_(std::move(channelResource.message_buffer_))
     , thread_(std::move(channelResource.thread_))
+    , receive_buffers_(std::move(channelResource.receive_buffers_))
+    , receive_buffer_size_(channelResource.receive_buffer_size_)
 {
     bool b = channelResource.alive_;
     alive_.store(b);
@@ -39,16 +48,45 @@ ChannelResource::ChannelResource(ChannelResource&& channelResource)
 }
 
 ChannelResource::ChannelResource(uint32_t rec_buffer_size)
-    : message_buffer_(rec_buffer_size)
+    : message_buffer_(0)
     , alive_(true)
+    , receive_buffer_size_(rec_buffer_size)
 {
-    memset(message_buffer_.buffer, 0, rec_buffer_size);
+    // Messages are received on reference counted buffers, so receivers can keep them
+    octet* buffer = SharedBuffer::allocate(rec_buffer_size);
+    if (buffer != nullptr)
+    {
+        receive_buffers_.push_back(buffer);
+        message_buffer_.init(buffer, rec_buffer_size);
+    }
+    else
+    {
+        // Receive on a buffer owned by the message, which is never lent
+        logWarning(RTPS_MSG_IN, "Cannot allocate a shared reception buffer of size: " << rec_buffer_size);
+        message_buffer_ = fastrtps::rtps::CDRMessage_t(rec_buffer_size);
+        receive_buffer_size_ = 0;
+    }
+
+    if (message_buffer_.buffer != nullptr)
+    {
+        memset(message_buffer_.buffer, 0, rec_buffer_size);
+    }
     logInfo(RTPS_MSG_IN, "Created with CDRMessage of size: " << message_buffer_.max_size);
 }
 
 ChannelResource::~ChannelResource()
 {
     clear();
+
+    // Buffers still referenced by a receiver are freed when it releases them
+    for (octet* buffer : receive_buffers_)
+    {
+        SharedBuffer::release(buffer);
+    }
+    if (receive_buffer_size_ > 0)
+    {
+        message_buffer_.buffer = nullptr;
+    }
 }
 
 void ChannelResource::clear()
@@ -67,6 +105,57 @@ void ChannelResource::clear()
     }
 }
 
+bool ChannelResource::can_lend_message_buffer(
+        uint32_t max_buffers)
+{
+    if (receive_buffer_size_ == 0 || max_buffers == 0)
+    {
+        return false;
+    }
+
+    for (octet* buffer : receive_buffers_)
+    {
+        if (buffer != message_buffer_.buffer && SharedBuffer::references(buffer) == 1)
+        {
+            return true;
+        }
+    }
+
+    // All the buffers are in use, so the next message will need a new one
+    if (receive_buffers_.size() <= max_buffers)
+    {
+        octet* buffer = SharedBuffer::allocate(receive_buffer_size_);
+        if (buffer != nullptr)
+        {
+            receive_buffers_.push_back(buffer);
+            logInfo(RTPS_MSG_IN, "Reception buffers kept by the receiver, " << receive_buffers_.size() << " created");
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ChannelResource::renew_message_buffer()
+{
+    octet* buffer = message_buffer_.buffer;
+    if (receive_buffer_size_ == 0 || SharedBuffer::references(buffer) == 1)
+    {
+        // Nobody kept the last message, so the buffer can be overwritten
+        return;
+    }
+
+    // can_lend_message_buffer() made sure there is a free one
+    for (octet* pooled_buffer : receive_buffers_)
+    {
+        if (SharedBuffer::references(pooled_buffer) == 1)
+        {
+            message_buffer_.buffer = pooled_buffer;
+            break;
+        }
+    }
+}
+
 } // namespace rtps
 } // namespace fastrtps
 } // namespace eprosima
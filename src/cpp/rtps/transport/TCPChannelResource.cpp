@@ -16,7 +16,9 @@
 #include <fastdds/rtps/transport/TCPTransportInterface.h>
 #include <fastrtps/utils/IPLocator.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <thread>
 
 namespace eprosima {
@@ -26,6 +28,10 @@ namespace rtps {
 using Locator_t = fastrtps::rtps::Locator_t;
 using IPLocator = fastrtps::rtps::IPLocator;
 using Log = fastdds::dds::Log;
+using octet = fastrtps::rtps::octet;
+
+//! Size of the chunks read from the socket by read_buffered
+static constexpr size_t s_receive_stream_size = 65536;
 
 /**
  * Search for the base port in the current domain without taking account the participant
@@ -53,6 +59,10 @@ TCPChannelResource::TCPChannelResource(
     , locator_(locator)
     , waiting_for_keep_alive_(false)
     , connection_status_(eConnectionStatus::eDisconnected)
+    , checksum_kind_(TCP_CHECKSUM_SUM)
+    , receive_stream_(s_receive_stream_size)
+    , receive_begin_(0)
+    , receive_end_(0)
     , tcp_connection_type_(TCPConnectionType::TCP_CONNECT_TYPE)
 {
 }
@@ -65,11 +75,54 @@ TCPChannelResource::TCPChannelResource(
     , locator_()
     , waiting_for_keep_alive_(false)
     , connection_status_(eConnectionStatus::eConnected)
+    , checksum_kind_(TCP_CHECKSUM_SUM)
+    , receive_stream_(s_receive_stream_size)
+    , receive_begin_(0)
+    , receive_end_(0)
     , tcp_connection_type_(TCPConnectionType::TCP_ACCEPT_TYPE)
 {
 }
 
 
+uint32_t TCPChannelResource::read_buffered(
+        octet* buffer,
+        std::size_t size,
+        asio::error_code& ec)
+{
+    size_t copied = std::min(size, receive_end_ - receive_begin_);
+    if (copied > 0)
+    {
+        memcpy(buffer, &receive_stream_[receive_begin_], copied);
+        receive_begin_ += copied;
+    }
+
+    while (copied < size)
+    {
+        size_t remaining = size - copied;
+        if (remaining >= receive_stream_.size())
+        {
+            // Not worth going through the stream
+            copied += read(&buffer[copied], remaining, ec);
+            break;
+        }
+
+        size_t bytes_read = read_some(receive_stream_.data(), receive_stream_.size(), ec);
+        receive_begin_ = 0;
+        receive_end_ = bytes_read;
+        if (bytes_read == 0)
+        {
+            break;
+        }
+
+        size_t to_copy = std::min(remaining, bytes_read);
+        memcpy(&buffer[copied], receive_stream_.data(), to_copy);
+        receive_begin_ = to_copy;
+        copied += to_copy;
+    }
+
+    return static_cast<uint32_t>(copied);
+}
+
 void TCPChannelResource::disable()
 {
     ChannelResource::disable(); // prevent asio callback workings on this channel.
@@ -144,6 +144,21 @@ uint32_t TCPChannelResourceBasic::read(
     return 0;
 }
 
+uint32_t TCPChannelResourceBasic::read_some(
+        octet* buffer,
+        std::size_t size,
+        asio::error_code& ec)
+{
+    std::unique_lock<std::mutex> read_lock(read_mutex_);
+
+    if (eConnecting < connection_status_)
+    {
+        return static_cast<uint32_t>(socket_->read_some(asio::buffer(buffer, size), ec));
+    }
+
+    return 0;
+}
+
 size_t TCPChannelResourceBasic::send(
         const octet* header,
         size_t header_size,
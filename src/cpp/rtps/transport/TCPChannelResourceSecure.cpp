@@ -194,6 +194,49 @@ uint32_t TCPChannelResourceSecure::read(
     return static_cast<uint32_t>(bytes_read);
 }
 
+uint32_t TCPChannelResourceSecure::read_some(
+        octet* buffer,
+        const std::size_t size,
+        asio::error_code& ec)
+{
+    size_t bytes_read = 0;
+
+    if (eConnecting < connection_status_)
+    {
+        std::promise<size_t> read_bytes_promise;
+        auto bytes_future = read_bytes_promise.get_future();
+        auto socket = secure_socket_;
+
+        strand_read_.post([&, socket]()
+        {
+            if(socket->lowest_layer().is_open())
+            {
+                socket->async_read_some(asio::buffer(buffer, size),
+                    [&, socket](const std::error_code& error, const size_t bytes_transferred)
+                    {
+                        ec = error;
+
+                        if (!error)
+                        {
+                            read_bytes_promise.set_value(bytes_transferred);
+                        }
+                        else
+                        {
+                            read_bytes_promise.set_value(0);
+                        }
+                    });
+            }
+            else
+            {
+                read_bytes_promise.set_value(0);
+            }
+        });
+        bytes_read = bytes_future.get();
+    }
+
+    return static_cast<uint32_t>(bytes_read);
+}
+
 size_t TCPChannelResourceSecure::send(
         const octet* header,
         size_t header_size,
@@ -15,6 +15,7 @@
 #include <fastdds/rtps/transport/TCPTransportInterface.h>
 #include <fastdds/rtps/transport/tcp/RTCPMessageManager.h>
 #include <rtps/transport/TCPSenderResource.hpp>
+#include <rtps/transport/tcp/TCPChecksum.hpp>
 //#include "TCPSenderResource.hpp"
 #include <fastdds/dds/log/Log.hpp>
 #include <fastrtps/utils/IPLocator.h>
@@ -70,6 +71,7 @@ TCPTransportDescriptor::TCPTransportDescriptor()
     , wait_for_tcp_negotiation(false)
     , calculate_crc(true)
     , check_crc(true)
+    , use_crc32c(false)
     , apply_security(false)
 {
 }
@@ -87,6 +89,7 @@ TCPTransportDescriptor::TCPTransportDescriptor(const TCPTransportDescriptor& t)
     , wait_for_tcp_negotiation(t.wait_for_tcp_negotiation)
     , calculate_crc(t.calculate_crc)
     , check_crc(t.check_crc)
+    , use_crc32c(t.use_crc32c)
     , apply_security(t.apply_security)
     , tls_config(t.tls_config)
 {
@@ -111,6 +114,7 @@ TCPTransportDescriptor& TCPTransportDescriptor::operator=(const TCPTransportDesc
     wait_for_tcp_negotiation = t.wait_for_tcp_negotiation;
     calculate_crc = t.calculate_crc;
     check_crc = t.check_crc;
+    use_crc32c = t.use_crc32c;
     apply_security = t.apply_security;
     tls_config = t.tls_config;
     return *this;
@@ -203,27 +207,19 @@ void TCPTransportInterface::bind_socket(
 bool TCPTransportInterface::check_crc(
         const TCPHeader &header,
         const octet *data,
-        uint32_t size) const
+        uint32_t size,
+        TCPChecksumKind kind) const
 {
-    uint32_t crc(0);
-    for (uint32_t i = 0; i < size; ++i)
-    {
-        crc = RTCPMessageManager::addToCRC(crc, data[i]);
-    }
-    return crc == header.crc;
+    return TCPChecksum::compute(kind, 0, data, size) == header.crc;
 }
 
 void TCPTransportInterface::calculate_crc(
         TCPHeader &header,
         const octet *data,
-        uint32_t size) const
+        uint32_t size,
+        TCPChecksumKind kind) const
 {
-    uint32_t crc(0);
-    for (uint32_t i = 0; i < size; ++i)
-    {
-        crc = RTCPMessageManager::addToCRC(crc, data[i]);
-    }
-    header.crc = crc;
+    header.crc = TCPChecksum::compute(kind, 0, data, size);
 }
 
 
@@ -301,13 +297,14 @@ void TCPTransportInterface::fill_rtcp_header(
         TCPHeader& header,
         const octet* send_buffer,
         uint32_t send_buffer_size,
-        uint16_t logical_port) const
+        uint16_t logical_port,
+        TCPChecksumKind checksum_kind) const
 {
     header.length = send_buffer_size + static_cast<uint32_t>(TCPHeader::size());
     header.logical_port = logical_port;
     if (configuration()->calculate_crc)
     {
-        calculate_crc(header, send_buffer, send_buffer_size);
+        calculate_crc(header, send_buffer, send_buffer_size, checksum_kind);
     }
 }
 
@@ -738,6 +735,9 @@ void TCPTransportInterface::perform_listen_operation(
 
         if(channel)
         {
+            // Leftovers from a previous connection of the channel
+            channel->clear_receive_stream();
+
             if (channel->tcp_connection_type() == TCPChannelResource::TCPConnectionType::TCP_CONNECT_TYPE)
             {
                 rtcp_message_manager->sendConnectionRequest(channel);
@@ -780,7 +780,15 @@ void TCPTransportInterface::perform_listen_operation(
                 ReceiverInUseCV* receiver_in_use = it->second.second;
                 receiver_in_use->in_use = true;
                 scopedLock.unlock();
-                receiver->OnDataReceived(msg.buffer, msg.length, channel->locator(), remote_locator);
+                if (channel->can_lend_message_buffer(receiver->max_lent_buffers()))
+                {
+                    receiver->OnPooledDataReceived(msg.buffer, msg.length, channel->locator(), remote_locator);
+                    channel->renew_message_buffer();
+                }
+                else
+                {
+                    receiver->OnDataReceived(msg.buffer, msg.length, channel->locator(), remote_locator);
+                }
                 scopedLock.lock();
                 receiver_in_use->in_use = false;
                 receiver_in_use->cv.notify_one();
@@ -804,7 +812,7 @@ bool TCPTransportInterface::read_body(
 {
     asio::error_code ec;
 
-    *bytes_received = channel->read(receive_buffer, body_size, ec);
+    *bytes_received = channel->read_buffered(receive_buffer, body_size, ec);
 
     if (ec)
     {
@@ -825,6 +833,9 @@ bool TCPTransportInterface::read_body(
 * the rest of the message, whose length is on the header.
 * TCP Header is transparent to the caller, so receive_buffer
 * doesn't include it.
+* Both are taken from the receive stream of the channel, which
+* reads the socket in big chunks, so a single system call
+* usually brings several messages.
 * */
 bool TCPTransportInterface::Receive(
         std::weak_ptr<RTCPMessageManager>& rtcp_manager,
@@ -845,7 +856,7 @@ bool TCPTransportInterface::Receive(
         TCPHeader tcp_header;
         asio::error_code ec;
 
-        size_t bytes_received = channel->read(reinterpret_cast<octet*>(&tcp_header),
+        size_t bytes_received = channel->read_buffered(reinterpret_cast<octet*>(&tcp_header),
                 TCPHeader::size(), ec);
 
         remote_locator = channel->locator();
@@ -909,7 +920,8 @@ bool TCPTransportInterface::Receive(
                     if (success)
                     {
                         if (configuration()->check_crc
-                                && !check_crc(tcp_header, receive_buffer, receive_buffer_size))
+                                && !check_crc(tcp_header, receive_buffer, receive_buffer_size,
+                                channel->checksum_kind()))
                         {
                             logWarning(RTCP_MSG_IN, "Bad TCP header CRC");
                         }
@@ -1069,7 +1081,7 @@ bool TCPTransportInterface::send(
             if (channel->is_logical_port_opened(logical_port))
             {
                 TCPHeader tcp_header;
-                fill_rtcp_header(tcp_header, send_buffer, send_buffer_size, logical_port);
+                fill_rtcp_header(tcp_header, send_buffer, send_buffer_size, logical_port, channel->checksum_kind());
 
                 {
                     asio::error_code ec;
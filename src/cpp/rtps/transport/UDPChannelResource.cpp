@@ -63,7 +63,15 @@ void UDPChannelResource::perform_listen_operation(Locator_t input_locator)
         // Processes the data through the CDR Message interface.
         if (message_receiver() != nullptr)
         {
-            message_receiver()->OnDataReceived(msg.buffer, msg.length, input_locator, remote_locator);
+            if (can_lend_message_buffer(message_receiver()->max_lent_buffers()))
+            {
+                message_receiver()->OnPooledDataReceived(msg.buffer, msg.length, input_locator, remote_locator);
+                renew_message_buffer();
+            }
+            else
+            {
+                message_receiver()->OnDataReceived(msg.buffer, msg.length, input_locator, remote_locator);
+            }
         }
         else if (alive())
         {
@@ -15,9 +15,10 @@
 #ifndef _FASTDDS_SHAREDMEM_MANAGER_H_
 #define _FASTDDS_SHAREDMEM_MANAGER_H_
 
+#include <algorithm>
 #include <atomic>
-#include <list>
 #include <unordered_map>
+#include <vector>
 
 #include <rtps/transport/shared_mem/SharedMemGlobal.hpp>
 
@@ -47,12 +48,135 @@ private:
         uint8_t data[1];
     };
 
+    /**
+     * Allocation data of a buffer, placed in the segment right before its BufferNode,
+     * so the layout of the BufferNode seen by the listeners doesn't change.
+     */
+    struct BufferInfo
+    {
+        //! Offset of the next BufferNode on the free list this buffer is on
+        std::atomic<SharedMemSegment::offset> next;
+        //! Set by whoever puts the buffer on its free list, so it is never put twice
+        std::atomic<uint32_t> on_free_list;
+        //! Bytes available for data
+        uint32_t capacity;
+        //! Free list the buffer returns to when released
+        uint32_t size_class;
+    };
+
+    /**
+     * Buffers are allocated on size classes, four for each power of two (16, 20, 24, 28, 32, 40...),
+     * so a released buffer can be reused by any later allocation of its class.
+     */
+    static constexpr uint32_t MIN_SIZE_CLASS_POWER = 4;
+    static constexpr uint32_t SIZE_CLASSES_PER_POWER = 4;
+    static constexpr uint32_t NUM_SIZE_CLASSES = (32 - MIN_SIZE_CLASS_POWER) * SIZE_CLASSES_PER_POWER;
+    static constexpr SharedMemSegment::offset EMPTY_FREE_LIST = -1;
+
     struct SegmentNode
     {
         std::atomic<uint32_t> ref_count;
         std::atomic<uint32_t> free_bytes;
+        //! Heads of the lists of released buffers of each size class.
+        //! Any process can push on them, only the process owning the segment pops from them.
+        std::atomic<SharedMemSegment::offset> free_lists[NUM_SIZE_CLASSES];
     };
 
+    static constexpr size_t buffer_alignment()
+    {
+        return (std::max)(std::alignment_of<BufferInfo>::value, std::alignment_of<BufferNode>::value);
+    }
+
+    static BufferInfo* buffer_info(
+            BufferNode* buffer_node)
+    {
+        return reinterpret_cast<BufferInfo*>(reinterpret_cast<uint8_t*>(buffer_node) - sizeof(BufferInfo));
+    }
+
+    static uint32_t size_class_power(
+            uint32_t size)
+    {
+        uint32_t power = MIN_SIZE_CLASS_POWER;
+        while (power < 31 && (size >> (power + 1)) != 0)
+        {
+            ++power;
+        }
+        return power;
+    }
+
+    //! @return Bytes of the given size class.
+    static uint32_t class_size(
+            uint32_t size_class)
+    {
+        uint32_t power = MIN_SIZE_CLASS_POWER + size_class / SIZE_CLASSES_PER_POWER;
+        uint32_t step = (1u << power) / SIZE_CLASSES_PER_POWER;
+        return (1u << power) + step * (size_class % SIZE_CLASSES_PER_POWER);
+    }
+
+    //! @return Smallest size class able to hold the given size. NUM_SIZE_CLASSES if there is none.
+    static uint32_t ceil_size_class(
+            uint32_t size)
+    {
+        if (size <= (1u << MIN_SIZE_CLASS_POWER))
+        {
+            return 0;
+        }
+
+        uint32_t power = size_class_power(size - 1);
+        uint32_t step = (1u << power) / SIZE_CLASSES_PER_POWER;
+        uint32_t index = (size - (1u << power) + step - 1) / step;
+        return (power - MIN_SIZE_CLASS_POWER) * SIZE_CLASSES_PER_POWER + index;
+    }
+
+    //! @return Largest size class whose buffers fit in the given size. The size must be at least the smallest class.
+    static uint32_t floor_size_class(
+            uint32_t size)
+    {
+        uint32_t power = size_class_power(size);
+        uint32_t step = (1u << power) / SIZE_CLASSES_PER_POWER;
+        uint32_t index = (size - (1u << power)) / step;
+        return (power - MIN_SIZE_CLASS_POWER) * SIZE_CLASSES_PER_POWER + index;
+    }
+
+    /**
+     * Push a buffer on the free list of its size class, unless it is already there.
+     * Lock-free, can be called from any process.
+     */
+    static void push_free_buffer(
+            SharedMemSegment& segment,
+            SegmentNode* segment_node,
+            BufferNode* buffer_node)
+    {
+        BufferInfo* info = buffer_info(buffer_node);
+        if (info->on_free_list.exchange(1) != 0)
+        {
+            return;
+        }
+
+        std::atomic<SharedMemSegment::offset>& head = segment_node->free_lists[info->size_class];
+        SharedMemSegment::offset offset = segment.get_offset_from_address(buffer_node);
+        SharedMemSegment::offset next = head.load(std::memory_order_relaxed);
+        do
+        {
+            info->next.store(next, std::memory_order_relaxed);
+        } while (!head.compare_exchange_weak(next, offset, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    /**
+     * Release the last reference to a buffer, making it available for new allocations on its segment.
+     */
+    static void release_buffer_node(
+            SharedMemSegment& segment,
+            SegmentNode* segment_node,
+            BufferNode* buffer_node)
+    {
+        uint32_t buffer_size = buffer_node->header.data_size;
+
+        // The buffer has to be on the free list before its space is announced
+        push_free_buffer(segment, segment_node, buffer_node);
+        segment_node->free_bytes.fetch_add(buffer_size);
+    }
+
 public:
 
     SharedMemManager(
@@ -83,7 +207,7 @@ public:
         );
             
         per_allocation_extra_size_ =
-                SharedMemSegment::compute_per_allocation_extra_size(std::alignment_of<BufferNode>::value);
+                SharedMemSegment::compute_per_allocation_extra_size(buffer_alignment());
     }
 
     class Buffer
@@ -147,13 +271,10 @@ public:
 
         void decrease_ref()
         {
-            int32_t buffer_size = buffer_node_->header.data_size;
-
             // Last reference to the buffer
             if (buffer_node_->header.ref_count.fetch_sub(1) == 1)
             {
-                // Anotate the new free space
-                segment_node_->free_bytes.fetch_add(buffer_size);
+                release_buffer_node(*segment_, segment_node_, buffer_node_);
             }
         }
 
@@ -205,6 +326,10 @@ public:
             segment_node_ = segment_->get().construct<SegmentNode>("segment_node")();
             segment_node_->ref_count.exchange(1);
             segment_node_->free_bytes.exchange(payload_size);
+            for (std::atomic<SharedMemSegment::offset>& free_list : segment_node_->free_lists)
+            {
+                free_list.store(EMPTY_FREE_LIST, std::memory_order_relaxed);
+            }
         }
 
         ~Segment()
@@ -237,17 +362,25 @@ public:
 
             wait_for_avaible_space(size, max_blocking_time_point);
 
-            release_unused_buffers();
-
-            void* data = nullptr;
             BufferNode* buffer_node = nullptr;
             std::shared_ptr<SharedMemBuffer> new_buffer;
 
             try
             {
-                buffer_node = static_cast<BufferNode*>(
-                    segment_->get().allocate_aligned(sizeof(BufferNode) + size, 
-                        std::alignment_of<BufferNode>::value));
+                uint32_t size_class = ceil_size_class(size);
+                if (size_class < NUM_SIZE_CLASSES)
+                {
+                    buffer_node = pop_free_buffer(size_class);
+                    if (buffer_node == nullptr)
+                    {
+                        recover_released_buffers();
+                        buffer_node = pop_free_buffer(size_class);
+                    }
+                }
+                if (buffer_node == nullptr)
+                {
+                    buffer_node = allocate_buffer_node(size, size_class);
+                }
 
                 buffer_node->header.data_size = size;
                 buffer_node->header.ref_count.store(0, std::memory_order_relaxed);
@@ -255,20 +388,13 @@ public:
                 // TODO(Adolfo) : Dynamic allocation. Use foonathan to convert it to static allocation
                 new_buffer = std::make_shared<SharedMemBuffer>(segment_, segment_id_, buffer_node, segment_node_);
 
-                // TODO(Adolfo) : Dynamic allocation. Use foonathan to convert it to static allocation
-                allocated_nodes_.push_back(buffer_node);
-
                 segment_node_->free_bytes.fetch_sub(size);
             }
             catch (const std::exception&)
             {
                 if (buffer_node)
                 {
-                    release_buffer(buffer_node);
-                }
-                else if (data)
-                {
-                    segment_->get().deallocate(data);
+                    push_free_buffer(*segment_, segment_node_, buffer_node);
                 }
 
                 overflows_count_++;
@@ -282,7 +408,8 @@ public:
     private:
 
         SegmentNode* segment_node_;
-        std::list<BufferNode*> allocated_nodes_;
+        //! Every buffer allocated on the segment, for the ones released without being put on their free list
+        std::vector<BufferNode*> allocated_nodes_;
         std::mutex alloc_mutex_;
         std::shared_ptr<SharedMemSegment> segment_;
         SharedMemSegment::Id segment_id_;
@@ -292,28 +419,120 @@ public:
         uint32_t max_payload_size_;
 #endif
 
-        void release_buffer(
-                BufferNode* buffer_node)
+        /**
+         * Take a released buffer from a free list.
+         * Only this process pops, and always holding alloc_mutex_, so the head cannot be popped
+         * and pushed again between reading it and replacing it.
+         */
+        BufferNode* pop_free_buffer(
+                uint32_t size_class)
         {
-            segment_->get().deallocate(buffer_node);
+            std::atomic<SharedMemSegment::offset>& head = segment_node_->free_lists[size_class];
+            SharedMemSegment::offset offset = head.load(std::memory_order_acquire);
+            while (offset != EMPTY_FREE_LIST)
+            {
+                BufferNode* buffer_node = static_cast<BufferNode*>(segment_->get_address_from_offset(offset));
+                SharedMemSegment::offset next = buffer_info(buffer_node)->next.load(std::memory_order_relaxed);
+                if (head.compare_exchange_weak(offset, next, std::memory_order_acquire, std::memory_order_acquire))
+                {
+                    buffer_info(buffer_node)->on_free_list.store(0, std::memory_order_relaxed);
+                    return buffer_node;
+                }
+            }
+            return nullptr;
         }
 
-        void release_unused_buffers()
+        BufferNode* new_buffer_node(
+                uint32_t capacity,
+                uint32_t size_class)
         {
-            auto node_it = allocated_nodes_.begin();
-            while (node_it != allocated_nodes_.end())
+            void* allocation = segment_->get().allocate_aligned(
+                sizeof(BufferInfo) + sizeof(BufferNode) + capacity, static_cast<uint32_t>(buffer_alignment()));
+
+            BufferInfo* info = static_cast<BufferInfo*>(allocation);
+            info->next.store(EMPTY_FREE_LIST, std::memory_order_relaxed);
+            info->on_free_list.store(0, std::memory_order_relaxed);
+            info->capacity = capacity;
+            info->size_class = size_class;
+            BufferNode* buffer_node =
+                    reinterpret_cast<BufferNode*>(static_cast<uint8_t*>(allocation) + sizeof(BufferInfo));
+
+            try
             {
-                // This shouldn't normally be negative, but when processes crashes
-                // due to fault-tolerance mecanishms it could happen.
-                if ((*node_it)->header.ref_count.load() <= 0)
+                allocated_nodes_.push_back(buffer_node);
+            }
+            catch (const std::exception&)
+            {
+                segment_->get().deallocate(allocation);
+                throw;
+            }
+
+            return buffer_node;
+        }
+
+        BufferNode* allocate_buffer_node(
+                uint32_t size,
+                uint32_t size_class)
+        {
+            if (size_class < NUM_SIZE_CLASSES)
+            {
+                try
+                {
+                    return new_buffer_node(class_size(size_class), size_class);
+                }
+                catch (const std::exception&)
                 {
-                    release_buffer(*node_it);
+                }
+            }
+
+            // No room for a whole size class. Give the released buffers back to the segment
+            // and allocate just the requested size.
+            release_free_buffers();
+            uint32_t capacity = (std::max)(size, 1u << MIN_SIZE_CLASS_POWER);
+            return new_buffer_node(capacity, floor_size_class(capacity));
+        }
 
-                    allocated_nodes_.erase(node_it++);
+        void release_free_buffers()
+        {
+            std::vector<BufferNode*> released;
+            for (std::atomic<SharedMemSegment::offset>& head : segment_node_->free_lists)
+            {
+                SharedMemSegment::offset offset = head.exchange(EMPTY_FREE_LIST, std::memory_order_acquire);
+                while (offset != EMPTY_FREE_LIST)
+                {
+                    BufferNode* buffer_node = static_cast<BufferNode*>(segment_->get_address_from_offset(offset));
+                    offset = buffer_info(buffer_node)->next.load(std::memory_order_relaxed);
+                    released.push_back(buffer_node);
                 }
-                else
+            }
+
+            std::sort(released.begin(), released.end());
+            allocated_nodes_.erase(std::remove_if(allocated_nodes_.begin(), allocated_nodes_.end(),
+                    [&released](BufferNode* buffer_node)
+                    {
+                        return std::binary_search(released.begin(), released.end(), buffer_node);
+                    }), allocated_nodes_.end());
+
+            for (BufferNode* buffer_node : released)
+            {
+                segment_->get().deallocate(buffer_info(buffer_node));
+            }
+        }
+
+        /**
+         * Put on their free lists the buffers whose last reference was released without doing it.
+         * Peers running a previous version only annotate the free space, and processes that crash
+         * holding references leave them unreleased.
+         */
+        void recover_released_buffers()
+        {
+            for (BufferNode* buffer_node : allocated_nodes_)
+            {
+                // This shouldn't normally be negative, but when processes crashes
+                // due to fault-tolerance mecanishms it could happen.
+                if (buffer_node->header.ref_count.load() <= 0)
                 {
-                    node_it++;
+                    push_free_buffer(*segment_, segment_node_, buffer_node);
                 }
             }
         }
@@ -611,9 +830,13 @@ public:
             uint32_t max_allocations)
     {
         // Every buffer allocated implies two internal allocations, node and payload.
-        // Every internal allocation consumes 'per_allocation_extra_size_' bytes
+        // Every internal allocation consumes 'per_allocation_extra_size_' bytes.
+        // Buffers are rounded up to their size class, which adds at most a quarter of their size,
+        // and buffers smaller than the smallest size class are given the whole class.
         uint32_t allocation_extra_size = sizeof(SegmentNode) + per_allocation_extra_size_ +
-                max_allocations * ((sizeof(BufferNode) + per_allocation_extra_size_) + per_allocation_extra_size_);
+                size / SIZE_CLASSES_PER_POWER +
+                max_allocations * ((sizeof(BufferInfo) + sizeof(BufferNode) + per_allocation_extra_size_) +
+                per_allocation_extra_size_ + (1u << MIN_SIZE_CLASS_POWER));
 
         return std::make_shared<Segment>(size + allocation_extra_size, size);
     }
@@ -750,13 +973,10 @@ public:
                 auto buffer_node =
                         static_cast<BufferNode*>(segment->get_address_from_offset(buffer_descriptor->buffer_node_offset));
 
-                int32_t buffer_size = buffer_node->header.data_size;
-
                 // Last reference to the buffer
                 if (buffer_node->header.ref_count.fetch_sub(1) == 1)
                 {
-                    // Anotate the new free space
-                    segment_node->free_bytes.fetch_add(buffer_size);
+                    release_buffer_node(*segment, segment_node, buffer_node);
                 }
             }
         }
@@ -25,6 +25,7 @@
 #include <fastdds/rtps/transport/TCPTransportInterface.h>
 #include <fastdds/rtps/transport/TCPv4TransportDescriptor.h>
 #include <fastdds/rtps/transport/TCPv6TransportDescriptor.h>
+#include <rtps/transport/tcp/TCPChecksum.hpp>
 
 
 #define IDSTRING "(ID:" << std::this_thread::get_id() <<") "<<
@@ -142,7 +143,7 @@ bool RTCPMessageManager::sendData(
     fastrtps::rtps::CDRMessage::initCDRMsg(&msg);
     const ResponseCode* code = (respCode != RETCODE_VOID) ? &respCode : nullptr;
 
-    fillHeaders(kind, transaction_id, ctrlHeader, header, payload, code);
+    fillHeaders(kind, transaction_id, ctrlHeader, header, channel->checksum_kind(), payload, code);
 
     RTPSMessageCreator::addCustomContent(&msg, (octet*)&header, TCPHeader::size());
     RTPSMessageCreator::addCustomContent(&msg, (octet*)&ctrlHeader, TCPControlMsgHeader::size());
@@ -181,6 +182,7 @@ void RTCPMessageManager::fillHeaders(
         const TCPTransactionId &transaction_id,
         TCPControlMsgHeader &retCtrlHeader,
         TCPHeader &header,
+        TCPChecksumKind checksum,
         const SerializedPayload_t *payload,
         const ResponseCode *respCode)
 {
@@ -220,35 +222,16 @@ void RTCPMessageManager::fillHeaders(
     uint32_t crc = 0;
     if (alive() && mTransport->configuration()->calculate_crc)
     {
-        octet* it = (octet*)&retCtrlHeader;
-        for (size_t i = 0; i < TCPControlMsgHeader::size(); ++i)
-        {
-            crc = addToCRC(crc, it[i]);
-        }
+        crc = TCPChecksum::compute(checksum, crc, (octet*)&retCtrlHeader, TCPControlMsgHeader::size());
         if (respCode != nullptr)
         {
-            it = (octet*)respCode;
-            for (int i = 0; i < 4; ++i)
-            {
-                crc = addToCRC(crc, it[i]);
-            }
+            crc = TCPChecksum::compute(checksum, crc, (octet*)respCode, 4);
         }
         if (payload != nullptr)
         {
-            octet* pay = (octet*)&(payload->encapsulation);
-            for (uint32_t i = 0; i < 2; ++i)
-            {
-                crc = addToCRC(crc, pay[i]);
-            }
-            pay = (octet*)&(payload->length);
-            for (uint32_t i = 0; i < 4; ++i)
-            {
-                crc = addToCRC(crc, pay[i]);
-            }
-            for (uint32_t i = 0; i < payload->length; ++i)
-            {
-                crc = addToCRC(crc, payload->data[i]);
-            }
+            crc = TCPChecksum::compute(checksum, crc, (octet*)&(payload->encapsulation), 2);
+            crc = TCPChecksum::compute(checksum, crc, (octet*)&(payload->length), 4);
+            crc = TCPChecksum::compute(checksum, crc, payload->data, payload->length);
         }
     }
     header.crc = crc;
@@ -317,6 +300,10 @@ TCPTransactionId RTCPMessageManager::sendConnectionRequest(
     }
     request.protocolVersion(c_rtcpProtocolVersion);
     request.transportLocator(locator);
+    request.checksumKind(config->use_crc32c ? TCP_CHECKSUM_CRC32C : TCP_CHECKSUM_SUM);
+
+    // A reconnection starts over with the checksum every peer understands
+    channel->checksum_kind(TCP_CHECKSUM_SUM);
 
     SerializedPayload_t payload(static_cast<uint32_t>(ConnectionRequest_t::getBufferCdrSerializedSize(request)));
     request.serialize(&payload);
@@ -451,6 +438,10 @@ ResponseCode RTCPMessageManager::processBindConnectionRequest(
 
     response.locator(localLocator);
 
+    // CRC-32C is used only when both ends enable it
+    bool use_crc32c = request.checksumKind() == TCP_CHECKSUM_CRC32C && mTransport->configuration()->use_crc32c;
+    response.checksumKind(use_crc32c ? TCP_CHECKSUM_CRC32C : TCP_CHECKSUM_SUM);
+
     SerializedPayload_t payload(static_cast<uint32_t>(BindConnectionResponse_t::getBufferCdrSerializedSize(response)));
     response.serialize(&payload);
 
@@ -475,6 +466,12 @@ ResponseCode RTCPMessageManager::processBindConnectionRequest(
 
     sendData(channel, BIND_CONNECTION_RESPONSE, transaction_id, &payload, code);
 
+    // The response is sent with the previous checksum. The requester switches when it receives it.
+    if (RETCODE_OK == code || RETCODE_EXISTING_CONNECTION == code)
+    {
+        channel->checksum_kind(response.checksumKind());
+    }
+
     return RETCODE_OK;
 }
 
@@ -729,6 +726,9 @@ ResponseCode RTCPMessageManager::processRTCPMessage(
 
         if (respCode == RETCODE_OK || respCode == RETCODE_EXISTING_CONNECTION)
         {
+            // Following messages, including the ones sent when the connection is established, use the agreed checksum
+            channel->checksum_kind(response.checksumKind());
+
             std::unique_lock<std::recursive_mutex> scopedLock(channel->pending_logical_mutex_);
             if (!channel->pending_logical_output_ports_.empty())
             {
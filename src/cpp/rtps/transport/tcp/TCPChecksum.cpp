@@ -0,0 +1,210 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TCPChecksum.cpp
+ */
+
+#include <rtps/transport/tcp/TCPChecksum.hpp>
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TCP_CHECKSUM_X86 1
+#include <emmintrin.h>
+#include <nmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif // if defined(_MSC_VER)
+#endif // x86
+
+// SSE2 is part of x86-64, but has to be enabled explicitly on 32-bit builds.
+#if defined(TCP_CHECKSUM_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define TCP_CHECKSUM_SSE2 1
+#endif
+
+// SSE4.2 is checked at runtime, so it is only used where the compiler can build a single function for it.
+#if defined(TCP_CHECKSUM_X86) && (defined(_MSC_VER) || defined(__GNUC__) || defined(__clang__))
+#define TCP_CHECKSUM_SSE42 1
+#if defined(_MSC_VER)
+#define TCP_CHECKSUM_TARGET_SSE42
+#else
+#define TCP_CHECKSUM_TARGET_SSE42 __attribute__((target("sse4.2")))
+#endif // if defined(_MSC_VER)
+#endif
+
+namespace eprosima {
+namespace fastdds {
+namespace rtps {
+
+using fastrtps::rtps::octet;
+
+//! Adding a carry back on every overflow is the same as reducing modulo 2^32 - 1, keeping 2^32 - 1 instead of 0.
+static inline uint32_t fold(
+        uint64_t total)
+{
+    return total == 0 ? 0u : static_cast<uint32_t>(((total - 1) % 0xFFFFFFFFull) + 1);
+}
+
+uint32_t TCPChecksum::sum(
+        uint32_t crc,
+        const octet* data,
+        size_t size)
+{
+    uint64_t total = crc;
+    size_t i = 0;
+
+#if defined(TCP_CHECKSUM_SSE2)
+    // Each psadbw adds 8 octets into a 64-bit lane, which would need more than 2^56 octets to overflow
+    __m128i zero = _mm_setzero_si128();
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[i]));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(block, zero));
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    total += lanes[0] + lanes[1];
+#else
+    // Independent accumulators let the compiler vectorize and pipeline the loop
+    uint64_t acc[4] = {0, 0, 0, 0};
+    for (; i + 4 <= size; i += 4)
+    {
+        acc[0] += data[i];
+        acc[1] += data[i + 1];
+        acc[2] += data[i + 2];
+        acc[3] += data[i + 3];
+    }
+    total += acc[0] + acc[1] + acc[2] + acc[3];
+#endif // if defined(TCP_CHECKSUM_SSE2)
+
+    for (; i < size; ++i)
+    {
+        total += data[i];
+    }
+
+    return fold(total);
+}
+
+static const uint32_t* crc32c_table()
+{
+    struct Table
+    {
+        uint32_t values[256];
+
+        Table()
+        {
+            for (uint32_t n = 0; n < 256; ++n)
+            {
+                uint32_t c = n;
+                for (int k = 0; k < 8; ++k)
+                {
+                    c = (c & 1) ? (0x82F63B78u ^ (c >> 1)) : (c >> 1);
+                }
+                values[n] = c;
+            }
+        }
+
+    };
+
+    static const Table table;
+    return table.values;
+}
+
+static uint32_t crc32c_software(
+        uint32_t crc,
+        const octet* data,
+        size_t size)
+{
+    const uint32_t* table = crc32c_table();
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#if defined(TCP_CHECKSUM_SSE42)
+TCP_CHECKSUM_TARGET_SSE42 static uint32_t crc32c_sse42(
+        uint32_t crc,
+        const octet* data,
+        size_t size)
+{
+    size_t i = 0;
+#if defined(__x86_64__) || defined(_M_X64)
+    uint64_t crc64 = crc;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t block;
+        memcpy(&block, &data[i], sizeof(block));
+        crc64 = _mm_crc32_u64(crc64, block);
+    }
+    crc = static_cast<uint32_t>(crc64);
+#endif // 64-bit
+    for (; i + 4 <= size; i += 4)
+    {
+        uint32_t block;
+        memcpy(&block, &data[i], sizeof(block));
+        crc = _mm_crc32_u32(crc, block);
+    }
+    for (; i < size; ++i)
+    {
+        crc = _mm_crc32_u8(crc, data[i]);
+    }
+    return crc;
+}
+
+static bool cpu_has_sse42()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2") != 0;
+#endif // if defined(_MSC_VER)
+}
+
+#endif // if defined(TCP_CHECKSUM_SSE42)
+
+bool TCPChecksum::crc32c_hardware()
+{
+#if defined(TCP_CHECKSUM_SSE42)
+    static const bool has_sse42 = cpu_has_sse42();
+    return has_sse42;
+#else
+    return false;
+#endif // if defined(TCP_CHECKSUM_SSE42)
+}
+
+uint32_t TCPChecksum::crc32c(
+        uint32_t crc,
+        const octet* data,
+        size_t size)
+{
+    crc = ~crc;
+#if defined(TCP_CHECKSUM_SSE42)
+    if (crc32c_hardware())
+    {
+        return ~crc32c_sse42(crc, data, size);
+    }
+#endif // if defined(TCP_CHECKSUM_SSE42)
+    return ~crc32c_software(crc, data, size);
+}
+
+} // namespace rtps
+} // namespace fastdds
+} // namespace eprosima
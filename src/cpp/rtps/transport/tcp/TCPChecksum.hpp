@@ -0,0 +1,97 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TCPChecksum.hpp
+ */
+
+#ifndef RTPS_TRANSPORT_TCP_TCPCHECKSUM_HPP
+#define RTPS_TRANSPORT_TCP_TCPCHECKSUM_HPP
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <fastdds/rtps/transport/tcp/RTCPHeader.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace eprosima {
+namespace fastdds {
+namespace rtps {
+
+/**
+ * Checksums stored on the crc field of TCPHeader.
+ *
+ * All the functions can be chained: the checksum of consecutive blocks is computed passing the result of each
+ * block as the initial value of the next one, starting with 0.
+ */
+class TCPChecksum
+{
+public:
+
+    /**
+     * Add octets to a checksum of kind TCP_CHECKSUM_SUM, the sum of all the octets where each carry out of the
+     * 32 bits is added back. Gives the same result as RTCPMessageManager::addToCRC called for each octet,
+     * processing 16 octets at a time with SSE2 when available.
+     * @param crc Checksum of the previous blocks.
+     * @param data Block to add.
+     * @param size Size of the block.
+     * @return Checksum including the block.
+     */
+    static uint32_t sum(
+            uint32_t crc,
+            const fastrtps::rtps::octet* data,
+            size_t size);
+
+    /**
+     * Add octets to a checksum of kind TCP_CHECKSUM_CRC32C (Castagnoli polynomial, as used by iSCSI and SCTP).
+     * Uses the SSE4.2 crc32 instruction when the processor has it.
+     * @param crc Checksum of the previous blocks.
+     * @param data Block to add.
+     * @param size Size of the block.
+     * @return Checksum including the block.
+     */
+    static uint32_t crc32c(
+            uint32_t crc,
+            const fastrtps::rtps::octet* data,
+            size_t size);
+
+    /**
+     * Add octets to a checksum of the given kind.
+     * @param kind Kind of checksum.
+     * @param crc Checksum of the previous blocks.
+     * @param data Block to add.
+     * @param size Size of the block.
+     * @return Checksum including the block.
+     */
+    static uint32_t compute(
+            TCPChecksumKind kind,
+            uint32_t crc,
+            const fastrtps::rtps::octet* data,
+            size_t size)
+    {
+        return kind == TCP_CHECKSUM_CRC32C ? crc32c(crc, data, size) : sum(crc, data, size);
+    }
+
+    /**
+     * @return Whether crc32c() runs on the crc32 instruction of the processor.
+     */
+    static bool crc32c_hardware();
+};
+
+} // namespace rtps
+} // namespace fastdds
+} // namespace eprosima
+
+#endif
+#endif  // RTPS_TRANSPORT_TCP_TCPCHECKSUM_HPP
@@ -102,7 +102,9 @@ static void operator>>(eprosima::fastcdr::Cdr &scdr, ResponseCode &code)
     code = static_cast<ResponseCode>(aux);
 }
 
-ConnectionRequest_t::ConnectionRequest_t() : m_vendorId(fastrtps::rtps::c_VendorId_eProsima)
+ConnectionRequest_t::ConnectionRequest_t()
+    : m_vendorId(fastrtps::rtps::c_VendorId_eProsima)
+    , m_checksumKind(TCP_CHECKSUM_SUM)
 {
 }
 
@@ -110,13 +112,17 @@ ConnectionRequest_t::~ConnectionRequest_t()
 {
 }
 
-ConnectionRequest_t::ConnectionRequest_t(const ConnectionRequest_t &x) : m_vendorId(x.m_vendorId)
+ConnectionRequest_t::ConnectionRequest_t(const ConnectionRequest_t &x)
+    : m_vendorId(x.m_vendorId)
+    , m_checksumKind(x.m_checksumKind)
 {
     m_protocolVersion = x.m_protocolVersion;
     m_transportLocator = x.m_transportLocator;
 }
 
-ConnectionRequest_t::ConnectionRequest_t(ConnectionRequest_t &&x) : m_vendorId(x.m_vendorId)
+ConnectionRequest_t::ConnectionRequest_t(ConnectionRequest_t &&x)
+    : m_vendorId(x.m_vendorId)
+    , m_checksumKind(x.m_checksumKind)
 {
     m_protocolVersion = x.m_protocolVersion;
     m_transportLocator = x.m_transportLocator;
@@ -127,6 +133,7 @@ ConnectionRequest_t& ConnectionRequest_t::operator=(const ConnectionRequest_t &x
     m_protocolVersion = x.m_protocolVersion;
     m_vendorId = x.m_vendorId;
     m_transportLocator = x.m_transportLocator;
+    m_checksumKind = x.m_checksumKind;
 
     return *this;
 }
@@ -136,6 +143,7 @@ ConnectionRequest_t& ConnectionRequest_t::operator=(ConnectionRequest_t &&x)
     m_protocolVersion = x.m_protocolVersion;
     m_vendorId = x.m_vendorId;
     m_transportLocator = x.m_transportLocator;
+    m_checksumKind = x.m_checksumKind;
 
     return *this;
 }
@@ -155,6 +163,8 @@ size_t ConnectionRequest_t::getCdrSerializedSize(const ConnectionRequest_t& /*da
 
     current_alignment += 24 + eprosima::fastcdr::Cdr::alignment(current_alignment, 24);
 
+    current_alignment += 1 + eprosima::fastcdr::Cdr::alignment(current_alignment, 1);
+
 
     return current_alignment - initial_alignment;
 }
@@ -207,6 +217,7 @@ bool ConnectionRequest_t::serialize(SerializedPayload_t *payload)
     try
     {
         p_type->serialize(ser); // Serialize the object:
+        ser << static_cast<fastrtps::rtps::octet>(m_checksumKind);
     }
     catch(eprosima::fastcdr::exception::NotEnoughMemoryException& /*exception*/)
     {
@@ -230,6 +241,15 @@ bool ConnectionRequest_t::deserialize(SerializedPayload_t* payload)
     try
     {
         p_type->deserialize(deser); //Deserialize the object:
+
+        // Peers with the first version of the protocol do not send the checksum kind
+        m_checksumKind = TCP_CHECKSUM_SUM;
+        if (deser.getSerializedDataLength() < payload->length)
+        {
+            fastrtps::rtps::octet checksum_kind = 0;
+            deser >> checksum_kind;
+            m_checksumKind = checksum_kind == TCP_CHECKSUM_CRC32C ? TCP_CHECKSUM_CRC32C : TCP_CHECKSUM_SUM;
+        }
     }
     catch(eprosima::fastcdr::exception::NotEnoughMemoryException& /*exception*/)
     {
@@ -1347,6 +1367,7 @@ void ControlProtocolRequestData::serializeKey(eprosima::fastcdr::Cdr &/*scdr*/)
 }
 
 BindConnectionResponse_t::BindConnectionResponse_t()
+    : m_checksumKind(TCP_CHECKSUM_SUM)
 {
     m_locator = 0;
 }
@@ -1356,11 +1377,13 @@ BindConnectionResponse_t::~BindConnectionResponse_t()
 }
 
 BindConnectionResponse_t::BindConnectionResponse_t(const BindConnectionResponse_t &x)
+    : m_checksumKind(x.m_checksumKind)
 {
     m_locator = x.m_locator;
 }
 
 BindConnectionResponse_t::BindConnectionResponse_t(BindConnectionResponse_t &&x)
+    : m_checksumKind(x.m_checksumKind)
 {
     m_locator = x.m_locator;
 }
@@ -1368,6 +1391,7 @@ BindConnectionResponse_t::BindConnectionResponse_t(BindConnectionResponse_t &&x)
 BindConnectionResponse_t& BindConnectionResponse_t::operator=(const BindConnectionResponse_t &x)
 {
     m_locator = x.m_locator;
+    m_checksumKind = x.m_checksumKind;
 
     return *this;
 }
@@ -1375,6 +1399,7 @@ BindConnectionResponse_t& BindConnectionResponse_t::operator=(const BindConnecti
 BindConnectionResponse_t& BindConnectionResponse_t::operator=(BindConnectionResponse_t &&x)
 {
     m_locator = x.m_locator;
+    m_checksumKind = x.m_checksumKind;
 
     return *this;
 }
@@ -1390,6 +1415,8 @@ size_t BindConnectionResponse_t::getCdrSerializedSize(const BindConnectionRespon
 
     current_alignment += 24 + eprosima::fastcdr::Cdr::alignment(current_alignment, 24);
 
+    current_alignment += 1 + eprosima::fastcdr::Cdr::alignment(current_alignment, 1);
+
 
     return current_alignment - initial_alignment;
 }
@@ -1435,6 +1462,7 @@ bool BindConnectionResponse_t::serialize(SerializedPayload_t *payload)
     try
     {
         p_type->serialize(ser); // Serialize the object:
+        ser << static_cast<fastrtps::rtps::octet>(m_checksumKind);
     }
     catch(eprosima::fastcdr::exception::NotEnoughMemoryException& /*exception*/)
     {
@@ -1458,6 +1486,15 @@ bool BindConnectionResponse_t::deserialize(SerializedPayload_t* payload)
     try
     {
         p_type->deserialize(deser); //Deserialize the object:
+
+        // Peers with the first version of the protocol do not send the checksum kind
+        m_checksumKind = TCP_CHECKSUM_SUM;
+        if (deser.getSerializedDataLength() < payload->length)
+        {
+            fastrtps::rtps::octet checksum_kind = 0;
+            deser >> checksum_kind;
+            m_checksumKind = checksum_kind == TCP_CHECKSUM_CRC32C ? TCP_CHECKSUM_CRC32C : TCP_CHECKSUM_SUM;
+        }
     }
     catch(eprosima::fastcdr::exception::NotEnoughMemoryException& /*exception*/)
     {
@@ -43,6 +43,8 @@ test_UDPv4Transport::test_UDPv4Transport(const test_UDPv4TransportDescriptor& de
     drop_heartbeat_messages_percentage_(descriptor.dropHeartbeatMessagesPercentage),
     drop_ack_nack_messages_percentage_(descriptor.dropAckNackMessagesPercentage),
     sequence_number_data_messages_to_drop_(descriptor.sequenceNumberDataMessagesToDrop),
+    drop_data_messages_filter_(descriptor.dropDataMessagesFilter),
+    sent_messages_observer_(descriptor.sentMessagesObserver),
     percentage_of_messages_to_drop_(descriptor.percentageOfMessagesToDrop)
     {
         test_UDPv4Transport_DropLogLength = 0;
@@ -68,6 +70,8 @@ test_UDPv4TransportDescriptor::test_UDPv4TransportDescriptor():
     dropAckNackMessagesPercentage(0),
     percentageOfMessagesToDrop(0),
     sequenceNumberDataMessagesToDrop(),
+    dropDataMessagesFilter(),
+    sentMessagesObserver(),
     dropLogLength(0)
     {
     }
@@ -123,7 +127,12 @@ bool test_UDPv4Transport::send(
         bool only_multicast_purpose,
         const std::chrono::microseconds& timeout)
 {
-    if (packet_should_drop(send_buffer, send_buffer_size))
+    if (sent_messages_observer_)
+    {
+        sent_messages_observer_(remote_locator, send_buffer, send_buffer_size);
+    }
+
+    if (packet_should_drop(send_buffer, send_buffer_size, remote_locator))
     {
         log_drop(send_buffer, send_buffer_size);
         return true;
@@ -164,7 +173,10 @@ static bool ReadSubmessageHeader(CDRMessage_t& msg, SubmessageHeader_t& smh)
     return true;
 }
 
-bool test_UDPv4Transport::packet_should_drop(const octet* send_buffer, uint32_t send_buffer_size)
+bool test_UDPv4Transport::packet_should_drop(
+        const octet* send_buffer,
+        uint32_t send_buffer_size,
+        const Locator_t& destination)
 {
     if(test_UDPv4Transport_ShutdownAllNetwork)
     {
@@ -227,6 +239,14 @@ bool test_UDPv4Transport::packet_should_drop(const octet* send_buffer, uint32_t
                 if(should_be_dropped(&drop_data_messages_percentage_))
                     return true;
 
+                if(drop_data_messages_filter_)
+                {
+                    bool drop = drop_data_messages_filter_(destination, cdrMessage);
+                    cdrMessage.pos = old_pos;
+                    if(drop)
+                        return true;
+                }
+
                 break;
 
             case fastrtps::rtps::ACKNACK:
@@ -32,7 +32,7 @@ LivelinessManager::LivelinessManager(
 
 LivelinessManager::~LivelinessManager()
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<LivelinessMutex> lock(mutex_);
     timer_owner_ = nullptr;
     timer_.cancel_timer();
 }
@@ -42,7 +42,7 @@ bool LivelinessManager::add_writer(
         LivelinessQosPolicyKind kind,
         Duration_t lease_duration)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<LivelinessMutex> lock(mutex_);
 
     if (!manage_automatic_ && kind == LivelinessQosPolicyKind::AUTOMATIC_LIVELINESS_QOS)
     {
@@ -69,7 +69,7 @@ bool LivelinessManager::remove_writer(
         LivelinessQosPolicyKind kind,
         Duration_t lease_duration)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<LivelinessMutex> lock(mutex_);
 
     for (LivelinessData& writer: writers_)
     {
@@ -104,6 +104,7 @@ bool LivelinessManager::remove_writer(
                 if (timer_owner_ != nullptr && timer_owner_->guid == guid)
                 {
                     timer_owner_ = nullptr;
+                    update_times();
                     if (!calculate_next())
                     {
                         timer_.cancel_timer();
@@ -129,7 +130,15 @@ bool LivelinessManager::assert_liveliness(
         LivelinessQosPolicyKind kind,
         Duration_t lease_duration)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    {
+        SharedLock lock(mutex_);
+        if (assert_alive_writers(guid, kind, lease_duration))
+        {
+            return true;
+        }
+    }
+
+    std::unique_lock<LivelinessMutex> lock(mutex_);
 
     ResourceLimitedVector<LivelinessData>::iterator wit;
     if (!find_writer(
@@ -142,6 +151,7 @@ bool LivelinessManager::assert_liveliness(
     }
 
     timer_.cancel_timer();
+    update_times();
 
     if (wit->kind == LivelinessQosPolicyKind::MANUAL_BY_PARTICIPANT_LIVELINESS_QOS ||
             wit->kind == LivelinessQosPolicyKind::AUTOMATIC_LIVELINESS_QOS)
@@ -178,7 +188,7 @@ bool LivelinessManager::assert_liveliness(
 bool LivelinessManager::assert_liveliness(
         LivelinessQosPolicyKind kind)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<LivelinessMutex> lock(mutex_);
 
     if (!manage_automatic_ && kind == LivelinessQosPolicyKind::AUTOMATIC_LIVELINESS_QOS)
     {
@@ -192,6 +202,7 @@ bool LivelinessManager::assert_liveliness(
     }
 
     timer_.cancel_timer();
+    update_times();
 
     for (LivelinessData& writer: writers_)
     {
@@ -245,7 +256,7 @@ bool LivelinessManager::calculate_next()
 
 bool LivelinessManager::timer_expired()
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<LivelinessMutex> lock(mutex_);
 
     if (timer_owner_ == nullptr)
     {
@@ -253,22 +264,28 @@ bool LivelinessManager::timer_expired()
         return false;
     }
 
-    if (callback_ != nullptr)
+    // The timer owner may have been asserted since the timer was started
+    update_times();
+    if (timer_owner_->time <= steady_clock::now())
     {
-        callback_(timer_owner_->guid,
-                timer_owner_->kind,
-                timer_owner_->lease_duration,
-                -1,
-                1);
+        if (callback_ != nullptr)
+        {
+            callback_(timer_owner_->guid,
+                    timer_owner_->kind,
+                    timer_owner_->lease_duration,
+                    -1,
+                    1);
+        }
+        timer_owner_->status = LivelinessData::WriterStatus::NOT_ALIVE;
     }
-    timer_owner_->status = LivelinessData::WriterStatus::NOT_ALIVE;
 
     if (calculate_next())
     {
         // Some times the interval could be negative if a writer expired during the call to this function
-        // Once in this situation there is not much we can do but let asio timers expire inmediately
+        // Once in this situation there is not much we can do but let asio timers expire inmediately.
+        // Fractions of millisecond are kept, as a timer expiring before the owner is due would be started again.
         auto interval = timer_owner_->time - steady_clock::now();
-        timer_.update_interval_millisec((double)duration_cast<milliseconds>(interval).count());
+        timer_.update_interval_millisec(duration_cast<duration<double, std::milli>>(interval).count());
         return true;
     }
 
@@ -297,7 +314,7 @@ bool LivelinessManager::find_writer(
 bool LivelinessManager::is_any_alive(
         LivelinessQosPolicyKind kind)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<LivelinessMutex> lock(mutex_);
 
     for (const auto& writer : writers_)
     {
@@ -336,6 +353,61 @@ void LivelinessManager::assert_writer_liveliness(
     writer.time = steady_clock::now() + nanoseconds(writer.lease_duration.to_ns());
 }
 
+bool LivelinessManager::assert_alive_writers(
+        const GUID_t& guid,
+        const LivelinessQosPolicyKind& kind,
+        const Duration_t& lease_duration)
+{
+    ResourceLimitedVector<LivelinessData>::iterator wit;
+    if (!find_writer(guid, kind, lease_duration, &wit))
+    {
+        return false;
+    }
+
+    int64_t now = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+
+    if (kind == LivelinessQosPolicyKind::MANUAL_BY_TOPIC_LIVELINESS_QOS)
+    {
+        if (wit->status != LivelinessData::WriterStatus::ALIVE)
+        {
+            return false;
+        }
+        wit->asserted_time.store(now + wit->lease_duration.to_ns(), std::memory_order_relaxed);
+        return true;
+    }
+
+    // All the writers of the kind are asserted together, so all of them should be alive
+    for (const LivelinessData& writer : writers_)
+    {
+        if (writer.kind == kind && writer.status != LivelinessData::WriterStatus::ALIVE)
+        {
+            return false;
+        }
+    }
+
+    for (LivelinessData& writer : writers_)
+    {
+        if (writer.kind == kind)
+        {
+            writer.asserted_time.store(now + writer.lease_duration.to_ns(), std::memory_order_relaxed);
+        }
+    }
+    return true;
+}
+
+void LivelinessManager::update_times()
+{
+    for (LivelinessData& writer : writers_)
+    {
+        steady_clock::time_point asserted_time(
+            duration_cast<steady_clock::duration>(nanoseconds(writer.asserted_time.load(std::memory_order_relaxed))));
+        if (writer.status == LivelinessData::WriterStatus::ALIVE && asserted_time > writer.time)
+        {
+            writer.time = asserted_time;
+        }
+    }
+}
+
 const ResourceLimitedVector<LivelinessData>& LivelinessManager::get_liveliness_data() const
 {
     return writers_;
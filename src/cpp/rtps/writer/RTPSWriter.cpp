@@ -22,6 +22,7 @@
 #include <fastdds/rtps/messages/RTPSMessageCreator.h>
 #include <fastdds/dds/log/Log.hpp>
 #include <rtps/participant/RTPSParticipantImpl.h>
+#include <rtps/messages/ControlMessageAggregator.hpp>
 #include <rtps/flowcontrol/FlowController.h>
 
 #include <mutex>
@@ -56,6 +57,7 @@ RTPSWriter::RTPSWriter(
 {
     mp_history->mp_writer = this;
     mp_history->mp_mutex = &mp_mutex;
+    RTPSMessageCreator::initDataSubmessageTemplate(&data_template_, guid.entityId);
     logInfo(RTPS_WRITER, "RTPSWriter created");
 }
 
@@ -144,6 +146,14 @@ bool RTPSWriter::remove_older_changes(
     return at_least_one;
 }
 
+void RTPSWriter::send_change_without_history(
+        CacheChange_t* change,
+        const std::chrono::time_point<std::chrono::steady_clock>& /*max_blocking_time*/)
+{
+    logError(RTPS_WRITER, "Writer " << getGuid() << " cannot send change " << change->sequenceNumber <<
+            " without history");
+}
+
 CONSTEXPR uint32_t info_dst_message_length = 16;
 CONSTEXPR uint32_t info_ts_message_length = 12;
 CONSTEXPR uint32_t data_frag_submessage_header_length = 36;
@@ -290,6 +300,13 @@ bool RTPSWriter::send(
     return participant->sendSync(message, locator_selector_.begin(), locator_selector_.end(), max_blocking_time_point);
 }
 
+bool RTPSWriter::queue_control_message(
+        CDRMessage_t* message,
+        ControlMessageAggregator& aggregator) const
+{
+    return aggregator.add(*message, locator_selector_.begin(), locator_selector_.end());
+}
+
 const LivelinessQosPolicyKind& RTPSWriter::get_liveliness_kind() const
 {
     return liveliness_kind_;
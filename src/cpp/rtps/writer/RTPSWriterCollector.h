@@ -23,13 +23,23 @@
 #include <fastdds/rtps/common/FragmentNumber.h>
 #include <fastdds/rtps/common/CacheChange.h>
 
+#include <algorithm>
 #include <vector>
 #include <cassert>
+#include <cstdint>
 
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+/**
+ * Collects the changes (or fragments) to be sent by a flow-controlled writer, in order.
+ *
+ * Items are kept on a flat array sorted by sequence number and fragment number, and the remote readers
+ * of each item are kept on a bitmap over the list of readers added to the collector.
+ * All the storage is kept between calls to reset(), so once the collector has reached the size required
+ * by the writer, collecting changes does not perform any allocation.
+ */
 template<class T>
 class RTPSWriterCollector
 {
@@ -38,9 +48,10 @@ class RTPSWriterCollector
         struct Item
         {
             Item(SequenceNumber_t seqNum, FragmentNumber_t fragNum,
-                    CacheChange_t* c) : sequenceNumber(seqNum),
-                                        fragmentNumber(fragNum),
-                                        cacheChange(c)
+                    CacheChange_t* c, size_t readersPos) : sequenceNumber(seqNum),
+                                                           fragmentNumber(fragNum),
+                                                           cacheChange(c),
+                                                           readersPosition(readersPos)
 
             {
                 assert(seqNum == c->sequenceNumber);
@@ -55,74 +66,219 @@ class RTPSWriterCollector
 
             CacheChange_t* cacheChange;
 
-            mutable std::vector<T> remoteReaders;
+            //! Position of the bitmap with the remote readers of this item.
+            size_t readersPosition;
         };
 
-        struct ItemCmp
-        {
-            bool operator()(const Item& a, const Item& b) const
-            {
-                if(a.sequenceNumber < b.sequenceNumber)
-                    return true;
-                else if(a.sequenceNumber == b.sequenceNumber)
-                    if(a.fragmentNumber < b.fragmentNumber)
-                        return true;
+        typedef std::vector<Item> ItemVector;
+        typedef typename ItemVector::iterator iterator;
 
-                return false;
-            }
-        };
+        /*!
+         * Reserve storage for the collector.
+         * @param max_items Number of items (changes or fragments) to reserve space for.
+         * @param max_readers Number of remote readers to reserve space for.
+         */
+        void reserve(size_t max_items, size_t max_readers)
+        {
+            size_t words = words_for(max_readers);
+            items_.reserve(max_items);
+            readers_.reserve(max_readers);
+            bitmaps_.reserve(max_items * words);
+        }
 
-        typedef std::set<Item, ItemCmp> ItemSet;
+        /*!
+         * Empty the collector, keeping its storage, to start a new collection.
+         * @param max_readers Expected number of different remote readers on the new collection.
+         */
+        void reset(size_t max_readers)
+        {
+            clear();
+            words_per_item_ = words_for(max_readers);
+        }
 
-        void add_change(CacheChange_t* change, const T& remoteReader, const FragmentNumberSet_t optionalFragmentsNotSent)
+        void add_change(CacheChange_t* change, const T& remoteReader, const FragmentNumberSet_t& optionalFragmentsNotSent)
         {
+            size_t reader_index = reader_index_of(remoteReader);
+
             if(change->getFragmentSize() > 0)
             {
-                optionalFragmentsNotSent.for_each([this, change, remoteReader](FragmentNumber_t sn)
+                optionalFragmentsNotSent.for_each([this, change, reader_index](FragmentNumber_t sn)
                 {
                     assert(sn <= change->getFragmentCount());
-                    auto it = mItems_.emplace(change->sequenceNumber, sn, change);
-                    it.first->remoteReaders.push_back(remoteReader);
+                    add_item(change, sn, reader_index);
                 });
             }
             else
             {
-                auto it = mItems_.emplace(change->sequenceNumber, 0, change);
-                it.first->remoteReaders.push_back(remoteReader);
+                add_item(change, 0, reader_index);
             }
         }
 
-        bool empty()
+        bool empty() const
         {
-            return mItems_.empty();
+            return head_ == items_.size();
         }
 
-        size_t size()
+        size_t size() const
         {
-            return mItems_.size();
+            return items_.size() - head_;
         }
 
+        /*!
+         * Remove the first item of the collector.
+         * The remote readers of the returned item can be traversed until the collector is reset.
+         * @return The removed item.
+         */
         Item pop()
         {
-            auto it = mItems_.begin();
-            Item ret = *it;
-            mItems_.erase(it);
-            return ret;
+            assert(!empty());
+            return items_[head_++];
         }
 
         void clear()
         {
-            return mItems_.clear();
+            items_.clear();
+            readers_.clear();
+            bitmaps_.clear();
+            head_ = 0;
+            last_reader_index_ = 0;
+        }
+
+        //! @return Iterator to the first item pending to be popped.
+        iterator begin()
+        {
+            return items_.begin() + head_;
         }
 
-        ItemSet& items()
+        iterator end()
         {
-            return mItems_;
+            return items_.end();
+        }
+
+        /*!
+         * Remove the items on the range [first, end()).
+         * @param first Iterator to the first item to remove.
+         */
+        void erase_from(iterator first)
+        {
+            items_.erase(first, items_.end());
+        }
+
+        /*!
+         * Call a functor for each remote reader of an item.
+         * @param item Item whose readers will be traversed.
+         * @param f Functor receiving a remote reader.
+         */
+        template<class Functor>
+        void for_each_reader(const Item& item, Functor f) const
+        {
+            const uint64_t* bitmap = &bitmaps_[item.readersPosition];
+            for (size_t word = 0; word < words_per_item_; ++word)
+            {
+                uint64_t bits = bitmap[word];
+                size_t index = word * 64u;
+                while (bits != 0)
+                {
+                    if (bits & 1u)
+                    {
+                        f(readers_[index]);
+                    }
+                    bits >>= 1u;
+                    ++index;
+                }
+            }
         }
 
     private:
 
-        ItemSet mItems_;
+        static size_t words_for(size_t num_readers)
+        {
+            return num_readers == 0 ? 1u : (num_readers + 63u) / 64u;
+        }
+
+        size_t reader_index_of(const T& remoteReader)
+        {
+            // Changes are usually collected reader by reader, so check the last one first
+            if (last_reader_index_ < readers_.size() && readers_[last_reader_index_] == remoteReader)
+            {
+                return last_reader_index_;
+            }
+
+            auto it = std::find(readers_.begin(), readers_.end(), remoteReader);
+            last_reader_index_ = static_cast<size_t>(std::distance(readers_.begin(), it));
+            if (it == readers_.end())
+            {
+                readers_.push_back(remoteReader);
+                if (readers_.size() > words_per_item_ * 64u)
+                {
+                    grow_bitmaps();
+                }
+            }
+
+            return last_reader_index_;
+        }
+
+        void add_item(CacheChange_t* change, FragmentNumber_t fragment, size_t reader_index)
+        {
+            const SequenceNumber_t& seq = change->sequenceNumber;
+            auto less = [](const Item& item, const std::pair<SequenceNumber_t, FragmentNumber_t>& key)
+                    {
+                        return (item.sequenceNumber < key.first) ||
+                               (item.sequenceNumber == key.first && item.fragmentNumber < key.second);
+                    };
+
+            iterator it = end();
+            if (!empty())
+            {
+                const Item& last = items_.back();
+                // Items are usually added in order, so avoid the search when possible
+                if (less(last, { seq, fragment }))
+                {
+                    it = end();
+                }
+                else
+                {
+                    it = std::lower_bound(begin(), end(), std::make_pair(seq, fragment), less);
+                }
+            }
+
+            if (it == end() || it->sequenceNumber != seq || it->fragmentNumber != fragment)
+            {
+                size_t position = bitmaps_.size();
+                bitmaps_.resize(position + words_per_item_, 0u);
+                it = items_.emplace(it, seq, fragment, change, position);
+            }
+
+            bitmaps_[it->readersPosition + (reader_index / 64u)] |= (uint64_t(1u) << (reader_index % 64u));
+        }
+
+        void grow_bitmaps()
+        {
+            size_t new_words = words_for(readers_.size());
+            std::vector<uint64_t> new_bitmaps(items_.size() * new_words, 0u);
+            for (size_t n = 0; n < items_.size(); ++n)
+            {
+                Item& item = items_[n];
+                size_t new_position = n * new_words;
+                std::copy_n(&bitmaps_[item.readersPosition], words_per_item_, &new_bitmaps[new_position]);
+                item.readersPosition = new_position;
+            }
+            bitmaps_.swap(new_bitmaps);
+            words_per_item_ = new_words;
+        }
+
+        //! Items sorted by sequence number and fragment number.
+        ItemVector items_;
+        //! Index of the first item not popped.
+        size_t head_ = 0;
+        //! Remote readers added to the collector.
+        std::vector<T> readers_;
+        //! Index on readers_ of the last remote reader added.
+        size_t last_reader_index_ = 0;
+        //! Bitmaps with the remote readers of each item.
+        std::vector<uint64_t> bitmaps_;
+        //! Number of 64-bit words on the bitmap of each item.
+        size_t words_per_item_ = 1;
 };
 
 } // namespace rtps
@@ -24,6 +24,7 @@
 #include <fastdds/rtps/common/LocatorListComparisons.hpp>
 
 #include <rtps/participant/RTPSParticipantImpl.h>
+#include <rtps/messages/ControlMessageAggregator.hpp>
 #include "rtps/RTPSDomainImpl.hpp"
 
 namespace eprosima {
@@ -143,6 +144,27 @@ bool ReaderLocator::send(
     return true;
 }
 
+bool ReaderLocator::queue_control_message(
+        CDRMessage_t* message,
+        ControlMessageAggregator& aggregator) const
+{
+    if (locator_info_.remote_guid != c_Guid_Unknown)
+    {
+        if (locator_info_.unicast.size() > 0)
+        {
+            return aggregator.add(*message, Locators(locator_info_.unicast.begin()),
+                           Locators(locator_info_.unicast.end()));
+        }
+        else
+        {
+            return aggregator.add(*message, Locators(locator_info_.multicast.begin()),
+                           Locators(locator_info_.multicast.end()));
+        }
+    }
+
+    return true;
+}
+
 RTPSReader* ReaderLocator::local_reader()
 {
     if (!local_reader_)
@@ -37,6 +37,16 @@ namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+static ResourceLimitedContainerConfig instance_limits_from_history(
+        const HistoryAttributes& history_attributes)
+{
+    // Only readers with a TIME_BASED_FILTER keep instances, so nothing is reserved beforehand
+    ResourceLimitedContainerConfig config = resource_limits_from_history(history_attributes);
+    config.initial = 0;
+    config.increment = 1u;
+    return config;
+}
+
 ReaderProxy::ReaderProxy(
         const WriterTimes& times,
         const RemoteLocatorsAllocationAttributes& loc_alloc,
@@ -47,6 +57,8 @@ ReaderProxy::ReaderProxy(
     , expects_inline_qos_(false)
     , is_reliable_(false)
     , disable_positive_acks_(false)
+    , minimum_separation_ns_(0)
+    , last_relevant_timestamps_(instance_limits_from_history(writer->mp_history->m_att))
     , writer_(writer)
     , changes_for_reader_(resource_limits_from_history(writer->mp_history->m_att, 0))
     , nack_supression_event_(nullptr)
@@ -102,6 +114,7 @@ void ReaderProxy::start(
     expects_inline_qos_ = reader_attributes.m_expectsInlineQos;
     is_reliable_ = reader_attributes.m_qos.m_reliability.kind != BEST_EFFORT_RELIABILITY_QOS;
     disable_positive_acks_ = reader_attributes.disable_positive_acks();
+    minimum_separation_ns_ = reader_attributes.m_qos.m_timeBasedFilter.minimum_separation.to_ns();
     acked_changes_set(SequenceNumber_t());  // Simulate initial acknack to set low mark
 
     timers_enabled_.store(is_remote_and_reliable());
@@ -120,6 +133,7 @@ bool ReaderProxy::update(
     expects_inline_qos_ = reader_attributes.m_expectsInlineQos;
     is_reliable_ = reader_attributes.m_qos.m_reliability.kind != BEST_EFFORT_RELIABILITY_QOS;
     disable_positive_acks_ = reader_attributes.disable_positive_acks();
+    minimum_separation_ns_ = reader_attributes.m_qos.m_timeBasedFilter.minimum_separation.to_ns();
 
     locator_info_.update(
         reader_attributes.remote_locators().unicast,
@@ -136,6 +150,7 @@ void ReaderProxy::stop()
     disable_timers();
 
     changes_for_reader_.clear();
+    last_relevant_timestamps_.clear();
     last_acknack_count_ = 0;
     last_nackfrag_count_ = 0;
     changes_low_mark_ = SequenceNumber_t();
@@ -215,6 +230,58 @@ void ReaderProxy::add_change(
     }
 }
 
+bool ReaderProxy::rtps_is_relevant(
+        CacheChange_t* change)
+{
+    if (minimum_separation_ns_ <= 0)
+    {
+        return true;
+    }
+
+    auto it = std::find_if(last_relevant_timestamps_.begin(), last_relevant_timestamps_.end(),
+                    [change](const std::pair<InstanceHandle_t, int64_t>& entry)
+                    {
+                        return entry.first == change->instanceHandle;
+                    });
+
+    // Only samples with data are filtered, so the reader is always notified of the state of the instances
+    if (change->kind != ALIVE)
+    {
+        if (it != last_relevant_timestamps_.end() &&
+                (change->kind == NOT_ALIVE_UNREGISTERED || change->kind == NOT_ALIVE_DISPOSED_UNREGISTERED))
+        {
+            last_relevant_timestamps_.erase(it);
+        }
+        return true;
+    }
+
+    int64_t timestamp = change->sourceTimestamp.to_ns();
+    if (it == last_relevant_timestamps_.end())
+    {
+        if (nullptr == last_relevant_timestamps_.emplace_back(change->instanceHandle, timestamp))
+        {
+            // More instances than the history can keep. The one relevant longest ago is forgotten,
+            // which at most lets one of its samples through before the minimum separation.
+            it = std::min_element(last_relevant_timestamps_.begin(), last_relevant_timestamps_.end(),
+                            [](const std::pair<InstanceHandle_t, int64_t>& e1,
+                            const std::pair<InstanceHandle_t, int64_t>& e2)
+                            {
+                                return e1.second < e2.second;
+                            });
+            *it = std::make_pair(change->instanceHandle, timestamp);
+        }
+        return true;
+    }
+
+    if (timestamp - it->second < minimum_separation_ns_)
+    {
+        return false;
+    }
+
+    it->second = timestamp;
+    return true;
+}
+
 bool ReaderProxy::has_changes() const
 {
     return !changes_for_reader_.empty();
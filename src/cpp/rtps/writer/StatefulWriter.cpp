@@ -33,6 +33,7 @@
 #include <fastdds/rtps/resources/TimedEvent.h>
 
 #include <fastdds/rtps/history/WriterHistory.h>
+#include <fastdds/rtps/attributes/PropertyPolicy.h>
 
 #include <fastdds/dds/log/Log.hpp>
 #include <fastrtps/utils/TimeConversion.h>
@@ -41,9 +42,11 @@
 #include <fastdds/rtps/builtin/liveliness/WLP.h>
 
 #include <rtps/writer/RTPSWriterCollector.h>
+#include <rtps/history/HistoryAttributesExtension.hpp>
 #include "rtps/RTPSDomainImpl.hpp"
 #include "../messages/RTPSGapBuilder.hpp"
 
+#include <cstdlib>
 #include <mutex>
 #include <vector>
 #include <stdexcept>
@@ -111,10 +114,13 @@ StatefulWriter::StatefulWriter(
     , periodic_hb_event_(nullptr)
     , nack_response_event_(nullptr)
     , ack_event_(nullptr)
+    , historical_replay_event_(nullptr)
+    , historical_replay_batch_(0)
     , m_heartbeatCount(0)
     , m_times(att.times)
     , matched_readers_(att.matched_readers_allocation)
     , matched_readers_pool_(att.matched_readers_allocation)
+    , matched_readers_index_(att.matched_readers_allocation)
     , next_all_acked_notify_sequence_(0, 1)
     , all_acked_(false)
     , may_remove_change_cond_()
@@ -127,6 +133,7 @@ StatefulWriter::StatefulWriter(
     , sendBufferSize_(pimpl->get_min_network_send_buffer_size())
     , currentUsageSendBufferSize_(static_cast<int32_t>(pimpl->get_min_network_send_buffer_size()))
     , m_controllers()
+    , flow_controlled_changes_(new RTPSWriterCollector<ReaderProxy*>())
 {
     m_heartbeatCount = 0;
 
@@ -154,10 +161,37 @@ StatefulWriter::StatefulWriter(
                 att.keep_duration.to_ns() * 1e-6); // in milliseconds
     }
 
+    // Historical changes can be replayed to late-joining readers without waiting for them to be requested
+    const std::string* replay_batch = PropertyPolicyHelper::find_property(att.endpoint.properties,
+                    "fastdds.historical_replay.samples_per_period");
+    if (replay_batch != nullptr)
+    {
+        historical_replay_batch_ = static_cast<uint32_t>(std::strtoul(replay_batch->c_str(), nullptr, 10));
+    }
+    if (historical_replay_batch_ > 0 && att.endpoint.durabilityKind >= TRANSIENT_LOCAL)
+    {
+        double replay_period_ms = 10.0;
+        const std::string* replay_period = PropertyPolicyHelper::find_property(att.endpoint.properties,
+                        "fastdds.historical_replay.period_ms");
+        if (replay_period != nullptr)
+        {
+            replay_period_ms = std::strtod(replay_period->c_str(), nullptr);
+        }
+
+        historical_replay_event_ = new TimedEvent(pimpl->getEventResource(), [&]() -> bool
+                {
+                    return replay_historical_changes();
+                },
+                replay_period_ms);
+    }
+
     for (size_t n = 0; n < att.matched_readers_allocation.initial; ++n)
     {
         matched_readers_pool_.push_back(new ReaderProxy(m_times, part_att.allocation.locators, this));
     }
+
+    flow_controlled_changes_->reserve(resource_limits_from_history(hist->m_att).initial,
+            att.matched_readers_allocation.initial);
 }
 
 StatefulWriter::~StatefulWriter()
@@ -181,6 +215,12 @@ StatefulWriter::~StatefulWriter()
         nack_response_event_ = nullptr;
     }
 
+    if (historical_replay_event_ != nullptr)
+    {
+        delete(historical_replay_event_);
+        historical_replay_event_ = nullptr;
+    }
+
     mp_RTPSParticipant->async_thread().unregister_writer(this);
 
     // After unregistering writer from AsyncWriterThread, delete all flow_controllers because they register the writer in
@@ -194,6 +234,7 @@ StatefulWriter::~StatefulWriter()
         {
             ReaderProxy* remote_reader = matched_readers_.back();
             matched_readers_.pop_back();
+            matched_readers_index_.remove(remote_reader->guid());
             remote_reader->stop();
             matched_readers_pool_.push_back(remote_reader);
         }
@@ -238,7 +279,14 @@ void StatefulWriter::unsent_change_added_to_history(
 
     if (!matched_readers_.empty())
     {
-        if (!isAsync())
+        // Changes filtered for some reader have to be sent reader by reader, with GAPs for the filtered ones
+        bool some_reader_filters = std::any_of(matched_readers_.begin(), matched_readers_.end(),
+                        [](const ReaderProxy* reader)
+                        {
+                            return reader->has_time_based_filter();
+                        });
+
+        if (!isAsync() && !some_reader_filters)
         {
             //TODO(Ricardo) Temporal.
             bool expectsInlineQos = false;
@@ -389,7 +437,14 @@ void StatefulWriter::unsent_change_added_to_history(
 
             if (m_pushMode)
             {
-                mp_RTPSParticipant->async_thread().wake_up(this, max_blocking_time);
+                if (isAsync())
+                {
+                    mp_RTPSParticipant->async_thread().wake_up(this, max_blocking_time);
+                }
+                else
+                {
+                    send_any_unsent_changes();
+                }
             }
         }
 
@@ -587,6 +642,7 @@ void StatefulWriter::send_heartbeat_to_all_readers()
         if (there_are_remote_readers_)
         {
             RTPSMessageGroup group(mp_RTPSParticipant, this, *this);
+            group.aggregate_control_messages();
             send_heartbeat_nts_(all_remote_readers_.size(), group, disable_positive_acks_);
         }
     }
@@ -816,10 +872,41 @@ void StatefulWriter::send_all_unsent_changes(
             send_heartbeat_piggyback_nts_(nullptr, group, lastBytesProcessed);
         };
 
+        // Changes requested by only some of the readers (i.e. repairs) are only sent to them. The transport
+        // selects a multicast locator when several of those readers share it, so a change lost by many readers
+        // is repaired with a single datagram.
+        auto select_destinations = [&](bool all_readers)
+        {
+            locator_selector_.reset(all_readers);
+            if (!all_readers)
+            {
+                bool tmp_bool = false;
+                for (ReaderProxy* remoteReader : matched_readers_)
+                {
+                    if (!remoteReader->is_local_reader() && remoteReader->change_is_unsent(seq, tmp_bool))
+                    {
+                        locator_selector_.enable(remoteReader->guid());
+                    }
+                }
+            }
+
+            if (locator_selector_.state_has_changed())
+            {
+                gap_builder.flush();
+                group.flush_and_reset();
+                network.select_locators(locator_selector_);
+                compute_selected_guids();
+            }
+        };
+
         // Add holes in history and send them to all readers
         for (auto cit = mp_history->changesBegin(); cit != mp_history->changesEnd(); cit++)
         {
             // Add all sequence numbers until the change's sequence number
+            if (seq < (*cit)->sequenceNumber)
+            {
+                select_destinations(true);
+            }
             while (seq < (*cit)->sequenceNumber)
             {
                 gap_builder.add(seq);
@@ -830,11 +917,17 @@ void StatefulWriter::send_all_unsent_changes(
             bool is_irrelevant = true;
             bool should_be_sent = false;
             bool inline_qos = false;
+            size_t num_destinations = 0;
             for (ReaderProxy* remoteReader : matched_readers_)
             {
                 if (!remoteReader->is_local_reader())
                 {
-                    should_be_sent |= remoteReader->change_is_unsent(seq, is_irrelevant);
+                    bool is_unsent = remoteReader->change_is_unsent(seq, is_irrelevant);
+                    should_be_sent |= is_unsent;
+                    if (is_unsent)
+                    {
+                        ++num_destinations;
+                    }
                     if (should_be_sent)
                     {
                         inline_qos |= remoteReader->expects_inline_qos();
@@ -850,10 +943,12 @@ void StatefulWriter::send_all_unsent_changes(
             {
                 if (is_irrelevant)
                 {
+                    select_destinations(true);
                     gap_builder.add(seq);
                 }
                 else
                 {
+                    select_destinations(num_destinations >= all_remote_readers_.size());
                     bool sent_ok = send_data_or_fragments(group, *cit, inline_qos, sent_fun);
                     if (sent_ok)
                     {
@@ -881,6 +976,7 @@ void StatefulWriter::send_all_unsent_changes(
         }
 
         // Add all sequence numbers above last change
+        select_destinations(true);
         while (seq < last_sequence)
         {
             gap_builder.add(seq);
@@ -920,7 +1016,8 @@ void StatefulWriter::send_unsent_changes_with_flow_control(
 
     // From here onwards, only remote readers should be accessed
 
-    RTPSWriterCollector<ReaderProxy*> relevantChanges;
+    RTPSWriterCollector<ReaderProxy*>& relevantChanges = *flow_controlled_changes_;
+    relevantChanges.reset(matched_readers_.size());
     bool heartbeat_has_been_sent = false;
 
     NetworkFactory& network = mp_RTPSParticipant->network_factory();
@@ -1035,11 +1132,11 @@ void StatefulWriter::send_unsent_changes_with_flow_control(
             bool expectsInlineQos = false;
             locator_selector_.reset(false);
 
-            for (const ReaderProxy* remoteReader : changeToSend.remoteReaders)
-            {
-                locator_selector_.enable(remoteReader->guid());
-                expectsInlineQos |= remoteReader->expects_inline_qos();
-            }
+            relevantChanges.for_each_reader(changeToSend, [&](const ReaderProxy* remoteReader)
+                    {
+                        locator_selector_.enable(remoteReader->guid());
+                        expectsInlineQos |= remoteReader->expects_inline_qos();
+                    });
 
             if (locator_selector_.state_has_changed())
             {
@@ -1058,7 +1155,7 @@ void StatefulWriter::send_unsent_changes_with_flow_control(
                         expectsInlineQos))
                 {
                     bool must_wake_up_async_thread = false;
-                    for (ReaderProxy* remoteReader : changeToSend.remoteReaders)
+                    relevantChanges.for_each_reader(changeToSend, [&](ReaderProxy* remoteReader)
                     {
                         bool allFragmentsSent = false;
                         if (remoteReader->mark_fragment_as_sent_for_change(
@@ -1086,7 +1183,7 @@ void StatefulWriter::send_unsent_changes_with_flow_control(
                                 }
                             }
                         }
-                    }
+                    });
 
                     if (must_wake_up_async_thread)
                     {
@@ -1103,7 +1200,7 @@ void StatefulWriter::send_unsent_changes_with_flow_control(
             {
                 if (group.add_data(*changeToSend.cacheChange, expectsInlineQos))
                 {
-                    for (ReaderProxy* remoteReader : changeToSend.remoteReaders)
+                    relevantChanges.for_each_reader(changeToSend, [&](ReaderProxy* remoteReader)
                     {
                         remoteReader->set_change_to_status(changeToSend.sequenceNumber, UNDERWAY, true);
 
@@ -1111,7 +1208,7 @@ void StatefulWriter::send_unsent_changes_with_flow_control(
                         {
                             activateHeartbeatPeriod = true;
                         }
-                    }
+                    });
                 }
                 else
                 {
@@ -1185,17 +1282,15 @@ bool StatefulWriter::matched_reader_add(
     std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
 
     // Check if it is already matched.
-    for (ReaderProxy* it : matched_readers_)
+    ReaderProxy* existing = matched_readers_index_.find(rdata.guid());
+    if (existing != nullptr)
     {
-        if (it->guid() == rdata.guid())
+        logInfo(RTPS_WRITER, "Attempting to add existing reader, updating information." << endl);
+        if (existing->update(rdata))
         {
-            logInfo(RTPS_WRITER, "Attempting to add existing reader, updating information." << endl);
-            if (it->update(rdata))
-            {
-                update_reader_info(true);
-            }
-            return false;
+            update_reader_info(true);
         }
+        return false;
     }
 
     // Get a reader proxy from the inactive pool (or create a new one if necessary and allowed)
@@ -1225,9 +1320,11 @@ bool StatefulWriter::matched_reader_add(
     rp->start(rdata);
     locator_selector_.add_entry(rp->locator_selector_entry());
     matched_readers_.push_back(rp);
+    matched_readers_index_.add(rp->guid(), rp);
     update_reader_info(true);
 
     RTPSMessageGroup group(mp_RTPSParticipant, this, rp->message_sender());
+    group.aggregate_control_messages();
 
     // Add initial heartbeat to message group
     send_heartbeat_nts_(1u, group, disable_positive_acks_);
@@ -1237,7 +1334,6 @@ bool StatefulWriter::matched_reader_add(
 
     if (current_seq != SequenceNumber_t::unknown())
     {
-        (void)last_seq;
         assert(last_seq != SequenceNumber_t::unknown());
         assert(current_seq <= last_seq);
 
@@ -1350,6 +1446,17 @@ bool StatefulWriter::matched_reader_add(
             logError(RTPS_WRITER, "Max blocking time reached");
         }
 
+        // Stream the history to the late-joining reader instead of waiting for it to be requested
+        if (historical_replay_event_ != nullptr && is_reliable && !rp->is_local_reader() &&
+                rp->durability_kind() >= TRANSIENT_LOCAL)
+        {
+            if (historical_replays_.empty())
+            {
+                historical_replay_event_->restart_timer();
+            }
+            historical_replays_.push_back({rp->guid(), get_seq_num_min(), last_seq + 1});
+        }
+
         // Always activate heartbeat period. We need a confirmation of the reader.
         // The state has to be updated.
         periodic_hb_event_->restart_timer();
@@ -1379,6 +1486,7 @@ bool StatefulWriter::matched_reader_remove(
     ReaderProxy* rproxy = nullptr;
     std::unique_lock<RecursiveTimedMutex> lock(mp_mutex);
 
+    matched_readers_index_.remove(reader_guid);
     ReaderProxyIterator it = matched_readers_.begin();
     while (it != matched_readers_.end())
     {
@@ -1421,14 +1529,7 @@ bool StatefulWriter::matched_reader_is_matched(
         const GUID_t& reader_guid)
 {
     std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
-    for (ReaderProxy* it : matched_readers_)
-    {
-        if (it->guid() == reader_guid)
-        {
-            return true;
-        }
-    }
-    return false;
+    return matched_readers_index_.find(reader_guid) != nullptr;
 }
 
 bool StatefulWriter::matched_reader_lookup(
@@ -1436,13 +1537,11 @@ bool StatefulWriter::matched_reader_lookup(
         ReaderProxy** RP)
 {
     std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
-    for (ReaderProxy* it : matched_readers_)
+    ReaderProxy* rp = matched_readers_index_.find(readerGuid);
+    if (rp != nullptr)
     {
-        if (it->guid() == readerGuid)
-        {
-            *RP = it;
-            return true;
-        }
+        *RP = rp;
+        return true;
     }
     return false;
 }
@@ -1659,6 +1758,22 @@ void StatefulWriter::updateTimes(
     m_times = times;
 }
 
+void StatefulWriter::notify_flow_controllers_feedback(
+        bool loss)
+{
+    for (std::unique_ptr<FlowController>& controller : m_controllers)
+    {
+        if (loss)
+        {
+            controller->NotifyLoss();
+        }
+        else
+        {
+            controller->NotifyAcknowledgement();
+        }
+    }
+}
+
 void StatefulWriter::add_flow_controller(
         std::unique_ptr<FlowController> controller)
 {
@@ -1714,6 +1829,7 @@ bool StatefulWriter::send_periodic_heartbeat(
                 try
                 {
                     RTPSMessageGroup group(mp_RTPSParticipant, this, *this);
+                    group.aggregate_control_messages();
                     send_heartbeat_nts_(all_remote_readers_.size(), group, disable_positive_acks_, liveliness);
                 }
                 catch (const RTPSMessageGroup::timeout&)
@@ -1737,6 +1853,7 @@ bool StatefulWriter::send_periodic_heartbeat(
             }
 
             RTPSMessageGroup group(mp_RTPSParticipant, this, *this);
+            group.aggregate_control_messages();
             send_heartbeat_nts_(all_remote_readers_.size(), group, final, liveliness);
         }
         catch (const RTPSMessageGroup::timeout&)
@@ -1755,6 +1872,7 @@ void StatefulWriter::send_heartbeat_to_nts(
     try
     {
         RTPSMessageGroup group(mp_RTPSParticipant, this, remoteReaderProxy.message_sender());
+        group.aggregate_control_messages();
         send_heartbeat_nts_(1u, group, disable_positive_acks_, liveliness);
     }
     catch (const RTPSMessageGroup::timeout&)
@@ -1854,19 +1972,70 @@ void StatefulWriter::perform_nack_response()
     }
 }
 
-void StatefulWriter::perform_nack_supression(
-        const GUID_t& reader_guid)
+bool StatefulWriter::replay_historical_changes()
 {
     std::unique_lock<RecursiveTimedMutex> lock(mp_mutex);
+    bool must_wake_up_async_thread = false;
 
-    for (ReaderProxy* remote_reader : matched_readers_)
+    auto replay = historical_replays_.begin();
+    while (replay != historical_replays_.end())
     {
-        if (remote_reader->guid() == reader_guid)
+        ReaderProxy* remote_reader = matched_readers_index_.find(replay->reader_guid);
+
+        if (remote_reader != nullptr)
         {
-            remote_reader->perform_nack_supression();
-            periodic_hb_event_->restart_timer();
-            return;
+            // Changes already sent or acknowledged are not changed by requested_changes_set
+            uint32_t pending = historical_replay_batch_;
+            while (pending > 0 && replay->next < replay->end)
+            {
+                SequenceNumber_t to = replay->end;
+                uint32_t batch = (std::min)(pending, 256u);
+                if (replay->next + batch < to)
+                {
+                    to = replay->next + batch;
+                }
+
+                SequenceNumberSet_t requested(replay->next);
+                requested.add_range(replay->next, to);
+                remote_reader->requested_changes_set(requested);
+                pending -= static_cast<uint32_t>((to - replay->next).to64long());
+                replay->next = to;
+            }
+
+            if (remote_reader->perform_acknack_response())
+            {
+                must_wake_up_async_thread = true;
+            }
+        }
+
+        if (remote_reader == nullptr || replay->next >= replay->end)
+        {
+            replay = historical_replays_.erase(replay);
         }
+        else
+        {
+            ++replay;
+        }
+    }
+
+    if (must_wake_up_async_thread)
+    {
+        mp_RTPSParticipant->async_thread().wake_up(this);
+    }
+
+    return !historical_replays_.empty();
+}
+
+void StatefulWriter::perform_nack_supression(
+        const GUID_t& reader_guid)
+{
+    std::unique_lock<RecursiveTimedMutex> lock(mp_mutex);
+
+    ReaderProxy* remote_reader = matched_readers_index_.find(reader_guid);
+    if (remote_reader != nullptr)
+    {
+        remote_reader->perform_nack_supression();
+        periodic_hb_event_->restart_timer();
     }
 }
 
@@ -1882,52 +2051,55 @@ bool StatefulWriter::process_acknack(
     result = (m_guid == writer_guid);
     if (result)
     {
-        for (ReaderProxy* remote_reader : matched_readers_)
+        ReaderProxy* remote_reader = matched_readers_index_.find(reader_guid);
+        if (remote_reader != nullptr)
         {
-            if (remote_reader->guid() == reader_guid)
+            if (remote_reader->check_and_set_acknack_count(ack_count))
             {
-                if (remote_reader->check_and_set_acknack_count(ack_count))
+                // Sequence numbers before Base are set as Acknowledged.
+                remote_reader->acked_changes_set(sn_set.base());
+                if (sn_set.base() > SequenceNumber_t(0, 0))
                 {
-                    // Sequence numbers before Base are set as Acknowledged.
-                    remote_reader->acked_changes_set(sn_set.base());
-                    if (sn_set.base() > SequenceNumber_t(0, 0))
+                    bool requested = remote_reader->requested_changes_set(sn_set);
+                    if (!remote_reader->is_local_reader())
                     {
-                        if (remote_reader->requested_changes_set(sn_set) || remote_reader->are_there_gaps())
-                        {
-                            nack_response_event_->restart_timer();
-                        }
-                        else if (!final_flag)
-                        {
-                            periodic_hb_event_->restart_timer();
-                        }
+                        notify_flow_controllers_feedback(requested);
+                    }
+
+                    if (requested || remote_reader->are_there_gaps())
+                    {
+                        nack_response_event_->restart_timer();
                     }
-                    else if (sn_set.empty() && !final_flag)
+                    else if (!final_flag)
+                    {
+                        periodic_hb_event_->restart_timer();
+                    }
+                }
+                else if (sn_set.empty() && !final_flag)
+                {
+                    // This is the preemptive acknack.
+                    if (remote_reader->process_initial_acknack())
                     {
-                        // This is the preemptive acknack.
-                        if (remote_reader->process_initial_acknack())
+                        if (remote_reader->is_local_reader())
                         {
-                            if (remote_reader->is_local_reader())
-                            {
-                                mp_RTPSParticipant->async_thread().wake_up(this);
-                            }
-                            else
-                            {
-                                // Send heartbeat if requested
-                                send_heartbeat_to_nts(*remote_reader);
-                            }
+                            mp_RTPSParticipant->async_thread().wake_up(this);
                         }
-
-                        if (remote_reader->is_local_reader())
+                        else
                         {
-                            intraprocess_heartbeat(remote_reader);
+                            // Send heartbeat if requested
+                            send_heartbeat_to_nts(*remote_reader);
                         }
                     }
 
-                    // Check if all CacheChange are acknowledge, because a user could be waiting
-                    // for this, of if VOLATILE should be removed CacheChanges
-                    check_acked_status();
+                    if (remote_reader->is_local_reader())
+                    {
+                        intraprocess_heartbeat(remote_reader);
+                    }
                 }
-                break;
+
+                // Check if all CacheChange are acknowledge, because a user could be waiting
+                // for this, of if VOLATILE should be removed CacheChanges
+                check_acked_status();
             }
         }
     }
@@ -1948,15 +2120,13 @@ bool StatefulWriter::process_nack_frag(
     if (m_guid == writer_guid)
     {
         result = true;
-        for (ReaderProxy* remote_reader : matched_readers_)
+        ReaderProxy* remote_reader = matched_readers_index_.find(reader_guid);
+        if (remote_reader != nullptr)
         {
-            if (remote_reader->guid() == reader_guid)
+            if (remote_reader->process_nack_frag(reader_guid, ack_count, seq_num, fragments_state))
             {
-                if (remote_reader->process_nack_frag(reader_guid, ack_count, seq_num, fragments_state))
-                {
-                    nack_response_event_->restart_timer();
-                }
-                break;
+                notify_flow_controllers_feedback(true);
+                nack_response_event_->restart_timer();
             }
         }
     }
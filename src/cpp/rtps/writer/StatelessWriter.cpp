@@ -94,10 +94,13 @@ StatelessWriter::StatelessWriter(
         listener)
     , matched_readers_(attributes.matched_readers_allocation)
     , unsent_changes_(resource_limits_from_history(history->m_att))
+    , flow_controlled_changes_(new RTPSWriterCollector<ReaderLocator*>())
     , last_intraprocess_sequence_number_(0)
 {
     get_builtin_guid();
 
+    flow_controlled_changes_->reserve(resource_limits_from_history(history->m_att).initial, 1u);
+
     const RemoteLocatorsAllocationAttributes& loc_alloc =
             participant->getRTPSParticipantAttributes().allocation.locators;
     for (size_t i = 0; i < attributes.matched_readers_allocation.initial; ++i)
@@ -195,6 +198,33 @@ void StatelessWriter::unsent_change_added_to_history(
 {
     std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
 
+    prepare_change(change);
+
+    if (isAsync() && (!fixed_locators_.empty() || matched_readers_.size() > 0))
+    {
+        unsent_changes_.push_back(ChangeForReader_t(change));
+        mp_RTPSParticipant->async_thread().wake_up(this, max_blocking_time);
+    }
+    else if (send_change(change, max_blocking_time) && mp_listener != nullptr)
+    {
+        mp_listener->onWriterChangeReceivedByAll(this, change);
+    }
+}
+
+void StatelessWriter::send_change_without_history(
+        CacheChange_t* change,
+        const std::chrono::time_point<std::chrono::steady_clock>& max_blocking_time)
+{
+    std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
+
+    // The change is not on the history, so the listener is not told it was received by all
+    prepare_change(change);
+    send_change(change, max_blocking_time);
+}
+
+void StatelessWriter::prepare_change(
+        CacheChange_t* change)
+{
     if (liveliness_lease_duration_ < c_TimeInfinite)
     {
         mp_RTPSParticipant->wlp()->assert_liveliness(
@@ -205,109 +235,100 @@ void StatelessWriter::unsent_change_added_to_history(
 
 #if HAVE_SECURITY
     encrypt_cachechange(change);
+#else
+    (void)change;
 #endif
+}
+
+bool StatelessWriter::send_change(
+        CacheChange_t* change,
+        const std::chrono::time_point<std::chrono::steady_clock>& max_blocking_time)
+{
+    if (fixed_locators_.empty() && matched_readers_.size() == 0)
+    {
+        logInfo(RTPS_WRITER, "No reader to add change.");
+        return true;
+    }
 
-    if (!fixed_locators_.empty() || matched_readers_.size() > 0)
+    try
     {
-        if (!isAsync())
+        if (m_separateSendingEnabled)
         {
-            try
+            for (ReaderLocator& it : matched_readers_)
             {
-                if (m_separateSendingEnabled)
+                if (it.is_local_reader())
+                {
+                    intraprocess_delivery(change, it);
+                }
+                else
                 {
-                    std::vector<GUID_t> guids(1);
-                    for (ReaderLocator& it : matched_readers_)
+                    RTPSMessageGroup group(mp_RTPSParticipant, this, it, max_blocking_time);
+
+                    uint32_t n_fragments = change->getFragmentCount();
+                    if (n_fragments > 0)
                     {
-                        if (it.is_local_reader())
-                        {
-                            intraprocess_delivery(change, it);
-                        }
-                        else
+                        for (uint32_t frag = 1; frag <= n_fragments; frag++)
                         {
-                            RTPSMessageGroup group(mp_RTPSParticipant, this, it, max_blocking_time);
-
-                            uint32_t n_fragments = change->getFragmentCount();
-                            if (n_fragments > 0)
-                            {
-                                for (uint32_t frag = 1; frag <= n_fragments; frag++)
-                                {
-                                    if (!group.add_data_frag(*change, frag, is_inline_qos_expected_))
-                                    {
-                                        logError(RTPS_WRITER, "Error sending fragment (" << change->sequenceNumber <<
-                                                ", " << frag << ")");
-                                    }
-                                }
-                            }
-                            else
+                            if (!group.add_data_frag(*change, frag, is_inline_qos_expected_))
                             {
-                                if (!group.add_data(*change, is_inline_qos_expected_))
-                                {
-                                    logError(RTPS_WRITER, "Error sending change " << change->sequenceNumber);
-                                }
+                                logError(RTPS_WRITER, "Error sending fragment (" << change->sequenceNumber <<
+                                        ", " << frag << ")");
                             }
                         }
                     }
-                }
-                else
-                {
-                    for (ReaderLocator& it : matched_readers_)
+                    else
                     {
-                        if (it.is_local_reader())
+                        if (!group.add_data(*change, is_inline_qos_expected_))
                         {
-                            intraprocess_delivery(change, it);
+                            logError(RTPS_WRITER, "Error sending change " << change->sequenceNumber);
                         }
                     }
+                }
+            }
+        }
+        else
+        {
+            for (ReaderLocator& it : matched_readers_)
+            {
+                if (it.is_local_reader())
+                {
+                    intraprocess_delivery(change, it);
+                }
+            }
 
-                    if (there_are_remote_readers_ || !fixed_locators_.empty())
-                    {
-                        RTPSMessageGroup group(mp_RTPSParticipant, this, *this, max_blocking_time);
+            if (there_are_remote_readers_ || !fixed_locators_.empty())
+            {
+                RTPSMessageGroup group(mp_RTPSParticipant, this, *this, max_blocking_time);
 
-                        uint32_t n_fragments = change->getFragmentCount();
-                        if (n_fragments > 0)
-                        {
-                            for (uint32_t frag = 1; frag <= n_fragments; frag++)
-                            {
-                                if (!group.add_data_frag(*change, frag, is_inline_qos_expected_))
-                                {
-                                    logError(RTPS_WRITER, "Error sending fragment (" << change->sequenceNumber <<
-                                            ", " << frag << ")");
-                                }
-                            }
-                        }
-                        else
+                uint32_t n_fragments = change->getFragmentCount();
+                if (n_fragments > 0)
+                {
+                    for (uint32_t frag = 1; frag <= n_fragments; frag++)
+                    {
+                        if (!group.add_data_frag(*change, frag, is_inline_qos_expected_))
                         {
-                            if (!group.add_data(*change, is_inline_qos_expected_))
-                            {
-                                logError(RTPS_WRITER, "Error sending change " << change->sequenceNumber);
-                            }
+                            logError(RTPS_WRITER, "Error sending fragment (" << change->sequenceNumber <<
+                                    ", " << frag << ")");
                         }
                     }
                 }
-
-                if (mp_listener != nullptr)
+                else
                 {
-                    mp_listener->onWriterChangeReceivedByAll(this, change);
+                    if (!group.add_data(*change, is_inline_qos_expected_))
+                    {
+                        logError(RTPS_WRITER, "Error sending change " << change->sequenceNumber);
+                    }
                 }
             }
-            catch (const RTPSMessageGroup::timeout&)
-            {
-                logError(RTPS_WRITER, "Max blocking time reached");
-            }
-        }
-        else
-        {
-            unsent_changes_.push_back(ChangeForReader_t(change));
-            mp_RTPSParticipant->async_thread().wake_up(this, max_blocking_time);
         }
     }
-    else
+    catch (const RTPSMessageGroup::timeout&)
     {
-        logInfo(RTPS_WRITER, "No reader to add change.");
-        if (mp_listener != nullptr)
-        {
-            mp_listener->onWriterChangeReceivedByAll(this, change);
-        }
+        logError(RTPS_WRITER, "Max blocking time reached");
+        return false;
     }
+
+    return true;
 }
 
 bool StatelessWriter::intraprocess_delivery(
@@ -463,7 +484,8 @@ void StatelessWriter::send_unsent_changes_with_flow_control()
     bool flow_controllers_limited = false;
     while (!unsent_changes_.empty() && !flow_controllers_limited)
     {
-        RTPSWriterCollector<ReaderLocator*> changesToSend;
+        RTPSWriterCollector<ReaderLocator*>& changesToSend = *flow_controlled_changes_;
+        changesToSend.reset(1u);
 
         for (const ChangeForReader_t& unsentChange : unsent_changes_)
         {
@@ -24,6 +24,9 @@
 #include <fastrtps/utils/TimeConversion.h>
 #include <fastrtps/transport/test_UDPv4Transport.h>
 
+#include <map>
+#include <mutex>
+
 using namespace eprosima::fastrtps;
 using namespace eprosima::fastrtps::rtps;
 
@@ -158,3 +161,103 @@ TEST(AcknackQos, NotRecoverAfterLosingCommunicationWithDisablePositiveAck)
     // Block reader until reception finished or timeout.
     ASSERT_EQ(reader.block_for_all(std::chrono::seconds(1)), 0u);
 }
+
+TEST(AcknackQos, RepairLostDataToSeveralReadersSharingMulticast)
+{
+    // This test makes a writer send samples to several readers sharing a multicast locator, each of them also
+    // having its own unicast locator. The first transmission of some samples is dropped, and the test checks
+    // that every reader gets them repaired, and that each repair was sent once to the multicast locator instead
+    // of once to every reader.
+
+    const size_t num_readers = 3;
+    std::string ip("239.255.1.4");
+
+    Locator_t multicast_locator;
+    IPLocator::setIPv4(multicast_locator, ip);
+    multicast_locator.port = global_port;
+
+    // Declared before the writer, as its transport uses them until it is destroyed.
+    const std::vector<SequenceNumber_t> lost_samples{ {0, 3}, {0, 7}, {0, 11} };
+    std::mutex destinations_mutex;
+    std::map<SequenceNumber_t, std::vector<Locator_t> > destinations;
+
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+    std::vector<std::unique_ptr<PubSubReader<HelloWorldType> > > readers;
+
+    auto testTransport = std::make_shared<test_UDPv4TransportDescriptor>();
+    testTransport->dropDataMessagesFilter = [&](const Locator_t& destination, CDRMessage_t& msg)
+            {
+                EntityId_t writer_id;
+                SequenceNumber_t sn;
+                msg.pos += 8;
+                CDRMessage::readEntityId(&msg, &writer_id);
+                CDRMessage::readInt32(&msg, &sn.high);
+                CDRMessage::readUInt32(&msg, &sn.low);
+
+                // Only samples of the user writer
+                if (0 != (writer_id.value[3] & 0xC0))
+                {
+                    return false;
+                }
+
+                std::lock_guard<std::mutex> guard(destinations_mutex);
+                std::vector<Locator_t>& sent_to = destinations[sn];
+                bool first_transmission = sent_to.empty();
+                sent_to.push_back(destination);
+                return first_transmission &&
+                       std::find(lost_samples.begin(), lost_samples.end(), sn) != lost_samples.end();
+            };
+    writer.disable_builtin_transport();
+    writer.add_user_transport_to_pparams(testTransport);
+    writer.history_kind(eprosima::fastrtps::KEEP_ALL_HISTORY_QOS).
+    reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+    ASSERT_TRUE(writer.isInitialized());
+
+    for (size_t i = 0; i < num_readers; ++i)
+    {
+        readers.emplace_back(new PubSubReader<HelloWorldType>(TEST_TOPIC_NAME));
+        readers.back()->history_kind(eprosima::fastrtps::KEEP_ALL_HISTORY_QOS).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).
+        add_to_unicast_locator_list("127.0.0.1", global_port + 1 + static_cast<uint32_t>(i)).
+        add_to_multicast_locator_list(ip, global_port).init();
+        ASSERT_TRUE(readers.back()->isInitialized());
+    }
+
+    // Wait for discovery.
+    writer.wait_discovery();
+    for (auto& reader : readers)
+    {
+        reader->wait_discovery();
+    }
+
+    std::list<HelloWorld> data = default_helloworld_data_generator(20);
+    for (auto& reader : readers)
+    {
+        reader->startReception(data);
+    }
+
+    // Send data
+    writer.send(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+
+    // Block readers until reception finished or timeout.
+    for (auto& reader : readers)
+    {
+        reader->block_for_all();
+    }
+
+    std::lock_guard<std::mutex> guard(destinations_mutex);
+    for (const SequenceNumber_t& sn : lost_samples)
+    {
+        // Dropped once, and repaired afterwards
+        ASSERT_GE(destinations[sn].size(), 2u);
+    }
+    for (const auto& sample : destinations)
+    {
+        for (const Locator_t& destination : sample.second)
+        {
+            ASSERT_EQ(destination, multicast_locator);
+        }
+    }
+}
@@ -22,8 +22,24 @@
 #include "ReqRepAsReliableHelloWorldReplier.hpp"
 
 #include <gtest/gtest.h>
+#include <fastdds/dds/domain/DomainParticipant.hpp>
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/dds/publisher/DataWriter.hpp>
+#include <fastdds/dds/publisher/DataWriterListener.hpp>
+#include <fastdds/dds/publisher/Publisher.hpp>
+#include <fastdds/dds/subscriber/DataReader.hpp>
+#include <fastdds/dds/subscriber/DataReaderListener.hpp>
+#include <fastdds/dds/subscriber/SampleInfo.hpp>
+#include <fastdds/dds/subscriber/Subscriber.hpp>
+#include <fastdds/dds/topic/TypeSupport.hpp>
+#include <fastdds/rtps/transport/UDPv4TransportDescriptor.h>
 #include <fastrtps/xmlparser/XMLProfileManager.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 using namespace eprosima::fastrtps;
 
 class Volatile : public testing::TestWithParam<bool>
@@ -51,6 +67,268 @@ public:
   }
 };
 
+/**
+ * Writer and reader of the DDS API, with the QoS of the DataWriters that send their samples without adding them to
+ * their history: synchronous, best-effort, volatile and KEEP_LAST(1).
+ * Each one is created on its own participant. Without intraprocess delivery, participants only use UDPv4.
+ */
+template<class TypeSupportImpl>
+class VolatileKeepLastOne
+    : public eprosima::fastdds::dds::DataWriterListener
+    , public eprosima::fastdds::dds::DataReaderListener
+{
+public:
+
+    typedef typename TypeSupportImpl::type type;
+
+    VolatileKeepLastOne(
+            const std::string& topic_name,
+            bool udp_only,
+            uint32_t max_message_size = 0)
+    {
+        namespace dds = eprosima::fastdds::dds;
+
+        dds::DomainParticipantQos pqos = dds::PARTICIPANT_QOS_DEFAULT;
+        if (udp_only)
+        {
+            auto udp = std::make_shared<eprosima::fastdds::rtps::UDPv4TransportDescriptor>();
+            if (max_message_size > 0)
+            {
+                udp->maxMessageSize = max_message_size;
+            }
+            pqos.transport().use_builtin_transports = false;
+            pqos.transport().user_transports.push_back(udp);
+        }
+
+        dds::DomainParticipantFactory* factory = dds::DomainParticipantFactory::get_instance();
+        uint32_t domain_id = (uint32_t)GET_PID() % 230;
+        writer_participant_ = factory->create_participant(domain_id, pqos);
+        reader_participant_ = factory->create_participant(domain_id, pqos);
+        if (writer_participant_ == nullptr || reader_participant_ == nullptr)
+        {
+            return;
+        }
+
+        dds::TypeSupport type(new TypeSupportImpl());
+        writer_participant_->register_type(type);
+        reader_participant_->register_type(type);
+        writer_topic_ = writer_participant_->create_topic(topic_name, type.get_type_name(), dds::TOPIC_QOS_DEFAULT);
+        reader_topic_ = reader_participant_->create_topic(topic_name, type.get_type_name(), dds::TOPIC_QOS_DEFAULT);
+        if (writer_topic_ == nullptr || reader_topic_ == nullptr)
+        {
+            return;
+        }
+
+        publisher_ = writer_participant_->create_publisher(dds::PUBLISHER_QOS_DEFAULT);
+        subscriber_ = reader_participant_->create_subscriber(dds::SUBSCRIBER_QOS_DEFAULT);
+        if (publisher_ == nullptr || subscriber_ == nullptr)
+        {
+            return;
+        }
+
+        dds::DataReaderQos rqos = dds::DATAREADER_QOS_DEFAULT;
+        rqos.reliability().kind = eprosima::fastrtps::BEST_EFFORT_RELIABILITY_QOS;
+        rqos.durability().kind = eprosima::fastrtps::VOLATILE_DURABILITY_QOS;
+        rqos.history().kind = eprosima::fastrtps::KEEP_ALL_HISTORY_QOS;
+        reader_ = subscriber_->create_datareader(reader_topic_, rqos, this);
+
+        dds::DataWriterQos wqos = dds::DATAWRITER_QOS_DEFAULT;
+        wqos.reliability().kind = eprosima::fastrtps::BEST_EFFORT_RELIABILITY_QOS;
+        wqos.durability().kind = eprosima::fastrtps::VOLATILE_DURABILITY_QOS;
+        wqos.history().kind = eprosima::fastrtps::KEEP_LAST_HISTORY_QOS;
+        wqos.history().depth = 1;
+        wqos.publish_mode().kind = eprosima::fastrtps::SYNCHRONOUS_PUBLISH_MODE;
+        writer_ = publisher_->create_datawriter(writer_topic_, wqos, this);
+    }
+
+    ~VolatileKeepLastOne()
+    {
+        if (writer_ != nullptr)
+        {
+            publisher_->delete_datawriter(writer_);
+        }
+        if (reader_ != nullptr)
+        {
+            subscriber_->delete_datareader(reader_);
+        }
+        if (publisher_ != nullptr)
+        {
+            writer_participant_->delete_publisher(publisher_);
+        }
+        if (subscriber_ != nullptr)
+        {
+            reader_participant_->delete_subscriber(subscriber_);
+        }
+        if (writer_topic_ != nullptr)
+        {
+            writer_participant_->delete_topic(writer_topic_);
+        }
+        if (reader_topic_ != nullptr)
+        {
+            reader_participant_->delete_topic(reader_topic_);
+        }
+        if (writer_participant_ != nullptr)
+        {
+            eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->delete_participant(writer_participant_);
+        }
+        if (reader_participant_ != nullptr)
+        {
+            eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->delete_participant(reader_participant_);
+        }
+    }
+
+    bool isInitialized() const
+    {
+        return writer_ != nullptr && reader_ != nullptr;
+    }
+
+    void wait_discovery()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait_for(lock, std::chrono::seconds(10), [&]()
+                {
+                    return writer_matched_ && reader_matched_;
+                });
+    }
+
+    //! Writes the samples, waiting the given time after each one.
+    void send(
+            std::list<type>& msgs,
+            uint32_t milliseconds)
+    {
+        auto it = msgs.begin();
+        while (it != msgs.end())
+        {
+            if (!writer_->write(&(*it)))
+            {
+                break;
+            }
+            it = msgs.erase(it);
+            std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+        }
+    }
+
+    //! @return Samples received, once at least the given number of them was received or a timeout expired.
+    std::list<type> block_for_at_least(
+            size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait_for(lock, std::chrono::seconds(10), [&]()
+                {
+                    return received_.size() >= count;
+                });
+        return received_;
+    }
+
+    void on_publication_matched(
+            eprosima::fastdds::dds::DataWriter* /*writer*/,
+            const eprosima::fastdds::dds::PublicationMatchedStatus& info) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        writer_matched_ = info.current_count > 0;
+        cv_.notify_all();
+    }
+
+    void on_subscription_matched(
+            eprosima::fastdds::dds::DataReader* /*reader*/,
+            const eprosima::fastdds::dds::SubscriptionMatchedStatus& info) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reader_matched_ = info.current_count > 0;
+        cv_.notify_all();
+    }
+
+    void on_data_available(
+            eprosima::fastdds::dds::DataReader* reader) override
+    {
+        type data;
+        eprosima::fastdds::dds::SampleInfo info;
+        while (eprosima::fastrtps::types::ReturnCode_t::RETCODE_OK == reader->take_next_sample(&data, &info))
+        {
+            if (info.instance_state == eprosima::fastdds::dds::ALIVE)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                received_.push_back(data);
+                cv_.notify_all();
+            }
+        }
+    }
+
+private:
+
+    eprosima::fastdds::dds::DomainParticipant* writer_participant_ = nullptr;
+    eprosima::fastdds::dds::DomainParticipant* reader_participant_ = nullptr;
+    eprosima::fastdds::dds::Topic* writer_topic_ = nullptr;
+    eprosima::fastdds::dds::Topic* reader_topic_ = nullptr;
+    eprosima::fastdds::dds::Publisher* publisher_ = nullptr;
+    eprosima::fastdds::dds::Subscriber* subscriber_ = nullptr;
+    eprosima::fastdds::dds::DataWriter* writer_ = nullptr;
+    eprosima::fastdds::dds::DataReader* reader_ = nullptr;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool writer_matched_ = false;
+    bool reader_matched_ = false;
+    std::list<type> received_;
+};
+
+// Synchronous best-effort volatile KEEP_LAST(1) writers send their samples without keeping them on the history.
+TEST_P(Volatile, PubSubAsNonReliableVolatileKeepLastOneHelloworld)
+{
+    VolatileKeepLastOne<HelloWorldType> pubsub(TEST_TOPIC_NAME, !GetParam());
+
+    ASSERT_TRUE(pubsub.isInitialized());
+
+    pubsub.wait_discovery();
+
+    auto data = default_helloworld_data_generator();
+    auto expected = data;
+    pubsub.send(data, 10);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+
+    // Best-effort samples may be lost over UDP, but the ones received are the ones sent, in order
+    auto received = pubsub.block_for_at_least(GetParam() ? expected.size() : 2);
+    ASSERT_GE(received.size(), GetParam() ? expected.size() : 2u);
+    auto sent = expected.begin();
+    for (const HelloWorld& sample : received)
+    {
+        while (sent != expected.end() && sent->index() != sample.index())
+        {
+            ++sent;
+        }
+        ASSERT_NE(sent, expected.end());
+        ASSERT_EQ(sent->message(), sample.message());
+    }
+}
+
+// Samples larger than the messages of the transport are fragmented from the change owned by the DataWriter.
+TEST_P(Volatile, PubSubAsNonReliableVolatileKeepLastOneFragmented)
+{
+    VolatileKeepLastOne<Data64kbType> pubsub(TEST_TOPIC_NAME, !GetParam(), 16384);
+
+    ASSERT_TRUE(pubsub.isInitialized());
+
+    pubsub.wait_discovery();
+
+    auto data = default_data64kb_data_generator(5);
+    auto expected = data;
+    pubsub.send(data, 50);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+
+    auto received = pubsub.block_for_at_least(GetParam() ? expected.size() : 1);
+    ASSERT_GE(received.size(), GetParam() ? expected.size() : 1u);
+    for (const Data64kb& sample : received)
+    {
+        auto sent = std::find_if(expected.begin(), expected.end(), [&sample](const Data64kb& value)
+                        {
+                            return value.data() == sample.data();
+                        });
+        ASSERT_NE(sent, expected.end());
+    }
+}
+
 // Test created to check bug #3020 (Github ros2/demos #238)
 TEST_P(Volatile, PubSubAsReliableVolatilePubRemoveWithoutSubs)
 {
@@ -43,6 +43,10 @@
 #include <gtest/gtest.h>
 #include <thread>
 
+#if defined(FASTDDS_ALLOCATION_TRACER)
+#include <AllocationTracer.h>
+#endif // if defined(FASTDDS_ALLOCATION_TRACER)
+
 using eprosima::fastrtps::rtps::IPLocator;
 using eprosima::fastrtps::rtps::UDPv4TransportDescriptor;
 
@@ -265,6 +269,15 @@ public:
 
     ~PubSubWriter()
     {
+#if defined(FASTDDS_ALLOCATION_TRACER)
+        // Readers are usually destroyed after the writer, so the trace covers the reception of all samples
+        if (tracing_allocations_)
+        {
+            eprosima_profiling::AllocationTracer::stop();
+            eprosima_profiling::AllocationTracer::report(std::cout);
+        }
+#endif // if defined(FASTDDS_ALLOCATION_TRACER)
+
         if (participant_ != nullptr)
         {
             eprosima::fastrtps::Domain::removeParticipant(participant_);
@@ -337,6 +350,14 @@ public:
             {
                 default_send_print<type>(*it);
                 it = msgs.erase(it);
+#if defined(FASTDDS_ALLOCATION_TRACER)
+                // Steady state is reached once the first sample has been sent
+                if (trace_allocations_ && !tracing_allocations_)
+                {
+                    tracing_allocations_ = true;
+                    eprosima_profiling::AllocationTracer::start();
+                }
+#endif // if defined(FASTDDS_ALLOCATION_TRACER)
                 if (milliseconds > 0)
                 {
                     std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
@@ -690,6 +711,9 @@ public:
     PubSubWriter& expect_no_allocs()
     {
         // TODO(Mcc): Add no allocations check code when feature is completely ready
+#if defined(FASTDDS_ALLOCATION_TRACER)
+        trace_allocations_ = true;
+#endif // if defined(FASTDDS_ALLOCATION_TRACER)
         return *this;
     }
 
@@ -1252,6 +1276,13 @@ private:
     //! The number of times liveliness was lost
     unsigned int times_liveliness_lost_;
 
+#if defined(FASTDDS_ALLOCATION_TRACER)
+    //! Whether allocations should be traced once steady state is reached
+    bool trace_allocations_ = false;
+    //! Whether allocations are being traced
+    bool tracing_allocations_ = false;
+#endif // if defined(FASTDDS_ALLOCATION_TRACER)
+
 #if HAVE_SECURITY
     std::mutex mutexAuthentication_;
     std::condition_variable cvAuthentication_;
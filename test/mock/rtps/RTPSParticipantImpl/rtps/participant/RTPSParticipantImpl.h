@@ -32,6 +32,8 @@
 #include <fastrtps/rtps/resources/ResourceEvent.h>
 #include <fastrtps/rtps/network/NetworkFactory.h>
 #include <fastrtps/rtps/resources/AsyncWriterThread.h>
+#include <fastrtps/rtps/common/CDRMessage_t.h>
+#include <fastrtps/rtps/common/Locator.h>
 
 #if HAVE_SECURITY
 #include <fastrtps/rtps/security/accesscontrol/ParticipantSecurityAttributes.h>
@@ -39,6 +41,9 @@
 
 #include <gmock/gmock.h>
 
+#include <chrono>
+#include <vector>
+
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
@@ -198,6 +203,26 @@ public:
 
     MOCK_CONST_METHOD0(get_domain_id, uint32_t());
 
+    template<class LocatorIteratorT>
+    bool sendSync(
+            CDRMessage_t* msg,
+            const LocatorIteratorT& destination_locators_begin,
+            const LocatorIteratorT& destination_locators_end,
+            std::chrono::steady_clock::time_point& /*max_blocking_time_point*/)
+    {
+        std::vector<Locator_t> locators;
+        LocatorIteratorT it = destination_locators_begin;
+        while (it != destination_locators_end)
+        {
+            locators.push_back(*it);
+            ++it;
+        }
+
+        return send_sync_mock(std::vector<octet>(msg->buffer, msg->buffer + msg->length), locators);
+    }
+
+    MOCK_METHOD2(send_sync_mock, bool(const std::vector<octet>&, const std::vector<Locator_t>&));
+
 private:
 
     MockParticipantListener listener_;
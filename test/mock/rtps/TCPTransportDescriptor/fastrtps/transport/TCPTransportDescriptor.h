@@ -161,6 +161,7 @@ typedef struct TCPTransportDescriptor : public SocketTransportDescriptor
     bool wait_for_tcp_negotiation;
     bool calculate_crc;
     bool check_crc;
+    bool use_crc32c;
     bool apply_security;
 
     TLSConfig tls_config;
@@ -0,0 +1,141 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file BenchmarkOptions.hpp
+ *
+ * Command line parsing shared by the single executable benchmarks.
+ */
+
+#ifndef TEST_PERFORMANCE_BENCHMARKOPTIONS_HPP_
+#define TEST_PERFORMANCE_BENCHMARKOPTIONS_HPP_
+
+#include "optionparser.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+struct Arg : public option::Arg
+{
+    static void print_error(const char* msg1, const option::Option& opt, const char* msg2)
+    {
+        fprintf(stderr, "%s", msg1);
+        fwrite(opt.name, opt.namelen, 1, stderr);
+        fprintf(stderr, "%s", msg2);
+    }
+
+    static option::ArgStatus Numeric(const option::Option& option, bool msg)
+    {
+        char* endptr = 0;
+        if (option.arg != 0)
+        {
+            strtol(option.arg, &endptr, 10);
+            if (endptr != option.arg && *endptr == 0)
+            {
+                return option::ARG_OK;
+            }
+        }
+
+        if (msg)
+        {
+            print_error("Option '", option, "' requires a numeric argument\n");
+        }
+        return option::ARG_ILLEGAL;
+    }
+
+    static option::ArgStatus String(const option::Option& option, bool msg)
+    {
+        if (option.arg != 0 && option.arg[0] != 0)
+        {
+            return option::ARG_OK;
+        }
+
+        if (msg)
+        {
+            print_error("Option '", option, "' requires an argument\n");
+        }
+        return option::ARG_ILLEGAL;
+    }
+};
+
+/**
+ * Options given to a benchmark on its command line.
+ *
+ * As in the other performance tools, the usage table describes the unknown options at index 0
+ * and the help option at index 1. Parse errors and the help option are handled here.
+ */
+class BenchmarkOptions
+{
+public:
+
+    BenchmarkOptions(
+            const option::Descriptor usage[],
+            int argc,
+            char** argv)
+        : exit_code_(-1)
+    {
+        argc -= (argc > 0); argv += (argc > 0); // skip program name argv[0] if present
+        option::Stats stats(usage, argc, argv);
+        options_.resize(stats.options_max);
+        buffer_.resize(stats.buffer_max);
+        option::Parser parse(usage, argc, argv, options_.data(), buffer_.data());
+
+        if (parse.error())
+        {
+            exit_code_ = 1;
+        }
+        else if (options_.size() > 1 && options_[1])
+        {
+            option::printUsage(fwrite, stdout, usage);
+            exit_code_ = 0;
+        }
+        else
+        {
+            count_ = parse.optionsCount();
+        }
+    }
+
+    //! Whether the benchmark should run. Otherwise it should return exit_code().
+    bool parsed() const
+    {
+        return exit_code_ < 0;
+    }
+
+    int exit_code() const
+    {
+        return exit_code_;
+    }
+
+    //! Number of options given, in the order they were given.
+    int count() const
+    {
+        return count_;
+    }
+
+    const option::Option& operator [](
+            int i) const
+    {
+        return buffer_[i];
+    }
+
+private:
+
+    std::vector<option::Option> options_;
+    std::vector<option::Option> buffer_;
+    int count_ = 0;
+    int exit_code_;
+};
+
+#endif // TEST_PERFORMANCE_BENCHMARKOPTIONS_HPP_
@@ -0,0 +1,326 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_CompressionTest.cpp
+ *
+ * Measures the bytes sent on the wire, the delivery rate and the CPU time of a reliable publisher writing the same
+ * samples to a subscriber without compression and with each built-in compression codec, for several sample sizes.
+ * The publisher uses the test UDP transport, which counts the bytes of every datagram it sends.
+ */
+
+#include "../throughput/ThroughputTypes.hpp"
+
+#include "../BenchmarkOptions.hpp"
+
+#include <fastrtps/Domain.h>
+#include <fastrtps/participant/Participant.h>
+#include <fastrtps/attributes/ParticipantAttributes.h>
+#include <fastrtps/attributes/PublisherAttributes.h>
+#include <fastrtps/attributes/SubscriberAttributes.h>
+#include <fastrtps/publisher/Publisher.h>
+#include <fastrtps/subscriber/Subscriber.h>
+#include <fastrtps/subscriber/SubscriberListener.h>
+#include <fastrtps/subscriber/SampleInfo.h>
+#include <fastrtps/transport/test_UDPv4TransportDescriptor.h>
+#include <fastrtps/xmlparser/XMLProfileManager.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    SAMPLES,
+    MSG_SIZE,
+    RANDOM_OPT,
+    FORCED_DOMAIN
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT,   0, "",  "",         Arg::None,    "Usage: CompressionTest [options]\n\nOptions:" },
+    { HELP,          0, "h", "help",     Arg::None,    "  -h         --help               Produce help message." },
+    { SAMPLES,       0, "n", "samples",  Arg::Numeric, "  -n <num>,  --samples=<num>      Samples written on each run (Default: 1000)." },
+    { MSG_SIZE,      0, "s", "msg_size", Arg::Numeric, "  -s <num>,  --msg_size=<num>     Only run this size of samples in bytes (Default: 1024, 8192 and 65000)." },
+    { RANDOM_OPT,    0, "",  "random",   Arg::None,    "             --random             Fill the samples with random bytes, which do not compress." },
+    { FORCED_DOMAIN, 0, "",  "domain",   Arg::Numeric, "             --domain=<num>       Set the domain to connect (Default: 0)." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+//! Codecs measured. An empty name writes without compression.
+static const char* const codecs[] = { "", "lz" };
+
+class CountingListener : public SubscriberListener
+{
+public:
+
+    void onSubscriptionMatched(
+            Subscriber* /*sub*/,
+            MatchingInfo& info) override
+    {
+        matched_ = (info.status == MATCHED_MATCHING);
+    }
+
+    void onNewDataMessage(
+            Subscriber* sub) override
+    {
+        SampleInfo_t info;
+        while (sub->takeNextData(data_, &info))
+        {
+            ++received_;
+        }
+    }
+
+    void* data_ = nullptr;
+
+    std::atomic<bool> matched_{false};
+
+    std::atomic<uint64_t> received_{0};
+};
+
+struct RunResult
+{
+    uint64_t received = 0;
+    uint64_t wire_bytes = 0;
+    double seconds = 0;
+    double cpu_ms = 0;
+};
+
+/**
+ * Fill the data of a sample like a sequence of records of 64 bytes, where only the first bytes of each record
+ * change, or with random bytes.
+ */
+static void fill_sample(
+        ThroughputType& sample,
+        bool random)
+{
+    std::mt19937 generator(1234);
+    for (size_t i = 0; i < sample.data.size(); ++i)
+    {
+        if (random)
+        {
+            sample.data[i] = static_cast<uint8_t>(generator());
+        }
+        else
+        {
+            size_t record = i / 64;
+            size_t offset = i % 64;
+            sample.data[i] = static_cast<uint8_t>(offset < 4 ? (record >> (8 * offset)) : offset);
+        }
+    }
+}
+
+static bool run_test(
+        uint32_t domain,
+        uint32_t samples,
+        uint32_t msg_size,
+        bool random,
+        const std::string& codec,
+        RunResult& result)
+{
+    // Shared with the transport, which may outlive this function when a run fails
+    auto wire_bytes = std::make_shared<std::atomic<uint64_t>>(0);
+    auto pub_descriptor = std::make_shared<test_UDPv4TransportDescriptor>();
+    pub_descriptor->sentMessagesObserver = [wire_bytes](const Locator_t&, const octet*, uint32_t size)
+            {
+                *wire_bytes += size;
+            };
+
+    ParticipantAttributes pub_part_attr;
+    pub_part_attr.domainId = domain;
+    pub_part_attr.rtps.setName("compression_publisher");
+    pub_part_attr.rtps.useBuiltinTransports = false;
+    pub_part_attr.rtps.userTransports.push_back(pub_descriptor);
+    Participant* pub_participant = Domain::createParticipant(pub_part_attr);
+
+    ParticipantAttributes sub_part_attr;
+    sub_part_attr.domainId = domain;
+    sub_part_attr.rtps.setName("compression_subscriber");
+    Participant* sub_participant = Domain::createParticipant(sub_part_attr);
+
+    if (pub_participant == nullptr || sub_participant == nullptr)
+    {
+        return false;
+    }
+
+    ThroughputDataType pub_type(msg_size);
+    ThroughputDataType sub_type(msg_size);
+    Domain::registerType(pub_participant, &pub_type);
+    Domain::registerType(sub_participant, &sub_type);
+
+    PublisherAttributes pub_attr;
+    pub_attr.topic.topicDataType = "ThroughputType";
+    pub_attr.topic.topicName = "CompressionTopic";
+    pub_attr.topic.historyQos.kind = KEEP_ALL_HISTORY_QOS;
+    pub_attr.topic.resourceLimitsQos.max_samples = samples;
+    pub_attr.topic.resourceLimitsQos.allocated_samples = samples;
+    pub_attr.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    if (!codec.empty())
+    {
+        pub_attr.qos.representation.m_value.push_back(eprosima::fastdds::dds::COMPRESSED_XCDR_DATA_REPRESENTATION);
+        pub_attr.properties.properties().emplace_back("fastdds.compression.codec", codec);
+    }
+    Publisher* publisher = Domain::createPublisher(pub_participant, pub_attr);
+    if (publisher == nullptr)
+    {
+        return false;
+    }
+
+    SubscriberAttributes sub_attr;
+    sub_attr.topic.topicDataType = "ThroughputType";
+    sub_attr.topic.topicName = "CompressionTopic";
+    sub_attr.topic.historyQos.kind = KEEP_LAST_HISTORY_QOS;
+    sub_attr.topic.historyQos.depth = 100;
+    sub_attr.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    sub_attr.qos.representation.m_value.push_back(eprosima::fastdds::dds::XCDR_DATA_REPRESENTATION);
+    sub_attr.qos.representation.m_value.push_back(eprosima::fastdds::dds::COMPRESSED_XCDR_DATA_REPRESENTATION);
+
+    CountingListener listener;
+    listener.data_ = sub_type.createData();
+    if (Domain::createSubscriber(sub_participant, sub_attr, &listener) == nullptr)
+    {
+        return false;
+    }
+
+    // Wait for discovery
+    auto discovery_limit = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!listener.matched_ && std::chrono::steady_clock::now() < discovery_limit)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    ThroughputType sample(static_cast<uint16_t>(msg_size));
+    fill_sample(sample, random);
+
+    // Only the traffic of the samples is counted, not the one of the discovery
+    *wire_bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::clock_t cpu_start = std::clock();
+    for (uint32_t i = 0; i < samples; ++i)
+    {
+        sample.seqnum = i;
+        publisher->write(&sample);
+    }
+
+    auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (listener.received_ < samples && std::chrono::steady_clock::now() < timeout)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    result.cpu_ms = 1000.0 * (std::clock() - cpu_start) / CLOCKS_PER_SEC;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.received = listener.received_;
+    result.wire_bytes = *wire_bytes;
+
+    Domain::removeParticipant(sub_participant);
+    Domain::removeParticipant(pub_participant);
+    sub_type.deleteData(listener.data_);
+
+    return result.received >= samples;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t samples = 1000;
+    uint32_t msg_size = 0;
+    bool random = false;
+    uint32_t domain = 0;
+
+    BenchmarkOptions options(usage, argc, argv);
+    if (!options.parsed())
+    {
+        return options.exit_code();
+    }
+
+    for (int i = 0; i < options.count(); ++i)
+    {
+        const option::Option& opt = options[i];
+        switch (opt.index())
+        {
+            case SAMPLES:
+                samples = strtol(opt.arg, nullptr, 10);
+                break;
+            case MSG_SIZE:
+                msg_size = strtol(opt.arg, nullptr, 10);
+                break;
+            case RANDOM_OPT:
+                random = true;
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage);
+                return 1;
+        }
+    }
+
+    samples = samples > 0 ? samples : 1;
+
+    // The samples should travel through the transport
+    LibrarySettingsAttributes library_settings;
+    library_settings.intraprocess_delivery = INTRAPROCESS_OFF;
+    xmlparser::XMLProfileManager::library_settings(library_settings);
+
+    std::vector<uint32_t> sizes = { 1024, 8192, 65000 };
+    if (msg_size > 0)
+    {
+        sizes = { msg_size };
+    }
+
+    printf("\n");
+    printf("[     Size][    Codec][  Received][   Wire KB][ Bytes/sample][  Of plain][ Samples/s][   CPU (ms)]\n");
+    printf("[---------,----------,-----------,-----------,-------------,-----------,-----------,-----------]\n");
+
+    bool all_ok = true;
+    for (uint32_t size : sizes)
+    {
+        uint64_t plain_bytes = 0;
+        for (const char* codec : codecs)
+        {
+            RunResult result;
+            all_ok &= run_test(domain, samples, size, random, codec, result);
+            if (codec[0] == 0)
+            {
+                plain_bytes = result.wire_bytes;
+            }
+
+            double samples_per_second = result.seconds > 0 ? result.received / result.seconds : 0;
+            double of_plain = plain_bytes > 0 ? 100.0 * result.wire_bytes / plain_bytes : 0;
+            printf("%10u,%10s,%11llu,%11.1f,%13.0f,%10.1f%%,%11.0f,%11.1f\n", size, codec[0] != 0 ? codec : "none",
+                    static_cast<unsigned long long>(result.received), result.wire_bytes / 1024.0,
+                    static_cast<double>(result.wire_bytes) / samples, of_plain, samples_per_second, result.cpu_ms);
+            fflush(stdout);
+        }
+    }
+    printf("\n");
+
+    Domain::stopAll();
+
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,307 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_ConcurrentWriteTest.cpp
+ *
+ * Measures how the write rate of a participant scales with the number of threads writing at the same time.
+ * Each thread writes on its own best-effort RTPSWriter, sending to a fixed localhost locator, so the only resources
+ * the threads share are the ones of the participant, like its send buffers and sender resources.
+ * Writers can also be given a liveliness QoS, so they assert their liveliness on the participant on each write.
+ */
+
+#include "../BenchmarkOptions.hpp"
+
+#include <fastdds/rtps/RTPSDomain.h>
+#include <fastdds/rtps/attributes/HistoryAttributes.h>
+#include <fastdds/rtps/attributes/RTPSParticipantAttributes.h>
+#include <fastdds/rtps/attributes/WriterAttributes.h>
+#include <fastdds/rtps/history/WriterHistory.h>
+#include <fastdds/rtps/participant/RTPSParticipant.h>
+#include <fastdds/rtps/writer/StatelessWriter.h>
+#include <fastrtps/attributes/TopicAttributes.h>
+#include <fastrtps/qos/WriterQos.h>
+#include <fastrtps/utils/IPLocator.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+using Clock = std::chrono::steady_clock;
+
+struct LivelinessArg : public Arg
+{
+    static option::ArgStatus Liveliness(const option::Option& option, bool msg)
+    {
+        if (option.arg != 0 && (strcmp(option.arg, "automatic") == 0 || strcmp(option.arg, "participant") == 0 ||
+                strcmp(option.arg, "topic") == 0))
+        {
+            return option::ARG_OK;
+        }
+
+        if (msg)
+        {
+            print_error("Option '", option, "' requires automatic, participant or topic\n");
+        }
+        return option::ARG_ILLEGAL;
+    }
+};
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    WRITERS,
+    SECONDS,
+    BUFFERS,
+    DYNAMIC,
+    LIVELINESS,
+    PORT,
+    FORCED_DOMAIN
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT,   0, "",  "",           Arg::None,                 "Usage: ConcurrentWriteTest [options]\n\nOptions:" },
+    { HELP,          0, "h", "help",       Arg::None,                 "  -h         --help               Produce help message." },
+    { WRITERS,       0, "w", "writers",    Arg::Numeric,              "  -w <num>,  --writers=<num>      Maximum number of writing threads. Measures 1, 2, 4... up to it (Default: 8)." },
+    { SECONDS,       0, "s", "seconds",    Arg::Numeric,              "  -s <num>,  --seconds=<num>      Duration of each measure (Default: 2)." },
+    { BUFFERS,       0, "b", "buffers",    Arg::Numeric,              "  -b <num>,  --buffers=<num>      Preallocated send buffers. 0 lets the participant decide (Default: 0)." },
+    { DYNAMIC,       0, "",  "dynamic",    Arg::None,                 "             --dynamic            Allow the participant to create more send buffers." },
+    { LIVELINESS,    0, "l", "liveliness", LivelinessArg::Liveliness, "  -l <kind>, --liveliness=<kind>  Give the writers a liveliness lease of 1 second (\"automatic\"/\"participant\"/\"topic\")." },
+    { PORT,          0, "p", "port",       Arg::Numeric,              "  -p <num>,  --port=<num>         Localhost port the samples are sent to (Default: 7499)." },
+    { FORCED_DOMAIN, 0, "",  "domain",     Arg::Numeric,              "             --domain=<num>       Set the domain to connect (Default: 0)." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+static const uint32_t s_payload_size = 64;
+
+struct Writer
+{
+    std::unique_ptr<WriterHistory> history;
+    RTPSWriter* writer = nullptr;
+};
+
+/**
+ * Write on the given writers, one thread each, during the given time.
+ * @return Total samples written per second.
+ */
+static double measure(
+        std::vector<Writer>& writers,
+        size_t n_threads,
+        uint32_t seconds)
+{
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> written(0);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < n_threads; ++i)
+    {
+        Writer& writer = writers[i];
+        threads.emplace_back([&]()
+                {
+                    uint64_t count = 0;
+                    while (!stop.load(std::memory_order_relaxed))
+                    {
+                        CacheChange_t* change = writer.writer->new_change([]() -> uint32_t
+                                {
+                                    return s_payload_size;
+                                }, ALIVE);
+                        if (change == nullptr)
+                        {
+                            // Best effort, so the oldest samples can always be dropped
+                            writer.history->remove_min_change();
+                            continue;
+                        }
+
+                        memset(change->serializedPayload.data, 0, s_payload_size);
+                        change->serializedPayload.length = s_payload_size;
+                        if (writer.history->add_change(change))
+                        {
+                            ++count;
+                        }
+                    }
+                    written += count;
+                });
+    }
+
+    auto start = Clock::now();
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    stop = true;
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    return written / elapsed;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t max_writers = 8;
+    uint32_t seconds = 2;
+    uint32_t buffers = 0;
+    bool dynamic = false;
+    bool liveliness = false;
+    LivelinessQosPolicyKind liveliness_kind = AUTOMATIC_LIVELINESS_QOS;
+    uint32_t port = 7499;
+    uint32_t domain = 0;
+
+    BenchmarkOptions options(usage, argc, argv);
+    if (!options.parsed())
+    {
+        return options.exit_code();
+    }
+
+    for (int i = 0; i < options.count(); ++i)
+    {
+        const option::Option& opt = options[i];
+        switch (opt.index())
+        {
+            case WRITERS:
+                max_writers = strtol(opt.arg, nullptr, 10);
+                break;
+            case SECONDS:
+                seconds = strtol(opt.arg, nullptr, 10);
+                break;
+            case BUFFERS:
+                buffers = strtol(opt.arg, nullptr, 10);
+                break;
+            case DYNAMIC:
+                dynamic = true;
+                break;
+            case LIVELINESS:
+                liveliness = true;
+                if (strcmp(opt.arg, "participant") == 0)
+                {
+                    liveliness_kind = MANUAL_BY_PARTICIPANT_LIVELINESS_QOS;
+                }
+                else if (strcmp(opt.arg, "topic") == 0)
+                {
+                    liveliness_kind = MANUAL_BY_TOPIC_LIVELINESS_QOS;
+                }
+                break;
+            case PORT:
+                port = strtol(opt.arg, nullptr, 10);
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage);
+                return 1;
+        }
+    }
+
+    max_writers = max_writers > 0 ? max_writers : 1;
+    seconds = seconds > 0 ? seconds : 1;
+
+    RTPSParticipantAttributes pattr;
+    pattr.setName("concurrent_write_participant");
+    pattr.allocation.send_buffers.preallocated_number = buffers;
+    pattr.allocation.send_buffers.dynamic = dynamic;
+    RTPSParticipant* participant = RTPSDomain::createParticipant(domain, pattr);
+    if (participant == nullptr)
+    {
+        printf("Error creating the participant\n");
+        return 1;
+    }
+
+    Locator_t locator;
+    IPLocator::setIPv4(locator, 127, 0, 0, 1);
+    locator.port = port;
+    LocatorList_t locators;
+    locators.push_back(locator);
+
+    HistoryAttributes hattr;
+    hattr.payloadMaxSize = s_payload_size;
+    hattr.initialReservedCaches = 64;
+    hattr.maximumReservedCaches = 64;
+    WriterAttributes wattr;
+    wattr.endpoint.reliabilityKind = BEST_EFFORT;
+    WriterQos wqos;
+    wqos.m_reliability.kind = BEST_EFFORT_RELIABILITY_QOS;
+    if (liveliness)
+    {
+        wattr.liveliness_kind = liveliness_kind;
+        wattr.liveliness_lease_duration = Duration_t(1, 0);
+        wattr.liveliness_announcement_period = Duration_t(0, 500000000);
+        wqos.m_liveliness.kind = liveliness_kind;
+        wqos.m_liveliness.lease_duration = wattr.liveliness_lease_duration;
+        wqos.m_liveliness.announcement_period = wattr.liveliness_announcement_period;
+    }
+
+    std::vector<Writer> writers(max_writers);
+    for (size_t i = 0; i < writers.size(); ++i)
+    {
+        Writer& writer = writers[i];
+        writer.history.reset(new WriterHistory(hattr));
+        writer.writer = RTPSDomain::createRTPSWriter(participant, wattr, writer.history.get());
+        StatelessWriter* stateless = dynamic_cast<StatelessWriter*>(writer.writer);
+        bool created = stateless != nullptr && stateless->set_fixed_locators(locators);
+
+        if (created && liveliness)
+        {
+            // Registration adds the writer to the liveliness protocol
+            TopicAttributes tattr;
+            tattr.topicKind = NO_KEY;
+            tattr.topicDataType = "ConcurrentWriteType";
+            tattr.topicName = "ConcurrentWriteTopic" + std::to_string(i);
+            created = participant->registerWriter(writer.writer, tattr, wqos);
+        }
+
+        if (!created)
+        {
+            printf("Error creating the writers\n");
+            RTPSDomain::removeRTPSParticipant(participant);
+            return 1;
+        }
+    }
+
+    printf("\n");
+    printf("[   Threads][   Written/s][  Per thread][ Scaling]\n");
+    printf("[----------,------------,------------,--------]\n");
+
+    double single_rate = 0;
+    for (size_t n_threads = 1; n_threads <= max_writers; n_threads *= 2)
+    {
+        double rate = measure(writers, n_threads, seconds);
+        if (n_threads == 1)
+        {
+            single_rate = rate;
+        }
+        printf("%11zu,%12.0f,%12.0f,%8.2f\n", n_threads, rate, rate / n_threads,
+                single_rate > 0 ? rate / single_rate : 0.0);
+        fflush(stdout);
+    }
+    printf("\n");
+
+    bool result = single_rate > 0;
+    for (Writer& writer : writers)
+    {
+        RTPSDomain::removeRTPSWriter(writer.writer);
+    }
+    RTPSDomain::removeRTPSParticipant(participant);
+
+    return result ? 0 : 1;
+}
@@ -0,0 +1,168 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_DataEncodingTest.cpp
+ *
+ * Measures the time taken to encode the INFO_TS and DATA submessages of a sample, when they are built field by
+ * field and when they are copied from the template of the writer, for small samples.
+ */
+
+#include "../BenchmarkOptions.hpp"
+
+#include <fastdds/rtps/messages/CDRMessage.h>
+#include <fastdds/rtps/messages/RTPSMessageCreator.h>
+#include <fastdds/rtps/messages/RTPS_messages.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+
+using Clock = std::chrono::steady_clock;
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    SAMPLES,
+    MAX_SIZE
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT, 0, "",  "",         Arg::None,    "Usage: DataEncodingTest [options]\n\nOptions:" },
+    { HELP,        0, "h", "help",     Arg::None,    "  -h        --help             Produce help message." },
+    { SAMPLES,     0, "n", "samples",  Arg::Numeric, "  -n <num>, --samples=<num>    Samples encoded on each measure (Default: 1000000)." },
+    { MAX_SIZE,    0, "m", "max_size", Arg::Numeric, "  -m <num>, --max_size=<num>   Largest payload measured. Sizes go from 16 bytes, by 2 (Default: 1024)." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+/**
+ * Encode the given number of samples, with a new sequence number each, starting a new message every time the
+ * current one is full.
+ * @return Average nanoseconds per sample, 0 on error.
+ */
+template<typename Encoder>
+static double measure(
+        CacheChange_t& change,
+        uint32_t samples,
+        Encoder encode)
+{
+    CDRMessage_t msg(RTPSMESSAGE_DEFAULT_SIZE);
+
+    auto start = Clock::now();
+    for (uint32_t i = 0; i < samples; ++i)
+    {
+        ++change.sequenceNumber;
+        if (!encode(msg))
+        {
+            CDRMessage::initCDRMsg(&msg);
+            if (!encode(msg))
+            {
+                return 0;
+            }
+        }
+    }
+    auto end = Clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / samples;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t samples = 1000000;
+    uint32_t max_size = 1024;
+
+    BenchmarkOptions options(usage, argc, argv);
+    if (!options.parsed())
+    {
+        return options.exit_code();
+    }
+
+    for (int i = 0; i < options.count(); ++i)
+    {
+        const option::Option& opt = options[i];
+        switch (opt.index())
+        {
+            case SAMPLES:
+                samples = strtol(opt.arg, nullptr, 10);
+                break;
+            case MAX_SIZE:
+                max_size = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage);
+                return 1;
+        }
+    }
+
+    samples = samples > 0 ? samples : 1;
+    max_size = max_size >= 16 ? max_size : 16;
+
+    EntityId_t writer_id;
+    writer_id.value[3] = 0x02;
+    EntityId_t reader_id;
+    reader_id.value[3] = 0x07;
+
+    DataSubmessageTemplate data_template;
+    RTPSMessageCreator::initDataSubmessageTemplate(&data_template, writer_id);
+
+    CacheChange_t change;
+    change.kind = ALIVE;
+    change.writerGUID.entityId = writer_id;
+    change.sourceTimestamp = Time_t(1234, 5678u);
+
+    printf("\n");
+    printf("[     Bytes][ Submessages(ns)][ Template(ns)]\n");
+    printf("[----------,----------------,-------------]\n");
+
+    bool result = true;
+    for (uint32_t size = 16; size <= max_size; size *= 2)
+    {
+        change.serializedPayload.reserve(size);
+        memset(change.serializedPayload.data, 0, size);
+        change.serializedPayload.length = size;
+
+        double submessages = measure(change, samples, [&](CDRMessage_t& msg)
+                        {
+                            bool is_big_submessage;
+                            uint32_t position = msg.pos;
+                            if (RTPSMessageCreator::addSubmessageInfoTS(&msg, change.sourceTimestamp, false) &&
+                                    RTPSMessageCreator::addSubmessageData(&msg, &change, NO_KEY, reader_id, false,
+                                    nullptr, &is_big_submessage))
+                            {
+                                return true;
+                            }
+                            // Leave the message as it was, like the template does when there is no room
+                            msg.pos = position;
+                            msg.length = position;
+                            return false;
+                        });
+        double from_template = measure(change, samples, [&](CDRMessage_t& msg)
+                        {
+                            return RTPSMessageCreator::addSubmessagesFromDataTemplate(&msg, data_template, &change,
+                                           NO_KEY, reader_id, false, true);
+                        });
+
+        printf("%11u,%16.1f,%13.1f\n", size, submessages, from_template);
+        fflush(stdout);
+        result &= submessages > 0 && from_template > 0;
+    }
+    printf("\n");
+
+    return result ? 0 : 1;
+}
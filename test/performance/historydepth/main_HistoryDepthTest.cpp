@@ -0,0 +1,277 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_HistoryDepthTest.cpp
+ *
+ * Measures how the cost of reading and taking samples from an RTPSReader grows with the number of samples kept on
+ * its history. The history is filled, then every sample is read, so each read finds all the previous samples read
+ * but not taken, and then every sample is taken.
+ */
+
+#include "../BenchmarkOptions.hpp"
+
+#include <fastdds/rtps/RTPSDomain.h>
+#include <fastdds/rtps/attributes/HistoryAttributes.h>
+#include <fastdds/rtps/attributes/ReaderAttributes.h>
+#include <fastdds/rtps/attributes/RTPSParticipantAttributes.h>
+#include <fastdds/rtps/attributes/WriterAttributes.h>
+#include <fastdds/rtps/history/ReaderHistory.h>
+#include <fastdds/rtps/history/WriterHistory.h>
+#include <fastdds/rtps/participant/RTPSParticipant.h>
+#include <fastdds/rtps/reader/ReaderListener.h>
+#include <fastdds/rtps/reader/RTPSReader.h>
+#include <fastdds/rtps/writer/RTPSWriter.h>
+#include <fastrtps/attributes/TopicAttributes.h>
+#include <fastrtps/qos/ReaderQos.h>
+#include <fastrtps/qos/WriterQos.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+using Clock = std::chrono::steady_clock;
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    DEPTH,
+    BEST_EFFORT_OPT,
+    FORCED_DOMAIN
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT,     0, "",  "",            Arg::None,    "Usage: HistoryDepthTest [options]\n\nOptions:" },
+    { HELP,            0, "h", "help",        Arg::None,    "  -h        --help           Produce help message." },
+    { DEPTH,           0, "d", "depth",       Arg::Numeric, "  -d <num>, --depth=<num>    Maximum number of samples on the history. Measures 10, 100... up to it (Default: 10000)." },
+    { BEST_EFFORT_OPT, 0, "",  "best_effort", Arg::None,    "            --best_effort    Use best effort endpoints, so the reader is a StatelessReader." },
+    { FORCED_DOMAIN,   0, "",  "domain",      Arg::Numeric, "            --domain=<num>   Set the domain to connect (Default: 0)." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+static const uint32_t s_payload_size = 64;
+
+class MatchListener : public ReaderListener
+{
+public:
+
+    void onReaderMatched(
+            RTPSReader* /*reader*/,
+            MatchingInfo& info) override
+    {
+        if (info.status == MATCHED_MATCHING)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            matched_ = true;
+            cv_.notify_all();
+        }
+    }
+
+    bool wait(
+            std::chrono::seconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [&]()
+                       {
+                           return matched_;
+                       });
+    }
+
+private:
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool matched_ = false;
+};
+
+/**
+ * Wait until the reader has the given number of unread samples, or until no more samples arrive.
+ * @return Number of unread samples on the reader.
+ */
+static uint64_t wait_unread(
+        RTPSReader* reader,
+        uint64_t expected)
+{
+    uint64_t unread = reader->get_unread_count();
+    auto last_arrival = Clock::now();
+    while (unread < expected && Clock::now() - last_arrival < std::chrono::seconds(1))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        uint64_t current = reader->get_unread_count();
+        if (current != unread)
+        {
+            unread = current;
+            last_arrival = Clock::now();
+        }
+    }
+    return unread;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t max_depth = 10000;
+    bool best_effort = false;
+    uint32_t domain = 0;
+
+    BenchmarkOptions options(usage, argc, argv);
+    if (!options.parsed())
+    {
+        return options.exit_code();
+    }
+
+    for (int i = 0; i < options.count(); ++i)
+    {
+        const option::Option& opt = options[i];
+        switch (opt.index())
+        {
+            case DEPTH:
+                max_depth = strtol(opt.arg, nullptr, 10);
+                break;
+            case BEST_EFFORT_OPT:
+                best_effort = true;
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage);
+                return 1;
+        }
+    }
+
+    max_depth = max_depth >= 10 ? max_depth : 10;
+
+    RTPSParticipantAttributes pattr;
+    pattr.setName("history_depth_participant");
+    RTPSParticipant* participant = RTPSDomain::createParticipant(domain, pattr);
+    if (participant == nullptr)
+    {
+        printf("Error creating the participant\n");
+        return 1;
+    }
+
+    HistoryAttributes hattr;
+    hattr.payloadMaxSize = s_payload_size;
+    hattr.initialReservedCaches = static_cast<int32_t>(max_depth);
+    hattr.maximumReservedCaches = static_cast<int32_t>(max_depth);
+    WriterHistory writer_history(hattr);
+    ReaderHistory reader_history(hattr);
+    MatchListener listener;
+
+    ReliabilityKind_t reliability = best_effort ? BEST_EFFORT : RELIABLE;
+    WriterAttributes wattr;
+    wattr.endpoint.reliabilityKind = reliability;
+    ReaderAttributes rattr;
+    rattr.endpoint.reliabilityKind = reliability;
+    RTPSWriter* writer = RTPSDomain::createRTPSWriter(participant, wattr, &writer_history);
+    RTPSReader* reader = RTPSDomain::createRTPSReader(participant, rattr, &reader_history, &listener);
+
+    TopicAttributes tattr;
+    tattr.topicKind = NO_KEY;
+    tattr.topicDataType = "HistoryDepthType";
+    tattr.topicName = "HistoryDepthTopic";
+    WriterQos wqos;
+    wqos.m_reliability.kind = best_effort ? BEST_EFFORT_RELIABILITY_QOS : RELIABLE_RELIABILITY_QOS;
+    ReaderQos rqos;
+    rqos.m_reliability.kind = wqos.m_reliability.kind;
+
+    bool ready = writer != nullptr && reader != nullptr &&
+            participant->registerWriter(writer, tattr, wqos) &&
+            participant->registerReader(reader, tattr, rqos) &&
+            listener.wait(std::chrono::seconds(10));
+    if (!ready)
+    {
+        printf("Error matching the endpoints\n");
+        RTPSDomain::removeRTPSParticipant(participant);
+        return 1;
+    }
+
+    printf("\n");
+    printf("[     Depth][   Samples][  Read(us)][  Take(us)]\n");
+    printf("[----------,----------,----------,----------]\n");
+
+    bool result = true;
+    for (uint32_t depth = 10; depth <= max_depth && result; depth *= 10)
+    {
+        writer_history.remove_all_changes();
+
+        for (uint32_t i = 0; i < depth; ++i)
+        {
+            CacheChange_t* change = writer->new_change([]() -> uint32_t
+                    {
+                        return s_payload_size;
+                    }, ALIVE);
+            if (change == nullptr)
+            {
+                break;
+            }
+
+            memset(change->serializedPayload.data, 0, s_payload_size);
+            change->serializedPayload.length = s_payload_size;
+            writer_history.add_change(change);
+        }
+
+        uint64_t samples = wait_unread(reader, depth);
+        if (samples == 0)
+        {
+            printf("Error receiving the samples\n");
+            result = false;
+            break;
+        }
+
+        // Every read finds all the previous samples read and not taken
+        auto t0 = Clock::now();
+        for (uint64_t i = 0; i < samples; ++i)
+        {
+            CacheChange_t* change = nullptr;
+            WriterProxy* proxy = nullptr;
+            result &= reader->nextUnreadCache(&change, &proxy);
+        }
+        auto t1 = Clock::now();
+
+        for (uint64_t i = 0; i < samples; ++i)
+        {
+            CacheChange_t* change = nullptr;
+            WriterProxy* proxy = nullptr;
+            if (reader->nextUntakenCache(&change, &proxy))
+            {
+                reader_history.remove_change(change);
+            }
+            else
+            {
+                result = false;
+            }
+        }
+        auto t2 = Clock::now();
+
+        printf("%11u,%10llu,%10.3f,%10.3f\n", depth, static_cast<unsigned long long>(samples),
+                std::chrono::duration<double, std::micro>(t1 - t0).count() / samples,
+                std::chrono::duration<double, std::micro>(t2 - t1).count() / samples);
+        fflush(stdout);
+    }
+    printf("\n");
+
+    RTPSDomain::removeRTPSParticipant(participant);
+
+    return result ? 0 : 1;
+}
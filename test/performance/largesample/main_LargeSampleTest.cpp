@@ -0,0 +1,304 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_LargeSampleTest.cpp
+ *
+ * Measures the throughput of large samples received over UDP by an RTPSReader, when their payloads are
+ * copied into the history of the reader and when the reader keeps them on their reception buffer.
+ */
+
+#include "../BenchmarkOptions.hpp"
+
+#include <fastdds/rtps/RTPSDomain.h>
+#include <fastdds/rtps/attributes/HistoryAttributes.h>
+#include <fastdds/rtps/attributes/ReaderAttributes.h>
+#include <fastdds/rtps/attributes/RTPSParticipantAttributes.h>
+#include <fastdds/rtps/attributes/WriterAttributes.h>
+#include <fastdds/rtps/history/ReaderHistory.h>
+#include <fastdds/rtps/history/WriterHistory.h>
+#include <fastdds/rtps/participant/RTPSParticipant.h>
+#include <fastdds/rtps/reader/ReaderListener.h>
+#include <fastdds/rtps/reader/RTPSReader.h>
+#include <fastdds/rtps/transport/UDPv4TransportDescriptor.h>
+#include <fastdds/rtps/writer/RTPSWriter.h>
+#include <fastrtps/attributes/TopicAttributes.h>
+#include <fastrtps/qos/ReaderQos.h>
+#include <fastrtps/qos/WriterQos.h>
+#include <fastrtps/xmlparser/XMLProfileManager.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+using namespace eprosima::fastdds::rtps;
+
+using Clock = std::chrono::steady_clock;
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    SECONDS,
+    MAX_SIZE,
+    RELIABLE_OPT,
+    FORCED_DOMAIN
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT,   0, "",  "",         Arg::None,    "Usage: LargeSampleTest [options]\n\nOptions:" },
+    { HELP,          0, "h", "help",     Arg::None,    "  -h        --help             Produce help message." },
+    { SECONDS,       0, "s", "seconds",  Arg::Numeric, "  -s <num>, --seconds=<num>    Duration of each measure (Default: 2)." },
+    { MAX_SIZE,      0, "m", "max_size", Arg::Numeric, "  -m <num>, --max_size=<num>   Largest payload measured. Sizes go from 16384 bytes, by 2 (Default: 60000)." },
+    { RELIABLE_OPT,  0, "",  "reliable", Arg::None,    "            --reliable         Use reliable endpoints." },
+    { FORCED_DOMAIN, 0, "",  "domain",   Arg::Numeric, "            --domain=<num>     Set the domain to connect (Default: 0)." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+class MatchListener : public ReaderListener
+{
+public:
+
+    void onReaderMatched(
+            RTPSReader* /*reader*/,
+            MatchingInfo& info) override
+    {
+        if (info.status == MATCHED_MATCHING)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            matched_ = true;
+            cv_.notify_all();
+        }
+    }
+
+    bool wait(
+            std::chrono::seconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [&]()
+                       {
+                           return matched_;
+                       });
+    }
+
+private:
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool matched_ = false;
+};
+
+static RTPSParticipant* create_participant(
+        uint32_t domain,
+        const char* name,
+        uint32_t min_adopted_payload_size)
+{
+    // Large socket buffers, so the measure is not limited by the datagrams dropped by the kernel
+    auto udp_transport = std::make_shared<UDPv4TransportDescriptor>();
+    udp_transport->sendBufferSize = 8 * 1024 * 1024;
+    udp_transport->receiveBufferSize = 8 * 1024 * 1024;
+
+    RTPSParticipantAttributes pattr;
+    pattr.setName(name);
+    pattr.useBuiltinTransports = false;
+    pattr.userTransports.push_back(udp_transport);
+    pattr.allocation.shared_payloads.min_adopted_payload_size = min_adopted_payload_size;
+    return RTPSDomain::createParticipant(domain, pattr);
+}
+
+/**
+ * Write samples of the given size during the given time, taking them from a reader on another participant.
+ * @return Samples taken per second, 0 on error.
+ */
+static double measure(
+        uint32_t domain,
+        uint32_t payload_size,
+        uint32_t seconds,
+        bool reliable,
+        bool adopt)
+{
+    RTPSParticipant* writer_participant = create_participant(domain, "large_sample_writer", 0);
+    RTPSParticipant* reader_participant = create_participant(domain, "large_sample_reader",
+                    adopt ? payload_size : 0);
+    if (writer_participant == nullptr || reader_participant == nullptr)
+    {
+        printf("Error creating the participants\n");
+        return 0;
+    }
+
+    HistoryAttributes hattr;
+    hattr.payloadMaxSize = payload_size;
+    hattr.initialReservedCaches = 64;
+    hattr.maximumReservedCaches = 64;
+    WriterHistory writer_history(hattr);
+    ReaderHistory reader_history(hattr);
+    MatchListener listener;
+
+    ReliabilityKind_t reliability = reliable ? RELIABLE : BEST_EFFORT;
+    WriterAttributes wattr;
+    wattr.endpoint.reliabilityKind = reliability;
+    ReaderAttributes rattr;
+    rattr.endpoint.reliabilityKind = reliability;
+    RTPSWriter* writer = RTPSDomain::createRTPSWriter(writer_participant, wattr, &writer_history);
+    RTPSReader* reader = RTPSDomain::createRTPSReader(reader_participant, rattr, &reader_history, &listener);
+
+    TopicAttributes tattr;
+    tattr.topicKind = NO_KEY;
+    tattr.topicDataType = "LargeSampleType";
+    tattr.topicName = "LargeSampleTopic";
+    WriterQos wqos;
+    wqos.m_reliability.kind = reliable ? RELIABLE_RELIABILITY_QOS : BEST_EFFORT_RELIABILITY_QOS;
+    ReaderQos rqos;
+    rqos.m_reliability.kind = wqos.m_reliability.kind;
+
+    double rate = 0;
+    bool ready = writer != nullptr && reader != nullptr &&
+            writer_participant->registerWriter(writer, tattr, wqos) &&
+            reader_participant->registerReader(reader, tattr, rqos) &&
+            listener.wait(std::chrono::seconds(10));
+    if (ready)
+    {
+        std::atomic<bool> stop(false);
+        uint64_t taken = 0;
+
+        std::thread taker([&]()
+                {
+                    while (!stop.load(std::memory_order_relaxed))
+                    {
+                        CacheChange_t* change = nullptr;
+                        WriterProxy* proxy = nullptr;
+                        if (reader->nextUntakenCache(&change, &proxy))
+                        {
+                            reader_history.remove_change(change);
+                            ++taken;
+                        }
+                        else
+                        {
+                            reader->wait_for_unread_cache(Duration_t(0, 1000000));
+                        }
+                    }
+                });
+
+        auto start = Clock::now();
+        auto end = start + std::chrono::seconds(seconds);
+        while (Clock::now() < end)
+        {
+            CacheChange_t* change = writer->new_change([payload_size]() -> uint32_t
+                    {
+                        return payload_size;
+                    }, ALIVE);
+            if (change == nullptr)
+            {
+                writer_history.remove_min_change();
+                continue;
+            }
+
+            memset(change->serializedPayload.data, 0, payload_size);
+            change->serializedPayload.length = payload_size;
+            writer_history.add_change(change);
+        }
+
+        stop = true;
+        taker.join();
+        rate = taken / std::chrono::duration<double>(Clock::now() - start).count();
+    }
+    else
+    {
+        printf("Error matching the endpoints\n");
+    }
+
+    RTPSDomain::removeRTPSParticipant(reader_participant);
+    RTPSDomain::removeRTPSParticipant(writer_participant);
+
+    return rate;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t seconds = 2;
+    uint32_t max_size = 60000;
+    bool reliable = false;
+    uint32_t domain = 0;
+
+    BenchmarkOptions options(usage, argc, argv);
+    if (!options.parsed())
+    {
+        return options.exit_code();
+    }
+
+    for (int i = 0; i < options.count(); ++i)
+    {
+        const option::Option& opt = options[i];
+        switch (opt.index())
+        {
+            case SECONDS:
+                seconds = strtol(opt.arg, nullptr, 10);
+                break;
+            case MAX_SIZE:
+                max_size = strtol(opt.arg, nullptr, 10);
+                break;
+            case RELIABLE_OPT:
+                reliable = true;
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage);
+                return 1;
+        }
+    }
+
+    seconds = seconds > 0 ? seconds : 1;
+    max_size = max_size >= 16384 ? max_size : 16384;
+
+    // The samples should travel through the transport
+    LibrarySettingsAttributes library_settings;
+    library_settings.intraprocess_delivery = INTRAPROCESS_OFF;
+    xmlparser::XMLProfileManager::library_settings(library_settings);
+
+    std::vector<uint32_t> sizes;
+    for (uint32_t size = 16384; size < max_size; size *= 2)
+    {
+        sizes.push_back(size);
+    }
+    sizes.push_back(max_size);
+
+    printf("\n");
+    printf("[     Bytes][  Copied/s][ Copied MB/s][ Adopted/s][Adopted MB/s]\n");
+    printf("[----------,----------,------------,----------,------------]\n");
+
+    bool result = true;
+    for (uint32_t size : sizes)
+    {
+        double copied = measure(domain, size, seconds, reliable, false);
+        double adopted = measure(domain, size, seconds, reliable, true);
+        printf("%11u,%10.0f,%12.1f,%10.0f,%12.1f\n", size,
+                copied, copied * size / (1024 * 1024), adopted, adopted * size / (1024 * 1024));
+        fflush(stdout);
+        result &= copied > 0 && adopted > 0;
+    }
+    printf("\n");
+
+    return result ? 0 : 1;
+}
@@ -0,0 +1,256 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_LateJoinerTest.cpp
+ *
+ * Measures the time a late-joining TRANSIENT_LOCAL reader takes to receive the whole history of a writer,
+ * with and without the historical replay of the writer enabled.
+ */
+
+#include "../throughput/ThroughputTypes.hpp"
+
+#include "../BenchmarkOptions.hpp"
+
+#include <fastrtps/Domain.h>
+#include <fastrtps/participant/Participant.h>
+#include <fastrtps/attributes/ParticipantAttributes.h>
+#include <fastrtps/attributes/PublisherAttributes.h>
+#include <fastrtps/attributes/SubscriberAttributes.h>
+#include <fastrtps/publisher/Publisher.h>
+#include <fastrtps/subscriber/Subscriber.h>
+#include <fastrtps/subscriber/SubscriberListener.h>
+#include <fastrtps/subscriber/SampleInfo.h>
+#include <fastrtps/xmlparser/XMLProfileManager.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    SAMPLES,
+    MSG_SIZE,
+    REPLAY_BATCH,
+    REPLAY_PERIOD,
+    FORCED_DOMAIN
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT,   0, "",  "",              Arg::None,    "Usage: LateJoinerTest [options]\n\nOptions:" },
+    { HELP,          0, "h", "help",          Arg::None,    "  -h         --help                 Produce help message." },
+    { SAMPLES,       0, "n", "samples",       Arg::Numeric, "  -n <num>,  --samples=<num>        Number of samples on the history (Default: 20000)." },
+    { MSG_SIZE,      0, "s", "msg_size",      Arg::Numeric, "  -s <num>,  --msg_size=<num>       Size of the samples in bytes (Default: 256)." },
+    { REPLAY_BATCH,  0, "",  "replay_batch",  Arg::Numeric, "             --replay_batch=<num>   Samples replayed per period (Default: 1000)." },
+    { REPLAY_PERIOD, 0, "",  "replay_period", Arg::Numeric, "             --replay_period=<num>  Replay period in milliseconds (Default: 10)." },
+    { FORCED_DOMAIN, 0, "",  "domain",        Arg::Numeric, "             --domain=<num>         Set the domain to connect (Default: 0)." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+class LateJoinerListener : public SubscriberListener
+{
+public:
+
+    explicit LateJoinerListener(
+            uint32_t expected)
+        : expected_(expected)
+        , received_(0)
+    {
+    }
+
+    void onNewDataMessage(
+            Subscriber* sub) override
+    {
+        SampleInfo_t info;
+        while (sub->takeNextData(data_, &info))
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (++received_ == expected_)
+            {
+                cv_.notify_one();
+            }
+        }
+    }
+
+    bool wait(
+            std::chrono::seconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [this]()
+                       {
+                           return received_ >= expected_;
+                       });
+    }
+
+    void* data_ = nullptr;
+
+private:
+
+    uint32_t expected_;
+    uint32_t received_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+static bool run_test(
+        uint32_t domain,
+        uint32_t samples,
+        uint32_t msg_size,
+        uint32_t replay_batch,
+        uint32_t replay_period_ms,
+        double& catch_up_time_ms)
+{
+    ParticipantAttributes pub_part_attr;
+    pub_part_attr.domainId = domain;
+    pub_part_attr.rtps.setName("late_joiner_publisher");
+    Participant* pub_participant = Domain::createParticipant(pub_part_attr);
+
+    ParticipantAttributes sub_part_attr;
+    sub_part_attr.domainId = domain;
+    sub_part_attr.rtps.setName("late_joiner_subscriber");
+    Participant* sub_participant = Domain::createParticipant(sub_part_attr);
+
+    if (pub_participant == nullptr || sub_participant == nullptr)
+    {
+        return false;
+    }
+
+    ThroughputDataType pub_type(msg_size);
+    ThroughputDataType sub_type(msg_size);
+    Domain::registerType(pub_participant, &pub_type);
+    Domain::registerType(sub_participant, &sub_type);
+
+    PublisherAttributes pub_attr;
+    pub_attr.topic.topicDataType = "ThroughputType";
+    pub_attr.topic.topicName = "LateJoinerTopic";
+    pub_attr.topic.historyQos.kind = KEEP_ALL_HISTORY_QOS;
+    pub_attr.topic.resourceLimitsQos.max_samples = static_cast<int32_t>(samples);
+    pub_attr.topic.resourceLimitsQos.allocated_samples = static_cast<int32_t>(samples);
+    pub_attr.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    pub_attr.qos.m_durability.kind = TRANSIENT_LOCAL_DURABILITY_QOS;
+    if (replay_batch > 0)
+    {
+        pub_attr.properties.properties().emplace_back("fastdds.historical_replay.samples_per_period",
+                std::to_string(replay_batch));
+        pub_attr.properties.properties().emplace_back("fastdds.historical_replay.period_ms",
+                std::to_string(replay_period_ms));
+    }
+    Publisher* publisher = Domain::createPublisher(pub_participant, pub_attr);
+    if (publisher == nullptr)
+    {
+        return false;
+    }
+
+    // Fill the history before the reader is created
+    ThroughputType sample(static_cast<uint16_t>(msg_size));
+    for (uint32_t i = 0; i < samples; ++i)
+    {
+        sample.seqnum = i;
+        publisher->write(&sample);
+    }
+
+    SubscriberAttributes sub_attr;
+    sub_attr.topic.topicDataType = "ThroughputType";
+    sub_attr.topic.topicName = "LateJoinerTopic";
+    sub_attr.topic.historyQos.kind = KEEP_ALL_HISTORY_QOS;
+    sub_attr.topic.resourceLimitsQos.max_samples = static_cast<int32_t>(samples);
+    sub_attr.topic.resourceLimitsQos.allocated_samples = static_cast<int32_t>(samples);
+    sub_attr.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    sub_attr.qos.m_durability.kind = TRANSIENT_LOCAL_DURABILITY_QOS;
+
+    LateJoinerListener listener(samples);
+    listener.data_ = sub_type.createData();
+
+    auto start = std::chrono::steady_clock::now();
+    Subscriber* subscriber = Domain::createSubscriber(sub_participant, sub_attr, &listener);
+    bool received_all = (subscriber != nullptr) && listener.wait(std::chrono::seconds(300));
+    auto end = std::chrono::steady_clock::now();
+    catch_up_time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    Domain::removeParticipant(sub_participant);
+    Domain::removeParticipant(pub_participant);
+    sub_type.deleteData(listener.data_);
+
+    return received_all;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t samples = 20000;
+    uint32_t msg_size = 256;
+    uint32_t replay_batch = 1000;
+    uint32_t replay_period_ms = 10;
+    uint32_t domain = 0;
+
+    BenchmarkOptions options(usage, argc, argv);
+    if (!options.parsed())
+    {
+        return options.exit_code();
+    }
+
+    for (int i = 0; i < options.count(); ++i)
+    {
+        const option::Option& opt = options[i];
+        switch (opt.index())
+        {
+            case SAMPLES:
+                samples = strtol(opt.arg, nullptr, 10);
+                break;
+            case MSG_SIZE:
+                msg_size = strtol(opt.arg, nullptr, 10);
+                break;
+            case REPLAY_BATCH:
+                replay_batch = strtol(opt.arg, nullptr, 10);
+                break;
+            case REPLAY_PERIOD:
+                replay_period_ms = strtol(opt.arg, nullptr, 10);
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage);
+                return 1;
+        }
+    }
+
+    // Force the history to travel through the transport
+    LibrarySettingsAttributes library_settings;
+    library_settings.intraprocess_delivery = INTRAPROCESS_OFF;
+    xmlparser::XMLProfileManager::library_settings(library_settings);
+
+    double requested_ms = 0;
+    double replayed_ms = 0;
+    bool requested_ok = run_test(domain, samples, msg_size, 0, replay_period_ms, requested_ms);
+    bool replayed_ok = run_test(domain, samples, msg_size, replay_batch, replay_period_ms, replayed_ms);
+
+    printf("\n");
+    printf("[ Samples,  Bytes][  Requested (ms)][   Replayed (ms)]\n");
+    printf("[--------,-------][----------------][----------------]\n");
+    printf("%9u,%7u,%17.1f,%17.1f\n", samples, msg_size, requested_ms, replayed_ms);
+    printf("\n");
+    fflush(stdout);
+
+    Domain::stopAll();
+
+    return (requested_ok && replayed_ok) ? 0 : 1;
+}
@@ -28,6 +28,10 @@
 #include <fastrtps/fastrtps_dll.h>
 #include <fastrtps/xmlparser/XMLProfileManager.h>
 
+#ifdef FASTDDS_LOCK_PROFILER
+#include "LockProfiler.h"
+#endif // ifdef FASTDDS_LOCK_PROFILER
+
 #if defined(_MSC_VER)
 #pragma warning (push)
 #pragma warning (disable:4512)
@@ -137,7 +141,8 @@ enum  optionIndex
     LARGE_DATA,
     XML_FILE,
     DYNAMIC_TYPES,
-    FORCED_DOMAIN
+    FORCED_DOMAIN,
+    LOCK_PROFILE
 };
 
 enum TestAgent
@@ -161,6 +166,9 @@ const option::Descriptor usage[] = {
 #if HAVE_SECURITY
     { USE_SECURITY,    0, "",  "security",        Arg::Required, "               --security <arg>      Echo mode (\"true\"/\"false\")." },
     { CERTS_PATH,      0, "",  "certs",           Arg::Required, "               --certs <arg>         Path where located certificates." },
+#endif
+#ifdef FASTDDS_LOCK_PROFILER
+    { LOCK_PROFILE,    0, "",  "lock_profile",    Arg::None,     "               --lock_profile        Print the most contended mutexes at exit." },
 #endif
     { UNKNOWN_OPT,     0, "",  "",                Arg::None,     "\nPublisher/Both options:"},
     { SUBSCRIBERS,     0, "n", "subscribers",     Arg::Numeric,  "  -n <num>,    --subscribers=<arg>   Number of subscribers." },
@@ -212,6 +220,7 @@ int main(
     std::string xml_config_file = "";
     bool dynamic_types = false;
     int forced_domain = -1;
+    bool lock_profile = false;
 
     argc -= (argc > 0);
     argv += (argc > 0); // skip program name argv[0] if present
@@ -365,6 +374,9 @@ int main(
                 certs_path = opt.arg;
                 break;
 #endif
+            case LOCK_PROFILE:
+                lock_profile = true;
+                break;
             case UNKNOWN_OPT:
                 option::printUsage(fwrite, stdout, usage, columns);
                 return 0;
@@ -372,6 +384,16 @@ int main(
         }
     }
 
+#ifdef FASTDDS_LOCK_PROFILER
+    if (lock_profile)
+    {
+        eprosima_profiling::LockProfiler::start();
+        eprosima_profiling::LockProfiler::report_at_exit();
+    }
+#else
+    static_cast<void>(lock_profile);
+#endif // ifdef FASTDDS_LOCK_PROFILER
+
     PropertyPolicy pub_part_property_policy;
     PropertyPolicy sub_part_property_policy;
     PropertyPolicy pub_property_policy;
@@ -0,0 +1,291 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_ManyWritersTest.cpp
+ *
+ * Measures the rate a single reliable RTPSReader receives samples at when it is matched with many writers, as a
+ * logger subscribed to a topic written by every node would be. Writers are added in steps of 1, 10, 100... and on
+ * each step all of them write in turns, so every message received has to be routed to a different writer proxy.
+ */
+
+#include "../BenchmarkOptions.hpp"
+
+#include <fastdds/rtps/RTPSDomain.h>
+#include <fastdds/rtps/attributes/HistoryAttributes.h>
+#include <fastdds/rtps/attributes/ReaderAttributes.h>
+#include <fastdds/rtps/attributes/RTPSParticipantAttributes.h>
+#include <fastdds/rtps/attributes/WriterAttributes.h>
+#include <fastdds/rtps/history/ReaderHistory.h>
+#include <fastdds/rtps/history/WriterHistory.h>
+#include <fastdds/rtps/participant/RTPSParticipant.h>
+#include <fastdds/rtps/reader/ReaderListener.h>
+#include <fastdds/rtps/reader/RTPSReader.h>
+#include <fastdds/rtps/writer/RTPSWriter.h>
+#include <fastrtps/attributes/TopicAttributes.h>
+#include <fastrtps/qos/ReaderQos.h>
+#include <fastrtps/qos/WriterQos.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+using Clock = std::chrono::steady_clock;
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    WRITERS,
+    SECONDS,
+    FORCED_DOMAIN
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT,   0, "",  "",        Arg::None,    "Usage: ManyWritersTest [options]\n\nOptions:" },
+    { HELP,          0, "h", "help",    Arg::None,    "  -h         --help            Produce help message." },
+    { WRITERS,       0, "w", "writers", Arg::Numeric, "  -w <num>,  --writers=<num>   Maximum number of writers. Measures 1, 10, 100... up to it (Default: 500)." },
+    { SECONDS,       0, "s", "seconds", Arg::Numeric, "  -s <num>,  --seconds=<num>   Duration of each measure (Default: 2)." },
+    { FORCED_DOMAIN, 0, "",  "domain",  Arg::Numeric, "             --domain=<num>    Set the domain to connect (Default: 0)." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+static const uint32_t s_payload_size = 64;
+
+class MatchListener : public ReaderListener
+{
+public:
+
+    void onReaderMatched(
+            RTPSReader* /*reader*/,
+            MatchingInfo& info) override
+    {
+        if (info.status == MATCHED_MATCHING)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++matched_;
+            cv_.notify_all();
+        }
+    }
+
+    bool wait(
+            size_t matched,
+            std::chrono::seconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [&]()
+                       {
+                           return matched_ >= matched;
+                       });
+    }
+
+private:
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    size_t matched_ = 0;
+};
+
+struct Writer
+{
+    std::unique_ptr<WriterHistory> history;
+    RTPSWriter* writer = nullptr;
+};
+
+/**
+ * Write on all the writers in turns while taking from the reader, during the given time.
+ * @return Samples taken per second.
+ */
+static double measure(
+        std::vector<Writer>& writers,
+        RTPSReader* reader,
+        ReaderHistory& reader_history,
+        uint32_t seconds)
+{
+    std::atomic<bool> stop(false);
+    uint64_t taken = 0;
+
+    std::thread taker([&]()
+            {
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    CacheChange_t* change = nullptr;
+                    WriterProxy* proxy = nullptr;
+                    if (reader->nextUntakenCache(&change, &proxy))
+                    {
+                        reader_history.remove_change(change);
+                        ++taken;
+                    }
+                    else
+                    {
+                        reader->wait_for_unread_cache(Duration_t(0, 1000000));
+                    }
+                }
+            });
+
+    auto start = Clock::now();
+    auto end = start + std::chrono::seconds(seconds);
+    while (Clock::now() < end)
+    {
+        for (Writer& writer : writers)
+        {
+            CacheChange_t* change = writer.writer->new_change([]() -> uint32_t
+                    {
+                        return s_payload_size;
+                    }, ALIVE);
+            if (change == nullptr)
+            {
+                writer.history->remove_min_change();
+                continue;
+            }
+
+            memset(change->serializedPayload.data, 0, s_payload_size);
+            change->serializedPayload.length = s_payload_size;
+            writer.history->add_change(change);
+        }
+    }
+
+    stop = true;
+    taker.join();
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    return taken / elapsed;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t max_writers = 500;
+    uint32_t seconds = 2;
+    uint32_t domain = 0;
+
+    BenchmarkOptions options(usage, argc, argv);
+    if (!options.parsed())
+    {
+        return options.exit_code();
+    }
+
+    for (int i = 0; i < options.count(); ++i)
+    {
+        const option::Option& opt = options[i];
+        switch (opt.index())
+        {
+            case WRITERS:
+                max_writers = strtol(opt.arg, nullptr, 10);
+                break;
+            case SECONDS:
+                seconds = strtol(opt.arg, nullptr, 10);
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage);
+                return 1;
+        }
+    }
+
+    max_writers = max_writers > 0 ? max_writers : 1;
+    seconds = seconds > 0 ? seconds : 1;
+
+    RTPSParticipantAttributes pattr;
+    pattr.setName("many_writers_participant");
+    RTPSParticipant* participant = RTPSDomain::createParticipant(domain, pattr);
+    if (participant == nullptr)
+    {
+        printf("Error creating the participant\n");
+        return 1;
+    }
+
+    HistoryAttributes hattr;
+    hattr.payloadMaxSize = s_payload_size;
+    hattr.initialReservedCaches = 16;
+    hattr.maximumReservedCaches = 16;
+    HistoryAttributes reader_hattr = hattr;
+    reader_hattr.initialReservedCaches = 1024;
+    reader_hattr.maximumReservedCaches = 1024;
+    ReaderHistory reader_history(reader_hattr);
+    MatchListener listener;
+
+    TopicAttributes tattr;
+    tattr.topicKind = NO_KEY;
+    tattr.topicDataType = "ManyWritersType";
+    tattr.topicName = "ManyWritersTopic";
+    WriterQos wqos;
+    wqos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    ReaderQos rqos;
+    rqos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+
+    ReaderAttributes rattr;
+    rattr.endpoint.reliabilityKind = RELIABLE;
+    rattr.matched_writers_allocation.maximum = max_writers;
+    RTPSReader* reader = RTPSDomain::createRTPSReader(participant, rattr, &reader_history, &listener);
+    if (reader == nullptr || !participant->registerReader(reader, tattr, rqos))
+    {
+        printf("Error creating the reader\n");
+        RTPSDomain::removeRTPSParticipant(participant);
+        return 1;
+    }
+
+    WriterAttributes wattr;
+    wattr.endpoint.reliabilityKind = RELIABLE;
+
+    printf("\n");
+    printf("[   Writers][  Received/s]\n");
+    printf("[----------,------------]\n");
+
+    bool result = true;
+    std::vector<Writer> writers;
+    for (uint32_t n_writers = 1; n_writers <= max_writers && result; n_writers *= 10)
+    {
+        while (writers.size() < n_writers)
+        {
+            Writer writer;
+            writer.history.reset(new WriterHistory(hattr));
+            writer.writer = RTPSDomain::createRTPSWriter(participant, wattr, writer.history.get());
+            if (writer.writer == nullptr || !participant->registerWriter(writer.writer, tattr, wqos))
+            {
+                result = false;
+                break;
+            }
+            writers.push_back(std::move(writer));
+        }
+
+        if (!result || !listener.wait(writers.size(), std::chrono::seconds(30)))
+        {
+            printf("Error matching the writers\n");
+            result = false;
+            break;
+        }
+
+        double rate = measure(writers, reader, reader_history, seconds);
+        printf("%11zu,%12.0f\n", writers.size(), rate);
+        fflush(stdout);
+        result = rate > 0;
+    }
+    printf("\n");
+
+    RTPSDomain::removeRTPSParticipant(participant);
+
+    return result ? 0 : 1;
+}
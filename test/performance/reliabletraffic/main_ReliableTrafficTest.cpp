@@ -0,0 +1,572 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_ReliableTrafficTest.cpp
+ *
+ * Measures the datagrams sent while several reliable RTPSWriters of a participant deliver their samples to the
+ * matched RTPSReaders of other participants. Every participant uses the test UDP transport, which counts every
+ * datagram sent, the ones carrying HEARTBEAT, ACKNACK, GAP, NACK_FRAG or HEARTBEAT_FRAG submessages, and the bytes
+ * of the DATA and DATA_FRAG submessages sent again to the same destination, which are the repairs.
+ * The same traffic is measured with and without the aggregation of control messages of the participants, and
+ * without losses and with the test transport of the writing participant dropping a percentage of the samples.
+ * Asynchronous writers can also be measured without and with AIMD congestion control, comparing their goodput.
+ */
+
+#include "../BenchmarkOptions.hpp"
+
+#include <fastdds/rtps/RTPSDomain.h>
+#include <fastdds/rtps/attributes/HistoryAttributes.h>
+#include <fastdds/rtps/attributes/ReaderAttributes.h>
+#include <fastdds/rtps/attributes/RTPSParticipantAttributes.h>
+#include <fastdds/rtps/attributes/WriterAttributes.h>
+#include <fastdds/rtps/common/CDRMessage_t.h>
+#include <fastdds/rtps/history/ReaderHistory.h>
+#include <fastdds/rtps/history/WriterHistory.h>
+#include <fastdds/rtps/messages/RTPS_messages.h>
+#include <fastdds/rtps/participant/RTPSParticipant.h>
+#include <fastdds/rtps/reader/ReaderListener.h>
+#include <fastdds/rtps/reader/RTPSReader.h>
+#include <fastdds/rtps/transport/test_UDPv4TransportDescriptor.h>
+#include <fastdds/rtps/writer/RTPSWriter.h>
+#include <fastrtps/attributes/TopicAttributes.h>
+#include <fastrtps/qos/ReaderQos.h>
+#include <fastrtps/qos/WriterQos.h>
+#include <fastrtps/xmlparser/XMLProfileManager.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+using namespace eprosima::fastdds::rtps;
+
+using Clock = std::chrono::steady_clock;
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    WRITERS,
+    READERS,
+    SAMPLES,
+    RATE,
+    SIZE,
+    PERIOD,
+    LOSS,
+    CONGESTION,
+    FORCED_DOMAIN
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT,   0, "",  "",           Arg::None,    "Usage: ReliableTrafficTest [options]\n\nOptions:" },
+    { HELP,          0, "h", "help",       Arg::None,    "  -h        --help            Produce help message." },
+    { WRITERS,       0, "w", "writers",    Arg::Numeric, "  -w <num>, --writers=<num>   Writers on the writing participant, each one with its own topic (Default: 8)." },
+    { READERS,       0, "p", "readers",    Arg::Numeric, "  -p <num>, --readers=<num>   Reading participants, each one with a reader for every writer (Default: 2)." },
+    { SAMPLES,       0, "n", "samples",    Arg::Numeric, "  -n <num>, --samples=<num>   Samples written by each writer (Default: 2000)." },
+    { RATE,          0, "r", "rate",       Arg::Numeric, "  -r <num>, --rate=<num>      Samples per second written by each writer. 0 writes as fast as possible (Default: 1000)." },
+    { SIZE,          0, "z", "size",       Arg::Numeric, "  -z <num>, --size=<num>      Size of the samples (Default: 1024)." },
+    { PERIOD,        0, "",  "period",     Arg::Numeric, "            --period=<num>    Aggregation period of the control messages in microseconds (Default: 1000)." },
+    { LOSS,          0, "l", "loss",       Arg::Numeric, "  -l <num>, --loss=<num>      Percentage of the samples dropped on the lossy runs. 0 skips them (Default: 10)." },
+    { CONGESTION,    0, "c", "congestion", Arg::None,    "  -c        --congestion      Also run asynchronous writers, without and with AIMD congestion control." },
+    { FORCED_DOMAIN, 0, "",  "domain",     Arg::Numeric, "            --domain=<num>    Set the domain to connect (Default: 0)." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+static const struct WriterKind
+{
+    const char* name;
+    bool asynchronous;
+    bool congestion_control;
+} writer_kinds[] = {
+    { "sync", false, false },
+    { "async", true, false },
+    { "aimd", true, true }
+};
+
+struct Measure
+{
+    double seconds = 0;
+    uint64_t datagrams = 0;
+    uint64_t bytes = 0;
+    uint64_t control_datagrams = 0;
+    uint64_t control_submessages = 0;
+    uint64_t repair_bytes = 0;
+    //! Payload bytes received per second by each reader
+    double goodput = 0;
+};
+
+//! Datagrams sent by the participants of a measure, as seen by their test transports
+class TrafficCounter
+{
+public:
+
+    void count(
+            const Locator_t& destination,
+            const octet* buffer,
+            uint32_t size)
+    {
+        if (size < RTPSMESSAGE_HEADER_SIZE || memcmp(buffer, "RTPS", 4) != 0)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint32_t control = 0;
+        uint32_t pos = RTPSMESSAGE_HEADER_SIZE;
+        while (pos + RTPSMESSAGE_SUBMESSAGEHEADER_SIZE <= size)
+        {
+            octet id = buffer[pos];
+            bool little_endian = (buffer[pos + 1] & 0x01) != 0;
+            uint32_t length = little_endian ?
+                    (buffer[pos + 2] | (buffer[pos + 3] << 8)) : ((buffer[pos + 2] << 8) | buffer[pos + 3]);
+            pos += RTPSMESSAGE_SUBMESSAGEHEADER_SIZE;
+            if (length == 0 && id != INFO_TS && id != PAD)
+            {
+                // The last submessage takes the rest of the datagram
+                length = size - pos;
+            }
+
+            if (id == HEARTBEAT || id == ACKNACK || id == GAP || id == NACK_FRAG || id == HEARTBEAT_FRAG)
+            {
+                ++control;
+            }
+            else if ((id == DATA || id == DATA_FRAG) && length >= data_key_length && pos + length <= size)
+            {
+                count_data(destination, buffer + pos, id == DATA_FRAG, length);
+            }
+            pos += length;
+        }
+
+        ++counted_.datagrams;
+        counted_.bytes += size;
+        if (control > 0)
+        {
+            ++counted_.control_datagrams;
+            counted_.control_submessages += control;
+        }
+    }
+
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        counted_ = Measure();
+        sent_.clear();
+    }
+
+    void get(
+            Measure& result)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        result.datagrams = counted_.datagrams;
+        result.bytes = counted_.bytes;
+        result.control_datagrams = counted_.control_datagrams;
+        result.control_submessages = counted_.control_submessages;
+        result.repair_bytes = counted_.repair_bytes;
+    }
+
+private:
+
+    //! Flags, octetsToInlineQos and readerId, followed by writerId, writerSN and fragmentStartingNum
+    static constexpr uint32_t data_key_offset = 8;
+    static constexpr uint32_t data_key_length = data_key_offset + 16;
+
+    void count_data(
+            const Locator_t& destination,
+            const octet* submessage,
+            bool fragment,
+            uint32_t length)
+    {
+        // Builtin writers are left out, so only the samples of the measure are counted
+        const octet* writer_id = submessage + data_key_offset;
+        if ((writer_id[3] & 0xC0) == 0xC0)
+        {
+            return;
+        }
+
+        // The readerId is not part of the key, as repairs may be addressed to a single reader
+        std::string key(reinterpret_cast<const char*>(destination.address), sizeof(destination.address));
+        key.append(reinterpret_cast<const char*>(&destination.port), sizeof(destination.port));
+        key.append(reinterpret_cast<const char*>(writer_id), fragment ? 16 : 12);
+        if (!sent_.insert(key).second)
+        {
+            counted_.repair_bytes += RTPSMESSAGE_SUBMESSAGEHEADER_SIZE + length;
+        }
+    }
+
+    std::mutex mutex_;
+    Measure counted_;
+    //! Destination, writer, sequence number and fragment of every DATA and DATA_FRAG sent
+    std::unordered_set<std::string> sent_;
+};
+
+class MatchListener : public ReaderListener
+{
+public:
+
+    void onReaderMatched(
+            RTPSReader* /*reader*/,
+            MatchingInfo& info) override
+    {
+        if (info.status == MATCHED_MATCHING)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++matched_;
+            cv_.notify_all();
+        }
+    }
+
+    bool wait(
+            uint32_t readers,
+            std::chrono::seconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [&]()
+                       {
+                           return matched_ >= readers;
+                       });
+    }
+
+private:
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    uint32_t matched_ = 0;
+};
+
+static RTPSParticipant* create_participant(
+        uint32_t domain,
+        const char* name,
+        uint32_t aggregation_us,
+        uint8_t loss,
+        TrafficCounter& counter)
+{
+    // Large socket buffers, so the only datagrams lost on the loopback are the ones dropped by the test transport
+    auto transport = std::make_shared<test_UDPv4TransportDescriptor>();
+    transport->sendBufferSize = 8 * 1024 * 1024;
+    transport->receiveBufferSize = 8 * 1024 * 1024;
+    transport->dropDataMessagesPercentage = loss;
+    transport->dropDataFragMessagesPercentage = loss;
+    transport->sentMessagesObserver = [&counter](const Locator_t& destination, const octet* buffer, uint32_t size)
+            {
+                counter.count(destination, buffer, size);
+            };
+
+    RTPSParticipantAttributes pattr;
+    pattr.setName(name);
+    pattr.useBuiltinTransports = false;
+    pattr.userTransports.push_back(transport);
+    if (aggregation_us > 0)
+    {
+        pattr.properties.properties().emplace_back("fastdds.control_messages.aggregation_period_us",
+                std::to_string(aggregation_us));
+    }
+    return RTPSDomain::createParticipant(domain, pattr);
+}
+
+/**
+ * Write the given samples on each writer, and count the datagrams sent until all of them are received.
+ * @return false on error.
+ */
+static bool measure(
+        uint32_t domain,
+        uint32_t num_writers,
+        uint32_t num_readers,
+        uint32_t samples,
+        uint32_t rate,
+        uint32_t payload_size,
+        uint32_t aggregation_us,
+        uint8_t loss,
+        const WriterKind& writer_kind,
+        Measure& result)
+{
+    // Only the writing participant drops samples, so the reading ones do not lose their ACKNACKs
+    TrafficCounter counter;
+    RTPSParticipant* writer_participant = create_participant(domain, "reliable_traffic_writer", aggregation_us,
+                    loss, counter);
+    std::vector<RTPSParticipant*> reader_participants;
+    bool ready = writer_participant != nullptr;
+    for (uint32_t i = 0; ready && i < num_readers; ++i)
+    {
+        reader_participants.push_back(create_participant(domain, "reliable_traffic_reader", aggregation_us, 0,
+                counter));
+        ready = reader_participants.back() != nullptr;
+    }
+    if (!ready)
+    {
+        // The transports of the participants created reference the counter
+        printf("Error creating the participants\n");
+        for (RTPSParticipant* reader_participant : reader_participants)
+        {
+            if (reader_participant != nullptr)
+            {
+                RTPSDomain::removeRTPSParticipant(reader_participant);
+            }
+        }
+        if (writer_participant != nullptr)
+        {
+            RTPSDomain::removeRTPSParticipant(writer_participant);
+        }
+        return false;
+    }
+
+    // Histories keep every sample, so the delivery is complete when the readers have all of them
+    HistoryAttributes hattr;
+    hattr.payloadMaxSize = payload_size;
+    hattr.initialReservedCaches = samples;
+    hattr.maximumReservedCaches = samples;
+
+    WriterQos wqos;
+    wqos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    ReaderQos rqos;
+    rqos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    // A short heartbeat period, so the last samples lost are repaired soon
+    WriterAttributes wattr;
+    wattr.endpoint.reliabilityKind = RELIABLE;
+    wattr.times.heartbeatPeriod = Duration_t(0, 100000000);
+    if (writer_kind.asynchronous)
+    {
+        wattr.mode = ASYNCHRONOUS_WRITER;
+    }
+    if (writer_kind.congestion_control)
+    {
+        wattr.endpoint.properties.properties().emplace_back("fastdds.congestion_control", "AIMD");
+    }
+    ReaderAttributes rattr;
+    rattr.endpoint.reliabilityKind = RELIABLE;
+
+    MatchListener listener;
+    std::vector<std::unique_ptr<WriterHistory>> writer_histories;
+    std::vector<std::unique_ptr<ReaderHistory>> reader_histories;
+    std::vector<RTPSWriter*> writers;
+    for (uint32_t i = 0; ready && i < num_writers; ++i)
+    {
+        // Each writer has its own topic, so it is only matched with its readers
+        TopicAttributes tattr;
+        tattr.topicKind = NO_KEY;
+        tattr.topicDataType = "ReliableTrafficType";
+        tattr.topicName = "ReliableTrafficTopic_" + std::to_string(i);
+
+        writer_histories.emplace_back(new WriterHistory(hattr));
+        RTPSWriter* writer = RTPSDomain::createRTPSWriter(writer_participant, wattr, writer_histories.back().get());
+        ready = writer != nullptr && writer_participant->registerWriter(writer, tattr, wqos);
+        writers.push_back(writer);
+
+        for (RTPSParticipant* reader_participant : reader_participants)
+        {
+            reader_histories.emplace_back(new ReaderHistory(hattr));
+            RTPSReader* reader = RTPSDomain::createRTPSReader(reader_participant, rattr,
+                            reader_histories.back().get(), &listener);
+            ready = ready && reader != nullptr && reader_participant->registerReader(reader, tattr, rqos);
+        }
+    }
+    ready = ready && listener.wait(num_writers * num_readers, std::chrono::seconds(10));
+
+    if (ready)
+    {
+        // Only the traffic of the samples is measured, not the one of the discovery
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        counter.reset();
+
+        auto start = Clock::now();
+        for (uint32_t n = 0; ready && n < samples; ++n)
+        {
+            for (size_t i = 0; ready && i < writers.size(); ++i)
+            {
+                CacheChange_t* change = writers[i]->new_change([payload_size]() -> uint32_t
+                        {
+                            return payload_size;
+                        }, ALIVE);
+                if (change == nullptr)
+                {
+                    printf("Error creating the samples\n");
+                    ready = false;
+                    break;
+                }
+
+                memset(change->serializedPayload.data, static_cast<int>(n), payload_size);
+                change->serializedPayload.length = payload_size;
+                writer_histories[i]->add_change(change);
+            }
+
+            if (rate > 0)
+            {
+                std::this_thread::sleep_until(start + std::chrono::microseconds(1000000ull * (n + 1) / rate));
+            }
+        }
+
+        auto timeout = Clock::now() + std::chrono::seconds(30);
+        bool received = false;
+        while (ready && !received && Clock::now() < timeout)
+        {
+            received = true;
+            for (const std::unique_ptr<ReaderHistory>& history : reader_histories)
+            {
+                received &= history->getHistorySize() >= samples;
+            }
+            if (!received)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        if (received)
+        {
+            result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            result.goodput = static_cast<double>(samples) * payload_size * num_writers / result.seconds;
+            counter.get(result);
+        }
+        else if (ready)
+        {
+            printf("Error receiving the samples\n");
+            ready = false;
+        }
+    }
+    else
+    {
+        printf("Error matching the endpoints\n");
+    }
+
+    for (RTPSParticipant* reader_participant : reader_participants)
+    {
+        RTPSDomain::removeRTPSParticipant(reader_participant);
+    }
+    RTPSDomain::removeRTPSParticipant(writer_participant);
+
+    return ready;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t writers = 8;
+    uint32_t readers = 2;
+    uint32_t samples = 2000;
+    uint32_t rate = 1000;
+    uint32_t size = 1024;
+    uint32_t period = 1000;
+    uint32_t loss = 10;
+    bool congestion = false;
+    uint32_t domain = 0;
+
+    BenchmarkOptions options(usage, argc, argv);
+    if (!options.parsed())
+    {
+        return options.exit_code();
+    }
+
+    for (int i = 0; i < options.count(); ++i)
+    {
+        const option::Option& opt = options[i];
+        switch (opt.index())
+        {
+            case WRITERS:
+                writers = strtol(opt.arg, nullptr, 10);
+                break;
+            case READERS:
+                readers = strtol(opt.arg, nullptr, 10);
+                break;
+            case SAMPLES:
+                samples = strtol(opt.arg, nullptr, 10);
+                break;
+            case RATE:
+                rate = strtol(opt.arg, nullptr, 10);
+                break;
+            case SIZE:
+                size = strtol(opt.arg, nullptr, 10);
+                break;
+            case PERIOD:
+                period = strtol(opt.arg, nullptr, 10);
+                break;
+            case LOSS:
+                loss = strtol(opt.arg, nullptr, 10);
+                break;
+            case CONGESTION:
+                congestion = true;
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage);
+                return 1;
+        }
+    }
+
+    writers = writers > 0 ? writers : 1;
+    readers = readers > 0 ? readers : 1;
+    loss = loss < 100 ? loss : 99;
+    samples = samples > 0 ? samples : 1;
+    size = size > 0 ? size : 1;
+
+    // The samples should travel through the transport
+    LibrarySettingsAttributes library_settings;
+    library_settings.intraprocess_delivery = INTRAPROCESS_OFF;
+    xmlparser::XMLProfileManager::library_settings(library_settings);
+
+    std::vector<uint32_t> periods = { 0 };
+    if (period > 0)
+    {
+        periods.push_back(period);
+    }
+
+    std::vector<uint32_t> losses = { 0 };
+    if (loss > 0)
+    {
+        losses.push_back(loss);
+    }
+
+    size_t num_writer_kinds = congestion ? 3 : 1;
+
+    printf("\n");
+    printf("[ Writers][ Aggregation][  Loss %%][   Seconds][ Goodput MB/s][ Datagrams][        KB][   Control]"
+            "[ Control/s][ Submessages][ Repair KB]\n");
+    printf("[--------,------------,---------,----------,-------------,----------,----------,----------,"
+            "----------,------------,----------]\n");
+
+    bool result = true;
+    for (size_t kind = 0; kind < num_writer_kinds; ++kind)
+    {
+        for (uint32_t run_loss : losses)
+        {
+            for (uint32_t aggregation_us : periods)
+            {
+                Measure measured;
+                result &= measure(domain, writers, readers, samples, rate, size, aggregation_us,
+                                static_cast<uint8_t>(run_loss), writer_kinds[kind], measured);
+                std::string name = aggregation_us > 0 ? std::to_string(aggregation_us) + " us" : "off";
+                double seconds = measured.seconds > 0 ? measured.seconds : 1;
+                printf("%9s,%13s,%9u,%10.2f,%13.2f,%10llu,%10.0f,%10llu,%10.0f,%12llu,%10.1f\n",
+                        writer_kinds[kind].name, name.c_str(), run_loss, measured.seconds, measured.goodput / 1e6,
+                        static_cast<unsigned long long>(measured.datagrams), measured.bytes / 1024.0,
+                        static_cast<unsigned long long>(measured.control_datagrams),
+                        measured.control_datagrams / seconds,
+                        static_cast<unsigned long long>(measured.control_submessages),
+                        measured.repair_bytes / 1024.0);
+                fflush(stdout);
+            }
+        }
+    }
+    printf("\n");
+
+    return result ? 0 : 1;
+}
@@ -0,0 +1,337 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_SharedPayloadTest.cpp
+ *
+ * Measures the CPU time and the memory taken by several readers of a participant to receive the same samples,
+ * when each reader copies the payloads into its history and when the readers share them.
+ */
+
+#include "../BenchmarkOptions.hpp"
+
+#include <fastdds/rtps/RTPSDomain.h>
+#include <fastdds/rtps/attributes/HistoryAttributes.h>
+#include <fastdds/rtps/attributes/ReaderAttributes.h>
+#include <fastdds/rtps/attributes/RTPSParticipantAttributes.h>
+#include <fastdds/rtps/attributes/WriterAttributes.h>
+#include <fastdds/rtps/history/ReaderHistory.h>
+#include <fastdds/rtps/history/WriterHistory.h>
+#include <fastdds/rtps/participant/RTPSParticipant.h>
+#include <fastdds/rtps/reader/ReaderListener.h>
+#include <fastdds/rtps/reader/RTPSReader.h>
+#include <fastdds/rtps/writer/RTPSWriter.h>
+#include <fastrtps/attributes/TopicAttributes.h>
+#include <fastrtps/qos/ReaderQos.h>
+#include <fastrtps/qos/WriterQos.h>
+#include <fastrtps/xmlparser/XMLProfileManager.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+using Clock = std::chrono::steady_clock;
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    READERS,
+    SAMPLES,
+    MAX_SIZE,
+    FORCED_DOMAIN
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT,   0, "",  "",         Arg::None,    "Usage: SharedPayloadTest [options]\n\nOptions:" },
+    { HELP,          0, "h", "help",     Arg::None,    "  -h        --help             Produce help message." },
+    { READERS,       0, "r", "readers",  Arg::Numeric, "  -r <num>, --readers=<num>    Readers on the receiving participant (Default: 4)." },
+    { SAMPLES,       0, "n", "samples",  Arg::Numeric, "  -n <num>, --samples=<num>    Samples kept by each reader (Default: 500)." },
+    { MAX_SIZE,      0, "m", "max_size", Arg::Numeric, "  -m <num>, --max_size=<num>   Largest payload measured. Sizes go from 8192 bytes, by 2 (Default: 60000)." },
+    { FORCED_DOMAIN, 0, "",  "domain",   Arg::Numeric, "            --domain=<num>     Set the domain to connect (Default: 0)." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+class MatchListener : public ReaderListener
+{
+public:
+
+    void onReaderMatched(
+            RTPSReader* /*reader*/,
+            MatchingInfo& info) override
+    {
+        if (info.status == MATCHED_MATCHING)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++matched_;
+            cv_.notify_all();
+        }
+    }
+
+    bool wait(
+            uint32_t readers,
+            std::chrono::seconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [&]()
+                       {
+                           return matched_ >= readers;
+                       });
+    }
+
+private:
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    uint32_t matched_ = 0;
+};
+
+//! Resident memory of the process, 0 when it cannot be known
+static uint64_t resident_bytes()
+{
+#if defined(__linux__)
+    unsigned long total_pages = 0;
+    unsigned long resident_pages = 0;
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (statm != nullptr)
+    {
+        if (fscanf(statm, "%lu %lu", &total_pages, &resident_pages) != 2)
+        {
+            resident_pages = 0;
+        }
+        fclose(statm);
+    }
+    return resident_pages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+struct Measure
+{
+    //! CPU time of the process per sample received by a reader
+    double cpu_us = 0;
+    //! Memory taken by the samples kept on the readers
+    double memory_mb = 0;
+};
+
+/**
+ * Write samples of the given size to several readers of another participant, keeping all of them.
+ * @return false on error.
+ */
+static bool measure(
+        uint32_t domain,
+        uint32_t num_readers,
+        uint32_t samples,
+        uint32_t payload_size,
+        bool share,
+        Measure& result)
+{
+    RTPSParticipantAttributes pattr;
+    pattr.setName("shared_payload_writer");
+    RTPSParticipant* writer_participant = RTPSDomain::createParticipant(domain, pattr);
+    pattr.setName("shared_payload_reader");
+    pattr.allocation.shared_payloads.min_payload_size = share ? payload_size : 0;
+    RTPSParticipant* reader_participant = RTPSDomain::createParticipant(domain, pattr);
+    if (writer_participant == nullptr || reader_participant == nullptr)
+    {
+        printf("Error creating the participants\n");
+        return false;
+    }
+
+    // The writer keeps every sample from the start, so only the readers take memory during the measure
+    HistoryAttributes writer_hattr;
+    writer_hattr.payloadMaxSize = payload_size;
+    writer_hattr.initialReservedCaches = samples;
+    writer_hattr.maximumReservedCaches = samples;
+    WriterHistory writer_history(writer_hattr);
+
+    // The readers only allocate the payloads they copy
+    HistoryAttributes reader_hattr;
+    reader_hattr.payloadMaxSize = payload_size;
+    reader_hattr.memoryPolicy = DYNAMIC_RESERVE_MEMORY_MODE;
+    reader_hattr.initialReservedCaches = samples;
+    reader_hattr.maximumReservedCaches = samples;
+
+    TopicAttributes tattr;
+    tattr.topicKind = NO_KEY;
+    tattr.topicDataType = "SharedPayloadType";
+    tattr.topicName = "SharedPayloadTopic";
+    WriterQos wqos;
+    wqos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    ReaderQos rqos;
+    rqos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+
+    WriterAttributes wattr;
+    wattr.endpoint.reliabilityKind = RELIABLE;
+    RTPSWriter* writer = RTPSDomain::createRTPSWriter(writer_participant, wattr, &writer_history);
+    bool ready = writer != nullptr && writer_participant->registerWriter(writer, tattr, wqos);
+
+    MatchListener listener;
+    std::vector<std::unique_ptr<ReaderHistory>> reader_histories;
+    ReaderAttributes rattr;
+    rattr.endpoint.reliabilityKind = RELIABLE;
+    for (uint32_t i = 0; ready && i < num_readers; ++i)
+    {
+        reader_histories.emplace_back(new ReaderHistory(reader_hattr));
+        RTPSReader* reader = RTPSDomain::createRTPSReader(reader_participant, rattr, reader_histories.back().get(),
+                        &listener);
+        ready = reader != nullptr && reader_participant->registerReader(reader, tattr, rqos);
+    }
+    ready = ready && listener.wait(num_readers, std::chrono::seconds(10));
+
+    if (ready)
+    {
+        uint64_t memory_before = resident_bytes();
+        std::clock_t cpu_before = std::clock();
+
+        for (uint32_t i = 0; i < samples; ++i)
+        {
+            CacheChange_t* change = writer->new_change([payload_size]() -> uint32_t
+                    {
+                        return payload_size;
+                    }, ALIVE);
+            memset(change->serializedPayload.data, static_cast<int>(i), payload_size);
+            change->serializedPayload.length = payload_size;
+            writer_history.add_change(change);
+        }
+
+        auto timeout = Clock::now() + std::chrono::seconds(30);
+        bool received = false;
+        while (!received && Clock::now() < timeout)
+        {
+            received = true;
+            for (const std::unique_ptr<ReaderHistory>& history : reader_histories)
+            {
+                received &= history->getHistorySize() >= samples;
+            }
+            if (!received)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        std::clock_t cpu_after = std::clock();
+        uint64_t memory_after = resident_bytes();
+
+        if (received)
+        {
+            double cpu_s = static_cast<double>(cpu_after - cpu_before) / CLOCKS_PER_SEC;
+            result.cpu_us = cpu_s * 1e6 / (static_cast<double>(samples) * num_readers);
+            result.memory_mb = memory_after > memory_before ?
+                    static_cast<double>(memory_after - memory_before) / (1024 * 1024) : 0;
+        }
+        else
+        {
+            printf("Error receiving the samples\n");
+            ready = false;
+        }
+    }
+    else
+    {
+        printf("Error matching the endpoints\n");
+    }
+
+    RTPSDomain::removeRTPSParticipant(reader_participant);
+    RTPSDomain::removeRTPSParticipant(writer_participant);
+
+    return ready;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t readers = 4;
+    uint32_t samples = 500;
+    uint32_t max_size = 60000;
+    uint32_t domain = 0;
+
+    BenchmarkOptions options(usage, argc, argv);
+    if (!options.parsed())
+    {
+        return options.exit_code();
+    }
+
+    for (int i = 0; i < options.count(); ++i)
+    {
+        const option::Option& opt = options[i];
+        switch (opt.index())
+        {
+            case READERS:
+                readers = strtol(opt.arg, nullptr, 10);
+                break;
+            case SAMPLES:
+                samples = strtol(opt.arg, nullptr, 10);
+                break;
+            case MAX_SIZE:
+                max_size = strtol(opt.arg, nullptr, 10);
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage);
+                return 1;
+        }
+    }
+
+    readers = readers > 1 ? readers : 2;
+    samples = samples > 0 ? samples : 1;
+    max_size = max_size >= 8192 ? max_size : 8192;
+
+    // The samples should travel through the transport
+    LibrarySettingsAttributes library_settings;
+    library_settings.intraprocess_delivery = INTRAPROCESS_OFF;
+    xmlparser::XMLProfileManager::library_settings(library_settings);
+
+    std::vector<uint32_t> sizes;
+    for (uint32_t size = 8192; size < max_size; size *= 2)
+    {
+        sizes.push_back(size);
+    }
+    sizes.push_back(max_size);
+
+    printf("\n%u readers keeping %u samples each%s\n", readers, samples,
+            resident_bytes() > 0 ? "" : " (resident memory not available on this platform)");
+    printf("[     Bytes][ Copied us/sample][ Copied MB][ Shared us/sample][ Shared MB]\n");
+    printf("[----------,------------------,-----------,------------------,-----------]\n");
+
+    bool result = true;
+    for (uint32_t size : sizes)
+    {
+        Measure copied;
+        Measure shared;
+        result &= measure(domain, readers, samples, size, false, copied);
+        result &= measure(domain, readers, samples, size, true, shared);
+        printf("%11u,%18.2f,%11.1f,%18.2f,%11.1f\n", size,
+                copied.cpu_us, copied.memory_mb, shared.cpu_us, shared.memory_mb);
+        fflush(stdout);
+    }
+    printf("\n");
+
+    return result ? 0 : 1;
+}
@@ -0,0 +1,239 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_SharedMemAllocTest.cpp
+ *
+ * Measures the latency of allocating and releasing buffers on a shared memory segment.
+ * A window of buffers is kept allocated while new ones are allocated and the oldest ones released,
+ * as the shared memory transport does while its listeners are still holding the last samples sent.
+ */
+
+#include "../BenchmarkOptions.hpp"
+
+#include <fastdds/dds/log/Log.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <rtps/transport/shared_mem/SharedMemManager.hpp>
+
+using namespace eprosima::fastdds::rtps;
+
+using Clock = std::chrono::steady_clock;
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    SAMPLES,
+    WINDOW,
+    MAX_SIZE
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT, 0, "",  "",         Arg::None,    "Usage: SharedMemAllocTest [options]\n\nOptions:" },
+    { HELP,        0, "h", "help",     Arg::None,    "  -h        --help             Produce help message." },
+    { SAMPLES,     0, "s", "samples",  Arg::Numeric, "  -s <num>, --samples=<num>    Allocations measured for each size (Default: 100000)." },
+    { WINDOW,      0, "w", "window",   Arg::Numeric, "  -w <num>, --window=<num>     Buffers kept allocated while measuring (Default: 64)." },
+    { MAX_SIZE,    0, "m", "max_size", Arg::Numeric, "  -m <num>, --max_size=<num>   Largest buffer size measured. Sizes go from 64 bytes, by 8 (Default: 262144)." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+struct Times
+{
+    std::vector<double> alloc_us;
+    std::vector<double> release_us;
+};
+
+static double percentile(
+        std::vector<double>& values,
+        double fraction)
+{
+    size_t index = static_cast<size_t>(fraction * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+static void print_times(
+        const char* size,
+        const char* operation,
+        std::vector<double>& values)
+{
+    double mean = 0;
+    for (double value : values)
+    {
+        mean += value;
+    }
+    mean /= values.size();
+
+    double min = *std::min_element(values.begin(), values.end());
+    double max = *std::max_element(values.begin(), values.end());
+    double p50 = percentile(values, 0.5);
+    double p99 = percentile(values, 0.99);
+    double p9999 = percentile(values, 0.9999);
+
+    printf("%10s,%8s,%10.3f,%10.3f,%10.3f,%10.3f,%10.3f,%10.3f\n", size, operation, mean, min, p50, p99, p9999, max);
+}
+
+/**
+ * Allocate the given sizes on the segment, keeping a window of buffers allocated.
+ * @return false when an allocation fails.
+ */
+static bool measure(
+        SharedMemManager::Segment& segment,
+        const std::vector<uint32_t>& sizes,
+        uint32_t samples,
+        uint32_t window,
+        Times& times)
+{
+    std::deque<std::shared_ptr<SharedMemManager::Buffer> > buffers;
+    times.alloc_us.clear();
+    times.release_us.clear();
+    times.alloc_us.reserve(samples);
+    times.release_us.reserve(samples);
+
+    // The first allocations of each size are not measured, so the segment reaches its steady state
+    for (uint32_t i = 0; i < samples + window; ++i)
+    {
+        bool measured = i >= window;
+
+        if (buffers.size() == window)
+        {
+            auto t0 = Clock::now();
+            buffers.pop_front();
+            auto t1 = Clock::now();
+            if (measured)
+            {
+                times.release_us.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+            }
+        }
+
+        uint32_t size = sizes[i % sizes.size()];
+        try
+        {
+            auto t0 = Clock::now();
+            buffers.push_back(segment.alloc_buffer(size, Clock::time_point()));
+            auto t1 = Clock::now();
+            if (measured)
+            {
+                times.alloc_us.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+            }
+        }
+        catch (const std::exception& e)
+        {
+            printf("Error allocating %u bytes: %s\n", size, e.what());
+            return false;
+        }
+
+        // Buffers are written as the transport does, so their pages are really used
+        memset(buffers.back()->data(), 0, size);
+    }
+
+    return true;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t samples = 100000;
+    uint32_t window = 64;
+    uint32_t max_size = 262144;
+
+    BenchmarkOptions options(usage, argc, argv);
+    if (!options.parsed())
+    {
+        return options.exit_code();
+    }
+
+    for (int i = 0; i < options.count(); ++i)
+    {
+        const option::Option& opt = options[i];
+        switch (opt.index())
+        {
+            case SAMPLES:
+                samples = strtol(opt.arg, nullptr, 10);
+                break;
+            case WINDOW:
+                window = strtol(opt.arg, nullptr, 10);
+                break;
+            case MAX_SIZE:
+                max_size = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage);
+                return 1;
+        }
+    }
+
+    samples = samples > 0 ? samples : 1;
+    window = window > 0 ? window : 1;
+    max_size = max_size >= 64 ? max_size : 64;
+
+    std::vector<std::vector<uint32_t> > runs;
+    for (uint32_t size = 64; size <= max_size; size *= 8)
+    {
+        runs.push_back({size});
+    }
+
+    // Sizes spread over the whole range, so released buffers rarely fit the next allocation exactly
+    std::vector<uint32_t> mixed(1024);
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<uint32_t> distribution(1, max_size);
+    for (uint32_t& size : mixed)
+    {
+        size = distribution(generator);
+    }
+    runs.push_back(mixed);
+
+    SharedMemManager shared_mem_manager("SHMAllocTest");
+
+    printf("\n");
+    printf("[      Size][      Op][ Mean(us)][  Min(us)][  50%%(us)][  99%%(us)][99.99%%(us)][  Max(us)]\n");
+    printf("[----------,--------,----------,----------,----------,----------,----------,----------]\n");
+
+    bool result = true;
+    for (const std::vector<uint32_t>& sizes : runs)
+    {
+        uint32_t largest = *std::max_element(sizes.begin(), sizes.end());
+
+        // Room for the window and some more, as the transport does
+        auto segment = shared_mem_manager.create_segment(largest * window * 2, window * 2);
+
+        Times times;
+        if (!measure(*segment, sizes, samples, window, times))
+        {
+            result = false;
+            break;
+        }
+
+        std::string size = sizes.size() == 1 ? std::to_string(sizes.front()) : std::string("mixed");
+        print_times(size.c_str(), "alloc", times.alloc_us);
+        print_times(size.c_str(), "release", times.release_us);
+        fflush(stdout);
+    }
+    printf("\n");
+
+    eprosima::fastdds::dds::Log::Reset();
+
+    return result ? 0 : 1;
+}
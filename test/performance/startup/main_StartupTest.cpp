@@ -0,0 +1,310 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_StartupTest.cpp
+ *
+ * Measures the startup time of a short-lived application: the initialization of the participant factory, the
+ * creation of participants, and the time until a publisher and a subscriber created from scratch are matched.
+ * Each measure is repeated with the default configuration, with the concurrent receiver setup and with a
+ * participant that is a TypeLookup client.
+ */
+
+#include "../throughput/ThroughputTypes.hpp"
+
+#include "../BenchmarkOptions.hpp"
+
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastrtps/Domain.h>
+#include <fastrtps/participant/Participant.h>
+#include <fastrtps/attributes/ParticipantAttributes.h>
+#include <fastrtps/attributes/PublisherAttributes.h>
+#include <fastrtps/attributes/SubscriberAttributes.h>
+#include <fastrtps/publisher/Publisher.h>
+#include <fastrtps/publisher/PublisherListener.h>
+#include <fastrtps/subscriber/Subscriber.h>
+#include <fastrtps/subscriber/SubscriberListener.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+using Clock = std::chrono::steady_clock;
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    PARTICIPANTS,
+    FORCED_DOMAIN
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT,   0, "",  "",             Arg::None,    "Usage: StartupTest [options]\n\nOptions:" },
+    { HELP,          0, "h", "help",         Arg::None,    "  -h         --help                 Produce help message." },
+    { PARTICIPANTS,  0, "n", "participants", Arg::Numeric, "  -n <num>,  --participants=<num>   Participants created on each measure (Default: 20)." },
+    { FORCED_DOMAIN, 0, "",  "domain",       Arg::Numeric, "             --domain=<num>         Set the domain to connect (Default: 0)." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+enum class StartupConfig
+{
+    DEFAULT,
+    PARALLEL_RECEIVERS,
+    TYPELOOKUP_CLIENT
+};
+
+static double elapsed_ms(
+        Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static ParticipantAttributes participant_attributes(
+        uint32_t domain,
+        StartupConfig config)
+{
+    ParticipantAttributes attr;
+    attr.domainId = domain;
+    attr.rtps.setName("startup_participant");
+    if (config == StartupConfig::PARALLEL_RECEIVERS)
+    {
+        attr.rtps.properties.properties().emplace_back("fastdds.participant.parallel_receiver_setup", "true");
+    }
+    else if (config == StartupConfig::TYPELOOKUP_CLIENT)
+    {
+        attr.rtps.builtin.typelookup_config.use_client = true;
+    }
+    return attr;
+}
+
+class MatchListener : public PublisherListener, public SubscriberListener
+{
+public:
+
+    void onPublicationMatched(
+            Publisher* /*pub*/,
+            MatchingInfo& info) override
+    {
+        notify(info);
+    }
+
+    void onSubscriptionMatched(
+            Subscriber* /*sub*/,
+            MatchingInfo& info) override
+    {
+        notify(info);
+    }
+
+    bool wait(
+            uint32_t expected,
+            std::chrono::seconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [&]()
+                {
+                    return matched_ >= expected;
+                });
+    }
+
+private:
+
+    void notify(
+            const MatchingInfo& info)
+    {
+        if (info.status == MATCHED_MATCHING)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++matched_;
+            cv_.notify_all();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    uint32_t matched_ = 0;
+};
+
+struct CreationResult
+{
+    double min_ms = 0;
+    double avg_ms = 0;
+    double max_ms = 0;
+};
+
+static bool measure_creation(
+        uint32_t domain,
+        uint32_t participants,
+        StartupConfig config,
+        CreationResult& result)
+{
+    std::vector<Participant*> created;
+    std::vector<double> times;
+    ParticipantAttributes attr = participant_attributes(domain, config);
+    for (uint32_t i = 0; i < participants; ++i)
+    {
+        auto start = Clock::now();
+        Participant* participant = Domain::createParticipant(attr);
+        times.push_back(elapsed_ms(start));
+        if (participant == nullptr)
+        {
+            break;
+        }
+        created.push_back(participant);
+    }
+
+    for (Participant* participant : created)
+    {
+        Domain::removeParticipant(participant);
+    }
+
+    if (times.empty() || created.size() != participants)
+    {
+        return false;
+    }
+
+    result.min_ms = *std::min_element(times.begin(), times.end());
+    result.max_ms = *std::max_element(times.begin(), times.end());
+    for (double time : times)
+    {
+        result.avg_ms += time;
+    }
+    result.avg_ms /= times.size();
+    return true;
+}
+
+static bool measure_first_match(
+        uint32_t domain,
+        StartupConfig config,
+        double& match_ms)
+{
+    ThroughputDataType pub_type(16);
+    ThroughputDataType sub_type(16);
+    MatchListener listener;
+
+    auto start = Clock::now();
+
+    ParticipantAttributes attr = participant_attributes(domain, config);
+    Participant* pub_participant = Domain::createParticipant(attr);
+    Participant* sub_participant = Domain::createParticipant(attr);
+    if (pub_participant == nullptr || sub_participant == nullptr)
+    {
+        return false;
+    }
+
+    Domain::registerType(pub_participant, &pub_type);
+    Domain::registerType(sub_participant, &sub_type);
+
+    PublisherAttributes pub_attr;
+    pub_attr.topic.topicDataType = "ThroughputType";
+    pub_attr.topic.topicName = "StartupTopic";
+    pub_attr.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    SubscriberAttributes sub_attr;
+    sub_attr.topic.topicDataType = "ThroughputType";
+    sub_attr.topic.topicName = "StartupTopic";
+    sub_attr.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+
+    bool matched = Domain::createPublisher(pub_participant, pub_attr, &listener) != nullptr &&
+            Domain::createSubscriber(sub_participant, sub_attr, &listener) != nullptr &&
+            listener.wait(2, std::chrono::seconds(10));
+    match_ms = elapsed_ms(start);
+
+    Domain::removeParticipant(sub_participant);
+    Domain::removeParticipant(pub_participant);
+
+    return matched;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t participants = 20;
+    uint32_t domain = 0;
+
+    BenchmarkOptions options(usage, argc, argv);
+    if (!options.parsed())
+    {
+        return options.exit_code();
+    }
+
+    for (int i = 0; i < options.count(); ++i)
+    {
+        const option::Option& opt = options[i];
+        switch (opt.index())
+        {
+            case PARTICIPANTS:
+                participants = strtol(opt.arg, nullptr, 10);
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage);
+                return 1;
+        }
+    }
+
+    if (participants == 0)
+    {
+        participants = 1;
+    }
+
+    // The first call loads the XML profiles and creates the singletons
+    auto factory_start = Clock::now();
+    eprosima::fastdds::dds::DomainParticipantFactory::get_instance();
+    double factory_ms = elapsed_ms(factory_start);
+
+    const struct
+    {
+        const char* name;
+        StartupConfig config;
+    } runs[] = {
+        { "default", StartupConfig::DEFAULT },
+        { "parallel", StartupConfig::PARALLEL_RECEIVERS },
+        { "typelookup", StartupConfig::TYPELOOKUP_CLIENT }
+    };
+
+    bool all_ok = true;
+    CreationResult creation[3];
+    double match_ms[3] = { 0, 0, 0 };
+    for (size_t i = 0; i < 3; ++i)
+    {
+        all_ok &= measure_creation(domain, participants, runs[i].config, creation[i]);
+        all_ok &= measure_first_match(domain, runs[i].config, match_ms[i]);
+    }
+
+    printf("\n");
+    printf("Factory initialization: %.3f ms\n", factory_ms);
+    printf("\n");
+    printf("[    Config][ Create min][ Create avg][ Create max][ First match]\n");
+    printf("[----------,------------,------------,------------,-------------]\n");
+    for (size_t i = 0; i < 3; ++i)
+    {
+        printf("%11s,%12.3f,%12.3f,%12.3f,%13.3f\n", runs[i].name,
+                creation[i].min_ms, creation[i].avg_ms, creation[i].max_ms, match_ms[i]);
+    }
+    printf("\n");
+    fflush(stdout);
+
+    Domain::stopAll();
+
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,353 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_TCPThroughputTest.cpp
+ *
+ * Measures the samples per second received through the TCP transport on loopback, for several sample sizes and
+ * with the header checksum disabled, with the octet sum and with CRC-32C.
+ * A publisher with a listening port writes as fast as it can to a subscriber connected to it as initial peer.
+ * Small samples are dominated by the cost of reading each message from the socket, large ones by the checksum.
+ */
+
+#include "../throughput/ThroughputTypes.hpp"
+
+#include "../BenchmarkOptions.hpp"
+
+#include <fastrtps/Domain.h>
+#include <fastrtps/participant/Participant.h>
+#include <fastrtps/attributes/ParticipantAttributes.h>
+#include <fastrtps/attributes/PublisherAttributes.h>
+#include <fastrtps/attributes/SubscriberAttributes.h>
+#include <fastrtps/publisher/Publisher.h>
+#include <fastrtps/subscriber/Subscriber.h>
+#include <fastrtps/subscriber/SubscriberListener.h>
+#include <fastrtps/subscriber/SampleInfo.h>
+#include <fastrtps/transport/TCPv4TransportDescriptor.h>
+#include <fastrtps/utils/IPLocator.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+enum class ChecksumMode
+{
+    NONE,
+    SUM,
+    CRC32C
+};
+
+static const struct
+{
+    const char* name;
+    ChecksumMode mode;
+} checksums[] = {
+    { "none", ChecksumMode::NONE },
+    { "sum", ChecksumMode::SUM },
+    { "crc32c", ChecksumMode::CRC32C }
+};
+
+struct ChecksumArg : public Arg
+{
+    static option::ArgStatus Checksum(const option::Option& option, bool msg)
+    {
+        if (option.arg != 0)
+        {
+            for (const auto& checksum : checksums)
+            {
+                if (strcmp(option.arg, checksum.name) == 0)
+                {
+                    return option::ARG_OK;
+                }
+            }
+        }
+
+        if (msg)
+        {
+            print_error("Option '", option, "' requires none, sum or crc32c\n");
+        }
+        return option::ARG_ILLEGAL;
+    }
+};
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    DURATION,
+    MSG_SIZE,
+    CHECKSUM,
+    PORT,
+    FORCED_DOMAIN
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT,   0, "",  "",         Arg::None,              "Usage: TCPThroughputTest [options]\n\nOptions:" },
+    { HELP,          0, "h", "help",     Arg::None,              "  -h         --help               Produce help message." },
+    { DURATION,      0, "d", "duration", Arg::Numeric,           "  -d <num>,  --duration=<num>     Seconds of each run (Default: 5)." },
+    { MSG_SIZE,      0, "s", "msg_size", Arg::Numeric,           "  -s <num>,  --msg_size=<num>     Only run this size of samples in bytes (Default: 16, 64, 256, 1024, 8192 and 65000)." },
+    { CHECKSUM,      0, "c", "checksum", ChecksumArg::Checksum,  "  -c <kind>, --checksum=<kind>    Only run this header checksum: none, sum or crc32c (Default: all of them)." },
+    { PORT,          0, "p", "port",     Arg::Numeric,           "  -p <num>,  --port=<num>         First listening port, one per run (Default: 5100)." },
+    { FORCED_DOMAIN, 0, "",  "domain",   Arg::Numeric,           "             --domain=<num>       Set the domain to connect (Default: 0)." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+class CountingListener : public SubscriberListener
+{
+public:
+
+    void onSubscriptionMatched(
+            Subscriber* /*sub*/,
+            MatchingInfo& info) override
+    {
+        matched_ = (info.status == MATCHED_MATCHING);
+    }
+
+    void onNewDataMessage(
+            Subscriber* sub) override
+    {
+        SampleInfo_t info;
+        while (sub->takeNextData(data_, &info))
+        {
+            ++received_;
+        }
+    }
+
+    void* data_ = nullptr;
+
+    std::atomic<bool> matched_{false};
+
+    std::atomic<uint64_t> received_{0};
+};
+
+struct RunResult
+{
+    uint64_t written = 0;
+    uint64_t received = 0;
+    double seconds = 0;
+    double cpu_ms = 0;
+};
+
+static std::shared_ptr<TCPv4TransportDescriptor> tcp_descriptor(
+        ChecksumMode mode)
+{
+    auto descriptor = std::make_shared<TCPv4TransportDescriptor>();
+    descriptor->calculate_crc = (mode != ChecksumMode::NONE);
+    descriptor->check_crc = (mode != ChecksumMode::NONE);
+    descriptor->use_crc32c = (mode == ChecksumMode::CRC32C);
+    descriptor->sendBufferSize = 1024 * 1024;
+    descriptor->receiveBufferSize = 1024 * 1024;
+    return descriptor;
+}
+
+static bool run_test(
+        uint32_t domain,
+        uint32_t duration_s,
+        uint32_t msg_size,
+        uint16_t port,
+        ChecksumMode mode,
+        RunResult& result)
+{
+    ParticipantAttributes pub_part_attr;
+    pub_part_attr.domainId = domain;
+    pub_part_attr.rtps.setName("tcp_throughput_publisher");
+    pub_part_attr.rtps.useBuiltinTransports = false;
+    auto pub_descriptor = tcp_descriptor(mode);
+    pub_descriptor->add_listener_port(port);
+    pub_part_attr.rtps.userTransports.push_back(pub_descriptor);
+    Participant* pub_participant = Domain::createParticipant(pub_part_attr);
+
+    Locator_t initial_peer;
+    initial_peer.kind = LOCATOR_KIND_TCPv4;
+    IPLocator::setIPv4(initial_peer, "127.0.0.1");
+    initial_peer.port = port;
+
+    ParticipantAttributes sub_part_attr;
+    sub_part_attr.domainId = domain;
+    sub_part_attr.rtps.setName("tcp_throughput_subscriber");
+    sub_part_attr.rtps.useBuiltinTransports = false;
+    sub_part_attr.rtps.userTransports.push_back(tcp_descriptor(mode));
+    sub_part_attr.rtps.builtin.initialPeersList.push_back(initial_peer);
+    Participant* sub_participant = Domain::createParticipant(sub_part_attr);
+
+    if (pub_participant == nullptr || sub_participant == nullptr)
+    {
+        return false;
+    }
+
+    ThroughputDataType pub_type(msg_size);
+    ThroughputDataType sub_type(msg_size);
+    Domain::registerType(pub_participant, &pub_type);
+    Domain::registerType(sub_participant, &sub_type);
+
+    PublisherAttributes pub_attr;
+    pub_attr.topic.topicDataType = "ThroughputType";
+    pub_attr.topic.topicName = "TCPThroughputTopic";
+    pub_attr.topic.historyQos.kind = KEEP_LAST_HISTORY_QOS;
+    pub_attr.topic.historyQos.depth = 100;
+    pub_attr.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    Publisher* publisher = Domain::createPublisher(pub_participant, pub_attr);
+    if (publisher == nullptr)
+    {
+        return false;
+    }
+
+    SubscriberAttributes sub_attr;
+    sub_attr.topic.topicDataType = "ThroughputType";
+    sub_attr.topic.topicName = "TCPThroughputTopic";
+    sub_attr.topic.historyQos.kind = KEEP_LAST_HISTORY_QOS;
+    sub_attr.topic.historyQos.depth = 100;
+    sub_attr.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+
+    CountingListener listener;
+    listener.data_ = sub_type.createData();
+    if (Domain::createSubscriber(sub_participant, sub_attr, &listener) == nullptr)
+    {
+        return false;
+    }
+
+    // Wait for discovery
+    auto discovery_limit = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!listener.matched_ && std::chrono::steady_clock::now() < discovery_limit)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    ThroughputType sample(static_cast<uint16_t>(msg_size));
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + std::chrono::seconds(duration_s);
+    std::clock_t cpu_start = std::clock();
+    while (std::chrono::steady_clock::now() < end)
+    {
+        sample.seqnum = static_cast<uint32_t>(result.written++);
+        publisher->write(&sample);
+    }
+
+    // Let the last samples arrive
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    result.cpu_ms = 1000.0 * (std::clock() - cpu_start) / CLOCKS_PER_SEC;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.received = listener.received_;
+
+    Domain::removeParticipant(sub_participant);
+    Domain::removeParticipant(pub_participant);
+    sub_type.deleteData(listener.data_);
+
+    return result.received > 0;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t duration_s = 5;
+    uint32_t msg_size = 0;
+    const char* checksum = nullptr;
+    uint16_t port = 5100;
+    uint32_t domain = 0;
+
+    BenchmarkOptions options(usage, argc, argv);
+    if (!options.parsed())
+    {
+        return options.exit_code();
+    }
+
+    for (int i = 0; i < options.count(); ++i)
+    {
+        const option::Option& opt = options[i];
+        switch (opt.index())
+        {
+            case DURATION:
+                duration_s = strtol(opt.arg, nullptr, 10);
+                break;
+            case MSG_SIZE:
+                msg_size = strtol(opt.arg, nullptr, 10);
+                break;
+            case CHECKSUM:
+                checksum = opt.arg;
+                break;
+            case PORT:
+                port = static_cast<uint16_t>(strtol(opt.arg, nullptr, 10));
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage);
+                return 1;
+        }
+    }
+
+    std::vector<uint32_t> sizes = { 16, 64, 256, 1024, 8192, 65000 };
+    if (msg_size > 0)
+    {
+        sizes = { msg_size };
+    }
+
+    struct Run
+    {
+        uint32_t size;
+        const char* checksum;
+        ChecksumMode mode;
+        RunResult result;
+    };
+
+    std::vector<Run> runs;
+    for (uint32_t size : sizes)
+    {
+        for (const auto& kind : checksums)
+        {
+            if (checksum == nullptr || strcmp(checksum, kind.name) == 0)
+            {
+                runs.push_back({ size, kind.name, kind.mode, RunResult() });
+            }
+        }
+    }
+
+    bool all_ok = true;
+    for (size_t i = 0; i < runs.size(); ++i)
+    {
+        // A new port for each run, as the previous one may still be on TIME_WAIT
+        Run& run = runs[i];
+        all_ok &= run_test(domain, duration_s, run.size, static_cast<uint16_t>(port + i), run.mode, run.result);
+    }
+
+    printf("\n");
+    printf("[     Size][ Checksum][  Written][  Received][ Samples/s][      MB/s][   CPU (ms)]\n");
+    printf("[---------,----------,----------,-----------,-----------,-----------,-----------]\n");
+    for (const Run& run : runs)
+    {
+        const RunResult& result = run.result;
+        double samples_per_second = result.seconds > 0 ? result.received / result.seconds : 0;
+        printf("%10u,%10s,%10llu,%11llu,%11.0f,%11.1f,%11.1f\n", run.size, run.checksum,
+                static_cast<unsigned long long>(result.written),
+                static_cast<unsigned long long>(result.received),
+                samples_per_second, samples_per_second * run.size / 1e6, result.cpu_ms);
+    }
+    printf("\n");
+    fflush(stdout);
+
+    Domain::stopAll();
+
+    return all_ok ? 0 : 1;
+}
@@ -29,6 +29,10 @@
 #include <fastrtps/Domain.h>
 #include <fastrtps/xmlparser/XMLProfileManager.h>
 
+#ifdef FASTDDS_LOCK_PROFILER
+#include "LockProfiler.h"
+#endif // ifdef FASTDDS_LOCK_PROFILER
+
 #if defined(_MSC_VER)
 #pragma warning (push)
 #pragma warning (disable:4512)
@@ -126,7 +130,8 @@ enum  optionIndex {
     CERTS_PATH,
     XML_FILE,
     DYNAMIC_TYPES,
-    FORCED_DOMAIN
+    FORCED_DOMAIN,
+    LOCK_PROFILE
 };
 
 enum TestAgent
@@ -148,6 +153,9 @@ const option::Descriptor usage[] = {
 #if HAVE_SECURITY
     { USE_SECURITY,  0, "",  "security",        Arg::Required, "             --security <arg>         Echo mode (\"true\"/\"false\")." },
     { CERTS_PATH,    0, "",  "certs",           Arg::Required, "             --certs <arg>            Path where located certificates." },
+#endif
+#ifdef FASTDDS_LOCK_PROFILER
+    { LOCK_PROFILE,  0, "",  "lock_profile",    Arg::None,     "             --lock_profile           Print the most contended mutexes at exit." },
 #endif
     { UNKNOWN_OPT,   0, "",  "",                Arg::None,     "\nPublisher/Both options:"},
     { TIME,          0, "t", "time",            Arg::Numeric,  "  -t <num>,  --time=<num>             Time of the test in seconds." },
@@ -196,6 +204,7 @@ int main(int argc, char** argv)
     std::string recoveries_file = "";
     bool dynamic_types = false;
     int forced_domain = -1;
+    bool lock_profile = false;
 #if HAVE_SECURITY
     bool use_security = false;
     std::string certs_path;
@@ -353,6 +362,10 @@ int main(int argc, char** argv)
                 break;
 #endif
 
+            case LOCK_PROFILE:
+                lock_profile = true;
+                break;
+
             case UNKNOWN_OPT:
                 option::printUsage(fwrite, stdout, usage, columns);
                 return 0;
@@ -360,6 +373,16 @@ int main(int argc, char** argv)
         }
     }
 
+#ifdef FASTDDS_LOCK_PROFILER
+    if (lock_profile)
+    {
+        eprosima_profiling::LockProfiler::start();
+        eprosima_profiling::LockProfiler::report_at_exit();
+    }
+#else
+    static_cast<void>(lock_profile);
+#endif // ifdef FASTDDS_LOCK_PROFILER
+
     PropertyPolicy pub_part_property_policy;
     PropertyPolicy sub_part_property_policy;
     PropertyPolicy pub_property_policy;
@@ -0,0 +1,279 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_TimeFilterTest.cpp
+ *
+ * Measures the traffic and CPU saved by the writer-side TIME_BASED_FILTER, with a fast publisher, one full-rate
+ * subscriber and several slow subscribers. The same setup is run with and without the filter on the slow ones.
+ */
+
+#include "../throughput/ThroughputTypes.hpp"
+
+#include "../BenchmarkOptions.hpp"
+
+#include <fastrtps/Domain.h>
+#include <fastrtps/participant/Participant.h>
+#include <fastrtps/attributes/ParticipantAttributes.h>
+#include <fastrtps/attributes/PublisherAttributes.h>
+#include <fastrtps/attributes/SubscriberAttributes.h>
+#include <fastrtps/publisher/Publisher.h>
+#include <fastrtps/subscriber/Subscriber.h>
+#include <fastrtps/subscriber/SubscriberListener.h>
+#include <fastrtps/subscriber/SampleInfo.h>
+#include <fastrtps/xmlparser/XMLProfileManager.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    RATE,
+    DURATION,
+    MSG_SIZE,
+    SLOW_SUBSCRIBERS,
+    SEPARATION,
+    FORCED_DOMAIN
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT,      0, "",  "",           Arg::None,    "Usage: TimeFilterTest [options]\n\nOptions:" },
+    { HELP,             0, "h", "help",       Arg::None,    "  -h         --help               Produce help message." },
+    { RATE,             0, "r", "rate",       Arg::Numeric, "  -r <num>,  --rate=<num>         Samples per second written (Default: 1000)." },
+    { DURATION,         0, "d", "duration",   Arg::Numeric, "  -d <num>,  --duration=<num>     Seconds of each run (Default: 5)." },
+    { MSG_SIZE,         0, "s", "msg_size",   Arg::Numeric, "  -s <num>,  --msg_size=<num>     Size of the samples in bytes (Default: 1024)." },
+    { SLOW_SUBSCRIBERS, 0, "",  "slow",       Arg::Numeric, "             --slow=<num>         Number of slow subscribers (Default: 4)." },
+    { SEPARATION,       0, "",  "separation", Arg::Numeric, "             --separation=<num>   Minimum separation of the slow subscribers in milliseconds (Default: 100)." },
+    { FORCED_DOMAIN,    0, "",  "domain",     Arg::Numeric, "             --domain=<num>       Set the domain to connect (Default: 0)." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+class CountingListener : public SubscriberListener
+{
+public:
+
+    void onNewDataMessage(
+            Subscriber* sub) override
+    {
+        SampleInfo_t info;
+        while (sub->takeNextData(data_, &info))
+        {
+            ++received_;
+        }
+    }
+
+    void* data_ = nullptr;
+
+    std::atomic<uint64_t> received_{0};
+};
+
+struct RunResult
+{
+    uint64_t written = 0;
+    uint64_t full_rate_received = 0;
+    uint64_t slow_received = 0;
+    double cpu_ms = 0;
+};
+
+static bool run_test(
+        uint32_t domain,
+        uint32_t rate,
+        uint32_t duration_s,
+        uint32_t msg_size,
+        uint32_t slow_subscribers,
+        uint32_t separation_ms,
+        RunResult& result)
+{
+    ParticipantAttributes pub_part_attr;
+    pub_part_attr.domainId = domain;
+    pub_part_attr.rtps.setName("time_filter_publisher");
+    Participant* pub_participant = Domain::createParticipant(pub_part_attr);
+
+    ParticipantAttributes sub_part_attr;
+    sub_part_attr.domainId = domain;
+    sub_part_attr.rtps.setName("time_filter_subscribers");
+    Participant* sub_participant = Domain::createParticipant(sub_part_attr);
+
+    if (pub_participant == nullptr || sub_participant == nullptr)
+    {
+        return false;
+    }
+
+    ThroughputDataType pub_type(msg_size);
+    ThroughputDataType sub_type(msg_size);
+    Domain::registerType(pub_participant, &pub_type);
+    Domain::registerType(sub_participant, &sub_type);
+
+    PublisherAttributes pub_attr;
+    pub_attr.topic.topicDataType = "ThroughputType";
+    pub_attr.topic.topicName = "TimeFilterTopic";
+    pub_attr.topic.historyQos.kind = KEEP_LAST_HISTORY_QOS;
+    pub_attr.topic.historyQos.depth = 100;
+    pub_attr.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    Publisher* publisher = Domain::createPublisher(pub_participant, pub_attr);
+    if (publisher == nullptr)
+    {
+        return false;
+    }
+
+    SubscriberAttributes sub_attr;
+    sub_attr.topic.topicDataType = "ThroughputType";
+    sub_attr.topic.topicName = "TimeFilterTopic";
+    sub_attr.topic.historyQos.kind = KEEP_LAST_HISTORY_QOS;
+    sub_attr.topic.historyQos.depth = 100;
+    sub_attr.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+
+    std::vector<std::unique_ptr<CountingListener> > listeners;
+    for (uint32_t i = 0; i <= slow_subscribers; ++i)
+    {
+        listeners.emplace_back(new CountingListener());
+        listeners.back()->data_ = sub_type.createData();
+
+        // The first subscriber always receives every sample
+        sub_attr.qos.m_timeBasedFilter.minimum_separation =
+                (i > 0 && separation_ms > 0) ? Duration_t(separation_ms * 1e-3) : Duration_t(0, 0);
+        if (Domain::createSubscriber(sub_participant, sub_attr, listeners.back().get()) == nullptr)
+        {
+            return false;
+        }
+    }
+
+    // Wait for discovery
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+
+    ThroughputType sample(static_cast<uint16_t>(msg_size));
+    auto period = std::chrono::nanoseconds(1000000000ull / rate);
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + std::chrono::seconds(duration_s);
+    auto next = start;
+    std::clock_t cpu_start = std::clock();
+    while (next < end)
+    {
+        sample.seqnum = static_cast<uint32_t>(result.written++);
+        publisher->write(&sample);
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+
+    // Let the last samples arrive
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    result.cpu_ms = 1000.0 * (std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+    result.full_rate_received = listeners[0]->received_;
+    for (uint32_t i = 1; i < listeners.size(); ++i)
+    {
+        result.slow_received += listeners[i]->received_;
+    }
+
+    Domain::removeParticipant(sub_participant);
+    Domain::removeParticipant(pub_participant);
+    for (auto& listener : listeners)
+    {
+        sub_type.deleteData(listener->data_);
+    }
+
+    return result.full_rate_received > 0;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t rate = 1000;
+    uint32_t duration_s = 5;
+    uint32_t msg_size = 1024;
+    uint32_t slow_subscribers = 4;
+    uint32_t separation_ms = 100;
+    uint32_t domain = 0;
+
+    BenchmarkOptions options(usage, argc, argv);
+    if (!options.parsed())
+    {
+        return options.exit_code();
+    }
+
+    for (int i = 0; i < options.count(); ++i)
+    {
+        const option::Option& opt = options[i];
+        switch (opt.index())
+        {
+            case RATE:
+                rate = strtol(opt.arg, nullptr, 10);
+                break;
+            case DURATION:
+                duration_s = strtol(opt.arg, nullptr, 10);
+                break;
+            case MSG_SIZE:
+                msg_size = strtol(opt.arg, nullptr, 10);
+                break;
+            case SLOW_SUBSCRIBERS:
+                slow_subscribers = strtol(opt.arg, nullptr, 10);
+                break;
+            case SEPARATION:
+                separation_ms = strtol(opt.arg, nullptr, 10);
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage);
+                return 1;
+        }
+    }
+
+    if (rate == 0)
+    {
+        rate = 1;
+    }
+
+    // Force the samples to travel through the transport
+    LibrarySettingsAttributes library_settings;
+    library_settings.intraprocess_delivery = INTRAPROCESS_OFF;
+    xmlparser::XMLProfileManager::library_settings(library_settings);
+
+    RunResult unfiltered;
+    RunResult filtered;
+    bool unfiltered_ok = run_test(domain, rate, duration_s, msg_size, slow_subscribers, 0, unfiltered);
+    bool filtered_ok = run_test(domain, rate, duration_s, msg_size, slow_subscribers, separation_ms, filtered);
+
+    printf("\n");
+    printf("[   Filter][  Written][ Full rate][      Slow][ Slow bytes][   CPU (ms)]\n");
+    printf("[---------,----------,-----------,-----------,------------,-----------]\n");
+    printf("%10s,%10llu,%11llu,%11llu,%12llu,%11.1f\n", "none",
+            static_cast<unsigned long long>(unfiltered.written),
+            static_cast<unsigned long long>(unfiltered.full_rate_received),
+            static_cast<unsigned long long>(unfiltered.slow_received),
+            static_cast<unsigned long long>(unfiltered.slow_received * msg_size), unfiltered.cpu_ms);
+    printf("%8ums,%10llu,%11llu,%11llu,%12llu,%11.1f\n", separation_ms,
+            static_cast<unsigned long long>(filtered.written),
+            static_cast<unsigned long long>(filtered.full_rate_received),
+            static_cast<unsigned long long>(filtered.slow_received),
+            static_cast<unsigned long long>(filtered.slow_received * msg_size), filtered.cpu_ms);
+    printf("\n");
+    fflush(stdout);
+
+    Domain::stopAll();
+
+    return (unfiltered_ok && filtered_ok) ? 0 : 1;
+}
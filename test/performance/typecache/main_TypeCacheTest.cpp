@@ -0,0 +1,405 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_TypeCacheTest.cpp
+ *
+ * Measures the time to the first sample of a subscriber that discovers its type through the TypeLookup Service,
+ * when it starts with an empty TypeObject cache and when it is restarted with the cache filled by the previous run.
+ * The publisher runs on this process, and each subscriber is a new process running this same executable.
+ */
+
+#include "../BenchmarkOptions.hpp"
+
+#include <fastdds/dds/domain/DomainParticipant.hpp>
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/dds/domain/DomainParticipantListener.hpp>
+#include <fastdds/dds/publisher/DataWriter.hpp>
+#include <fastdds/dds/publisher/Publisher.hpp>
+#include <fastdds/dds/publisher/qos/DataWriterQos.hpp>
+#include <fastdds/dds/subscriber/DataReader.hpp>
+#include <fastdds/dds/subscriber/DataReaderListener.hpp>
+#include <fastdds/dds/subscriber/SampleInfo.hpp>
+#include <fastdds/dds/subscriber/Subscriber.hpp>
+#include <fastdds/dds/subscriber/qos/DataReaderQos.hpp>
+#include <fastdds/dds/topic/Topic.hpp>
+#include <fastdds/dds/topic/TypeSupport.hpp>
+#include <fastrtps/types/DynamicDataFactory.h>
+#include <fastrtps/types/DynamicPubSubType.h>
+#include <fastrtps/types/DynamicTypeBuilderFactory.h>
+#include <fastrtps/types/DynamicTypeBuilderPtr.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace eprosima::fastdds::dds;
+using eprosima::fastrtps::string_255;
+using namespace eprosima::fastrtps::types;
+
+using Clock = std::chrono::steady_clock;
+
+static const char* const s_topic_name = "TypeCacheTopic";
+static const char* const s_type_name = "TypeCacheSample";
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    RUNS,
+    CACHE_FILE,
+    FORCED_DOMAIN,
+    SUBSCRIBER
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT,   0, "",  "",           Arg::None,    "Usage: TypeCacheTest [options]\n\nOptions:" },
+    { HELP,          0, "h", "help",       Arg::None,    "  -h         --help               Produce help message." },
+    { RUNS,          0, "r", "runs",       Arg::Numeric, "  -r <num>,  --runs=<num>         Subscribers started with an empty cache and with a filled one (Default: 5)." },
+    { CACHE_FILE,    0, "f", "file",       Arg::String,  "  -f <path>, --file=<path>        TypeObject cache used by the subscribers (Default: TypeCacheTest.cache)." },
+    { FORCED_DOMAIN, 0, "",  "domain",     Arg::Numeric, "             --domain=<num>       Set the domain to connect (Default: 0)." },
+    { SUBSCRIBER,    0, "",  "subscriber", Arg::None,    "             --subscriber         Run as one of the subscribers launched by the test." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+static double elapsed_ms(
+        Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static bool file_exists(
+        const std::string& filename)
+{
+    std::ifstream file(filename);
+    return file.good();
+}
+
+/**
+ * Builds a type with nested structures, so the subscriber needs several TypeLookup replies to resolve it.
+ */
+static DynamicType_ptr create_type()
+{
+    DynamicTypeBuilderFactory* factory = DynamicTypeBuilderFactory::get_instance();
+
+    DynamicTypeBuilder_ptr point = factory->create_struct_builder();
+    point->set_name("TypeCachePoint");
+    point->add_member(0, "x", factory->create_float64_type());
+    point->add_member(1, "y", factory->create_float64_type());
+    point->add_member(2, "z", factory->create_float64_type());
+
+    DynamicTypeBuilder_ptr pose = factory->create_struct_builder();
+    pose->set_name("TypeCachePose");
+    pose->add_member(0, "position", point->build());
+    pose->add_member(1, "orientation", point->build());
+
+    DynamicTypeBuilder_ptr sample = factory->create_struct_builder();
+    sample->set_name(s_type_name);
+    sample->add_member(0, "index", factory->create_uint32_type());
+    sample->add_member(1, "frame", factory->create_string_type());
+    sample->add_member(2, "pose", pose->build());
+    return sample->build();
+}
+
+class SubscriberApp : public DomainParticipantListener
+{
+public:
+
+    SubscriberApp(
+            uint32_t domain,
+            const std::string& cache_file)
+    {
+        DomainParticipantQos pqos;
+        pqos.wire_protocol().builtin.typelookup_config.use_client = true;
+        pqos.properties().properties().emplace_back("fastdds.typelookup.cache_file", cache_file);
+        pqos.name("type_cache_subscriber");
+
+        start_ = Clock::now();
+        participant_ = DomainParticipantFactory::get_instance()->create_participant(domain, pqos, this);
+    }
+
+    ~SubscriberApp()
+    {
+        if (participant_ != nullptr)
+        {
+            if (subscriber_ != nullptr)
+            {
+                if (reader_ != nullptr)
+                {
+                    subscriber_->delete_datareader(reader_);
+                }
+                participant_->delete_subscriber(subscriber_);
+            }
+            if (topic_ != nullptr)
+            {
+                participant_->delete_topic(topic_);
+            }
+            DomainParticipantFactory::get_instance()->delete_participant(participant_);
+        }
+    }
+
+    void on_type_information_received(
+            DomainParticipant* participant,
+            const string_255 topic_name,
+            const string_255 type_name,
+            const TypeInformation& type_information) override
+    {
+        if (topic_name.to_string() != s_topic_name)
+        {
+            return;
+        }
+
+        std::function<void(const std::string&, const DynamicType_ptr)> callback =
+                [this, participant](const std::string& name, const DynamicType_ptr type)
+                {
+                    on_type_registered(participant, name, type);
+                };
+        participant->register_remote_type(type_information, type_name.to_string(), callback);
+    }
+
+    void on_data_available(
+            DataReader* reader) override
+    {
+        SampleInfo info;
+        if (data_ && reader->take_next_sample(data_.get(), &info) == ReturnCode_t::RETCODE_OK)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (sample_ms_ == 0)
+            {
+                sample_ms_ = elapsed_ms(start_);
+            }
+            cv_.notify_all();
+        }
+    }
+
+    bool wait(
+            std::chrono::seconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return participant_ != nullptr && cv_.wait_for(lock, timeout, [&]()
+                       {
+                           return sample_ms_ > 0;
+                       });
+    }
+
+    double type_ms() const
+    {
+        return type_ms_;
+    }
+
+    double sample_ms() const
+    {
+        return sample_ms_;
+    }
+
+private:
+
+    void on_type_registered(
+            DomainParticipant* participant,
+            const std::string& name,
+            const DynamicType_ptr type)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (type_ms_ > 0 || !type)
+        {
+            return;
+        }
+        type_ms_ = elapsed_ms(start_);
+        data_ = DynamicData_ptr(DynamicDataFactory::get_instance()->create_data(type));
+
+        subscriber_ = participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT);
+        topic_ = participant->create_topic(s_topic_name, name, TOPIC_QOS_DEFAULT);
+        if (subscriber_ != nullptr && topic_ != nullptr)
+        {
+            DataReaderQos rqos = DATAREADER_QOS_DEFAULT;
+            rqos.durability().kind = TRANSIENT_LOCAL_DURABILITY_QOS;
+            rqos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+            reader_ = subscriber_->create_datareader(topic_, rqos, this);
+        }
+    }
+
+    DomainParticipant* participant_ = nullptr;
+    Subscriber* subscriber_ = nullptr;
+    Topic* topic_ = nullptr;
+    DataReader* reader_ = nullptr;
+    DynamicData_ptr data_;
+    Clock::time_point start_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    double type_ms_ = 0;
+    double sample_ms_ = 0;
+};
+
+static int run_subscriber(
+        uint32_t domain,
+        const std::string& cache_file)
+{
+    bool warm = file_exists(cache_file);
+    bool received = false;
+    double type_ms = 0;
+    double sample_ms = 0;
+    {
+        SubscriberApp app(domain, cache_file);
+        received = app.wait(std::chrono::seconds(20));
+        type_ms = app.type_ms();
+        sample_ms = app.sample_ms();
+    }
+
+    if (!received)
+    {
+        printf("%15s, no sample received\n", warm ? "warm" : "cold");
+        fflush(stdout);
+        return 1;
+    }
+
+    printf("%15s,%15.1f,%15.1f\n", warm ? "warm" : "cold", type_ms, sample_ms);
+    fflush(stdout);
+    return 0;
+}
+
+static int run_publisher(
+        uint32_t domain,
+        uint32_t runs,
+        const std::string& cache_file,
+        const std::string& program)
+{
+    DynamicType_ptr type = create_type();
+    TypeSupport type_support(new DynamicPubSubType(type));
+    // Only the TypeInformation is announced, so the subscribers resolve the type with TypeLookup requests
+    type_support->auto_fill_type_information(true);
+    type_support->auto_fill_type_object(false);
+
+    DomainParticipantQos pqos;
+    pqos.wire_protocol().builtin.typelookup_config.use_server = true;
+    pqos.name("type_cache_publisher");
+    DomainParticipant* participant = DomainParticipantFactory::get_instance()->create_participant(domain, pqos);
+    if (participant == nullptr)
+    {
+        printf("Error creating the publisher participant\n");
+        return 1;
+    }
+
+    DataWriter* writer = nullptr;
+    Publisher* publisher = nullptr;
+    Topic* topic = nullptr;
+    if (type_support.register_type(participant) == ReturnCode_t::RETCODE_OK)
+    {
+        publisher = participant->create_publisher(PUBLISHER_QOS_DEFAULT);
+        topic = participant->create_topic(s_topic_name, s_type_name, TOPIC_QOS_DEFAULT);
+    }
+    if (publisher != nullptr && topic != nullptr)
+    {
+        DataWriterQos wqos = DATAWRITER_QOS_DEFAULT;
+        wqos.durability().kind = TRANSIENT_LOCAL_DURABILITY_QOS;
+        wqos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+        writer = publisher->create_datawriter(topic, wqos);
+    }
+
+    DynamicData_ptr data(DynamicDataFactory::get_instance()->create_data(type));
+    data->set_string_value("map", 1);
+    bool all_ok = writer != nullptr && writer->write(data.get());
+    if (!all_ok)
+    {
+        printf("Error creating the publisher\n");
+    }
+
+    // Every subscriber receives the sample kept by the writer
+    std::string command = "\"" + program + "\" --subscriber --domain=" + std::to_string(domain) +
+            " --file=\"" + cache_file + "\"";
+
+    printf("\n");
+    printf("[          Cache][    Type (ms)][  Sample (ms)]\n");
+    printf("[---------------,---------------,---------------]\n");
+    fflush(stdout);
+
+    for (uint32_t run = 0; all_ok && run < runs; ++run)
+    {
+        std::remove(cache_file.c_str());
+        all_ok &= std::system(command.c_str()) == 0;
+        all_ok &= std::system(command.c_str()) == 0;
+    }
+    printf("\n");
+    std::remove(cache_file.c_str());
+
+    if (writer != nullptr)
+    {
+        publisher->delete_datawriter(writer);
+    }
+    if (publisher != nullptr)
+    {
+        participant->delete_publisher(publisher);
+    }
+    if (topic != nullptr)
+    {
+        participant->delete_topic(topic);
+    }
+    DomainParticipantFactory::get_instance()->delete_participant(participant);
+    return all_ok ? 0 : 1;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t runs = 5;
+    uint32_t domain = 0;
+    std::string cache_file = "TypeCacheTest.cache";
+    bool subscriber = false;
+    std::string program = argc > 0 ? argv[0] : "TypeCacheTest";
+
+    BenchmarkOptions options(usage, argc, argv);
+    if (!options.parsed())
+    {
+        return options.exit_code();
+    }
+
+    for (int i = 0; i < options.count(); ++i)
+    {
+        const option::Option& opt = options[i];
+        switch (opt.index())
+        {
+            case RUNS:
+                runs = strtol(opt.arg, nullptr, 10);
+                break;
+            case CACHE_FILE:
+                cache_file = opt.arg;
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            case SUBSCRIBER:
+                subscriber = true;
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage);
+                return 1;
+        }
+    }
+
+    if (subscriber)
+    {
+        return run_subscriber(domain, cache_file);
+    }
+
+    if (runs == 0)
+    {
+        runs = 1;
+    }
+
+    return run_publisher(domain, runs, cache_file, program);
+}
@@ -0,0 +1,209 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_TypeObjectTest.cpp
+ *
+ * Measures the latency of the first uses of the TypeObjectFactory (creation, first builtin annotation looked up by
+ * name and first lookup by TypeIdentifier) and the throughput of the lookups by name and by TypeIdentifier from
+ * one and several threads.
+ */
+
+#include "../BenchmarkOptions.hpp"
+
+#include <fastrtps/types/TypeObjectFactory.h>
+#include <fastrtps/types/TypeNamesGenerator.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps::types;
+
+using Clock = std::chrono::steady_clock;
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    ITERATIONS,
+    THREADS,
+    TYPES
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT, 0, "",  "",           Arg::None,    "Usage: TypeObjectTest [options]\n\nOptions:" },
+    { HELP,        0, "h", "help",       Arg::None,    "  -h         --help               Produce help message." },
+    { ITERATIONS,  0, "i", "iterations", Arg::Numeric, "  -i <num>,  --iterations=<num>   Lookups done by each thread (Default: 1000000)." },
+    { THREADS,     0, "t", "threads",    Arg::Numeric, "  -t <num>,  --threads=<num>      Threads on the concurrent runs (Default: 4)." },
+    { TYPES,       0, "n", "types",      Arg::Numeric, "  -n <num>,  --types=<num>        String types registered besides the builtin ones (Default: 256)." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+static double elapsed_us(
+        Clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+/**
+ * Runs the given lookup on each thread and returns the total lookups per second, or 0 if any of them failed.
+ */
+template<typename Lookup>
+static double lookups_per_second(
+        uint32_t threads,
+        uint32_t iterations,
+        const Lookup& lookup)
+{
+    std::atomic<bool> ok(true);
+    std::vector<std::thread> workers;
+    auto start = Clock::now();
+    for (uint32_t t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]()
+                {
+                    for (uint32_t i = 0; i < iterations; ++i)
+                    {
+                        if (!lookup(t + i))
+                        {
+                            ok = false;
+                            return;
+                        }
+                    }
+                });
+    }
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+    double seconds = elapsed_us(start) / 1e6;
+    return ok && seconds > 0 ? (static_cast<double>(threads) * iterations) / seconds : 0;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t iterations = 1000000;
+    uint32_t threads = 4;
+    uint32_t types = 256;
+
+    BenchmarkOptions options(usage, argc, argv);
+    if (!options.parsed())
+    {
+        return options.exit_code();
+    }
+
+    for (int i = 0; i < options.count(); ++i)
+    {
+        const option::Option& opt = options[i];
+        switch (opt.index())
+        {
+            case ITERATIONS:
+                iterations = strtol(opt.arg, nullptr, 10);
+                break;
+            case THREADS:
+                threads = strtol(opt.arg, nullptr, 10);
+                break;
+            case TYPES:
+                types = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage);
+                return 1;
+        }
+    }
+
+    if (threads == 0)
+    {
+        threads = 1;
+    }
+
+    if (iterations == 0)
+    {
+        iterations = 1;
+    }
+
+    // First uses
+    auto start = Clock::now();
+    TypeObjectFactory* factory = TypeObjectFactory::get_instance();
+    double creation_us = elapsed_us(start);
+
+    start = Clock::now();
+    const TypeIdentifier* key_identifier = factory->get_type_identifier("key", true);
+    double first_annotation_us = elapsed_us(start);
+
+    start = Clock::now();
+    const TypeObject* key_object = factory->get_type_object(key_identifier);
+    double first_identifier_us = elapsed_us(start);
+
+    if (key_identifier == nullptr || key_object == nullptr)
+    {
+        printf("Builtin annotation 'key' not found\n");
+        return 1;
+    }
+
+    // Names looked up: primitives, builtin annotations and registered types
+    std::vector<std::string> names = { TKNAME_INT32, TKNAME_FLOAT64, TKNAME_CHAR8, "key", "id", "extensibility" };
+    for (uint32_t i = 1; i <= types; ++i)
+    {
+        factory->get_string_identifier(i);
+        names.push_back(TypeNamesGenerator::get_string_type_name(i, false, false));
+    }
+    std::vector<const TypeIdentifier*> identifiers;
+    for (const std::string& name : names)
+    {
+        identifiers.push_back(factory->get_type_identifier(name));
+    }
+
+    auto by_name = [&](uint32_t i)
+            {
+                return factory->get_type_identifier(names[i % names.size()]) != nullptr;
+            };
+
+    // Only the annotations have a TypeObject, but all of them must be found
+    auto by_identifier = [&](uint32_t i)
+            {
+                const TypeIdentifier* identifier = identifiers[i % identifiers.size()];
+                return identifier != nullptr && factory->get_type_name(identifier) != "UNDEF";
+            };
+
+    double name_single = lookups_per_second(1, iterations, by_name);
+    double name_concurrent = lookups_per_second(threads, iterations, by_name);
+    // Reverse lookups walk the tables, so they do less iterations
+    uint32_t identifier_iterations = iterations / 10 > 0 ? iterations / 10 : 1;
+    double identifier_single = lookups_per_second(1, identifier_iterations, by_identifier);
+    double identifier_concurrent = lookups_per_second(threads, identifier_iterations, by_identifier);
+
+    printf("\n");
+    printf("Factory creation:                   %10.1f us\n", creation_us);
+    printf("First builtin annotation by name:   %10.1f us\n", first_annotation_us);
+    printf("First lookup by TypeIdentifier:     %10.1f us\n", first_identifier_us);
+    printf("\n");
+    printf("[        Lookup][   Threads][   Lookups/s]\n");
+    printf("[--------------,-----------,------------]\n");
+    printf("%15s,%11u,%12.0f\n", "name", 1u, name_single);
+    printf("%15s,%11u,%12.0f\n", "name", threads, name_concurrent);
+    printf("%15s,%11u,%12.0f\n", "identifier", 1u, identifier_single);
+    printf("%15s,%11u,%12.0f\n", "identifier", threads, identifier_concurrent);
+    printf("\n");
+    fflush(stdout);
+
+    TypeObjectFactory::delete_instance();
+
+    bool all_ok = name_single > 0 && name_concurrent > 0 && identifier_single > 0 && identifier_concurrent > 0;
+    return all_ok ? 0 : 1;
+}
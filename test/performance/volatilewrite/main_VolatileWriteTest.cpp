@@ -0,0 +1,314 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_VolatileWriteTest.cpp
+ *
+ * Measures the cost of writing on a synchronous, best-effort, volatile DataWriter, and the rate its matched
+ * DataReader receives samples at. A KEEP_LAST(1) writer sends its samples without keeping them on its history,
+ * while a KEEP_LAST(2) writer, otherwise identical, adds every sample to its history and removes it afterwards.
+ */
+
+#include "../BenchmarkOptions.hpp"
+
+#include <fastdds/dds/domain/DomainParticipant.hpp>
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/dds/publisher/DataWriter.hpp>
+#include <fastdds/dds/publisher/DataWriterListener.hpp>
+#include <fastdds/dds/publisher/Publisher.hpp>
+#include <fastdds/dds/publisher/qos/DataWriterQos.hpp>
+#include <fastdds/dds/subscriber/DataReader.hpp>
+#include <fastdds/dds/subscriber/DataReaderListener.hpp>
+#include <fastdds/dds/subscriber/SampleInfo.hpp>
+#include <fastdds/dds/subscriber/Subscriber.hpp>
+#include <fastdds/dds/subscriber/qos/DataReaderQos.hpp>
+#include <fastdds/dds/topic/TopicDataType.hpp>
+#include <fastdds/dds/topic/TypeSupport.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+using namespace eprosima::fastdds::dds;
+using namespace eprosima::fastrtps::rtps;
+
+using Clock = std::chrono::steady_clock;
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    SECONDS,
+    SIZE,
+    FORCED_DOMAIN
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT,   0, "",  "",        Arg::None,    "Usage: VolatileWriteTest [options]\n\nOptions:" },
+    { HELP,          0, "h", "help",    Arg::None,    "  -h        --help            Produce help message." },
+    { SECONDS,       0, "s", "seconds", Arg::Numeric, "  -s <num>, --seconds=<num>   Duration of each measure (Default: 2)." },
+    { SIZE,          0, "z", "size",    Arg::Numeric, "  -z <num>, --size=<num>      Size of the samples (Default: 64)." },
+    { FORCED_DOMAIN, 0, "",  "domain",  Arg::Numeric, "            --domain=<num>    Set the domain to connect (Default: 0)." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+//! Unkeyed type whose samples are a vector of bytes, serialized as they are
+class BytesType : public TopicDataType
+{
+public:
+
+    BytesType(
+            uint32_t size)
+    {
+        setName("VolatileWriteType");
+        m_typeSize = size;
+        m_isGetKeyDefined = false;
+    }
+
+    bool serialize(
+            void* data,
+            SerializedPayload_t* payload) override
+    {
+        std::vector<octet>* bytes = static_cast<std::vector<octet>*>(data);
+        memcpy(payload->data, bytes->data(), bytes->size());
+        payload->length = static_cast<uint32_t>(bytes->size());
+        return true;
+    }
+
+    bool deserialize(
+            SerializedPayload_t* payload,
+            void* data) override
+    {
+        std::vector<octet>* bytes = static_cast<std::vector<octet>*>(data);
+        bytes->assign(payload->data, payload->data + payload->length);
+        return true;
+    }
+
+    std::function<uint32_t()> getSerializedSizeProvider(
+            void* data) override
+    {
+        return [data]() -> uint32_t
+               {
+                   return static_cast<uint32_t>(static_cast<std::vector<octet>*>(data)->size());
+               };
+    }
+
+    void* createData() override
+    {
+        return new std::vector<octet>();
+    }
+
+    void deleteData(
+            void* data) override
+    {
+        delete static_cast<std::vector<octet>*>(data);
+    }
+
+    bool getKey(
+            void* /*data*/,
+            InstanceHandle_t* /*ihandle*/,
+            bool /*force_md5*/) override
+    {
+        return false;
+    }
+
+};
+
+class Listener : public DataWriterListener, public DataReaderListener
+{
+public:
+
+    void on_publication_matched(
+            DataWriter* /*writer*/,
+            const PublicationMatchedStatus& info) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        matched_ = info.current_count > 0;
+        cv_.notify_all();
+    }
+
+    void on_data_available(
+            DataReader* reader) override
+    {
+        SampleInfo info;
+        while (ReturnCode_t::RETCODE_OK == reader->take_next_sample(&sample_, &info))
+        {
+            ++received_;
+        }
+    }
+
+    bool wait(
+            std::chrono::seconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [&]()
+                       {
+                           return matched_;
+                       });
+    }
+
+    std::atomic<uint64_t> received_{0};
+
+private:
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool matched_ = false;
+    std::vector<octet> sample_;
+};
+
+struct Result
+{
+    double write_us = 0;
+    double received = 0;
+};
+
+/**
+ * Write samples of the given size during the given time, on a writer with the given history depth.
+ * @return Average duration of a write, and samples received per second. All 0 on error.
+ */
+static Result measure(
+        DomainParticipant* participant,
+        Topic* topic,
+        int32_t depth,
+        uint32_t size,
+        uint32_t seconds)
+{
+    Result result;
+    Listener listener;
+
+    Publisher* publisher = participant->create_publisher(PUBLISHER_QOS_DEFAULT);
+    Subscriber* subscriber = participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT);
+
+    DataWriterQos wqos = DATAWRITER_QOS_DEFAULT;
+    wqos.reliability().kind = BEST_EFFORT_RELIABILITY_QOS;
+    wqos.durability().kind = VOLATILE_DURABILITY_QOS;
+    wqos.history().kind = KEEP_LAST_HISTORY_QOS;
+    wqos.history().depth = depth;
+    wqos.publish_mode().kind = SYNCHRONOUS_PUBLISH_MODE;
+    DataReaderQos rqos = DATAREADER_QOS_DEFAULT;
+    rqos.reliability().kind = BEST_EFFORT_RELIABILITY_QOS;
+    rqos.durability().kind = VOLATILE_DURABILITY_QOS;
+
+    DataReader* reader = subscriber->create_datareader(topic, rqos, &listener);
+    DataWriter* writer = publisher->create_datawriter(topic, wqos, &listener);
+
+    if (reader != nullptr && writer != nullptr && listener.wait(std::chrono::seconds(10)))
+    {
+        std::vector<octet> sample(size, 0);
+        uint64_t written = 0;
+        Clock::duration writing(0);
+
+        auto start = Clock::now();
+        auto end = start + std::chrono::seconds(seconds);
+        while (Clock::now() < end)
+        {
+            auto t0 = Clock::now();
+            writer->write(&sample);
+            writing += Clock::now() - t0;
+            ++written;
+        }
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        result.write_us = std::chrono::duration<double, std::micro>(writing).count() / written;
+        result.received = listener.received_ / elapsed;
+    }
+    else
+    {
+        printf("Error matching the endpoints\n");
+    }
+
+    publisher->delete_datawriter(writer);
+    subscriber->delete_datareader(reader);
+    participant->delete_publisher(publisher);
+    participant->delete_subscriber(subscriber);
+
+    return result;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t seconds = 2;
+    uint32_t size = 64;
+    uint32_t domain = 0;
+
+    BenchmarkOptions options(usage, argc, argv);
+    if (!options.parsed())
+    {
+        return options.exit_code();
+    }
+
+    for (int i = 0; i < options.count(); ++i)
+    {
+        const option::Option& opt = options[i];
+        switch (opt.index())
+        {
+            case SECONDS:
+                seconds = strtol(opt.arg, nullptr, 10);
+                break;
+            case SIZE:
+                size = strtol(opt.arg, nullptr, 10);
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                option::printUsage(fwrite, stdout, usage);
+                return 1;
+        }
+    }
+
+    seconds = seconds > 0 ? seconds : 1;
+    size = size > 0 ? size : 1;
+
+    DomainParticipant* participant = DomainParticipantFactory::get_instance()->create_participant(domain);
+    if (participant == nullptr)
+    {
+        printf("Error creating the participant\n");
+        return 1;
+    }
+
+    TypeSupport type(new BytesType(size));
+    Topic* topic = nullptr;
+    if (ReturnCode_t::RETCODE_OK == participant->register_type(type))
+    {
+        topic = participant->create_topic("VolatileWriteTopic", type.get_type_name(), TOPIC_QOS_DEFAULT);
+    }
+    if (topic == nullptr)
+    {
+        printf("Error creating the topic\n");
+        DomainParticipantFactory::get_instance()->delete_participant(participant);
+        return 1;
+    }
+
+    Result with_history = measure(participant, topic, 2, size, seconds);
+    Result without_history = measure(participant, topic, 1, size, seconds);
+
+    printf("\n");
+    printf("[   History][  Write(us)][  Received/s]\n");
+    printf("[----------,-----------,------------]\n");
+    printf("%11s,%11.3f,%12.0f\n", "KEEP_LAST 2", with_history.write_us, with_history.received);
+    printf("%11s,%11.3f,%12.0f\n", "KEEP_LAST 1", without_history.write_us, without_history.received);
+    printf("\n");
+
+    participant->delete_topic(topic);
+    DomainParticipantFactory::get_instance()->delete_participant(participant);
+
+    return with_history.received > 0 && without_history.received > 0 ? 0 : 1;
+}
@@ -23,9 +23,14 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+
+#if defined(FASTDDS_ALLOCATION_TRACER)
+#include "tracer/AllocationTracer.h"
+#else
 #include "osrf_testing_tools_cpp/memory_tools/memory_tools.hpp"
 
 using MemoryToolsService = osrf_testing_tools_cpp::memory_tools::MemoryToolsService;
+#endif // if defined(FASTDDS_ALLOCATION_TRACER)
 
 namespace eprosima_profiling
 {
@@ -46,6 +51,64 @@ void callgrind_dump()
 {
 }
 
+#if defined(FASTDDS_ALLOCATION_TRACER)
+
+/*
+ * The tracer only records the data exchange phase, which should not allocate once the first sample has been
+ * exchanged, and keeps the stack of every allocation instead of counting them.
+ */
+
+void entities_created(
+        bool,
+        bool)
+{
+}
+
+void discovery_finished()
+{
+}
+
+void first_sample_exchanged()
+{
+    AllocationTracer::start();
+}
+
+void all_samples_exchanged()
+{
+    AllocationTracer::stop();
+}
+
+void undiscovery_finished()
+{
+}
+
+size_t data_exchange_allocations()
+{
+    return AllocationTracer::hot_path_allocations();
+}
+
+void print_results(
+        const std::string& file_prefix,
+        const std::string& entity,
+        const std::string& config)
+{
+    std::string output_filename = file_prefix;
+    if (file_prefix.length() == 0)
+    {
+        output_filename = "alloc_trace_" + entity + "_" + config + ".txt";
+    }
+
+    std::ofstream outFile;
+    outFile.open(output_filename, std::ofstream::app);
+    AllocationTracer::report(outFile, true);
+    outFile.close();
+
+    std::cout << AllocationTracer::hot_path_allocations() << " allocations on hot-path threads during data exchange. "
+              << "See " << output_filename << std::endl;
+}
+
+#else
+
 static bool g_print_alloc_traces = false;
 static bool g_print_dealloc_traces = false;
 static bool g_print_results = true;
@@ -155,6 +218,11 @@ void undiscovery_finished()
     EXPECT_NO_MEMORY_OPERATIONS_END();
 }
 
+size_t data_exchange_allocations()
+{
+    return g_allocations[2].load();
+}
+
 /**
  * Print memory profiling results.
  */
@@ -208,4 +276,6 @@ void print_results(
     outFile.close();
 }
 
+#endif // if defined(FASTDDS_ALLOCATION_TRACER)
+
 }   // namespace eprosima_profiling
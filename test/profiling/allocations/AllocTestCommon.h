@@ -20,6 +20,7 @@
 #ifndef FASTRTPS_TEST_PROFILING_ALLOCATIONS_ALLOCTESTCOMMON_H_
 #define FASTRTPS_TEST_PROFILING_ALLOCATIONS_ALLOCTESTCOMMON_H_
 
+#include <cstddef>
 #include <string>
 
 namespace eprosima_profiling
@@ -67,6 +68,12 @@ void all_samples_exchanged();
  */
 void undiscovery_finished();
 
+/**
+ * Allocations made by the library while exchanging samples, i.e. after the first sample was exchanged.
+ * When built with the allocation tracer, only the ones made on hot-path threads are counted.
+ */
+size_t data_exchange_allocations();
+
 /**
  * Print memory profiling results.
  */
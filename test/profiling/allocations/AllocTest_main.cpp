@@ -17,6 +17,7 @@
  *
  */
 
+#include "AllocTestCommon.h"
 #include "AllocTestPublisher.h"
 #include "AllocTestSubscriber.h"
 
@@ -33,6 +34,7 @@ int main(int argc, char** argv)
     int type = 1;
     int domain = 1;
     bool wait_unmatch = false;
+    bool check_allocations = false;
     const char* profile = "tl_be";
     std::string outputFile = "";
     if(argc > 2)
@@ -54,6 +56,8 @@ int main(int argc, char** argv)
         {
             outputFile = argv[5];
         }
+
+        check_allocations = (argc > 6) && (strcmp(argv[6], "true") == 0);
     }
     else
     {
@@ -65,7 +69,9 @@ int main(int argc, char** argv)
             << "        tl_be: transient-local best-effort" << std::endl
             << "        tl_re: transient-local reliable" << std::endl
             << "        vo_be: volatile best-effort" << std::endl
-            << "        vo_re: volatile reliable" << std::endl;
+            << "        vo_re: volatile reliable" << std::endl
+            << "        vo_be_fc: volatile best-effort, flow controlled" << std::endl
+            << "        vo_re_fc: volatile reliable, flow controlled" << std::endl;
         eprosima::fastdds::dds::Log::Reset();
         return 0;
     }
@@ -96,5 +102,15 @@ int main(int argc, char** argv)
     Domain::stopAll();
     eprosima::fastdds::dds::Log::Reset();
 
+    if (check_allocations)
+    {
+        size_t allocations = eprosima_profiling::data_exchange_allocations();
+        if (allocations > 0)
+        {
+            std::cout << "ERROR: " << allocations << " allocations while exchanging samples" << std::endl;
+            return 1;
+        }
+    }
+
     return 0;
 }
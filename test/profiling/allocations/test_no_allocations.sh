@@ -0,0 +1,35 @@
+#!/bin/sh
+
+## Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+##
+## Licensed under the Apache License, Version 2.0 (the "License");
+## you may not use this file except in compliance with the License.
+## You may obtain a copy of the License at
+##
+##     http:##www.apache.org/licenses/LICENSE-2.0
+##
+## Unless required by applicable law or agreed to in writing, software
+## distributed under the License is distributed on an "AS IS" BASIS,
+## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+## See the License for the specific language governing permissions and
+## limitations under the License.
+
+############################################################################################
+# This script runs the allocation trace test on the given profile, and fails when the
+# publisher allocates on a hot-path thread once the first sample has been sent.
+#
+# Usage: test_no_allocations.sh <AllocationTraceTest executable> <profile> <domain>
+############################################################################################
+
+test_bin=$1
+profile=$2
+domain=$3
+
+$test_bin subscriber $profile true $domain &
+subscriber_pid=$!
+
+$test_bin publisher $profile false $domain "" true
+result=$?
+
+wait $subscriber_pid
+exit $result
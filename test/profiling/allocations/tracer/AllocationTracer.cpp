@@ -0,0 +1,524 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file AllocationTracer.cpp
+ *
+ */
+
+#include "AllocationTracer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <new>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <cxxabi.h>
+#include <execinfo.h>
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(
+        size_t size);
+void* __libc_calloc(
+        size_t count,
+        size_t size);
+void* __libc_realloc(
+        void* ptr,
+        size_t size);
+void __libc_free(
+        void* ptr);
+}   // extern "C"
+#define TRACER_ALLOC(size) __libc_malloc(size)
+#define TRACER_FREE(ptr) __libc_free(ptr)
+#else
+#define TRACER_ALLOC(size) std::malloc(size)
+#define TRACER_FREE(ptr) std::free(ptr)
+#endif // if defined(__GLIBC__)
+
+namespace eprosima_profiling
+{
+
+//! Maximum number of allocations whose stack is kept.
+static constexpr size_t max_records = 4096;
+
+//! Maximum number of frames kept for each allocation.
+static constexpr int max_depth = 40;
+
+//! Frames of the tracer itself at the top of every stack.
+static constexpr int hook_frames = 2;
+
+struct TraceRecord
+{
+    size_t size;
+    uint32_t thread;
+    int depth;
+    void* frames[max_depth];
+};
+
+static TraceRecord g_records[max_records];
+static std::atomic_size_t g_next_record(0u);
+static std::atomic_size_t g_allocations(0u);
+static std::atomic_size_t g_deallocations(0u);
+static std::atomic_bool g_tracing(false);
+static std::atomic<uint32_t> g_next_thread(0u);
+
+// Initial-exec TLS is never allocated on demand, so it can be used from inside malloc.
+static thread_local bool t_in_tracer __attribute__((tls_model("initial-exec"))) = false;
+static thread_local uint32_t t_thread __attribute__((tls_model("initial-exec"))) = 0u;
+
+/**
+ * Keeps the reentrancy flag raised while the tracer is running its own code, so allocations made by backtrace()
+ * or by the report are not recorded.
+ */
+class TracerScope
+{
+public:
+
+    TracerScope()
+        : was_inside_(t_in_tracer)
+    {
+        t_in_tracer = true;
+    }
+
+    ~TracerScope()
+    {
+        t_in_tracer = was_inside_;
+    }
+
+private:
+
+    bool was_inside_;
+};
+
+__attribute__((noinline)) static void record_allocation(
+        size_t size)
+{
+    if (!g_tracing.load(std::memory_order_relaxed) || t_in_tracer)
+    {
+        return;
+    }
+
+    TracerScope scope;
+    ++g_allocations;
+    if (t_thread == 0u)
+    {
+        t_thread = ++g_next_thread;
+    }
+
+    size_t index = g_next_record++;
+    if (index < max_records)
+    {
+        TraceRecord& record = g_records[index];
+        record.size = size;
+        record.thread = t_thread;
+        record.depth = backtrace(record.frames, max_depth);
+    }
+}
+
+static inline void record_deallocation(
+        void* ptr)
+{
+    if (ptr != nullptr && g_tracing.load(std::memory_order_relaxed) && !t_in_tracer)
+    {
+        ++g_deallocations;
+    }
+}
+
+enum class ThreadKind
+{
+    RECEPTION,
+    EVENTS,
+    ASYNC_WRITER,
+    USER_WRITE,
+    USER_TAKE,
+    OTHER
+};
+
+static const char* thread_kind_name(
+        ThreadKind kind)
+{
+    switch (kind)
+    {
+        case ThreadKind::RECEPTION:
+            return "reception";
+        case ThreadKind::EVENTS:
+            return "events";
+        case ThreadKind::ASYNC_WRITER:
+            return "async writer";
+        case ThreadKind::USER_WRITE:
+            return "user write";
+        case ThreadKind::USER_TAKE:
+            return "user take";
+        default:
+            return "other";
+    }
+}
+
+struct ThreadPattern
+{
+    ThreadKind kind;
+    const char* symbol;
+};
+
+/**
+ * Parts of the mangled names of the functions that identify each hot-path thread. Entry points of the internal
+ * threads are checked before the user API, as a listener called from the reception thread may call write or take.
+ */
+static const ThreadPattern thread_patterns[] =
+{
+    { ThreadKind::RECEPTION, "perform_listen_operation" },
+    { ThreadKind::EVENTS, "ResourceEvent13event_service" },
+    { ThreadKind::ASYNC_WRITER, "AsyncWriterThread3run" },
+    { ThreadKind::USER_WRITE, "Publisher5write" },
+    { ThreadKind::USER_WRITE, "PublisherImpl14create_new_change" },
+    { ThreadKind::USER_WRITE, "DataWriter5write" },
+    { ThreadKind::USER_WRITE, "DataWriterImpl17create_new_change" },
+    { ThreadKind::USER_TAKE, "takeNextData" },
+    { ThreadKind::USER_TAKE, "readNextData" },
+    { ThreadKind::USER_TAKE, "take_next_sample" },
+    { ThreadKind::USER_TAKE, "read_next_sample" },
+};
+
+static ThreadKind classify(
+        char** symbols,
+        int depth)
+{
+    for (const ThreadPattern& pattern : thread_patterns)
+    {
+        for (int i = hook_frames; i < depth; ++i)
+        {
+            if (std::strstr(symbols[i], pattern.symbol) != nullptr)
+            {
+                return pattern.kind;
+            }
+        }
+    }
+
+    return ThreadKind::OTHER;
+}
+
+/**
+ * Turn a line of backtrace_symbols(), like "libfastrtps.so(_ZN8eprosima...+0x1c) [0x7f...]", into a readable one.
+ */
+static std::string demangle(
+        const char* symbol)
+{
+    const char* begin = std::strchr(symbol, '(');
+    const char* end = begin != nullptr ? std::strchr(begin, '+') : nullptr;
+    if (begin == nullptr || end == nullptr || end == begin + 1)
+    {
+        return symbol;
+    }
+
+    std::string mangled(begin + 1, end);
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+    if (status != 0 || demangled == nullptr)
+    {
+        return symbol;
+    }
+
+    std::string result = std::string(demangled) + " [" + std::string(symbol, begin) + "]";
+    std::free(demangled);
+    return result;
+}
+
+struct StackGroup
+{
+    size_t count = 0;
+    size_t bytes = 0;
+    ThreadKind kind = ThreadKind::OTHER;
+    std::set<uint32_t> threads;
+};
+
+using StackGroups = std::map<std::vector<void*>, StackGroup>;
+
+static size_t recorded()
+{
+    return std::min(g_next_record.load(), max_records);
+}
+
+static void group_records(
+        StackGroups& groups)
+{
+    size_t count = recorded();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const TraceRecord& record = g_records[i];
+        StackGroup& group = groups[std::vector<void*>(record.frames, record.frames + record.depth)];
+        ++group.count;
+        group.bytes += record.size;
+        group.threads.insert(record.thread);
+    }
+
+    for (auto& group : groups)
+    {
+        int depth = static_cast<int>(group.first.size());
+        char** symbols = backtrace_symbols(group.first.data(), depth);
+        if (symbols != nullptr)
+        {
+            group.second.kind = classify(symbols, depth);
+            std::free(symbols);
+        }
+    }
+}
+
+void AllocationTracer::start()
+{
+    TracerScope scope;
+
+    // First call to backtrace() loads libgcc, which allocates
+    void* frames[max_depth];
+    backtrace(frames, max_depth);
+
+    g_tracing = false;
+    g_next_record = 0u;
+    g_allocations = 0u;
+    g_deallocations = 0u;
+    g_tracing = true;
+}
+
+void AllocationTracer::stop()
+{
+    g_tracing = false;
+}
+
+size_t AllocationTracer::allocations()
+{
+    return g_allocations.load();
+}
+
+size_t AllocationTracer::deallocations()
+{
+    return g_deallocations.load();
+}
+
+size_t AllocationTracer::hot_path_allocations()
+{
+    TracerScope scope;
+    StackGroups groups;
+    group_records(groups);
+
+    size_t count = 0;
+    for (const auto& group : groups)
+    {
+        if (group.second.kind != ThreadKind::OTHER)
+        {
+            count += group.second.count;
+        }
+    }
+    return count;
+}
+
+void AllocationTracer::report(
+        std::ostream& out,
+        bool all_threads)
+{
+    TracerScope scope;
+    StackGroups groups;
+    group_records(groups);
+
+    size_t per_kind[static_cast<size_t>(ThreadKind::OTHER) + 1] = {};
+    std::vector<StackGroups::const_iterator> sorted;
+    for (auto it = groups.cbegin(); it != groups.cend(); ++it)
+    {
+        per_kind[static_cast<size_t>(it->second.kind)] += it->second.count;
+        if (all_threads || it->second.kind != ThreadKind::OTHER)
+        {
+            sorted.push_back(it);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end(),
+            [](const StackGroups::const_iterator& a, const StackGroups::const_iterator& b)
+            {
+                return a->second.count > b->second.count;
+            });
+
+    out << "Allocation trace: " << g_allocations.load() << " allocations, " << g_deallocations.load() <<
+        " deallocations";
+    if (g_allocations.load() > max_records)
+    {
+        out << " (only the first " << max_records << " allocations have been recorded)";
+    }
+    out << std::endl;
+    for (size_t kind = 0; kind <= static_cast<size_t>(ThreadKind::OTHER); ++kind)
+    {
+        out << "  " << thread_kind_name(static_cast<ThreadKind>(kind)) << ": " << per_kind[kind] << std::endl;
+    }
+
+    for (const auto& it : sorted)
+    {
+        const StackGroup& group = it->second;
+        out << std::endl << group.count << " allocations (" << group.bytes << " bytes) on " <<
+            thread_kind_name(group.kind) << " thread";
+        for (uint32_t thread : group.threads)
+        {
+            out << " #" << thread;
+        }
+        out << std::endl;
+
+        int depth = static_cast<int>(it->first.size());
+        char** symbols = backtrace_symbols(it->first.data(), depth);
+        if (symbols == nullptr)
+        {
+            continue;
+        }
+        for (int i = hook_frames; i < depth; ++i)
+        {
+            out << "    " << demangle(symbols[i]) << std::endl;
+        }
+        std::free(symbols);
+    }
+}
+
+}   // namespace eprosima_profiling
+
+using eprosima_profiling::record_allocation;
+using eprosima_profiling::record_deallocation;
+
+// On glibc every allocation of the process goes through these, including the ones made by operator new in
+// other libraries. Elsewhere only operator new and delete are traced.
+#if defined(__GLIBC__)
+extern "C" {
+
+void* malloc(
+        size_t size)
+{
+    void* ptr = __libc_malloc(size);
+    record_allocation(size);
+    return ptr;
+}
+
+void* calloc(
+        size_t count,
+        size_t size)
+{
+    void* ptr = __libc_calloc(count, size);
+    record_allocation(count * size);
+    return ptr;
+}
+
+void* realloc(
+        void* ptr,
+        size_t size)
+{
+    void* new_ptr = __libc_realloc(ptr, size);
+    record_allocation(size);
+    return new_ptr;
+}
+
+void free(
+        void* ptr)
+{
+    record_deallocation(ptr);
+    __libc_free(ptr);
+}
+
+}   // extern "C"
+#endif // if defined(__GLIBC__)
+
+static inline void* traced_new(
+        size_t size)
+{
+    void* ptr = TRACER_ALLOC(size == 0 ? 1 : size);
+    record_allocation(size);
+    return ptr;
+}
+
+static inline void traced_delete(
+        void* ptr) noexcept
+{
+    record_deallocation(ptr);
+    TRACER_FREE(ptr);
+}
+
+void* operator new(
+        size_t size)
+{
+    void* ptr = traced_new(size);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](
+        size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(
+        size_t size,
+        const std::nothrow_t&) noexcept
+{
+    return traced_new(size);
+}
+
+void* operator new[](
+        size_t size,
+        const std::nothrow_t&) noexcept
+{
+    return traced_new(size);
+}
+
+void operator delete(
+        void* ptr) noexcept
+{
+    traced_delete(ptr);
+}
+
+void operator delete[](
+        void* ptr) noexcept
+{
+    traced_delete(ptr);
+}
+
+void operator delete(
+        void* ptr,
+        const std::nothrow_t&) noexcept
+{
+    traced_delete(ptr);
+}
+
+void operator delete[](
+        void* ptr,
+        const std::nothrow_t&) noexcept
+{
+    traced_delete(ptr);
+}
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(
+        void* ptr,
+        size_t) noexcept
+{
+    traced_delete(ptr);
+}
+
+void operator delete[](
+        void* ptr,
+        size_t) noexcept
+{
+    traced_delete(ptr);
+}
+#endif // if defined(__cpp_sized_deallocation)
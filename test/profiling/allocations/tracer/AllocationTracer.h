@@ -0,0 +1,85 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file AllocationTracer.h
+ *
+ */
+
+#ifndef FASTRTPS_TEST_PROFILING_ALLOCATIONS_TRACER_ALLOCATIONTRACER_H_
+#define FASTRTPS_TEST_PROFILING_ALLOCATIONS_TRACER_ALLOCATIONTRACER_H_
+
+#include <cstddef>
+#include <ostream>
+
+namespace eprosima_profiling
+{
+
+/**
+ * Heap allocation tracer for the realtime allocation tests.
+ *
+ * Linking the allocation_tracer library replaces the global operator new / delete and, on glibc, malloc, calloc,
+ * realloc and free of the whole process. While tracing is started, the call stack and the thread of every
+ * allocation are recorded on a preallocated table, so the tracer itself never allocates on the hooks.
+ *
+ * The report groups the recorded allocations by call stack, and tells which hot-path thread they come from
+ * (reception, events, asynchronous writer, user write or user take/read), by looking for the functions those
+ * threads run on the stack. Allocations on any other thread (discovery of a new participant, logging, the test
+ * itself) are only counted.
+ */
+class AllocationTracer
+{
+public:
+
+    /**
+     * Start recording allocations. Should be called once the participants are on steady state.
+     * Previously recorded allocations are discarded.
+     */
+    static void start();
+
+    /**
+     * Stop recording allocations.
+     */
+    static void stop();
+
+    /**
+     * @return Number of allocations recorded since start().
+     */
+    static size_t allocations();
+
+    /**
+     * @return Number of deallocations seen since start().
+     */
+    static size_t deallocations();
+
+    /**
+     * Classify the recorded allocations.
+     * @return Number of recorded allocations made by a hot-path thread.
+     */
+    static size_t hot_path_allocations();
+
+    /**
+     * Print the recorded allocations grouped by call stack, with the symbols of each frame.
+     * Should be called after stop().
+     * @param out Stream where the report is written.
+     * @param all_threads Whether to also print the allocations not made by a hot-path thread.
+     */
+    static void report(
+            std::ostream& out,
+            bool all_threads = false);
+};
+
+}   // namespace eprosima_profiling
+
+#endif   // FASTRTPS_TEST_PROFILING_ALLOCATIONS_TRACER_ALLOCATIONTRACER_H_
@@ -0,0 +1,766 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file LockProfiler.cpp
+ *
+ */
+
+#include "LockProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 30))
+#define PROFILER_CLOCK_FUNCTIONS 1
+#else
+#define PROFILER_CLOCK_FUNCTIONS 0
+#endif // if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 30))
+
+namespace eprosima_profiling
+{
+
+//! Maximum number of lock sites. Must be a power of two.
+static constexpr size_t max_sites = 4096;
+
+//! Maximum number of mutexes a thread may hold at the same time and still be profiled.
+static constexpr size_t max_held = 32;
+
+//! Maximum number of frames kept to name a site.
+static constexpr int max_depth = 16;
+
+//! Frames of the profiler itself at the top of every stack.
+static constexpr int hook_frames = 3;
+
+//! Bucket i of the histograms counts the times in [2^i, 2^(i+1)) nanoseconds. The last one is unbounded.
+static constexpr size_t histogram_buckets = 32;
+
+struct Histogram
+{
+    std::atomic<uint64_t> buckets[histogram_buckets];
+
+    void add(
+            uint64_t ns)
+    {
+        size_t bucket = 0;
+        while (ns > 1 && bucket < histogram_buckets - 1)
+        {
+            ns >>= 1;
+            ++bucket;
+        }
+        buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+struct LockSite
+{
+    std::atomic<bool> used;
+    pthread_mutex_t* mutex;
+    void* caller;
+    int depth;
+    void* frames[max_depth];
+
+    std::atomic<uint64_t> acquisitions;
+    std::atomic<uint64_t> contended;
+    std::atomic<uint64_t> wait_ns;
+    std::atomic<uint64_t> wait_max_ns;
+    std::atomic<uint64_t> hold_ns;
+    std::atomic<uint64_t> hold_max_ns;
+    Histogram wait;
+    Histogram hold;
+};
+
+struct HeldLock
+{
+    pthread_mutex_t* mutex;
+    LockSite* site;
+    uint64_t since;
+    bool reentered;
+};
+
+static LockSite g_sites[max_sites];
+static std::atomic_flag g_sites_lock = ATOMIC_FLAG_INIT;
+static std::atomic<uint64_t> g_dropped(0u);
+static std::atomic_bool g_profiling(false);
+static size_t g_report_sites = 20;
+
+// Initial-exec TLS is never allocated on demand, so it can be used from inside the hooks.
+static thread_local bool t_in_profiler __attribute__((tls_model("initial-exec"))) = false;
+static thread_local HeldLock t_held[max_held] __attribute__((tls_model("initial-exec")));
+static thread_local size_t t_held_count __attribute__((tls_model("initial-exec"))) = 0u;
+// Mutex whose trylock failed, and when, so the spinning before the final lock counts as waiting.
+static thread_local pthread_mutex_t* t_waiting_mutex __attribute__((tls_model("initial-exec"))) = nullptr;
+static thread_local uint64_t t_waiting_since __attribute__((tls_model("initial-exec"))) = 0u;
+
+/**
+ * Keeps the reentrancy flag raised while the profiler is running its own code, so the mutexes taken by backtrace()
+ * or by the report are not recorded.
+ */
+class ProfilerScope
+{
+public:
+
+    ProfilerScope()
+        : was_inside_(t_in_profiler)
+    {
+        t_in_profiler = true;
+    }
+
+    ~ProfilerScope()
+    {
+        t_in_profiler = was_inside_;
+    }
+
+private:
+
+    bool was_inside_;
+};
+
+static inline bool profiling()
+{
+    return g_profiling.load(std::memory_order_relaxed) && !t_in_profiler;
+}
+
+static inline uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+static inline void update_max(
+        std::atomic<uint64_t>& max,
+        uint64_t value)
+{
+    uint64_t current = max.load(std::memory_order_relaxed);
+    while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+static inline size_t site_index(
+        pthread_mutex_t* mutex,
+        void* caller)
+{
+    uint64_t hash = (reinterpret_cast<uintptr_t>(mutex) >> 4) ^
+            (reinterpret_cast<uintptr_t>(caller) * 0x9E3779B97F4A7C15ull);
+    return static_cast<size_t>(hash ^ (hash >> 29)) & (max_sites - 1);
+}
+
+__attribute__((noinline)) static LockSite* create_site(
+        pthread_mutex_t* mutex,
+        void* caller,
+        size_t index)
+{
+    ProfilerScope scope;
+    while (g_sites_lock.test_and_set(std::memory_order_acquire))
+    {
+    }
+
+    // Another thread may have created the site, or taken the slot, meanwhile
+    LockSite* result = nullptr;
+    for (size_t probe = 0; probe < max_sites && result == nullptr; ++probe, index = (index + 1) & (max_sites - 1))
+    {
+        LockSite& site = g_sites[index];
+        if (!site.used.load(std::memory_order_acquire))
+        {
+            site.mutex = mutex;
+            site.caller = caller;
+            site.depth = backtrace(site.frames, max_depth);
+            site.used.store(true, std::memory_order_release);
+            result = &site;
+        }
+        else if (site.mutex == mutex && site.caller == caller)
+        {
+            result = &site;
+        }
+    }
+
+    g_sites_lock.clear(std::memory_order_release);
+    return result;
+}
+
+static LockSite* find_site(
+        pthread_mutex_t* mutex,
+        void* caller)
+{
+    size_t index = site_index(mutex, caller);
+    for (size_t probe = 0; probe < max_sites; ++probe, index = (index + 1) & (max_sites - 1))
+    {
+        LockSite& site = g_sites[index];
+        if (!site.used.load(std::memory_order_acquire))
+        {
+            return create_site(mutex, caller, index);
+        }
+        if (site.mutex == mutex && site.caller == caller)
+        {
+            return &site;
+        }
+    }
+    return nullptr;
+}
+
+static HeldLock* find_held(
+        pthread_mutex_t* mutex)
+{
+    for (size_t i = t_held_count; i > 0; --i)
+    {
+        if (t_held[i - 1].mutex == mutex)
+        {
+            return &t_held[i - 1];
+        }
+    }
+    return nullptr;
+}
+
+static void on_acquired(
+        pthread_mutex_t* mutex,
+        uint64_t start,
+        bool contended,
+        void* caller)
+{
+    uint64_t now = now_ns();
+    if (t_waiting_mutex == mutex)
+    {
+        start = t_waiting_since;
+        contended = true;
+    }
+    t_waiting_mutex = nullptr;
+
+    if (t_held_count >= max_held)
+    {
+        g_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Acquisitions of a recursive mutex already held by the thread are not accounted
+    bool reentered = find_held(mutex) != nullptr;
+    LockSite* site = reentered ? nullptr : find_site(mutex, caller);
+    if (!reentered && site == nullptr)
+    {
+        g_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    HeldLock& held = t_held[t_held_count++];
+    held.mutex = mutex;
+    held.site = site;
+    held.since = now;
+    held.reentered = reentered;
+
+    if (site != nullptr)
+    {
+        uint64_t wait = now - start;
+        site->acquisitions.fetch_add(1, std::memory_order_relaxed);
+        if (contended)
+        {
+            site->contended.fetch_add(1, std::memory_order_relaxed);
+        }
+        site->wait_ns.fetch_add(wait, std::memory_order_relaxed);
+        update_max(site->wait_max_ns, wait);
+        site->wait.add(wait);
+    }
+}
+
+static void record_hold(
+        const HeldLock& held)
+{
+    if (held.site != nullptr)
+    {
+        uint64_t hold = now_ns() - held.since;
+        held.site->hold_ns.fetch_add(hold, std::memory_order_relaxed);
+        update_max(held.site->hold_max_ns, hold);
+        held.site->hold.add(hold);
+    }
+}
+
+static void on_released(
+        pthread_mutex_t* mutex)
+{
+    t_waiting_mutex = nullptr;
+    HeldLock* held = find_held(mutex);
+    if (held == nullptr)
+    {
+        return;
+    }
+
+    if (!held->reentered)
+    {
+        record_hold(*held);
+    }
+
+    for (HeldLock* next = held + 1; next < t_held + t_held_count; ++next)
+    {
+        *(next - 1) = *next;
+    }
+    --t_held_count;
+}
+
+template<typename Function>
+static Function real_function(
+        std::atomic<Function>& function,
+        const char* name)
+{
+    Function result = function.load(std::memory_order_relaxed);
+    if (result == nullptr)
+    {
+        result = reinterpret_cast<Function>(dlsym(RTLD_NEXT, name));
+        function.store(result, std::memory_order_relaxed);
+    }
+    return result;
+}
+
+using LockFunction = int (*)(pthread_mutex_t*);
+using TimedLockFunction = int (*)(pthread_mutex_t*, const struct timespec*);
+using CondWaitFunction = int (*)(pthread_cond_t*, pthread_mutex_t*);
+using CondTimedWaitFunction = int (*)(pthread_cond_t*, pthread_mutex_t*, const struct timespec*);
+
+static std::atomic<LockFunction> g_lock(nullptr);
+static std::atomic<LockFunction> g_trylock(nullptr);
+static std::atomic<LockFunction> g_unlock(nullptr);
+static std::atomic<TimedLockFunction> g_timedlock(nullptr);
+static std::atomic<CondWaitFunction> g_cond_wait(nullptr);
+static std::atomic<CondTimedWaitFunction> g_cond_timedwait(nullptr);
+
+#if PROFILER_CLOCK_FUNCTIONS
+using ClockLockFunction = int (*)(pthread_mutex_t*, clockid_t, const struct timespec*);
+using CondClockWaitFunction = int (*)(pthread_cond_t*, pthread_mutex_t*, clockid_t, const struct timespec*);
+
+static std::atomic<ClockLockFunction> g_clocklock(nullptr);
+static std::atomic<CondClockWaitFunction> g_cond_clockwait(nullptr);
+#endif // if PROFILER_CLOCK_FUNCTIONS
+
+//! Functions of the mutex wrappers and of the profiler, skipped when naming a site.
+static const char* const wrapper_patterns[] =
+{
+    "pthread_",
+    "eprosima_profiling",
+    "TimedMutex",
+    "AdaptiveLock",
+    "TimedConditionVariable",
+    "__gthread",
+    "std::mutex::",
+    "std::recursive_mutex::",
+    "std::timed_mutex::",
+    "std::recursive_timed_mutex::",
+    "std::__timed_mutex_impl",
+    "std::unique_lock",
+    "std::lock_guard",
+    "std::condition_variable",
+    "std::_V2::condition_variable_any",
+    "std::__condvar",
+};
+
+/**
+ * Turn a line of backtrace_symbols(), like "libfastrtps.so(_ZN8eprosima...+0x1c) [0x7f...]", into the demangled
+ * name of the function, or return it untouched when it has no symbol.
+ */
+static std::string demangle(
+        const char* symbol)
+{
+    const char* begin = std::strchr(symbol, '(');
+    const char* end = begin != nullptr ? std::strchr(begin, '+') : nullptr;
+    if (begin == nullptr || end == nullptr || end == begin + 1)
+    {
+        return symbol;
+    }
+
+    std::string mangled(begin + 1, end);
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+    if (status != 0 || demangled == nullptr)
+    {
+        return mangled;
+    }
+
+    std::string result(demangled);
+    std::free(demangled);
+    return result;
+}
+
+static std::string site_name(
+        const LockSite& site)
+{
+    std::string name = "<unknown>";
+    char** symbols = backtrace_symbols(site.frames, site.depth);
+    if (symbols == nullptr)
+    {
+        return name;
+    }
+
+    for (int i = hook_frames; i < site.depth; ++i)
+    {
+        std::string function = demangle(symbols[i]);
+        bool wrapper = false;
+        for (const char* pattern : wrapper_patterns)
+        {
+            wrapper |= function.find(pattern) != std::string::npos;
+        }
+        if (!wrapper)
+        {
+            name = function;
+            break;
+        }
+    }
+    std::free(symbols);
+    return name;
+}
+
+struct SiteGroup
+{
+    uint64_t acquisitions = 0;
+    uint64_t contended = 0;
+    uint64_t wait_ns = 0;
+    uint64_t wait_max_ns = 0;
+    uint64_t hold_ns = 0;
+    uint64_t hold_max_ns = 0;
+    uint64_t wait[histogram_buckets] = {};
+    uint64_t hold[histogram_buckets] = {};
+    std::set<pthread_mutex_t*> mutexes;
+};
+
+//! Upper bound, in nanoseconds, of the bucket where the given fraction of the samples is reached.
+static uint64_t percentile(
+        const uint64_t (&histogram)[histogram_buckets],
+        double fraction)
+{
+    uint64_t total = 0;
+    for (uint64_t count : histogram)
+    {
+        total += count;
+    }
+
+    uint64_t accumulated = 0;
+    for (size_t bucket = 0; bucket < histogram_buckets; ++bucket)
+    {
+        accumulated += histogram[bucket];
+        if (total > 0 && accumulated >= fraction * total)
+        {
+            return 2ull << bucket;
+        }
+    }
+    return 0;
+}
+
+void LockProfiler::start()
+{
+    ProfilerScope scope;
+
+    // First call to backtrace() loads libgcc, which takes mutexes and allocates
+    void* frames[max_depth];
+    backtrace(frames, max_depth);
+
+    g_profiling = false;
+    for (LockSite& site : g_sites)
+    {
+        site.used = false;
+        site.acquisitions = 0u;
+        site.contended = 0u;
+        site.wait_ns = 0u;
+        site.wait_max_ns = 0u;
+        site.hold_ns = 0u;
+        site.hold_max_ns = 0u;
+        for (size_t bucket = 0; bucket < histogram_buckets; ++bucket)
+        {
+            site.wait.buckets[bucket] = 0u;
+            site.hold.buckets[bucket] = 0u;
+        }
+    }
+    g_dropped = 0u;
+    g_profiling = true;
+}
+
+void LockProfiler::stop()
+{
+    g_profiling = false;
+}
+
+size_t LockProfiler::acquisitions()
+{
+    size_t count = 0;
+    for (const LockSite& site : g_sites)
+    {
+        if (site.used.load(std::memory_order_acquire))
+        {
+            count += site.acquisitions.load(std::memory_order_relaxed);
+        }
+    }
+    return count;
+}
+
+void LockProfiler::report(
+        std::ostream& out,
+        size_t max_sites_shown)
+{
+    ProfilerScope scope;
+
+    std::map<std::string, SiteGroup> groups;
+    size_t sites = 0;
+    for (const LockSite& site : g_sites)
+    {
+        if (!site.used.load(std::memory_order_acquire) || site.acquisitions.load() == 0)
+        {
+            continue;
+        }
+
+        ++sites;
+        SiteGroup& group = groups[site_name(site)];
+        group.acquisitions += site.acquisitions.load();
+        group.contended += site.contended.load();
+        group.wait_ns += site.wait_ns.load();
+        group.wait_max_ns = std::max(group.wait_max_ns, site.wait_max_ns.load());
+        group.hold_ns += site.hold_ns.load();
+        group.hold_max_ns = std::max(group.hold_max_ns, site.hold_max_ns.load());
+        for (size_t bucket = 0; bucket < histogram_buckets; ++bucket)
+        {
+            group.wait[bucket] += site.wait.buckets[bucket].load();
+            group.hold[bucket] += site.hold.buckets[bucket].load();
+        }
+        group.mutexes.insert(site.mutex);
+    }
+
+    std::vector<std::map<std::string, SiteGroup>::const_iterator> sorted;
+    for (auto it = groups.cbegin(); it != groups.cend(); ++it)
+    {
+        sorted.push_back(it);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+            [](const std::map<std::string, SiteGroup>::const_iterator& a,
+            const std::map<std::string, SiteGroup>::const_iterator& b)
+            {
+                return a->second.wait_ns > b->second.wait_ns;
+            });
+
+    out << "Lock profile: " << sites << " sites grouped on " << groups.size() << " names";
+    if (g_dropped.load() > 0)
+    {
+        out << " (" << g_dropped.load() << " acquisitions could not be recorded)";
+    }
+    out << std::endl;
+    out << "Times in microseconds. Percentiles are upper bounds of power of two buckets." << std::endl;
+
+    char line[256];
+    snprintf(line, sizeof(line), "%4s %12s %11s %10s %10s %10s %10s %12s %10s %10s %7s",
+            "Rank", "Acquisitions", "Contended", "Wait sum", "Wait p99", "Wait max",
+            "Hold sum", "Hold p50", "Hold p99", "Hold max", "Mutexes");
+    out << line << std::endl;
+
+    size_t rank = 0;
+    for (const auto& it : sorted)
+    {
+        if (rank >= max_sites_shown)
+        {
+            break;
+        }
+
+        const SiteGroup& group = it->second;
+        snprintf(line, sizeof(line), "%4zu %12llu %10.2f%% %10.0f %10.1f %10.1f %10.0f %12.1f %10.1f %10.1f %7zu",
+                ++rank,
+                static_cast<unsigned long long>(group.acquisitions),
+                100.0 * group.contended / group.acquisitions,
+                group.wait_ns / 1e3,
+                percentile(group.wait, 0.99) / 1e3,
+                group.wait_max_ns / 1e3,
+                group.hold_ns / 1e3,
+                percentile(group.hold, 0.5) / 1e3,
+                percentile(group.hold, 0.99) / 1e3,
+                group.hold_max_ns / 1e3,
+                group.mutexes.size());
+        out << line << std::endl << "     " << it->first << std::endl;
+    }
+}
+
+static void report_on_exit()
+{
+    LockProfiler::stop();
+    LockProfiler::report(std::cout, g_report_sites);
+}
+
+void LockProfiler::report_at_exit(
+        size_t max_sites_shown)
+{
+    g_report_sites = max_sites_shown;
+    std::atexit(report_on_exit);
+}
+
+}   // namespace eprosima_profiling
+
+using namespace eprosima_profiling;
+
+extern "C" {
+
+int pthread_mutex_lock(
+        pthread_mutex_t* mutex)
+{
+    LockFunction real_lock = real_function(g_lock, "pthread_mutex_lock");
+    if (!profiling())
+    {
+        return real_lock(mutex);
+    }
+
+    uint64_t start = now_ns();
+    bool contended = real_function(g_trylock, "pthread_mutex_trylock")(mutex) != 0;
+    int ret = contended ? real_lock(mutex) : 0;
+    if (ret == 0)
+    {
+        on_acquired(mutex, start, contended, __builtin_return_address(0));
+    }
+    return ret;
+}
+
+int pthread_mutex_trylock(
+        pthread_mutex_t* mutex)
+{
+    int ret = real_function(g_trylock, "pthread_mutex_trylock")(mutex);
+    if (profiling())
+    {
+        if (ret == 0)
+        {
+            on_acquired(mutex, now_ns(), false, __builtin_return_address(0));
+        }
+        else if (t_waiting_mutex != mutex)
+        {
+            t_waiting_mutex = mutex;
+            t_waiting_since = now_ns();
+        }
+    }
+    return ret;
+}
+
+int pthread_mutex_timedlock(
+        pthread_mutex_t* mutex,
+        const struct timespec* abs_timeout)
+{
+    TimedLockFunction real_timedlock = real_function(g_timedlock, "pthread_mutex_timedlock");
+    if (!profiling())
+    {
+        return real_timedlock(mutex, abs_timeout);
+    }
+
+    uint64_t start = now_ns();
+    bool contended = real_function(g_trylock, "pthread_mutex_trylock")(mutex) != 0;
+    int ret = contended ? real_timedlock(mutex, abs_timeout) : 0;
+    if (ret == 0)
+    {
+        on_acquired(mutex, start, contended, __builtin_return_address(0));
+    }
+    return ret;
+}
+
+int pthread_mutex_unlock(
+        pthread_mutex_t* mutex)
+{
+    if (profiling())
+    {
+        on_released(mutex);
+    }
+    return real_function(g_unlock, "pthread_mutex_unlock")(mutex);
+}
+
+int pthread_cond_wait(
+        pthread_cond_t* cond,
+        pthread_mutex_t* mutex)
+{
+    CondWaitFunction real_wait = real_function(g_cond_wait, "pthread_cond_wait");
+    HeldLock* held = profiling() ? find_held(mutex) : nullptr;
+    if (held != nullptr && !held->reentered)
+    {
+        record_hold(*held);
+    }
+    int ret = real_wait(cond, mutex);
+    if (held != nullptr)
+    {
+        held->since = now_ns();
+    }
+    return ret;
+}
+
+int pthread_cond_timedwait(
+        pthread_cond_t* cond,
+        pthread_mutex_t* mutex,
+        const struct timespec* abs_timeout)
+{
+    CondTimedWaitFunction real_wait = real_function(g_cond_timedwait, "pthread_cond_timedwait");
+    HeldLock* held = profiling() ? find_held(mutex) : nullptr;
+    if (held != nullptr && !held->reentered)
+    {
+        record_hold(*held);
+    }
+    int ret = real_wait(cond, mutex, abs_timeout);
+    if (held != nullptr)
+    {
+        held->since = now_ns();
+    }
+    return ret;
+}
+
+#if PROFILER_CLOCK_FUNCTIONS
+int pthread_mutex_clocklock(
+        pthread_mutex_t* mutex,
+        clockid_t clock,
+        const struct timespec* abs_timeout)
+{
+    ClockLockFunction real_clocklock = real_function(g_clocklock, "pthread_mutex_clocklock");
+    if (!profiling())
+    {
+        return real_clocklock(mutex, clock, abs_timeout);
+    }
+
+    uint64_t start = now_ns();
+    bool contended = real_function(g_trylock, "pthread_mutex_trylock")(mutex) != 0;
+    int ret = contended ? real_clocklock(mutex, clock, abs_timeout) : 0;
+    if (ret == 0)
+    {
+        on_acquired(mutex, start, contended, __builtin_return_address(0));
+    }
+    return ret;
+}
+
+int pthread_cond_clockwait(
+        pthread_cond_t* cond,
+        pthread_mutex_t* mutex,
+        clockid_t clock,
+        const struct timespec* abs_timeout)
+{
+    CondClockWaitFunction real_wait = real_function(g_cond_clockwait, "pthread_cond_clockwait");
+    HeldLock* held = profiling() ? find_held(mutex) : nullptr;
+    if (held != nullptr && !held->reentered)
+    {
+        record_hold(*held);
+    }
+    int ret = real_wait(cond, mutex, clock, abs_timeout);
+    if (held != nullptr)
+    {
+        held->since = now_ns();
+    }
+    return ret;
+}
+#endif // if PROFILER_CLOCK_FUNCTIONS
+
+}   // extern "C"
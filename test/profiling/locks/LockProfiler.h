@@ -0,0 +1,82 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file LockProfiler.h
+ *
+ */
+
+#ifndef FASTRTPS_TEST_PROFILING_LOCKS_LOCKPROFILER_H_
+#define FASTRTPS_TEST_PROFILING_LOCKS_LOCKPROFILER_H_
+
+#include <cstddef>
+#include <ostream>
+
+namespace eprosima_profiling
+{
+
+/**
+ * Lock contention profiler for the performance tools.
+ *
+ * Linking the lock_profiler library interposes pthread_mutex_lock, trylock, timedlock and unlock, and the
+ * condition variable waits, of the whole process, the same way the realtime mutex_testing_tool does. Every mutex
+ * of the library (std::mutex, TimedMutex, RecursiveTimedMutex...) ends up on them, so no change is needed on the
+ * library itself.
+ *
+ * While profiling is started, each lock site, that is each mutex together with the code locking it, records how
+ * many acquisitions found the mutex taken, and histograms of the time waited to acquire it and of the time it was
+ * held. The time a condition variable wait releases the mutex doesn't count as held. Sites are named after the
+ * first function on their stack that isn't part of a mutex wrapper, and the report adds up the sites with the
+ * same name, so the mutexes of all the instances of an endpoint or a resource appear as a single entry.
+ */
+class LockProfiler
+{
+public:
+
+    /**
+     * Start profiling. Previously recorded sites are discarded.
+     */
+    static void start();
+
+    /**
+     * Stop profiling.
+     */
+    static void stop();
+
+    /**
+     * @return Number of acquisitions recorded since start().
+     */
+    static size_t acquisitions();
+
+    /**
+     * Print the lock sites ranked by the total time threads waited on them.
+     * Should be called after stop().
+     * @param out Stream where the report is written.
+     * @param max_sites Maximum number of sites printed.
+     */
+    static void report(
+            std::ostream& out,
+            size_t max_sites = 20);
+
+    /**
+     * Stop profiling and print the report on the standard output when the process exits.
+     * @param max_sites Maximum number of sites printed.
+     */
+    static void report_at_exit(
+            size_t max_sites = 20);
+};
+
+}   // namespace eprosima_profiling
+
+#endif   // FASTRTPS_TEST_PROFILING_LOCKS_LOCKPROFILER_H_
@@ -5069,6 +5069,38 @@ TEST(TypeIdentifierTests, MinimalTypeIdentifierComparision)
     ASSERT_FALSE(unionUnionStruct1 == unionUnion1);
 }
 
+TEST_F(DynamicTypesTests, TypeObjectFactory_builtin_annotations)
+{
+    TypeObjectFactory::delete_instance();
+    TypeObjectFactory* factory = TypeObjectFactory::get_instance();
+
+    const TypeIdentifier* int32_id = factory->get_type_identifier(TKNAME_INT32);
+    ASSERT_NE(int32_id, nullptr);
+    EXPECT_EQ(int32_id->_d(), TK_INT32);
+    EXPECT_EQ(factory->get_type_name(int32_id), TKNAME_INT32);
+
+    // Registered on the first lookup by name
+    const TypeIdentifier* key_id = factory->get_type_identifier("key", true);
+    ASSERT_NE(key_id, nullptr);
+    EXPECT_EQ(key_id->_d(), EK_COMPLETE);
+    const TypeObject* key_object = factory->get_type_object("key", false);
+    ASSERT_NE(key_object, nullptr);
+    EXPECT_EQ(key_object->minimal()._d(), TK_ANNOTATION);
+    EXPECT_EQ(factory->get_type_identifier("key", true), key_id);
+
+    // Lookups by identifier find any of them
+    TypeIdentifier autoid_kind = *factory->get_type_identifier("AutoidKind", true);
+    TypeObjectFactory::delete_instance();
+    factory = TypeObjectFactory::get_instance();
+    EXPECT_EQ(factory->get_type_name(&autoid_kind), "AutoidKind");
+    EXPECT_NE(factory->get_type_object(&autoid_kind), nullptr);
+    EXPECT_NE(factory->get_type_identifier_trying_complete("non_serialized"), nullptr);
+
+    factory->add_alias("my_key", "key");
+    EXPECT_EQ(factory->get_type_identifier("my_key", true), factory->get_type_identifier("key", true));
+    EXPECT_EQ(factory->get_type_identifier("not_a_type"), nullptr);
+}
+
 int main(
         int argc,
         char** argv)
@@ -0,0 +1,131 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastdds/rtps/common/GuidIndex.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+struct Proxy
+{
+    GUID_t guid;
+};
+
+static GUID_t make_guid(
+        uint32_t participant,
+        uint32_t entity)
+{
+    GUID_t guid;
+    guid.guidPrefix.value[0] = 0x01;
+    guid.guidPrefix.value[1] = 0x0f;
+    memcpy(&guid.guidPrefix.value[8], &participant, sizeof(participant));
+    memcpy(guid.entityId.value, &entity, sizeof(entity));
+    return guid;
+}
+
+TEST(GuidIndex, add_find_remove)
+{
+    GuidIndex<Proxy> index(ResourceLimitedContainerConfig{});
+    Proxy p1{make_guid(1, 0x103)};
+    Proxy p2{make_guid(2, 0x103)};
+
+    ASSERT_EQ(nullptr, index.find(p1.guid));
+    ASSERT_TRUE(index.add(p1.guid, &p1));
+    ASSERT_TRUE(index.add(p2.guid, &p2));
+    ASSERT_FALSE(index.add(p1.guid, &p2));
+    ASSERT_EQ(2u, index.size());
+
+    ASSERT_EQ(&p1, index.find(p1.guid));
+    ASSERT_EQ(&p2, index.find(p2.guid));
+    ASSERT_EQ(nullptr, index.find(make_guid(1, 0x104)));
+
+    ASSERT_TRUE(index.remove(p1.guid));
+    ASSERT_FALSE(index.remove(p1.guid));
+    ASSERT_EQ(nullptr, index.find(p1.guid));
+    ASSERT_EQ(&p2, index.find(p2.guid));
+
+    index.clear();
+    ASSERT_EQ(0u, index.size());
+    ASSERT_EQ(nullptr, index.find(p2.guid));
+}
+
+TEST(GuidIndex, resource_limits)
+{
+    GuidIndex<Proxy> index(ResourceLimitedContainerConfig::fixed_size_configuration(2));
+    Proxy proxies[] = {{make_guid(1, 1)}, {make_guid(2, 1)}, {make_guid(3, 1)}};
+
+    ASSERT_TRUE(index.add(proxies[0].guid, &proxies[0]));
+    ASSERT_TRUE(index.add(proxies[1].guid, &proxies[1]));
+    ASSERT_FALSE(index.add(proxies[2].guid, &proxies[2]));
+    ASSERT_EQ(nullptr, index.find(proxies[2].guid));
+
+    ASSERT_TRUE(index.remove(proxies[0].guid));
+    ASSERT_TRUE(index.add(proxies[2].guid, &proxies[2]));
+    ASSERT_EQ(&proxies[2], index.find(proxies[2].guid));
+}
+
+TEST(GuidIndex, random_order)
+{
+    const uint32_t num_proxies = 500;
+    std::vector<Proxy> proxies;
+    for (uint32_t i = 0; i < num_proxies; ++i)
+    {
+        proxies.push_back({make_guid(i * 7919u, 0x100 + (i % 3))});
+    }
+
+    std::mt19937 generator(0);
+    std::shuffle(proxies.begin(), proxies.end(), generator);
+
+    GuidIndex<Proxy> index(ResourceLimitedContainerConfig{});
+    for (Proxy& proxy : proxies)
+    {
+        ASSERT_TRUE(index.add(proxy.guid, &proxy));
+    }
+
+    for (Proxy& proxy : proxies)
+    {
+        ASSERT_EQ(&proxy, index.find(proxy.guid));
+    }
+
+    // Remove half of them, in another order
+    std::vector<Proxy*> order;
+    for (Proxy& proxy : proxies)
+    {
+        order.push_back(&proxy);
+    }
+    std::shuffle(order.begin(), order.end(), generator);
+    for (uint32_t i = 0; i < num_proxies / 2; ++i)
+    {
+        ASSERT_TRUE(index.remove(order[i]->guid));
+    }
+
+    for (uint32_t i = 0; i < num_proxies; ++i)
+    {
+        ASSERT_EQ(i < num_proxies / 2 ? nullptr : order[i], index.find(order[i]->guid));
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
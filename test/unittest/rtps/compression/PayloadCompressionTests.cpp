@@ -0,0 +1,298 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/compression/PayloadCompression.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+
+using namespace eprosima::fastdds::rtps;
+using namespace eprosima::fastdds::dds;
+using namespace eprosima::fastrtps::rtps;
+
+static void fill_payload(
+        SerializedPayload_t& payload,
+        uint32_t length,
+        bool compressible)
+{
+    payload.reserve(length);
+    // CDR little endian encapsulation
+    payload.data[0] = 0x00;
+    payload.data[1] = 0x01;
+    payload.data[2] = 0x00;
+    payload.data[3] = 0x00;
+
+    std::mt19937 generator(1234);
+    for (uint32_t i = 4; i < length; ++i)
+    {
+        payload.data[i] = compressible ? static_cast<octet>((i / 64) % 7) : static_cast<octet>(generator());
+    }
+    payload.length = length;
+}
+
+static std::shared_ptr<PayloadCompressor> compressed_writer_compressor()
+{
+    DataRepresentationQosPolicy representation;
+    representation.m_value.push_back(COMPRESSED_XCDR_DATA_REPRESENTATION);
+    PropertyPolicy properties;
+    return PayloadCompression::writer_compressor(representation, properties);
+}
+
+TEST(PayloadCompressionTests, writer_compressor_selection)
+{
+    DataRepresentationQosPolicy representation;
+    PropertyPolicy properties;
+    EXPECT_EQ(nullptr, PayloadCompression::writer_compressor(representation, properties));
+
+    representation.m_value.push_back(XCDR2_DATA_REPRESENTATION);
+    representation.m_value.push_back(COMPRESSED_XCDR_DATA_REPRESENTATION);
+    EXPECT_EQ(nullptr, PayloadCompression::writer_compressor(representation, properties));
+
+    ASSERT_NE(nullptr, compressed_writer_compressor());
+    EXPECT_EQ(compressed_writer_compressor(), PayloadCompressorRegistry::find("lz"));
+
+    representation.m_value.clear();
+    representation.m_value.push_back(COMPRESSED_XCDR_DATA_REPRESENTATION);
+    properties.properties().emplace_back("fastdds.compression.codec", "unknown");
+    EXPECT_EQ(nullptr, PayloadCompression::writer_compressor(representation, properties));
+}
+
+TEST(PayloadCompressionTests, round_trip)
+{
+    std::shared_ptr<PayloadCompressor> compressor = compressed_writer_compressor();
+    ASSERT_NE(nullptr, compressor);
+    std::vector<octet> buffer;
+
+    for (uint32_t length : { 64u, 1000u, 65536u, 300000u })
+    {
+        SerializedPayload_t original;
+        fill_payload(original, length, true);
+        SerializedPayload_t payload;
+        payload.copy(&original, false);
+
+        ASSERT_TRUE(PayloadCompression::compress(*compressor, payload, buffer));
+        EXPECT_LT(payload.length, original.length);
+        ASSERT_TRUE(PayloadCompression::is_compressed(payload));
+
+        SerializedPayload_t decompressed;
+        std::shared_ptr<PayloadCompressor> codec;
+        ASSERT_TRUE(PayloadCompression::decompress(payload, decompressed, length, codec));
+        ASSERT_EQ(original.length, decompressed.length);
+        EXPECT_EQ(0, memcmp(original.data, decompressed.data, original.length));
+    }
+}
+
+TEST(PayloadCompressionTests, incompressible_payload_is_kept)
+{
+    std::shared_ptr<PayloadCompressor> compressor = compressed_writer_compressor();
+    ASSERT_NE(nullptr, compressor);
+    std::vector<octet> buffer;
+
+    SerializedPayload_t original;
+    fill_payload(original, 4096, false);
+    SerializedPayload_t payload;
+    payload.copy(&original, false);
+
+    EXPECT_FALSE(PayloadCompression::compress(*compressor, payload, buffer));
+    EXPECT_FALSE(PayloadCompression::is_compressed(payload));
+    ASSERT_EQ(original.length, payload.length);
+    EXPECT_EQ(0, memcmp(original.data, payload.data, original.length));
+}
+
+TEST(PayloadCompressionTests, malformed_payload)
+{
+    std::shared_ptr<PayloadCompressor> compressor = compressed_writer_compressor();
+    ASSERT_NE(nullptr, compressor);
+    std::vector<octet> buffer;
+
+    SerializedPayload_t payload;
+    fill_payload(payload, 2048, true);
+    ASSERT_TRUE(PayloadCompression::compress(*compressor, payload, buffer));
+
+    SerializedPayload_t decompressed;
+    std::shared_ptr<PayloadCompressor> codec;
+    const uint32_t max_length = 4096;
+
+    // Truncated data
+    SerializedPayload_t truncated;
+    truncated.copy(&payload, false);
+    truncated.length -= 3;
+    EXPECT_FALSE(PayloadCompression::decompress(truncated, decompressed, max_length, codec));
+
+    // Wrong uncompressed length
+    SerializedPayload_t wrong_length;
+    wrong_length.copy(&payload, false);
+    wrong_length.data[4] ^= 0x01;
+    EXPECT_FALSE(PayloadCompression::decompress(wrong_length, decompressed, max_length, codec));
+
+    // Unknown codec
+    SerializedPayload_t unknown_codec;
+    unknown_codec.copy(&payload, false);
+    unknown_codec.data[2] = 200;
+    EXPECT_FALSE(PayloadCompression::decompress(unknown_codec, decompressed, max_length, codec));
+
+    // Random garbage after the header must never write out of bounds
+    std::mt19937 generator(4321);
+    for (int i = 0; i < 1000; ++i)
+    {
+        SerializedPayload_t garbage;
+        garbage.copy(&payload, false);
+        for (uint32_t n = PayloadCompression::header_size; n < garbage.length; ++n)
+        {
+            garbage.data[n] = static_cast<octet>(generator());
+        }
+        PayloadCompression::decompress(garbage, decompressed, max_length, codec);
+    }
+}
+
+TEST(PayloadCompressionTests, length_above_maximum)
+{
+    std::shared_ptr<PayloadCompressor> compressor = compressed_writer_compressor();
+    ASSERT_NE(nullptr, compressor);
+    std::vector<octet> buffer;
+
+    SerializedPayload_t payload;
+    fill_payload(payload, 2048, true);
+    ASSERT_TRUE(PayloadCompression::compress(*compressor, payload, buffer));
+
+    SerializedPayload_t decompressed;
+    std::shared_ptr<PayloadCompressor> codec;
+    EXPECT_FALSE(PayloadCompression::decompress(payload, decompressed, 2047, codec));
+    EXPECT_EQ(0u, decompressed.max_size);
+
+    // A forged length is rejected before allocating it
+    payload.data[7] = 0xFF;
+    EXPECT_FALSE(PayloadCompression::decompress(payload, decompressed, 2048, codec));
+    EXPECT_EQ(0u, decompressed.max_size);
+
+    payload.data[7] = 0;
+    EXPECT_TRUE(PayloadCompression::decompress(payload, decompressed, 2048, codec));
+}
+
+class CopyCompressor : public PayloadCompressor
+{
+public:
+
+    explicit CopyCompressor(
+            uint8_t id)
+        : id_(id)
+    {
+    }
+
+    uint8_t id() const override
+    {
+        return id_;
+    }
+
+    bool compress(
+            const octet* input,
+            uint32_t input_length,
+            octet* output,
+            uint32_t output_max_length,
+            uint32_t& output_length) const override
+    {
+        if (input_length > output_max_length)
+        {
+            return false;
+        }
+        memcpy(output, input, input_length);
+        output_length = input_length;
+        return true;
+    }
+
+    bool decompress(
+            const octet* input,
+            uint32_t input_length,
+            octet* output,
+            uint32_t output_length) const override
+    {
+        if (input_length != output_length)
+        {
+            return false;
+        }
+        memcpy(output, input, input_length);
+        return true;
+    }
+
+private:
+
+    uint8_t id_;
+};
+
+TEST(PayloadCompressionTests, custom_codec_identifiers)
+{
+    // Identifiers below 128 are reserved for the built-in codecs
+    EXPECT_FALSE(PayloadCompressorRegistry::register_compressor("copy", std::make_shared<CopyCompressor>(2)));
+    EXPECT_FALSE(PayloadCompressorRegistry::register_compressor("copy", std::make_shared<CopyCompressor>(127)));
+    EXPECT_EQ(nullptr, PayloadCompressorRegistry::find("copy"));
+
+    EXPECT_TRUE(PayloadCompressorRegistry::register_compressor("copy", std::make_shared<CopyCompressor>(128)));
+    ASSERT_NE(nullptr, PayloadCompressorRegistry::find("copy"));
+    EXPECT_EQ(PayloadCompressorRegistry::find("copy"), PayloadCompressorRegistry::find(uint8_t(128)));
+
+    // Neither the name nor the identifier can be registered twice
+    EXPECT_FALSE(PayloadCompressorRegistry::register_compressor("copy", std::make_shared<CopyCompressor>(129)));
+    EXPECT_FALSE(PayloadCompressorRegistry::register_compressor("copy2", std::make_shared<CopyCompressor>(128)));
+}
+
+TEST(PayloadCompressionTests, codec_kept_between_payloads)
+{
+    std::shared_ptr<PayloadCompressor> lz = compressed_writer_compressor();
+    ASSERT_NE(nullptr, lz);
+    std::shared_ptr<PayloadCompressor> copy = std::make_shared<CopyCompressor>(130);
+    ASSERT_TRUE(PayloadCompressorRegistry::register_compressor("copy130", copy));
+    std::vector<octet> buffer;
+
+    SerializedPayload_t lz_payload;
+    fill_payload(lz_payload, 2048, true);
+    ASSERT_TRUE(PayloadCompression::compress(*lz, lz_payload, buffer));
+
+    // The copy codec never shrinks the payload, so its header is written by hand
+    SerializedPayload_t copy_payload;
+    fill_payload(copy_payload, 2048 + PayloadCompression::header_size, true);
+    copy_payload.data[0] = lz_payload.data[0];
+    copy_payload.data[1] = lz_payload.data[1];
+    copy_payload.data[2] = copy->id();
+    copy_payload.data[3] = 0;
+    copy_payload.data[4] = 0x00;
+    copy_payload.data[5] = 0x08;
+    copy_payload.data[6] = 0;
+    copy_payload.data[7] = 0;
+
+    SerializedPayload_t decompressed;
+    std::shared_ptr<PayloadCompressor> codec;
+    ASSERT_TRUE(PayloadCompression::decompress(lz_payload, decompressed, 4096, codec));
+    EXPECT_EQ(lz, codec);
+    ASSERT_TRUE(PayloadCompression::decompress(lz_payload, decompressed, 4096, codec));
+    EXPECT_EQ(lz, codec);
+
+    // A payload of another codec replaces the one kept
+    ASSERT_TRUE(PayloadCompression::decompress(copy_payload, decompressed, 4096, codec));
+    EXPECT_EQ(copy, codec);
+    EXPECT_EQ(2048u, decompressed.length);
+
+    // An unknown codec fails without using the one kept
+    copy_payload.data[2] = 201;
+    EXPECT_FALSE(PayloadCompression::decompress(copy_payload, decompressed, 4096, codec));
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
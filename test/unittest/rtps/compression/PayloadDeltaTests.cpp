@@ -0,0 +1,299 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/compression/PayloadDelta.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+
+using namespace eprosima::fastdds::rtps;
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+/**
+ * Serialized object track, as sent by a tracker: identifier, timestamp, position, velocity,
+ * a 6x6 covariance matrix and a label. Only timestamp, position and velocity change on each update.
+ */
+class TrackSample
+{
+public:
+
+    static constexpr uint32_t covariance_size = 36;
+
+    explicit TrackSample(
+            uint32_t id)
+        : id_(id)
+    {
+        for (uint32_t i = 0; i < covariance_size; ++i)
+        {
+            covariance_[i] = 0.01 * (i % 7);
+        }
+    }
+
+    void update(
+            std::mt19937& generator)
+    {
+        std::uniform_real_distribution<double> noise(-0.5, 0.5);
+        timestamp_ += 100000000ull;
+        for (int i = 0; i < 3; ++i)
+        {
+            velocity_[i] += noise(generator);
+            position_[i] += velocity_[i] * 0.1;
+        }
+    }
+
+    void serialize(
+            SerializedPayload_t& payload) const
+    {
+        static const char label[] = "pedestrian";
+        uint32_t length = 4 + 4 + 8 + 6 * 8 + covariance_size * 8 + 4 + sizeof(label);
+        payload.reserve(length);
+        octet* p = payload.data;
+        const octet encapsulation[4] = { 0x00, 0x01, 0x00, 0x00 };
+        p = append(p, encapsulation, 4);
+        p = append(p, &id_, 4);
+        p = append(p, &timestamp_, 8);
+        p = append(p, position_, 24);
+        p = append(p, velocity_, 24);
+        p = append(p, covariance_, covariance_size * 8);
+        uint32_t label_length = sizeof(label);
+        p = append(p, &label_length, 4);
+        append(p, label, sizeof(label));
+        payload.length = length;
+    }
+
+private:
+
+    static octet* append(
+            octet* p,
+            const void* data,
+            size_t size)
+    {
+        memcpy(p, data, size);
+        return p + size;
+    }
+
+    uint32_t id_;
+    uint64_t timestamp_ = 0;
+    double position_[3] = { 0, 0, 0 };
+    double velocity_[3] = { 1, 0, 0 };
+    double covariance_[covariance_size];
+};
+
+//! Payload size of the histories in the tests
+static constexpr uint32_t max_length = 2048;
+
+static void fill_payload(
+        SerializedPayload_t& payload,
+        uint32_t length,
+        octet seed)
+{
+    payload.reserve(length);
+    for (uint32_t i = 0; i < length; ++i)
+    {
+        payload.data[i] = static_cast<octet>(i + seed * (i % 5 == 0));
+    }
+    payload.length = length;
+}
+
+TEST(PayloadDeltaTests, keyframe_period_property)
+{
+    PropertyPolicy properties;
+    EXPECT_EQ(0u, PayloadDelta::keyframe_period(properties));
+
+    properties.properties().emplace_back("fastdds.delta_encoding.keyframe_period", "10");
+    EXPECT_EQ(10u, PayloadDelta::keyframe_period(properties));
+}
+
+TEST(PayloadDeltaTests, keyframes_and_deltas)
+{
+    DeltaKeyframe writer_keyframe;
+    DeltaKeyframe reader_keyframe;
+    std::vector<octet> buffer;
+    SerializedPayload_t decoded;
+
+    for (octet sample = 0; sample < 12; ++sample)
+    {
+        SerializedPayload_t original;
+        fill_payload(original, 500, sample);
+        SerializedPayload_t payload;
+        payload.copy(&original, false);
+
+        // One keyframe every 4 samples
+        bool is_delta = PayloadDelta::encode(writer_keyframe, 4, max_length, payload, buffer);
+        EXPECT_EQ(sample % 4 != 0, is_delta);
+        ASSERT_TRUE(PayloadDelta::is_encoded(payload));
+        if (is_delta)
+        {
+            EXPECT_LT(payload.length, original.length);
+        }
+
+        ASSERT_TRUE(PayloadDelta::decode(payload, reader_keyframe, decoded));
+        ASSERT_EQ(original.length, decoded.length);
+        EXPECT_EQ(0, memcmp(original.data, decoded.data, original.length));
+    }
+}
+
+TEST(PayloadDeltaTests, lost_samples)
+{
+    DeltaKeyframe writer_keyframe;
+    DeltaKeyframe reader_keyframe;
+    std::vector<octet> buffer;
+    SerializedPayload_t decoded;
+    SerializedPayload_t payload;
+
+    // Keyframe received
+    fill_payload(payload, 300, 0);
+    EXPECT_FALSE(PayloadDelta::encode(writer_keyframe, 3, max_length, payload, buffer));
+    ASSERT_TRUE(PayloadDelta::decode(payload, reader_keyframe, decoded));
+
+    // A lost delta does not prevent decoding the next one
+    fill_payload(payload, 300, 1);
+    EXPECT_TRUE(PayloadDelta::encode(writer_keyframe, 3, max_length, payload, buffer));
+    fill_payload(payload, 300, 2);
+    EXPECT_TRUE(PayloadDelta::encode(writer_keyframe, 3, max_length, payload, buffer));
+    ASSERT_TRUE(PayloadDelta::decode(payload, reader_keyframe, decoded));
+
+    // Deltas of a lost keyframe are discarded
+    fill_payload(payload, 300, 3);
+    EXPECT_FALSE(PayloadDelta::encode(writer_keyframe, 3, max_length, payload, buffer));
+    fill_payload(payload, 300, 4);
+    EXPECT_TRUE(PayloadDelta::encode(writer_keyframe, 3, max_length, payload, buffer));
+    EXPECT_FALSE(PayloadDelta::decode(payload, reader_keyframe, decoded));
+
+    // Samples with a different length are sent in full
+    fill_payload(payload, 320, 5);
+    EXPECT_FALSE(PayloadDelta::encode(writer_keyframe, 3, max_length, payload, buffer));
+    SerializedPayload_t keyframe;
+    keyframe.copy(&payload, false);
+    ASSERT_TRUE(PayloadDelta::decode(payload, reader_keyframe, decoded));
+    EXPECT_EQ(320u, decoded.length);
+
+    // A keyframe kept on reception is enough to decode the following deltas
+    DeltaKeyframe late_keyframe;
+    PayloadDelta::store_keyframe(keyframe, late_keyframe);
+    fill_payload(payload, 320, 6);
+    EXPECT_TRUE(PayloadDelta::encode(writer_keyframe, 3, max_length, payload, buffer));
+    EXPECT_TRUE(PayloadDelta::decode(payload, late_keyframe, decoded));
+}
+
+TEST(PayloadDeltaTests, keyframes_exceeding_history_payload_size)
+{
+    DeltaKeyframe writer_keyframe;
+    DeltaKeyframe reader_keyframe;
+    std::vector<octet> buffer;
+    SerializedPayload_t decoded;
+    SerializedPayload_t payload;
+    bool is_keyframe = false;
+    uint32_t keyframe_id = 0;
+
+    // A sample without room for the header is sent unencoded
+    fill_payload(payload, max_length - PayloadDelta::header_size + 1, 0);
+    EXPECT_FALSE(PayloadDelta::encode(writer_keyframe, 3, max_length, payload, buffer));
+    EXPECT_FALSE(PayloadDelta::is_encoded(payload));
+    EXPECT_EQ(max_length - PayloadDelta::header_size + 1, payload.length);
+
+    // So the next one is a keyframe
+    fill_payload(payload, max_length - PayloadDelta::header_size, 1);
+    EXPECT_FALSE(PayloadDelta::encode(writer_keyframe, 3, max_length, payload, buffer));
+    EXPECT_EQ(max_length, payload.length);
+    ASSERT_TRUE(PayloadDelta::read_header(payload, is_keyframe, keyframe_id));
+    EXPECT_TRUE(is_keyframe);
+    ASSERT_TRUE(PayloadDelta::decode(payload, reader_keyframe, decoded));
+
+    fill_payload(payload, max_length - PayloadDelta::header_size, 2);
+    EXPECT_TRUE(PayloadDelta::encode(writer_keyframe, 3, max_length, payload, buffer));
+    uint32_t delta_keyframe_id = 0;
+    ASSERT_TRUE(PayloadDelta::read_header(payload, is_keyframe, delta_keyframe_id));
+    EXPECT_FALSE(is_keyframe);
+    EXPECT_EQ(keyframe_id, delta_keyframe_id);
+    EXPECT_TRUE(PayloadDelta::decode(payload, reader_keyframe, decoded));
+}
+
+TEST(PayloadDeltaTests, malformed_payload)
+{
+    DeltaKeyframe writer_keyframe;
+    DeltaKeyframe reader_keyframe;
+    std::vector<octet> buffer;
+    SerializedPayload_t decoded;
+    SerializedPayload_t payload;
+
+    fill_payload(payload, 1000, 0);
+    PayloadDelta::encode(writer_keyframe, 100, max_length, payload, buffer);
+    ASSERT_TRUE(PayloadDelta::decode(payload, reader_keyframe, decoded));
+    fill_payload(payload, 1000, 1);
+    ASSERT_TRUE(PayloadDelta::encode(writer_keyframe, 100, max_length, payload, buffer));
+
+    std::mt19937 generator(1234);
+    for (int i = 0; i < 1000; ++i)
+    {
+        SerializedPayload_t garbage;
+        garbage.copy(&payload, false);
+        for (uint32_t n = PayloadDelta::header_size; n < garbage.length; ++n)
+        {
+            garbage.data[n] = static_cast<octet>(generator());
+        }
+        PayloadDelta::decode(garbage, reader_keyframe, decoded);
+    }
+}
+
+TEST(PayloadDeltaTests, object_tracks_workload)
+{
+    const uint32_t num_tracks = 50;
+    const uint32_t num_updates = 100;
+    std::mt19937 generator(42);
+    std::vector<TrackSample> tracks;
+    std::vector<DeltaKeyframe> writer_keyframes(num_tracks);
+    std::vector<DeltaKeyframe> reader_keyframes(num_tracks);
+    for (uint32_t i = 0; i < num_tracks; ++i)
+    {
+        tracks.emplace_back(i);
+    }
+
+    std::vector<octet> buffer;
+    SerializedPayload_t decoded;
+    uint64_t full_bytes = 0;
+    uint64_t encoded_bytes = 0;
+    for (uint32_t update = 0; update < num_updates; ++update)
+    {
+        for (uint32_t i = 0; i < num_tracks; ++i)
+        {
+            tracks[i].update(generator);
+            SerializedPayload_t original;
+            tracks[i].serialize(original);
+            SerializedPayload_t payload;
+            payload.copy(&original, false);
+
+            PayloadDelta::encode(writer_keyframes[i], 10, max_length, payload, buffer);
+            full_bytes += original.length;
+            encoded_bytes += payload.length;
+
+            ASSERT_TRUE(PayloadDelta::decode(payload, reader_keyframes[i], decoded));
+            ASSERT_EQ(original, decoded);
+        }
+    }
+
+    // Only 56 of the 367 bytes of each track change on every update
+    EXPECT_LT(encoded_bytes * 2, full_bytes);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
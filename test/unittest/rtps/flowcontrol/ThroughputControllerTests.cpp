@@ -15,6 +15,7 @@
 #include <rtps/participant/RTPSParticipantImpl.h>
 #include <fastrtps/rtps/writer/RTPSWriter.h>
 #include <rtps/flowcontrol/ThroughputController.h>
+#include <rtps/flowcontrol/CongestionController.h>
 
 #include <gtest/gtest.h>
 
@@ -141,6 +142,139 @@ TEST_F(ThroughputControllerTests, throughput_controller_resets_completely_after_
    std::this_thread::sleep_for(std::chrono::milliseconds(periodMillisecs + 50));
 }
 
+TEST(RTPSWriterCollectorTests, items_are_sorted_and_keep_their_readers)
+{
+    std::vector<std::unique_ptr<CacheChange_t>> changes;
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        changes.emplace_back(new CacheChange_t(testPayloadSize));
+        changes.back()->sequenceNumber = {0, i + 1};
+        changes.back()->serializedPayload.length = testPayloadSize;
+    }
+
+    // Use more readers than fit on a single bitmap word
+    std::vector<int> readers(100);
+    RTPSWriterCollector<int*> collector;
+    collector.reset(2u);
+
+    // Each reader receives changes 4, 3, 2, 1 ... down to its position modulo 4
+    for (size_t r = 0; r < readers.size(); r++)
+    {
+        for (size_t n = changes.size(); n > r % changes.size(); n--)
+        {
+            collector.add_change(changes[n - 1].get(), &readers[r], FragmentNumberSet_t());
+        }
+    }
+
+    ASSERT_EQ(changes.size(), collector.size());
+
+    SequenceNumber_t expected_seq(0, 1);
+    while (!collector.empty())
+    {
+        RTPSWriterCollector<int*>::Item item = collector.pop();
+        ASSERT_EQ(expected_seq, item.sequenceNumber);
+        ASSERT_EQ(0u, item.fragmentNumber);
+
+        size_t num_readers = 0;
+        size_t seq_index = static_cast<size_t>(item.sequenceNumber.to64long() - 1);
+        collector.for_each_reader(item, [&](int* reader)
+                {
+                    size_t r = static_cast<size_t>(reader - readers.data());
+                    ASSERT_LE(r % changes.size(), seq_index);
+                    ++num_readers;
+                });
+
+        size_t expected_readers = 0;
+        for (size_t r = 0; r < readers.size(); r++)
+        {
+            if (r % changes.size() <= seq_index)
+            {
+                ++expected_readers;
+            }
+        }
+        ASSERT_EQ(expected_readers, num_readers);
+
+        ++expected_seq;
+    }
+}
+
+TEST(CongestionControllerTests, window_adapts_to_feedback)
+{
+    CongestionControllerDescriptor descriptor;
+    descriptor.periodMillisecs = periodMillisecs;
+    descriptor.initialBytesPerPeriod = 4000;
+    descriptor.minBytesPerPeriod = 1500;
+    descriptor.maxBytesPerPeriod = 6000;
+    descriptor.additiveIncrease = 1000;
+    CongestionController controller(descriptor, (RTPSWriter*)nullptr);
+    ASSERT_EQ(4000u, controller.window());
+
+    // Additive increase, up to the maximum
+    controller.NotifyAcknowledgement();
+    ASSERT_EQ(5000u, controller.window());
+    controller.NotifyAcknowledgement();
+    controller.NotifyAcknowledgement();
+    ASSERT_EQ(6000u, controller.window());
+
+    // Multiplicative decrease, only once per period
+    controller.NotifyLoss();
+    ASSERT_EQ(3000u, controller.window());
+    controller.NotifyLoss();
+    ASSERT_EQ(3000u, controller.window());
+
+    // Never below the minimum
+    std::this_thread::sleep_for(std::chrono::milliseconds(periodMillisecs + 10));
+    controller.NotifyLoss();
+    ASSERT_EQ(1500u, controller.window());
+    std::this_thread::sleep_for(std::chrono::milliseconds(periodMillisecs + 10));
+    controller.NotifyLoss();
+    ASSERT_EQ(1500u, controller.window());
+}
+
+TEST(CongestionControllerTests, only_the_window_is_let_through)
+{
+    CongestionControllerDescriptor descriptor;
+    descriptor.periodMillisecs = periodMillisecs;
+    descriptor.initialBytesPerPeriod = 3500;
+    descriptor.minBytesPerPeriod = 1000;
+    CongestionController controller(descriptor, (RTPSWriter*)nullptr);
+
+    std::vector<std::unique_ptr<CacheChange_t>> changes;
+    RTPSWriterCollector<ReaderProxy*> collector;
+    for (unsigned int i = 0; i < numberOfTestChanges; i++)
+    {
+        changes.emplace_back(new CacheChange_t(testPayloadSize));
+        changes.back()->sequenceNumber = {0, i + 1};
+        changes.back()->serializedPayload.length = testPayloadSize;
+        collector.add_change(changes.back().get(), nullptr, FragmentNumberSet_t());
+    }
+
+    controller.NotifyLoss();
+    controller(collector);
+    ASSERT_EQ(1u, collector.size());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(periodMillisecs + 50));
+}
+
+TEST(CongestionControllerTests, descriptor_from_properties)
+{
+    CongestionControllerDescriptor descriptor;
+    PropertyPolicy properties;
+    ThroughputControllerDescriptor throughput;
+    ASSERT_FALSE(CongestionControllerDescriptor::from_properties(properties, throughput, descriptor));
+
+    properties.properties().emplace_back("fastdds.congestion_control", "AIMD");
+    properties.properties().emplace_back("fastdds.congestion_control.min_bytes", "2000");
+    properties.properties().emplace_back("fastdds.congestion_control.initial_bytes", "500000");
+    throughput = ThroughputControllerDescriptor(300000, 50);
+    ASSERT_TRUE(CongestionControllerDescriptor::from_properties(properties, throughput, descriptor));
+    EXPECT_EQ(50u, descriptor.periodMillisecs);
+    EXPECT_EQ(2000u, descriptor.minBytesPerPeriod);
+    EXPECT_EQ(300000u, descriptor.maxBytesPerPeriod);
+    // Initial window is limited by the maximum
+    EXPECT_EQ(300000u, descriptor.initialBytesPerPeriod);
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
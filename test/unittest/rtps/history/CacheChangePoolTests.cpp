@@ -15,7 +15,10 @@
 #include <gtest/gtest.h>
 #include <fastrtps/rtps/history/CacheChangePool.h>
 #include <fastrtps/rtps/common/CacheChange.h>
+#include <rtps/common/SharedBuffer.hpp>
+#include <rtps/history/SharedPayloadPool.hpp>
 
+#include <cstring>
 #include <tuple>
 
 using namespace eprosima::fastrtps::rtps;
@@ -259,6 +262,130 @@ TEST_P(CacheChangePoolTests, chage_change)
     }
 }
 
+TEST_P(CacheChangePoolTests, shared_payload)
+{
+    CacheChange_t* ch1 = nullptr;
+    CacheChange_t* ch2 = nullptr;
+
+    ASSERT_TRUE(pool->reserve_Cache(&ch1, 0u));
+    ASSERT_TRUE(pool->reserve_Cache(&ch2, 0u));
+    octet* own_data = ch2->serializedPayload.data;
+    uint32_t own_max_size = ch2->serializedPayload.max_size;
+
+    SerializedPayload_t received(payload_size);
+    received.length = payload_size;
+    memset(received.data, 0xAB, payload_size);
+
+    SharedPayloadPool payload_pool(1u, 0u);
+    ASSERT_FALSE(payload_pool.should_share(payload_size, 1u));
+    ASSERT_TRUE(payload_pool.should_share(payload_size, 2u));
+
+    // Both changes reference the same buffer
+    CacheChange_t source;
+    source.serializedPayload.data = received.data;
+    source.serializedPayload.length = payload_size;
+    octet* shared_buffer = payload_pool.get_payload(source);
+    ASSERT_NE(shared_buffer, nullptr);
+    ASSERT_EQ(source.serializedPayload.data, shared_buffer);
+
+    SharedPayloadPool::set_incoming(&source, shared_buffer);
+    ASSERT_EQ(SharedPayloadPool::incoming_buffer(source), shared_buffer);
+    ASSERT_EQ(SharedPayloadPool::incoming_buffer(*ch1), nullptr);
+    SharedPayloadPool::share_payload(shared_buffer, source, *ch1);
+    SharedPayloadPool::share_payload(shared_buffer, source, *ch2);
+    SharedPayloadPool::set_incoming(nullptr, nullptr);
+    SharedBuffer::release(shared_buffer);
+    source.serializedPayload.data = nullptr;
+
+    ASSERT_TRUE(SharedPayloadPool::is_shared(*ch1));
+    ASSERT_TRUE(SharedPayloadPool::is_shared(*ch2));
+    ASSERT_EQ(ch1->serializedPayload.data, ch2->serializedPayload.data);
+    ASSERT_EQ(ch2->serializedPayload.length, payload_size);
+    ASSERT_EQ(ch2->serializedPayload, received);
+
+    // Releasing a change restores its own buffer, while the other one keeps the shared buffer
+    pool->release_Cache(ch1);
+    ASSERT_TRUE(SharedPayloadPool::is_shared(*ch2));
+    ASSERT_EQ(ch2->serializedPayload, received);
+
+    pool->release_Cache(ch2);
+    if (memory_policy != MemoryManagementPolicy_t::DYNAMIC_RESERVE_MEMORY_MODE)
+    {
+        ASSERT_FALSE(SharedPayloadPool::is_shared(*ch2));
+        ASSERT_EQ(ch2->serializedPayload.data, own_data);
+        ASSERT_EQ(ch2->serializedPayload.max_size, own_max_size);
+        ASSERT_EQ(ch2->serializedPayload.length, 0u);
+    }
+
+    // Released shared buffers are reused
+    source.serializedPayload.data = received.data;
+    source.serializedPayload.length = payload_size;
+    ASSERT_EQ(payload_pool.get_payload(source), shared_buffer);
+    SharedBuffer::release(shared_buffer);
+    source.serializedPayload.data = nullptr;
+}
+
+TEST(SharedBufferTests, free_list_outlived_by_buffers)
+{
+    SharedBuffer::FreeList* free_list = SharedBuffer::FreeList::create(1u);
+    octet* buffer1 = free_list->allocate(100u);
+    octet* buffer2 = free_list->allocate(100u);
+    ASSERT_NE(buffer1, nullptr);
+    ASSERT_NE(buffer2, nullptr);
+
+    // Only one buffer is kept on each size class
+    SharedBuffer::release(buffer1);
+    SharedBuffer::release(buffer2);
+    octet* buffer3 = free_list->allocate(128u);
+    ASSERT_EQ(buffer3, buffer1);
+
+    // Buffers released after the free list are freed
+    free_list->release();
+    memset(buffer3, 0, 128u);
+    SharedBuffer::release(buffer3);
+}
+
+TEST_P(CacheChangePoolTests, adopted_payload)
+{
+    CacheChange_t* ch1 = nullptr;
+    CacheChange_t* ch2 = nullptr;
+
+    ASSERT_TRUE(pool->reserve_Cache(&ch1, 0u));
+    ASSERT_TRUE(pool->reserve_Cache(&ch2, 0u));
+
+    // The payload is received after some headers on a reference counted buffer
+    const uint32_t header_size = 24u;
+    octet* reception_buffer = SharedBuffer::allocate(header_size + payload_size);
+    ASSERT_NE(reception_buffer, nullptr);
+    memset(reception_buffer + header_size, 0xCD, payload_size);
+
+    SharedPayloadPool payload_pool(0u, 1u);
+    ASSERT_TRUE(payload_pool.should_adopt(payload_size));
+    ASSERT_FALSE(SharedPayloadPool(0u, 0u).should_adopt(payload_size));
+
+    CacheChange_t received;
+    received.serializedPayload.data = reception_buffer + header_size;
+    received.serializedPayload.length = payload_size;
+    received.serializedPayload.max_size = payload_size;
+    octet* shared_buffer = SharedPayloadPool::adopt_payload(reception_buffer, received);
+    ASSERT_EQ(shared_buffer, reception_buffer);
+    SharedPayloadPool::share_payload(shared_buffer, received, *ch1);
+    SharedPayloadPool::share_payload(shared_buffer, received, *ch2);
+    SharedBuffer::release(shared_buffer);
+    received.serializedPayload.data = nullptr;
+
+    // The changes reference the payload where it was received
+    ASSERT_EQ(ch1->serializedPayload.data, reception_buffer + header_size);
+    ASSERT_EQ(ch2->serializedPayload.data, reception_buffer + header_size);
+    ASSERT_EQ(ch2->serializedPayload.length, payload_size);
+    ASSERT_EQ(SharedBuffer::references(reception_buffer), 3u);
+
+    pool->release_Cache(ch1);
+    pool->release_Cache(ch2);
+    ASSERT_EQ(SharedBuffer::references(reception_buffer), 1u);
+    SharedBuffer::release(reception_buffer);
+}
+
 #ifdef INSTANTIATE_TEST_SUITE_P
 #define GTEST_INSTANTIATE_TEST_MACRO(x, y, z) INSTANTIATE_TEST_SUITE_P(x, y, z)
 #else
@@ -0,0 +1,241 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <rtps/participant/RTPSParticipantImpl.h>
+#include <rtps/messages/ControlMessageAggregator.hpp>
+#include <fastdds/rtps/messages/CDRMessage.h>
+#include <fastdds/rtps/messages/RTPSMessageCreator.h>
+#include <fastdds/rtps/messages/RTPS_messages.h>
+
+#include <memory>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+
+static const uint32_t control_submessage_size = RTPSMESSAGE_SUBMESSAGEHEADER_SIZE + 4;
+static const uint32_t info_dst_size = RTPSMESSAGE_SUBMESSAGEHEADER_SIZE + GuidPrefix_t::size;
+
+class ControlMessageAggregatorTests : public ::testing::Test
+{
+protected:
+
+    void SetUp() override
+    {
+        prefix.value[0] = 1;
+        destination_prefix.value[0] = 2;
+
+        Locator_t locator;
+        locator.port = 7400;
+        locators_a.push_back(locator);
+        locator.port = 7410;
+        locators_b.push_back(locator);
+    }
+
+    std::unique_ptr<ControlMessageAggregator> create_aggregator(
+            uint32_t max_message_size)
+    {
+        return std::unique_ptr<ControlMessageAggregator>(
+            new ControlMessageAggregator(&participant, prefix, max_message_size, 1000u));
+    }
+
+    //! Builds a message with a fake control submessage, optionally preceded by an INFO_DST
+    void build_message(
+            bool with_info_dst)
+    {
+        CDRMessage::initCDRMsg(&message);
+        RTPSMessageCreator::addHeader(&message, prefix);
+        if (with_info_dst)
+        {
+            RTPSMessageCreator::addSubmessageInfoDST(&message, destination_prefix);
+        }
+        const octet submessage[control_submessage_size] = { HEARTBEAT, 0x01, 0x04, 0x00, 1, 2, 3, 4 };
+        CDRMessage::addData(&message, submessage, control_submessage_size);
+    }
+
+    RTPSParticipantImpl participant;
+
+    GuidPrefix_t prefix;
+
+    GuidPrefix_t destination_prefix;
+
+    std::vector<Locator_t> locators_a;
+
+    std::vector<Locator_t> locators_b;
+
+    CDRMessage_t message;
+};
+
+TEST_F(ControlMessageAggregatorTests, messages_to_same_destination_are_aggregated)
+{
+    std::vector<std::vector<octet> > sent_to_a;
+    std::vector<std::vector<octet> > sent_to_b;
+
+    EXPECT_CALL(participant, send_sync_mock(_, locators_a)).WillRepeatedly(Invoke(
+                [&](const std::vector<octet>& msg, const std::vector<Locator_t>&)
+                {
+                    sent_to_a.push_back(msg);
+                    return true;
+                }));
+    EXPECT_CALL(participant, send_sync_mock(_, locators_b)).WillRepeatedly(Invoke(
+                [&](const std::vector<octet>& msg, const std::vector<Locator_t>&)
+                {
+                    sent_to_b.push_back(msg);
+                    return true;
+                }));
+
+    auto aggregator = create_aggregator(65500u);
+
+    build_message(true);
+    ASSERT_TRUE(aggregator->add(message, Locators(locators_a.begin()), Locators(locators_a.end())));
+    ASSERT_TRUE(aggregator->add(message, Locators(locators_a.begin()), Locators(locators_a.end())));
+    ASSERT_TRUE(aggregator->add(message, Locators(locators_b.begin()), Locators(locators_b.end())));
+
+    // Nothing is sent until the aggregator is flushed
+    ASSERT_TRUE(sent_to_a.empty());
+    ASSERT_TRUE(sent_to_b.empty());
+
+    aggregator.reset();
+
+    uint32_t body_size = info_dst_size + control_submessage_size;
+    ASSERT_EQ(1u, sent_to_a.size());
+    ASSERT_EQ(RTPSMESSAGE_HEADER_SIZE + 2 * body_size, sent_to_a[0].size());
+    ASSERT_EQ(1u, sent_to_b.size());
+    ASSERT_EQ(RTPSMESSAGE_HEADER_SIZE + body_size, sent_to_b[0].size());
+}
+
+TEST_F(ControlMessageAggregatorTests, destination_is_reset_between_messages)
+{
+    std::vector<std::vector<octet> > sent;
+    EXPECT_CALL(participant, send_sync_mock(_, locators_a)).WillRepeatedly(Invoke(
+                [&](const std::vector<octet>& msg, const std::vector<Locator_t>&)
+                {
+                    sent.push_back(msg);
+                    return true;
+                }));
+
+    auto aggregator = create_aggregator(65500u);
+
+    build_message(true);
+    ASSERT_TRUE(aggregator->add(message, Locators(locators_a.begin()), Locators(locators_a.end())));
+    build_message(false);
+    ASSERT_TRUE(aggregator->add(message, Locators(locators_a.begin()), Locators(locators_a.end())));
+
+    aggregator.reset();
+
+    ASSERT_EQ(1u, sent.size());
+    const std::vector<octet>& msg = sent[0];
+    ASSERT_EQ(RTPSMESSAGE_HEADER_SIZE + 2 * (info_dst_size + control_submessage_size), msg.size());
+
+    // Second message should be preceded by an INFO_DST to an unknown destination
+    size_t second_info_dst = RTPSMESSAGE_HEADER_SIZE + info_dst_size + control_submessage_size;
+    ASSERT_EQ(INFO_DST, msg[second_info_dst]);
+    GuidPrefix_t second_destination;
+    memcpy(second_destination.value, &msg[second_info_dst + RTPSMESSAGE_SUBMESSAGEHEADER_SIZE],
+            GuidPrefix_t::size);
+    ASSERT_EQ(c_GuidPrefix_Unknown, second_destination);
+    ASSERT_EQ(HEARTBEAT, msg[second_info_dst + info_dst_size]);
+}
+
+TEST_F(ControlMessageAggregatorTests, full_message_is_sent)
+{
+    uint32_t body_size = info_dst_size + control_submessage_size;
+    uint32_t max_message_size = RTPSMESSAGE_HEADER_SIZE + 3 * body_size;
+
+    std::vector<std::vector<octet> > sent;
+    EXPECT_CALL(participant, send_sync_mock(_, locators_a)).WillRepeatedly(Invoke(
+                [&](const std::vector<octet>& msg, const std::vector<Locator_t>&)
+                {
+                    sent.push_back(msg);
+                    return true;
+                }));
+
+    auto aggregator = create_aggregator(max_message_size);
+
+    build_message(true);
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(aggregator->add(message, Locators(locators_a.begin()), Locators(locators_a.end())));
+    }
+    ASSERT_TRUE(sent.empty());
+
+    // No room for a fourth message
+    ASSERT_TRUE(aggregator->add(message, Locators(locators_a.begin()), Locators(locators_a.end())));
+    ASSERT_EQ(1u, sent.size());
+    ASSERT_EQ(max_message_size, sent[0].size());
+
+    aggregator.reset();
+    ASSERT_EQ(2u, sent.size());
+    ASSERT_EQ(RTPSMESSAGE_HEADER_SIZE + body_size, sent[1].size());
+}
+
+TEST_F(ControlMessageAggregatorTests, full_message_is_sent_without_the_mutex)
+{
+    uint32_t body_size = info_dst_size + control_submessage_size;
+    uint32_t max_message_size = RTPSMESSAGE_HEADER_SIZE + body_size;
+
+    auto aggregator = create_aggregator(max_message_size);
+
+    // Messages can be queued while a full one is being sent
+    bool queued_while_sending = false;
+    EXPECT_CALL(participant, send_sync_mock(_, locators_a)).WillRepeatedly(Invoke(
+                [&](const std::vector<octet>&, const std::vector<Locator_t>&)
+                {
+                    if (!queued_while_sending)
+                    {
+                        queued_while_sending = aggregator->add(message,
+                        Locators(locators_b.begin()), Locators(locators_b.end()));
+                    }
+                    return true;
+                }));
+    EXPECT_CALL(participant, send_sync_mock(_, locators_b)).WillRepeatedly(Return(true));
+
+    build_message(true);
+    ASSERT_TRUE(aggregator->add(message, Locators(locators_a.begin()), Locators(locators_a.end())));
+    ASSERT_TRUE(aggregator->add(message, Locators(locators_a.begin()), Locators(locators_a.end())));
+    ASSERT_TRUE(queued_while_sending);
+
+    aggregator.reset();
+}
+
+TEST_F(ControlMessageAggregatorTests, messages_not_aggregated)
+{
+    EXPECT_CALL(participant, send_sync_mock(_, _)).Times(0);
+
+    auto aggregator = create_aggregator(RTPSMESSAGE_HEADER_SIZE + info_dst_size + control_submessage_size);
+
+    // No destinations
+    build_message(true);
+    std::vector<Locator_t> no_locators;
+    ASSERT_FALSE(aggregator->add(message, Locators(no_locators.begin()), Locators(no_locators.end())));
+
+    // Too big to be aggregated
+    build_message(true);
+    const octet submessage[control_submessage_size] = { ACKNACK, 0x01, 0x04, 0x00, 1, 2, 3, 4 };
+    CDRMessage::addData(&message, submessage, control_submessage_size);
+    ASSERT_FALSE(aggregator->add(message, Locators(locators_a.begin()), Locators(locators_a.end())));
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
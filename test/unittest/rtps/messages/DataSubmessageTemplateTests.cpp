@@ -0,0 +1,183 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <fastdds/rtps/messages/CDRMessage.h>
+#include <fastdds/rtps/messages/RTPSMessageCreator.h>
+#include <fastdds/rtps/messages/RTPS_messages.h>
+
+#include <cstring>
+#include <limits>
+
+using namespace eprosima::fastrtps::rtps;
+
+class DataSubmessageTemplateTests : public ::testing::Test
+{
+protected:
+
+    void SetUp() override
+    {
+        writer_id.value[0] = 1;
+        writer_id.value[3] = 0x02;
+        reader_id.value[1] = 3;
+        reader_id.value[3] = 0x07;
+        RTPSMessageCreator::initDataSubmessageTemplate(&data_template, writer_id);
+
+        change.kind = ALIVE;
+        change.writerGUID.entityId = writer_id;
+        change.sequenceNumber = SequenceNumber_t(1, 42);
+        change.sourceTimestamp = Time_t(1234, 5678u);
+    }
+
+    void set_payload(
+            uint32_t length)
+    {
+        change.serializedPayload.reserve(length);
+        for (uint32_t i = 0; i < length; ++i)
+        {
+            change.serializedPayload.data[i] = static_cast<octet>(i);
+        }
+        change.serializedPayload.length = length;
+    }
+
+    //! Checks the template gives the same bytes as adding the submessages one by one
+    void check_same_bytes(
+            TopicKind_t topic_kind,
+            bool expects_inline_qos,
+            uint32_t initial_position = 0,
+            bool add_info_ts = true)
+    {
+        CDRMessage_t expected(RTPSMESSAGE_DEFAULT_SIZE);
+        CDRMessage_t actual(RTPSMESSAGE_DEFAULT_SIZE);
+        for (uint32_t i = 0; i < initial_position; ++i)
+        {
+            CDRMessage::addOctet(&expected, 0xAA);
+            CDRMessage::addOctet(&actual, 0xAA);
+        }
+
+        bool is_big_submessage;
+        if (add_info_ts)
+        {
+            ASSERT_TRUE(RTPSMessageCreator::addSubmessageInfoTS(&expected, change.sourceTimestamp, false));
+        }
+        ASSERT_TRUE(RTPSMessageCreator::addSubmessageData(&expected, &change, topic_kind, reader_id,
+                expects_inline_qos, nullptr, &is_big_submessage));
+        ASSERT_FALSE(is_big_submessage);
+
+        ASSERT_TRUE(RTPSMessageCreator::addSubmessagesFromDataTemplate(&actual, data_template, &change, topic_kind,
+                reader_id, expects_inline_qos, add_info_ts));
+
+        ASSERT_EQ(expected.pos, actual.pos);
+        ASSERT_EQ(expected.length, actual.length);
+        EXPECT_EQ(0, memcmp(expected.buffer, actual.buffer, expected.length));
+    }
+
+    EntityId_t writer_id;
+
+    EntityId_t reader_id;
+
+    DataSubmessageTemplate data_template;
+
+    CacheChange_t change;
+};
+
+TEST_F(DataSubmessageTemplateTests, same_bytes_as_submessages)
+{
+    // All the paddings needed to align the submessage
+    for (uint32_t length = 1; length <= 8; ++length)
+    {
+        set_payload(length);
+        check_same_bytes(NO_KEY, false);
+        check_same_bytes(NO_KEY, true);
+        check_same_bytes(WITH_KEY, false);
+    }
+
+    set_payload(1000);
+    check_same_bytes(NO_KEY, false, 24);
+}
+
+TEST_F(DataSubmessageTemplateTests, without_info_ts)
+{
+    for (uint32_t length = 1; length <= 4; ++length)
+    {
+        set_payload(length);
+        check_same_bytes(NO_KEY, false, 0, false);
+        check_same_bytes(NO_KEY, false, 3, false);
+    }
+}
+
+TEST_F(DataSubmessageTemplateTests, unknown_reader)
+{
+    reader_id = c_EntityId_Unknown;
+    set_payload(16);
+    check_same_bytes(NO_KEY, false);
+}
+
+TEST_F(DataSubmessageTemplateTests, submessages_not_matching_template)
+{
+    CDRMessage_t msg(RTPSMESSAGE_DEFAULT_SIZE);
+    set_payload(16);
+
+    // Inline QoS with the key
+    ASSERT_FALSE(RTPSMessageCreator::addSubmessagesFromDataTemplate(&msg, data_template, &change, WITH_KEY,
+            reader_id, true, true));
+
+    // Inline QoS with the related sample identity
+    SampleIdentity related;
+    related.writer_guid(GUID_t(GuidPrefix_t(), writer_id));
+    related.sequence_number(SequenceNumber_t(0, 1));
+    change.write_params.related_sample_identity(related);
+    ASSERT_FALSE(RTPSMessageCreator::addSubmessagesFromDataTemplate(&msg, data_template, &change, NO_KEY,
+            reader_id, false, true));
+    change.write_params.related_sample_identity(SampleIdentity::unknown());
+
+    // Status info
+    change.kind = NOT_ALIVE_DISPOSED;
+    ASSERT_FALSE(RTPSMessageCreator::addSubmessagesFromDataTemplate(&msg, data_template, &change, NO_KEY,
+            reader_id, false, true));
+    change.kind = ALIVE;
+
+    // No payload
+    change.serializedPayload.length = 0;
+    ASSERT_FALSE(RTPSMessageCreator::addSubmessagesFromDataTemplate(&msg, data_template, &change, NO_KEY,
+            reader_id, false, true));
+
+    EXPECT_EQ(0u, msg.pos);
+    EXPECT_EQ(0u, msg.length);
+}
+
+TEST_F(DataSubmessageTemplateTests, no_room)
+{
+    set_payload(64);
+    CDRMessage_t msg(DataSubmessageTemplate::size + 63);
+    ASSERT_FALSE(RTPSMessageCreator::addSubmessagesFromDataTemplate(&msg, data_template, &change, NO_KEY,
+            reader_id, false, true));
+    EXPECT_EQ(0u, msg.pos);
+
+    // Bigger than the length field of the DATA submessage
+    set_payload(std::numeric_limits<uint16_t>::max());
+    CDRMessage_t big_msg(2 * std::numeric_limits<uint16_t>::max());
+    ASSERT_FALSE(RTPSMessageCreator::addSubmessagesFromDataTemplate(&big_msg, data_template, &change, NO_KEY,
+            reader_id, false, true));
+    EXPECT_EQ(0u, big_msg.pos);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -20,6 +20,7 @@
 #include <fastrtps/rtps/common/Time_t.h>
 #include <asio.hpp>
 #include <thread>
+#include <vector>
 #include <condition_variable>
 #include <gtest/gtest.h>
 
@@ -412,6 +413,63 @@ TEST_F(LivelinessManagerTests, TimerExpired_ManualByTopic)
     EXPECT_EQ(num_writers_lost, 1u);
 }
 
+//! Tests that writers asserted while alive, from several threads, keep their liveliness until they stop asserting
+TEST_F(LivelinessManagerTests, AssertLivelinessWhileAlive)
+{
+    LivelinessManager liveliness_manager(
+                std::bind(&LivelinessManagerTests::liveliness_changed,
+                          this,
+                          std::placeholders::_1,
+                          std::placeholders::_2,
+                          std::placeholders::_3,
+                          std::placeholders::_4,
+                          std::placeholders::_5),
+                service_);
+
+    GuidPrefix_t guidP;
+    guidP.value[0] = 1;
+
+    const unsigned int num_writers = 4u;
+    for (unsigned int i = 1; i <= num_writers; ++i)
+    {
+        liveliness_manager.add_writer(GUID_t(guidP, i), MANUAL_BY_TOPIC_LIVELINESS_QOS, Duration_t(0.1));
+        liveliness_manager.assert_liveliness(GUID_t(guidP, i), MANUAL_BY_TOPIC_LIVELINESS_QOS, Duration_t(0.1));
+    }
+    wait_liveliness_recovered(num_writers);
+
+    // Keep asserting for several lease durations
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i <= num_writers; ++i)
+    {
+        threads.emplace_back([&liveliness_manager, guidP, i]()
+                {
+                    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(400);
+                    while (std::chrono::steady_clock::now() < end)
+                    {
+                        EXPECT_TRUE(liveliness_manager.assert_liveliness(
+                                    GUID_t(guidP, i),
+                                    MANUAL_BY_TOPIC_LIVELINESS_QOS,
+                                    Duration_t(0.1)));
+                        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    }
+                });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(num_writers_lost, 0u);
+    EXPECT_EQ(num_writers_recovered, num_writers);
+    for (const LivelinessData& writer : liveliness_manager.get_liveliness_data())
+    {
+        EXPECT_EQ(writer.status, LivelinessData::WriterStatus::ALIVE);
+    }
+
+    // All of them are lost once they stop asserting
+    wait_liveliness_lost(num_writers);
+    EXPECT_EQ(num_writers_recovered, num_writers);
+}
+
 //! Tests that the timer owner is calculated correctly
 //! This is tested indirectly by checking which writer lost liveliness last
 TEST_F(LivelinessManagerTests, TimerOwnerCalculation)
@@ -133,6 +133,85 @@ TEST(ReaderProxyTests, are_there_gaps)
     ASSERT_FALSE(rproxy.are_there_gaps());
 }
 
+TEST(ReaderProxyTests, time_based_filter)
+{
+    StatefulWriter writerMock;
+    WriterTimes wTimes;
+    RemoteLocatorsAllocationAttributes alloc;
+    ReaderProxy rproxy(wTimes, alloc, &writerMock);
+
+    GUID_t writer_guid;
+    EXPECT_CALL(writerMock, getGuid()).WillRepeatedly(::testing::ReturnRef(writer_guid));
+
+    auto timestamp = [](int32_t sec, uint32_t nanosec)
+            {
+                Time_t time;
+                time.seconds(sec);
+                time.nanosec(nanosec);
+                return time;
+            };
+
+    CacheChange_t change;
+    change.kind = ALIVE;
+    change.sourceTimestamp = timestamp(10, 0);
+
+    // Without filter every change is relevant
+    ReaderProxyData reader_attributes(0, 0);
+    rproxy.start(reader_attributes);
+    ASSERT_FALSE(rproxy.has_time_based_filter());
+    ASSERT_TRUE(rproxy.rtps_is_relevant(&change));
+    ASSERT_TRUE(rproxy.rtps_is_relevant(&change));
+
+    // 100ms minimum separation
+    reader_attributes.m_qos.m_timeBasedFilter.minimum_separation = Duration_t(0, 100000000);
+    rproxy.update(reader_attributes);
+    ASSERT_TRUE(rproxy.has_time_based_filter());
+
+    InstanceHandle_t instance_1;
+    instance_1.value[0] = 1;
+    InstanceHandle_t instance_2;
+    instance_2.value[0] = 2;
+
+    change.instanceHandle = instance_1;
+    change.sourceTimestamp = timestamp(10, 0);
+    ASSERT_TRUE(rproxy.rtps_is_relevant(&change));
+    change.sourceTimestamp = timestamp(10, 50000000);
+    ASSERT_FALSE(rproxy.rtps_is_relevant(&change));
+    change.sourceTimestamp = timestamp(10, 99999999);
+    ASSERT_FALSE(rproxy.rtps_is_relevant(&change));
+
+    // Each instance is filtered on its own
+    change.instanceHandle = instance_2;
+    change.sourceTimestamp = timestamp(10, 60000000);
+    ASSERT_TRUE(rproxy.rtps_is_relevant(&change));
+
+    change.instanceHandle = instance_1;
+    change.sourceTimestamp = timestamp(10, 100000000);
+    ASSERT_TRUE(rproxy.rtps_is_relevant(&change));
+    change.sourceTimestamp = timestamp(10, 150000000);
+    ASSERT_FALSE(rproxy.rtps_is_relevant(&change));
+
+    // Changes on the state of the instance are never filtered
+    change.kind = NOT_ALIVE_DISPOSED;
+    ASSERT_TRUE(rproxy.rtps_is_relevant(&change));
+
+    // Unregistered instances are forgotten
+    change.kind = NOT_ALIVE_DISPOSED_UNREGISTERED;
+    ASSERT_TRUE(rproxy.rtps_is_relevant(&change));
+    change.kind = ALIVE;
+    change.sourceTimestamp = timestamp(10, 160000000);
+    ASSERT_TRUE(rproxy.rtps_is_relevant(&change));
+
+    // Irrelevant changes leave a hole, which is sent as a GAP
+    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 1)), false);
+    ChangeForReader_t irrelevant(SequenceNumber_t(0, 2));
+    irrelevant.setRelevance(false);
+    rproxy.add_change(irrelevant, false);
+    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 3)), false);
+    ASSERT_TRUE(rproxy.are_there_gaps());
+    ASSERT_TRUE(rproxy.change_is_acked(SequenceNumber_t(0, 2)));
+}
+
 } // namespace rtps
 } // namespace fastrtps
 } // namespace eprosima
@@ -894,6 +894,45 @@ TEST_F(SHMTransportTests, on_port_failure_free_enqueued_descriptors)
     thread_listener1.join();
 }
 
+TEST_F(SHMTransportTests, released_buffers_are_reused)
+{
+    const std::string domain_name("SHMTests");
+
+    SharedMemManager shared_mem_manager(domain_name);
+    auto segment = shared_mem_manager.create_segment(4096, 16);
+    std::vector<std::shared_ptr<SharedMemManager::Buffer> > buffers;
+
+    // Fill the segment with buffers of different sizes
+    uint32_t sizes[] = {100, 1000, 20, 1000, 500, 1476};
+    for (uint32_t size : sizes)
+    {
+        buffers.push_back(segment->alloc_buffer(size, std::chrono::steady_clock::time_point()));
+        ASSERT_EQ(size, buffers.back()->size());
+        memset(buffers.back()->data(), 0, size);
+    }
+
+    ASSERT_THROW(segment->alloc_buffer(1, std::chrono::steady_clock::time_point()), std::exception);
+
+    // A released buffer is given to the next allocation of a similar size
+    void* data = buffers[1]->data();
+    buffers[1].reset();
+    buffers[1] = segment->alloc_buffer(990, std::chrono::steady_clock::time_point());
+    ASSERT_EQ(data, buffers[1]->data());
+    ASSERT_EQ(990u, buffers[1]->size());
+
+    // Once everything is released, the whole segment can be allocated again, even in a single buffer
+    buffers.clear();
+    buffers.push_back(segment->alloc_buffer(4096, std::chrono::steady_clock::time_point()));
+    memset(buffers.back()->data(), 0, buffers.back()->size());
+    buffers.clear();
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        buffers.push_back(segment->alloc_buffer(256, std::chrono::steady_clock::time_point()));
+        memset(buffers.back()->data(), 0, buffers.back()->size());
+    }
+}
+
 TEST_F(SHMTransportTests, empty_cv_mutex_deadlocked_try_push)
 {
     const std::string domain_name("SHMTests");
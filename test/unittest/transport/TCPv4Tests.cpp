@@ -20,7 +20,9 @@
 #include <fastdds/dds/log/Log.hpp>
 #include <MockReceiverResource.h>
 #include "../../../src/cpp/rtps/transport/TCPSenderResource.hpp"
+#include "../../../src/cpp/rtps/transport/tcp/TCPChecksum.hpp"
 
+#include <atomic>
 #include <memory>
 #include <asio.hpp>
 #include <gtest/gtest.h>
@@ -1297,6 +1299,237 @@ TEST_F(TCPv4Tests, send_and_receive_between_blocked_interfaces_ports)
 
 #endif
 
+TEST_F(TCPv4Tests, checksum_sum_is_the_octet_by_octet_sum)
+{
+    using eprosima::fastdds::rtps::TCPChecksum;
+    using eprosima::fastdds::rtps::RTCPMessageManager;
+
+    std::vector<octet> data(1000);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<octet>(i * 131 + 7);
+    }
+
+    // Initial values close to the wraparound
+    for (uint32_t initial : {0u, 12345u, 0xFFFFFF00u, 0xFFFFFFFFu})
+    {
+        for (size_t size : {0u, 1u, 15u, 16u, 17u, 100u, 1000u})
+        {
+            uint32_t expected = initial;
+            for (size_t i = 0; i < size; ++i)
+            {
+                RTCPMessageManager::addToCRC(expected, data[i]);
+            }
+
+            EXPECT_EQ(expected, TCPChecksum::sum(initial, data.data(), size));
+
+            // Chained in two blocks
+            size_t half = size / 2;
+            uint32_t chained = TCPChecksum::sum(initial, data.data(), half);
+            EXPECT_EQ(expected, TCPChecksum::sum(chained, &data[half], size - half));
+        }
+    }
+}
+
+TEST_F(TCPv4Tests, checksum_crc32c)
+{
+    using eprosima::fastdds::rtps::TCPChecksum;
+
+    const octet check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    EXPECT_EQ(0xE3069283u, TCPChecksum::crc32c(0, check, sizeof(check)));
+
+    std::vector<octet> data(1000);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<octet>(i * 131 + 7);
+    }
+    uint32_t whole = TCPChecksum::crc32c(0, data.data(), data.size());
+    uint32_t chained = TCPChecksum::crc32c(TCPChecksum::crc32c(0, data.data(), 333), &data[333], data.size() - 333);
+    EXPECT_EQ(whole, chained);
+}
+
+TEST_F(TCPv4Tests, bind_messages_carry_the_checksum_kind)
+{
+    using namespace eprosima::fastdds::rtps;
+
+    ConnectionRequest_t request;
+    request.checksumKind(TCP_CHECKSUM_CRC32C);
+    SerializedPayload_t payload(static_cast<uint32_t>(ConnectionRequest_t::getBufferCdrSerializedSize(request)));
+    ASSERT_TRUE(request.serialize(&payload));
+
+    ConnectionRequest_t received;
+    ASSERT_TRUE(received.deserialize(&payload));
+    EXPECT_EQ(TCP_CHECKSUM_CRC32C, received.checksumKind());
+
+    // Peers with the first version of the protocol do not send it
+    payload.length -= 1;
+    ASSERT_TRUE(received.deserialize(&payload));
+    EXPECT_EQ(TCP_CHECKSUM_SUM, received.checksumKind());
+
+    BindConnectionResponse_t response;
+    response.checksumKind(TCP_CHECKSUM_CRC32C);
+    SerializedPayload_t response_payload(
+        static_cast<uint32_t>(BindConnectionResponse_t::getBufferCdrSerializedSize(response)));
+    ASSERT_TRUE(response.serialize(&response_payload));
+
+    BindConnectionResponse_t received_response;
+    ASSERT_TRUE(received_response.deserialize(&response_payload));
+    EXPECT_EQ(TCP_CHECKSUM_CRC32C, received_response.checksumKind());
+}
+
+#ifndef __APPLE__
+TEST_F(TCPv4Tests, send_and_receive_with_crc32c)
+{
+    eprosima::fastdds::dds::Log::ClearConsumers();
+    TCPv4TransportDescriptor recvDescriptor;
+    recvDescriptor.add_listener_port(g_default_port);
+    recvDescriptor.wait_for_tcp_negotiation = true;
+    recvDescriptor.use_crc32c = true;
+    TCPv4Transport receiveTransportUnderTest(recvDescriptor);
+    receiveTransportUnderTest.init();
+
+    TCPv4TransportDescriptor sendDescriptor;
+    sendDescriptor.wait_for_tcp_negotiation = true;
+    sendDescriptor.use_crc32c = true;
+    TCPv4Transport sendTransportUnderTest(sendDescriptor);
+    sendTransportUnderTest.init();
+
+    Locator_t inputLocator;
+    inputLocator.kind = LOCATOR_KIND_TCPv4;
+    inputLocator.port = g_default_port;
+    IPLocator::setIPv4(inputLocator, 127, 0, 0, 1);
+    IPLocator::setLogicalPort(inputLocator, 7410);
+
+    LocatorList_t locator_list;
+    locator_list.push_back(inputLocator);
+
+    Locator_t outputLocator;
+    outputLocator.kind = LOCATOR_KIND_TCPv4;
+    IPLocator::setIPv4(outputLocator, 127, 0, 0, 1);
+    outputLocator.port = g_default_port;
+    IPLocator::setLogicalPort(outputLocator, 7410);
+
+    MockReceiverResource receiver(receiveTransportUnderTest, inputLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+    ASSERT_TRUE(receiveTransportUnderTest.IsInputChannelOpen(inputLocator));
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(sendTransportUnderTest.OpenOutputChannel(send_resource_list, outputLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+    octet message[5] = { 'H','e','l','l','o' };
+
+    Semaphore sem;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message, msg_recv->data, 5), 0);
+        sem.post();
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    auto sendThreadFunction = [&]()
+    {
+        bool sent = false;
+        while (!sent)
+        {
+            Locators input_begin(locator_list.begin());
+            Locators input_end(locator_list.end());
+
+            sent = send_resource_list.at(0)->send(message, 5, &input_begin, &input_end, (std::chrono::steady_clock::now()+ std::chrono::microseconds(100)));
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        EXPECT_TRUE(sent);
+    };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    senderThread->join();
+    sem.wait();
+
+    // Any message checked with the wrong kind of checksum would have been reported
+    eprosima::fastdds::dds::Log::Flush();
+}
+
+TEST_F(TCPv4Tests, send_and_receive_consecutive_messages)
+{
+    eprosima::fastdds::dds::Log::ClearConsumers();
+    TCPv4TransportDescriptor recvDescriptor;
+    recvDescriptor.add_listener_port(g_default_port);
+    recvDescriptor.wait_for_tcp_negotiation = true;
+    TCPv4Transport receiveTransportUnderTest(recvDescriptor);
+    receiveTransportUnderTest.init();
+
+    TCPv4TransportDescriptor sendDescriptor;
+    sendDescriptor.wait_for_tcp_negotiation = true;
+    TCPv4Transport sendTransportUnderTest(sendDescriptor);
+    sendTransportUnderTest.init();
+
+    Locator_t inputLocator;
+    inputLocator.kind = LOCATOR_KIND_TCPv4;
+    inputLocator.port = g_default_port;
+    IPLocator::setIPv4(inputLocator, 127, 0, 0, 1);
+    IPLocator::setLogicalPort(inputLocator, 7410);
+
+    LocatorList_t locator_list;
+    locator_list.push_back(inputLocator);
+
+    Locator_t outputLocator;
+    outputLocator.kind = LOCATOR_KIND_TCPv4;
+    IPLocator::setIPv4(outputLocator, 127, 0, 0, 1);
+    outputLocator.port = g_default_port;
+    IPLocator::setLogicalPort(outputLocator, 7410);
+
+    MockReceiverResource receiver(receiveTransportUnderTest, inputLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+    ASSERT_TRUE(receiveTransportUnderTest.IsInputChannelOpen(inputLocator));
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(sendTransportUnderTest.OpenOutputChannel(send_resource_list, outputLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+    octet message[5] = { 'H','e','l','l','o' };
+
+    // Small messages sent back to back arrive together, and are parsed from the same chunk of the stream
+    const uint32_t num_messages = 100;
+    std::atomic<uint32_t> received(0);
+    Semaphore sem;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(msg_recv->data[0], static_cast<octet>(received));
+        EXPECT_EQ(memcmp(&message[1], &msg_recv->data[1], 4), 0);
+        if (++received == num_messages)
+        {
+            sem.post();
+        }
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    // Wait for the connection to be established
+    bool sent = false;
+    while (!sent)
+    {
+        Locators input_begin(locator_list.begin());
+        Locators input_end(locator_list.end());
+
+        message[0] = 0;
+        sent = send_resource_list.at(0)->send(message, 5, &input_begin, &input_end, (std::chrono::steady_clock::now()+ std::chrono::microseconds(100)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    for (uint32_t i = 1; i < num_messages; ++i)
+    {
+        Locators input_begin(locator_list.begin());
+        Locators input_end(locator_list.end());
+
+        message[0] = static_cast<octet>(i);
+        EXPECT_TRUE(send_resource_list.at(0)->send(message, 5, &input_begin, &input_end, (std::chrono::steady_clock::now()+ std::chrono::milliseconds(100))));
+    }
+
+    sem.wait();
+    EXPECT_EQ(num_messages, received.load());
+}
+#endif
+
 void TCPv4Tests::HELPER_SetDescriptorDefaults()
 {
     descriptor.add_listener_port(g_default_port);
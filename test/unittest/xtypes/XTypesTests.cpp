@@ -17,8 +17,12 @@
 #include <fastdds/dds/log/Log.hpp>
 #include "idl/TypesTypeObject.h"
 #include "idl/WideEnumTypeObject.h"
+#include <fastdds/builtin/typelookup/TypeObjectCache.hpp>
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <fstream>
+
 using namespace eprosima::fastrtps;
 using namespace eprosima::fastrtps::types;
 
@@ -731,6 +735,90 @@ TEST_F(XTypesTests, SimpleUnionCompleteCoercion)
     ASSERT_FALSE(basic_wide_union->consistent(*basic_union, consistencyQos));
 }
 
+TEST_F(XTypesTests, TypeObjectCacheRoundTrip)
+{
+    using eprosima::fastdds::dds::builtin::TypeObjectCache;
+
+    const std::string filename = "XTypesTests_type_cache.bin";
+    std::remove(filename.c_str());
+
+    const TypeIdentifier* enum_id = GetMyEnumStructIdentifier(true);
+    const TypeObject* enum_obj = GetCompleteMyEnumStructObject();
+    const TypeIdentifier* alias_id = GetMyAliasEnumStructIdentifier(true);
+    const TypeObject* alias_obj = GetCompleteMyAliasEnumStructObject();
+    const TypeIdentifier* minimal_id = GetMyAliasEnumStructIdentifier(false);
+    const TypeObject* minimal_obj = GetMinimalMyAliasEnumStructObject();
+    ASSERT_NE(enum_id, nullptr);
+    ASSERT_NE(alias_id, nullptr);
+    ASSERT_NE(minimal_id, nullptr);
+
+    // Only complete hashed identifiers with a complete TypeObject are kept
+    {
+        TypeObjectCache cache(filename);
+        ASSERT_TRUE(cache.store(*enum_id, *enum_obj));
+        ASSERT_FALSE(cache.store(*enum_id, *enum_obj));
+        ASSERT_TRUE(cache.store(*alias_id, *alias_obj));
+        ASSERT_FALSE(cache.store(*minimal_id, *minimal_obj));
+        ASSERT_FALSE(cache.store(*TypeObjectFactory::get_instance()->get_type_identifier("int32_t"), *enum_obj));
+        // Stored types weren't loaded from the file
+        ASSERT_FALSE(cache.contains(*enum_id));
+    }
+
+    {
+        TypeObjectCache cache(filename);
+        ASSERT_EQ(cache.load(TypeObjectFactory::get_instance()), 2u);
+        ASSERT_TRUE(cache.contains(*enum_id));
+        ASSERT_TRUE(cache.contains(*alias_id));
+        ASSERT_FALSE(cache.store(*enum_id, *enum_obj));
+    }
+
+    // Types are registered under their own name
+    ASSERT_EQ(TypeObjectFactory::get_instance()->get_type_name(enum_id), "MyEnumStruct");
+
+    // A half written record at the end is ignored, and the file is left as it is
+    {
+        std::ofstream out(filename, std::ios::binary | std::ios::app);
+        const char partial[] = { 0x40, 0x00, 0x00, 0x00, 0x10 };
+        out.write(partial, sizeof(partial));
+    }
+
+    std::streamoff broken_size;
+    {
+        std::ifstream in(filename, std::ios::binary | std::ios::ate);
+        broken_size = in.tellg();
+    }
+
+    {
+        TypeObjectCache cache(filename);
+        ASSERT_EQ(cache.load(TypeObjectFactory::get_instance()), 2u);
+        ASSERT_TRUE(cache.contains(*enum_id));
+        ASSERT_FALSE(cache.store(*GetMyBadEnumStructIdentifier(true), *GetCompleteMyBadEnumStructObject()));
+    }
+
+    {
+        std::ifstream in(filename, std::ios::binary | std::ios::ate);
+        ASSERT_EQ(in.tellg(), broken_size);
+    }
+
+    const TypeObject* loaded = TypeObjectFactory::get_instance()->get_type_object(enum_id);
+    ASSERT_NE(loaded, nullptr);
+    ASSERT_TRUE(*loaded == *enum_obj);
+
+    // A file that isn't a cache is neither loaded nor written
+    {
+        std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+        out << "not a cache";
+    }
+
+    {
+        TypeObjectCache cache(filename);
+        ASSERT_EQ(cache.load(TypeObjectFactory::get_instance()), 0u);
+        ASSERT_FALSE(cache.store(*enum_id, *enum_obj));
+    }
+
+    std::remove(filename.c_str());
+}
+
 int main(int argc, char **argv)
 {
     eprosima::fastdds::dds::Log::SetVerbosity(eprosima::fastdds::dds::Log::Info);